@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef BASE_PARALLEL_H
+#define BASE_PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <vector>
+
+
+namespace Base
+{
+
+/**
+ * Splits the index range [0, count) into at most \a threads contiguous blocks and calls
+ * \a func(begin, end, block) for each of them concurrently. The blocks are numbered in
+ * ascending order of their ranges, so results collected per block can be merged in order.
+ * If \a threads is less than one the number of hardware threads is used.
+ */
+template<class Func>
+void parallel_for(std::size_t count, int threads, Func func)
+{
+    if (threads < 1) {
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    std::size_t blocks = std::min(static_cast<std::size_t>(threads), count);
+    if (blocks < 2) {
+        if (count > 0) {
+            func(std::size_t(0), count, std::size_t(0));
+        }
+        return;
+    }
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(blocks - 1);
+    std::size_t step = count / blocks;
+    std::size_t extra = count % blocks;
+    std::size_t begin = 0;
+    for (std::size_t block = 0; block < blocks; block++) {
+        std::size_t end = begin + step + (block < extra ? 1 : 0);
+        if (block + 1 < blocks) {
+            futures.push_back(std::async(std::launch::async, func, begin, end, block));
+        }
+        else {
+            func(begin, end, block);
+        }
+        begin = end;
+    }
+
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
+}  // namespace Base
+
+
+#endif  // BASE_PARALLEL_H
@@ -173,17 +173,18 @@ private:
         }
         std::string EncodedName = std::string(Name);
         PyMem_Free(Name);
-        Base::FileInfo file(EncodedName.c_str());
 
         if (PyObject_TypeCheck(pObj, &(App::DocumentObjectPy::Type))) {
             App::DocumentObject* obj =
                 static_cast<App::DocumentObjectPy*>(pObj)->getDocumentObjectPtr();
             if (obj->isDerivedFrom<Path::Feature>()) {
                 const Path::Toolpath& path = static_cast<Path::Feature*>(obj)->Path.getValue();
-                std::string gcode = path.toGCode();
-                Base::ofstream ofile(file);
-                ofile << gcode;
-                ofile.close();
+                try {
+                    path.writeGCodeFile(EncodedName);
+                }
+                catch (const Base::Exception& e) {
+                    throw Py::RuntimeError(e.what());
+                }
             }
             else {
                 throw Py::RuntimeError("The given file is not a path");
@@ -222,12 +223,8 @@ private:
 
         try {
             // read the gcode file
-            Base::ifstream filestr(file);
-            std::stringstream buffer;
-            buffer << filestr.rdbuf();
-            std::string gcode = buffer.str();
             Path::Toolpath path;
-            path.setFromGCode(gcode);
+            path.setFromGCodeFile(EncodedName);
             auto* object = pcDoc->addObject<Path::Feature>(file.fileNamePure().c_str());
             object->Path.setValue(path);
             pcDoc->recompute();
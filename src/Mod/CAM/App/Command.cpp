@@ -34,6 +34,7 @@
 #include <Base/Writer.h>
 
 #include "Command.h"
+#include "GCodeStream.h"
 
 
 using namespace Base;
@@ -96,14 +97,8 @@ bool Command::has(const std::string& attr) const
 
 std::string Command::toGCode(int precision, bool padzero) const
 {
-    std::stringstream str;
-    str.fill('0');
-    str << Name;
-    if (precision < 0) {
-        precision = 0;
-    }
-    double scale = std::pow(10.0, precision + 1);
-    std::int64_t iscale = static_cast<std::int64_t>(scale) / 10;
+    std::string str = Name;
+    char buf[GCodeWriter::MaxValueSize];
     for (std::map<std::string, double>::const_iterator i = Parameters.begin();
          i != Parameters.end();
          ++i) {
@@ -111,34 +106,11 @@ std::string Command::toGCode(int precision, bool padzero) const
             continue;
         }
 
-        str << " " << i->first;
-
-        std::int64_t v = static_cast<std::int64_t>(i->second * scale);
-        if (v < 0) {
-            v = -v;
-            str << '-';  // shall we allow -0 ?
-        }
-        v += 5;
-        v /= 10;
-        str << (v / iscale);
-        if (!precision) {
-            continue;
-        }
-
-        int width = precision;
-        std::int64_t digits = v % iscale;
-        if (!padzero) {
-            if (!digits) {
-                continue;
-            }
-            while (digits % 10 == 0) {
-                digits /= 10;
-                --width;
-            }
-        }
-        str << '.' << std::setw(width) << std::right << digits;
+        str += ' ';
+        str += i->first;
+        str.append(buf, GCodeWriter::formatValue(buf, i->second, precision, padzero));
     }
-    return str.str();
+    return str;
 }
 
 void Command::setFromGCode(const std::string& str)
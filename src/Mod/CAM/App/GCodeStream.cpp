@@ -0,0 +1,468 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <ostream>
+#include <thread>
+#include <vector>
+#endif
+
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+
+#include "Command.h"
+#include "GCodeStream.h"
+#include "PackedToolpath.h"
+
+
+using namespace Path;
+
+namespace
+{
+
+// inputs below this size are not worth splitting
+constexpr std::size_t MinChunkSize = 1 << 20;
+// flush threshold of the writer
+constexpr std::size_t WriteBufferSize = 1 << 20;
+
+inline bool isSegmentStart(char c)
+{
+    return c == '(' || c == 'g' || c == 'G' || c == 'm' || c == 'M';
+}
+
+inline bool isValueChar(char c)
+{
+    return (c >= '0' && c <= '9') || c == '-' || c == '.';
+}
+
+inline bool isAlpha(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+inline char toUpper(char c)
+{
+    return (c >= 'a' && c <= 'z') ? char(c - 'a' + 'A') : c;
+}
+
+inline std::uint32_t letterBit(char c)
+{
+    return std::uint32_t(1) << (c - 'A');
+}
+
+// the parameters converted by Command::scaleBy()
+const std::uint32_t InchLetters = letterBit('X') | letterBit('Y') | letterBit('Z')
+    | letterBit('I') | letterBit('J') | letterBit('R') | letterBit('Q') | letterBit('F');
+
+/* Parses one contiguous piece of G-code. It reproduces the splitting of
+ * Toolpath::setFromGCode() into commands and comments and the interpretation of
+ * Command::setFromGCode() for each of them, reusing its buffers so that no memory is
+ * allocated per command once they have grown.
+ */
+class ChunkParser
+{
+public:
+    explicit ChunkParser(PackedToolpath& commands)
+        : commands(commands)
+    {}
+
+    // parses [begin, end) of text, the last chunk drops an unterminated comment
+    void parse(std::string_view text, std::size_t begin, std::size_t end, bool isLast)
+    {
+        bool comment = false;
+        std::size_t last = std::string_view::npos;
+        std::size_t found = findSegment(text, begin, end);
+        while (found < end) {
+            if (text[found] == '(') {
+                if (last != std::string_view::npos && !comment) {
+                    addSegment(text.substr(last, found - last));
+                }
+                comment = true;
+                last = found;
+                found = text.find(')', found + 1);
+                found = std::min(found, end);
+            }
+            else if (text[found] == ')') {
+                addSegment(text.substr(last, found - last + 1));
+                last = std::string_view::npos;
+                found = findSegment(text, found + 1, end);
+                comment = false;
+            }
+            else {
+                if (last != std::string_view::npos) {
+                    addSegment(text.substr(last, found - last));
+                }
+                last = found;
+                found = findSegment(text, found + 1, end);
+            }
+        }
+        if (last != std::string_view::npos) {
+            if (!comment) {
+                addSegment(text.substr(last, end - last));
+            }
+            else if (!isLast) {
+                openComment = true;
+            }
+        }
+    }
+
+    // true if the chunk ends inside a comment, so the next one was split at a wrong place
+    bool openComment = false;
+    // number of commands before the first G20/G21 of the chunk
+    std::size_t beforeUnitSwitch = std::string_view::npos;
+    bool inches = false;
+
+private:
+    static std::size_t findSegment(std::string_view text, std::size_t pos, std::size_t end)
+    {
+        while (pos < end && !isSegmentStart(text[pos])) {
+            ++pos;
+        }
+        return pos;
+    }
+
+    void addParameter()
+    {
+        if (!isAlpha(key)) {
+            // a ')' outside of a comment makes '(' the key, which has no letter slot
+            otherKeys = true;
+            return;
+        }
+        char c = toUpper(key);
+        double val = 0.0;
+        std::from_chars(value.data(), value.data() + value.size(), val);
+        // like atof() a malformed number reads as far as it is valid, or as zero
+        mask |= letterBit(c);
+        letterValues[c - 'A'] = val;
+    }
+
+    void addSegment(std::string_view str)
+    {
+        enum class Mode
+        {
+            None,
+            Command,
+            Argument,
+            Comment
+        };
+        Mode mode = Mode::None;
+        key = 0;
+        value.clear();
+        mask = 0;
+        otherKeys = false;
+
+        for (char c : str) {
+            if (isValueChar(c)) {
+                value += c;
+            }
+            else if (isAlpha(c)) {
+                if (mode == Mode::Command) {
+                    if (!key || value.empty()) {
+                        throw Base::BadFormatError("Badly formatted GCode command");
+                    }
+                    name.assign(1, toUpper(key));
+                    name += value;
+                    value.clear();
+                    mode = Mode::Argument;
+                }
+                else if (mode == Mode::None) {
+                    mode = Mode::Command;
+                }
+                else if (mode == Mode::Argument) {
+                    if (!key || value.empty()) {
+                        throw Base::BadFormatError("Badly formatted GCode argument");
+                    }
+                    addParameter();
+                    value.clear();
+                }
+                else {
+                    value += c;
+                }
+                key = c;
+            }
+            else if (c == '(') {
+                mode = Mode::Comment;
+            }
+            else if (c == ')') {
+                key = '(';
+                value += ')';
+            }
+            else if (mode == Mode::Comment) {
+                // add non-ascii characters only if this is a comment
+                value += c;
+            }
+        }
+        if (!key || value.empty()) {
+            throw Base::BadFormatError("Badly formatted GCode argument");
+        }
+        if (mode == Mode::Command || mode == Mode::Comment) {
+            name.assign(1, mode == Mode::Command ? toUpper(key) : key);
+            name += value;
+        }
+        else {
+            addParameter();
+        }
+
+        if (name == "G20" || name == "G21") {
+            if (beforeUnitSwitch == std::string_view::npos) {
+                beforeUnitSwitch = commands.size();
+            }
+            inches = name == "G20";
+            return;
+        }
+        if (otherKeys) {
+            // rare enough to take the slow path, the side table keeps these parameters
+            Command cmd;
+            cmd.setFromGCode(std::string(str));
+            if (inches) {
+                cmd.scaleBy(25.4);
+            }
+            commands.push_back(cmd);
+            return;
+        }
+        if (inches) {
+            for (int i = 0; i < 26; i++) {
+                if ((mask & InchLetters) & (std::uint32_t(1) << i)) {
+                    letterValues[i] *= 25.4;
+                }
+            }
+        }
+        commands.push_back(name, mask, letterValues.data());
+    }
+
+    PackedToolpath& commands;
+    std::string name;
+    std::string value;
+    char key = 0;
+    std::uint32_t mask = 0;
+    bool otherKeys = false;
+    std::array<double, 26> letterValues {};
+};
+
+}  // namespace
+
+// GCodeParser
+
+GCodeParser::GCodeParser(int threads)
+    : threads(threads)
+{
+    if (this->threads < 1) {
+        this->threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+}
+
+void GCodeParser::parse(std::string_view text, PackedToolpath& commands) const
+{
+    std::size_t count = std::min<std::size_t>(threads, text.size() / MinChunkSize);
+
+    // split at line starts that begin a command or a comment
+    std::vector<std::size_t> bounds {0};
+    for (std::size_t i = 1; i < count; i++) {
+        std::size_t pos = std::max(bounds.back() + 1, text.size() * i / count);
+        while (pos < text.size() && !(text[pos - 1] == '\n' && isSegmentStart(text[pos]))) {
+            ++pos;
+        }
+        if (pos >= text.size()) {
+            break;
+        }
+        bounds.push_back(pos);
+    }
+    bounds.push_back(text.size());
+
+    if (bounds.size() <= 2) {
+        ChunkParser parser(commands);
+        parser.parse(text, 0, text.size(), true);
+        return;
+    }
+
+    std::size_t chunks = bounds.size() - 1;
+    std::vector<PackedToolpath> results(chunks);
+    std::vector<ChunkParser> parsers;
+    parsers.reserve(chunks);
+    for (std::size_t i = 0; i < chunks; i++) {
+        parsers.emplace_back(results[i]);
+    }
+    std::vector<std::exception_ptr> errors(chunks);
+    std::vector<std::thread> workers;
+    workers.reserve(chunks);
+    for (std::size_t i = 0; i < chunks; i++) {
+        workers.emplace_back([&, i]() {
+            try {
+                parsers[i].parse(text, bounds[i], bounds[i + 1], i + 1 == chunks);
+            }
+            catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    // a comment spanning a line break at a split point, start over in one piece
+    if (std::any_of(parsers.begin(), parsers.end(), [](const ChunkParser& p) {
+            return p.openComment;
+        })) {
+        ChunkParser parser(commands);
+        parser.parse(text, 0, text.size(), true);
+        return;
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // every chunk started in millimeters, carry the unit mode over from its predecessor
+    bool inches = false;
+    for (std::size_t i = 0; i < chunks; i++) {
+        const ChunkParser& parser = parsers[i];
+        if (inches) {
+            std::size_t last = std::min(parser.beforeUnitSwitch, results[i].size());
+            results[i].scale(0, last, InchLetters, 25.4);
+        }
+        if (parser.beforeUnitSwitch != std::string_view::npos) {
+            inches = parser.inches;
+        }
+        commands.append(results[i]);
+        results[i].clear();
+    }
+}
+
+void GCodeParser::parseFile(const std::string& fileName, PackedToolpath& commands) const
+{
+    Base::FileInfo file(fileName);
+    Base::ifstream str(file, std::ios::in | std::ios::binary);
+    if (!str) {
+        throw Base::FileException("Cannot open file", file);
+    }
+    std::string text(std::istreambuf_iterator<char>(str), {});
+    parse(text, commands);
+}
+
+// GCodeWriter
+
+GCodeWriter::GCodeWriter(int precision, bool padzero)
+    : precision(precision)
+    , padzero(padzero)
+{}
+
+char* GCodeWriter::formatValue(char* buf, double value, int precision, bool padzero)
+{
+    static constexpr std::array<double, 19> powers {1e0,  1e1,  1e2,  1e3,  1e4,
+                                                    1e5,  1e6,  1e7,  1e8,  1e9,
+                                                    1e10, 1e11, 1e12, 1e13, 1e14,
+                                                    1e15, 1e16, 1e17, 1e18};
+    // beyond that the scaled value no longer fits into 64 bits
+    precision = std::clamp(precision, 0, 17);
+    double scale = powers[precision + 1];
+    std::int64_t iscale = static_cast<std::int64_t>(scale) / 10;
+
+    char* end = buf + MaxValueSize;
+    std::int64_t v = static_cast<std::int64_t>(value * scale);
+    if (v < 0) {
+        v = -v;
+        *buf++ = '-';  // shall we allow -0 ?
+    }
+    v += 5;
+    v /= 10;
+    buf = std::to_chars(buf, end, v / iscale).ptr;
+    if (!precision) {
+        return buf;
+    }
+
+    int width = precision;
+    std::int64_t digits = v % iscale;
+    if (!padzero) {
+        if (!digits) {
+            return buf;
+        }
+        while (digits % 10 == 0) {
+            digits /= 10;
+            --width;
+        }
+    }
+    *buf++ = '.';
+    char tmp[20];
+    char* tmpEnd = std::to_chars(tmp, tmp + sizeof(tmp), digits).ptr;
+    int length = static_cast<int>(tmpEnd - tmp);
+    for (; length < width; --width) {
+        *buf++ = '0';
+    }
+    std::memcpy(buf, tmp, length);
+    return buf + length;
+}
+
+void GCodeWriter::append(std::string& out, const CommandView& cmd) const
+{
+    if (cmd.hasLongParameters()) {
+        // long parameter names interleave with the letters, keep the order of Command
+        out += cmd.toCommand().toGCode(precision, padzero);
+        return;
+    }
+
+    char buf[MaxValueSize];
+    out += cmd.name();
+    for (char c = 'A'; c <= 'Z'; c++) {
+        if (c == 'N' || !cmd.has(c)) {
+            continue;
+        }
+        out += ' ';
+        out += c;
+        out.append(buf, formatValue(buf, cmd.getParam(c), precision, padzero));
+    }
+}
+
+void GCodeWriter::write(std::ostream& out, const PackedToolpath& commands) const
+{
+    std::string buffer;
+    buffer.reserve(WriteBufferSize + 256);
+    for (std::size_t i = 0; i < commands.size(); i++) {
+        append(buffer, commands[i]);
+        buffer += '\n';
+        if (buffer.size() >= WriteBufferSize) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+void GCodeWriter::writeFile(const std::string& fileName, const PackedToolpath& commands) const
+{
+    Base::FileInfo file(fileName);
+    Base::ofstream str(file, std::ios::out | std::ios::binary);
+    if (!str) {
+        throw Base::FileException("Cannot open file", file);
+    }
+    write(str, commands);
+}
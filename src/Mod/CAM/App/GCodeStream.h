@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef PATH_GCODESTREAM_H
+#define PATH_GCODESTREAM_H
+
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <Mod/CAM/PathGlobal.h>
+
+namespace Path
+{
+class CommandView;
+class PackedToolpath;
+
+/** Reads G-code text straight into a PackedToolpath.
+ * The text is split into commands and comments and interpreted the same way as
+ * Command::setFromGCode(), including the G20/G21 unit switches, but without building
+ * intermediate Command objects. Large inputs are split at line starts and parsed in
+ * parallel, the pieces are appended in order.
+ */
+class PathExport GCodeParser
+{
+public:
+    // threads < 1 uses the hardware concurrency
+    explicit GCodeParser(int threads = 0);
+
+    // appends the commands of text, throws Base::BadFormatError on malformed commands
+    void parse(std::string_view text, PackedToolpath& commands) const;
+    void parseFile(const std::string& fileName, PackedToolpath& commands) const;
+
+private:
+    int threads;
+};
+
+/** Writes the commands of a PackedToolpath as G-code text, one command per line.
+ * The output is identical to calling Command::toGCode() on every command.
+ */
+class PathExport GCodeWriter
+{
+public:
+    explicit GCodeWriter(int precision = 6, bool padzero = true);
+
+    void write(std::ostream& out, const PackedToolpath& commands) const;
+    void writeFile(const std::string& fileName, const PackedToolpath& commands) const;
+    // appends a single command without a line break
+    void append(std::string& out, const CommandView& cmd) const;
+
+    // writes a parameter value to buf and returns the end of the written characters,
+    // buf must hold at least MaxValueSize characters
+    static char* formatValue(char* buf, double value, int precision, bool padzero);
+    static constexpr int MaxValueSize = 48;
+
+private:
+    int precision;
+    bool padzero;
+};
+
+}  // namespace Path
+
+#endif  // PATH_GCODESTREAM_H
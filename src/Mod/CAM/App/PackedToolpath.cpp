@@ -0,0 +1,338 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <bit>
+#include <ostream>
+#include <boost/algorithm/string.hpp>
+#endif
+
+#include <Base/Rotation.h>
+
+#include "Command.h"
+#include "GCodeStream.h"
+#include "PackedToolpath.h"
+
+
+using namespace Path;
+
+namespace
+{
+inline bool isLetter(char c)
+{
+    return c >= 'A' && c <= 'Z';
+}
+
+inline std::uint32_t letterBit(char c)
+{
+    return std::uint32_t(1) << (c - 'A');
+}
+}  // namespace
+
+// CommandView
+
+Opcode CommandView::opcode() const
+{
+    return store->opcodes[store->records[index].name];
+}
+
+const std::string& CommandView::name() const
+{
+    return store->names[store->records[index].name];
+}
+
+bool CommandView::hasLongParameters() const
+{
+    return store->records[index].extra != PackedToolpath::NoExtra;
+}
+
+bool CommandView::has(char letter) const
+{
+    return isLetter(letter) && (store->records[index].mask & letterBit(letter)) != 0;
+}
+
+double CommandView::getParam(char letter, double fallback) const
+{
+    if (!has(letter)) {
+        return fallback;
+    }
+    const PackedToolpath::Record& rec = store->records[index];
+    std::uint32_t below = rec.mask & (letterBit(letter) - 1);
+    return store->values[rec.offset + std::popcount(below)];
+}
+
+bool CommandView::has(const std::string& attr) const
+{
+    std::string a(attr);
+    boost::to_upper(a);
+    if (a.size() == 1 && isLetter(a[0])) {
+        return has(a[0]);
+    }
+    const PackedToolpath::Record& rec = store->records[index];
+    return rec.extra != PackedToolpath::NoExtra && store->extras[rec.extra].contains(a);
+}
+
+double CommandView::getValue(const std::string& attr) const
+{
+    std::string a(attr);
+    boost::to_upper(a);
+    if (a.size() == 1 && isLetter(a[0])) {
+        return getParam(a[0]);
+    }
+    const PackedToolpath::Record& rec = store->records[index];
+    if (rec.extra == PackedToolpath::NoExtra) {
+        return 0.0;
+    }
+    const std::map<std::string, double>& params = store->extras[rec.extra];
+    auto it = params.find(a);
+    return it == params.end() ? 0.0 : it->second;
+}
+
+Base::Placement CommandView::getPlacement(const Base::Vector3d& pos) const
+{
+    Base::Rotation rot;
+    rot.setYawPitchRoll(getParam('A'), getParam('B'), getParam('C'));
+    return Base::Placement(getPosition(pos), rot);
+}
+
+Base::Vector3d CommandView::getCenter() const
+{
+    return Base::Vector3d(getParam('I'), getParam('J'), getParam('K'));
+}
+
+Base::Vector3d CommandView::getPosition(const Base::Vector3d& pos) const
+{
+    return Base::Vector3d(getParam('X', pos.x), getParam('Y', pos.y), getParam('Z', pos.z));
+}
+
+Command CommandView::toCommand() const
+{
+    const PackedToolpath::Record& rec = store->records[index];
+    Command cmd;
+    cmd.Name = name();
+    std::uint32_t offset = rec.offset;
+    for (char c = 'A'; c <= 'Z'; c++) {
+        if (rec.mask & letterBit(c)) {
+            cmd.Parameters.emplace_hint(cmd.Parameters.end(),
+                                        std::string(1, c),
+                                        store->values[offset++]);
+        }
+    }
+    if (rec.extra != PackedToolpath::NoExtra) {
+        const std::map<std::string, double>& params = store->extras[rec.extra];
+        cmd.Parameters.insert(params.begin(), params.end());
+    }
+    return cmd;
+}
+
+void CommandView::toGCode(std::ostream& str, int precision, bool padzero) const
+{
+    str << toGCode(precision, padzero);
+}
+
+std::string CommandView::toGCode(int precision, bool padzero) const
+{
+    std::string str;
+    GCodeWriter(precision, padzero).append(str, *this);
+    return str;
+}
+
+// PackedToolpath
+
+void PackedToolpath::clear()
+{
+    records.clear();
+    values.clear();
+    extras.clear();
+}
+
+void PackedToolpath::reserve(std::size_t count, std::size_t values)
+{
+    records.reserve(count);
+    this->values.reserve(values);
+}
+
+std::uint32_t PackedToolpath::intern(const std::string& name)
+{
+    auto it = nameIndex.find(name);
+    if (it != nameIndex.end()) {
+        return it->second;
+    }
+    auto idx = static_cast<std::uint32_t>(names.size());
+    names.push_back(name);
+    opcodes.push_back(opcodeOf(name));
+    nameIndex.emplace(name, idx);
+    return idx;
+}
+
+std::uint32_t PackedToolpath::valueCount(const Record& rec) const
+{
+    return std::popcount(rec.mask);
+}
+
+PackedToolpath::Record PackedToolpath::pack(const Command& cmd, std::uint32_t offset)
+{
+    // the parameter map is sorted, so the single letters are visited in letter order
+    Record rec {0, offset, intern(cmd.Name), NoExtra};
+    for (const auto& it : cmd.Parameters) {
+        const std::string& key = it.first;
+        if (key.size() == 1 && isLetter(key[0])) {
+            rec.mask |= letterBit(key[0]);
+            values.insert(values.begin() + offset++, it.second);
+        }
+        else {
+            if (rec.extra == NoExtra) {
+                rec.extra = static_cast<std::uint32_t>(extras.size());
+                extras.emplace_back();
+            }
+            extras[rec.extra][key] = it.second;
+        }
+    }
+    return rec;
+}
+
+void PackedToolpath::push_back(const Command& cmd)
+{
+    records.push_back(pack(cmd, static_cast<std::uint32_t>(values.size())));
+}
+
+void PackedToolpath::push_back(const std::string& name,
+                               std::uint32_t mask,
+                               const double* letterValues)
+{
+    records.push_back({mask, static_cast<std::uint32_t>(values.size()), intern(name), NoExtra});
+    for (int i = 0; mask; i++, mask >>= 1) {
+        if (mask & 1) {
+            values.push_back(letterValues[i]);
+        }
+    }
+}
+
+void PackedToolpath::append(const PackedToolpath& other)
+{
+    std::vector<std::uint32_t> nameMap;
+    nameMap.reserve(other.names.size());
+    for (const std::string& name : other.names) {
+        nameMap.push_back(intern(name));
+    }
+
+    auto offset = static_cast<std::uint32_t>(values.size());
+    records.reserve(records.size() + other.records.size());
+    for (const Record& rec : other.records) {
+        Record copy {rec.mask, rec.offset + offset, nameMap[rec.name], NoExtra};
+        if (rec.extra != NoExtra) {
+            copy.extra = static_cast<std::uint32_t>(extras.size());
+            extras.push_back(other.extras[rec.extra]);
+        }
+        records.push_back(copy);
+    }
+    values.insert(values.end(), other.values.begin(), other.values.end());
+}
+
+void PackedToolpath::insert(std::size_t pos, const Command& cmd)
+{
+    if (pos >= records.size()) {
+        push_back(cmd);
+        return;
+    }
+    Record rec = pack(cmd, records[pos].offset);
+    std::uint32_t count = valueCount(rec);
+    for (std::size_t i = pos; i < records.size(); i++) {
+        records[i].offset += count;
+    }
+    records.insert(records.begin() + pos, rec);
+}
+
+void PackedToolpath::erase(std::size_t pos)
+{
+    const Record& rec = records[pos];
+    std::uint32_t count = valueCount(rec);
+    values.erase(values.begin() + rec.offset, values.begin() + rec.offset + count);
+    if (rec.extra != NoExtra) {
+        // the slot stays unused until the next clear()
+        extras[rec.extra].clear();
+    }
+    for (std::size_t i = pos + 1; i < records.size(); i++) {
+        records[i].offset -= count;
+    }
+    records.erase(records.begin() + pos);
+}
+
+void PackedToolpath::pop_back()
+{
+    erase(records.size() - 1);
+}
+
+void PackedToolpath::scale(std::size_t first,
+                           std::size_t last,
+                           std::uint32_t letters,
+                           double factor)
+{
+    for (std::size_t i = first; i < last; i++) {
+        const Record& rec = records[i];
+        std::uint32_t offset = rec.offset;
+        for (std::uint32_t mask = rec.mask, bit = 1; mask; mask &= ~bit, bit <<= 1) {
+            if (mask & bit) {
+                if (letters & bit) {
+                    values[offset] *= factor;
+                }
+                offset++;
+            }
+        }
+    }
+}
+
+std::size_t PackedToolpath::memSize() const
+{
+    std::size_t size = records.size() * sizeof(Record) + values.size() * sizeof(double);
+    for (const std::string& name : names) {
+        size += name.size();
+    }
+    for (const auto& params : extras) {
+        size += params.size() * (sizeof(std::string) + sizeof(double));
+    }
+    return size;
+}
+
+Command PackedToolpath::at(std::size_t pos) const
+{
+    return (*this)[pos].toCommand();
+}
+
+Opcode PackedToolpath::opcodeOf(const std::string& name)
+{
+    if (name == "G0" || name == "G00") {
+        return Opcode::Rapid;
+    }
+    if (name == "G1" || name == "G01") {
+        return Opcode::Linear;
+    }
+    if (name == "G2" || name == "G02") {
+        return Opcode::ArcCW;
+    }
+    if (name == "G3" || name == "G03") {
+        return Opcode::ArcCCW;
+    }
+    return Opcode::Other;
+}
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef PATH_PACKEDTOOLPATH_H
+#define PATH_PACKEDTOOLPATH_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <Base/Placement.h>
+#include <Base/Vector3D.h>
+#include <Mod/CAM/PathGlobal.h>
+
+namespace Path
+{
+class Command;
+class PackedToolpath;
+
+/** The motion class of a command, resolved once when the command is stored */
+enum class Opcode : std::uint8_t
+{
+    Other,   // anything that is not a motion command, e.g. comments, M-codes or canned cycles
+    Rapid,   // G0, G00
+    Linear,  // G1, G01
+    ArcCW,   // G2, G02
+    ArcCCW   // G3, G03
+};
+
+/** Read-only access to a single command of a PackedToolpath.
+ * It offers the query interface of Command without materializing the parameter map.
+ * A view is invalidated by any modification of the toolpath it refers to.
+ */
+class PathExport CommandView
+{
+public:
+    Opcode opcode() const;
+    const std::string& name() const;
+    // true if the command has parameters with names longer than one letter
+    bool hasLongParameters() const;
+
+    // the letter must be upper case
+    bool has(char letter) const;
+    double getParam(char letter, double fallback = 0.0) const;
+
+    // same semantics as the Command methods of the same name
+    bool has(const std::string& attr) const;
+    double getValue(const std::string& attr) const;
+    Base::Placement getPlacement(const Base::Vector3d& pos = Base::Vector3d()) const;
+    Base::Vector3d getCenter() const;
+
+    // returns the X, Y, Z values, taking the missing ones from the given position
+    Base::Vector3d getPosition(const Base::Vector3d& pos) const;
+
+    Command toCommand() const;
+    std::string toGCode(int precision = 6, bool padzero = true) const;
+    void toGCode(std::ostream& str, int precision = 6, bool padzero = true) const;
+
+private:
+    friend class PackedToolpath;
+    CommandView(const PackedToolpath* store, std::size_t index)
+        : store(store)
+        , index(index)
+    {}
+
+    const PackedToolpath* store;
+    std::size_t index;
+};
+
+/** Compact storage of the commands of a toolpath.
+ * Every command is a fixed size record: an index into a table of interned command names,
+ * a bitmask of the single letter parameters A-Z it has and the offset of their values in
+ * one contiguous array, sorted by letter. Parameters with longer names, which only show up
+ * when set from Python, are kept in a side table.
+ */
+class PathExport PackedToolpath
+{
+public:
+    PackedToolpath() = default;
+
+    std::size_t size() const
+    {
+        return records.size();
+    }
+    bool empty() const
+    {
+        return records.empty();
+    }
+    void clear();
+    void reserve(std::size_t count, std::size_t values = 0);
+
+    void push_back(const Command& cmd);
+    // appends a command with the parameters set in mask (bit n for letter 'A' + n),
+    // letterValues holds the value of every letter at index letter - 'A'
+    void push_back(const std::string& name, std::uint32_t mask, const double* letterValues);
+    void append(const PackedToolpath& other);
+    void insert(std::size_t pos, const Command& cmd);
+    void erase(std::size_t pos);
+    void pop_back();
+    // multiplies the parameters in letters (as in mask) of the commands in [first, last)
+    void scale(std::size_t first, std::size_t last, std::uint32_t letters, double factor);
+    std::size_t memSize() const;
+
+    CommandView operator[](std::size_t pos) const
+    {
+        return {this, pos};
+    }
+    // builds a standalone copy of the command at the given position
+    Command at(std::size_t pos) const;
+
+    // returns the motion class of the given command name
+    static Opcode opcodeOf(const std::string& name);
+
+private:
+    friend class CommandView;
+
+    struct Record
+    {
+        std::uint32_t mask;    // bit n set if parameter 'A' + n is present
+        std::uint32_t offset;  // index of the first value in values
+        std::uint32_t name;    // index into names
+        std::uint32_t extra;   // index into extras or NoExtra
+    };
+    static constexpr std::uint32_t NoExtra = 0xffffffff;
+
+    Record pack(const Command& cmd, std::uint32_t offset);
+    std::uint32_t intern(const std::string& name);
+    std::uint32_t valueCount(const Record& rec) const;
+
+    std::vector<Record> records;
+    std::vector<double> values;
+    std::vector<std::string> names;
+    std::vector<Opcode> opcodes;
+    std::unordered_map<std::string, std::uint32_t> nameIndex;
+    std::vector<std::map<std::string, double>> extras;
+};
+
+}  // namespace Path
+
+#endif  // PATH_PACKEDTOOLPATH_H
@@ -21,6 +21,9 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
+#ifndef _PreComp_
+#include <iterator>
+#endif
 
 #include <App/Application.h>
 #include <Base/Console.h>
@@ -29,6 +32,7 @@
 #include <Base/Writer.h>
 #include <Mod/CAM/App/PathSegmentWalker.h>
 
+#include "GCodeStream.h"
 #include "Path.h"
 
 
@@ -41,17 +45,14 @@ Toolpath::Toolpath()
 {}
 
 Toolpath::Toolpath(const Toolpath& otherPath)
-    : vpcCommands(otherPath.vpcCommands.size())
+    : commands(otherPath.commands)
     , center(otherPath.center)
 {
-    *this = otherPath;
     recalculate();
 }
 
 Toolpath::~Toolpath()
-{
-    clear();
-}
+{}
 
 Toolpath& Toolpath::operator=(const Toolpath& otherPath)
 {
@@ -59,14 +60,7 @@ Toolpath& Toolpath::operator=(const Toolpath& otherPath)
         return *this;
     }
 
-    clear();
-    vpcCommands.resize(otherPath.vpcCommands.size());
-    int i = 0;
-    for (std::vector<Command*>::const_iterator it = otherPath.vpcCommands.begin();
-         it != otherPath.vpcCommands.end();
-         ++it, i++) {
-        vpcCommands[i] = new Command(**it);
-    }
+    commands = otherPath.commands;
     center = otherPath.center;
     recalculate();
     return *this;
@@ -74,17 +68,13 @@ Toolpath& Toolpath::operator=(const Toolpath& otherPath)
 
 void Toolpath::clear()
 {
-    for (std::vector<Command*>::iterator it = vpcCommands.begin(); it != vpcCommands.end(); ++it) {
-        delete (*it);
-    }
-    vpcCommands.clear();
+    commands.clear();
     recalculate();
 }
 
 void Toolpath::addCommand(const Command& Cmd)
 {
-    Command* tmp = new Command(Cmd);
-    vpcCommands.push_back(tmp);
+    commands.push_back(Cmd);
     recalculate();
 }
 
@@ -93,9 +83,8 @@ void Toolpath::insertCommand(const Command& Cmd, int pos)
     if (pos == -1) {
         addCommand(Cmd);
     }
-    else if (pos <= static_cast<int>(vpcCommands.size())) {
-        Command* tmp = new Command(Cmd);
-        vpcCommands.insert(vpcCommands.begin() + pos, tmp);
+    else if (pos <= static_cast<int>(commands.size())) {
+        commands.insert(pos, Cmd);
     }
     else {
         throw Base::IndexError("Index not in range");
@@ -106,11 +95,12 @@ void Toolpath::insertCommand(const Command& Cmd, int pos)
 void Toolpath::deleteCommand(int pos)
 {
     if (pos == -1) {
-        // delete(*vpcCommands.rbegin()); // causes crash
-        vpcCommands.pop_back();
+        if (!commands.empty()) {
+            commands.pop_back();
+        }
     }
-    else if (pos <= static_cast<int>(vpcCommands.size())) {
-        vpcCommands.erase(vpcCommands.begin() + pos);
+    else if (pos >= 0 && pos < static_cast<int>(commands.size())) {
+        commands.erase(pos);
     }
     else {
         throw Base::IndexError("Index not in range");
@@ -120,24 +110,24 @@ void Toolpath::deleteCommand(int pos)
 
 double Toolpath::getLength()
 {
-    if (vpcCommands.empty()) {
+    if (commands.empty()) {
         return 0;
     }
     double l = 0;
     Vector3d last(0, 0, 0);
     Vector3d next;
-    for (std::vector<Command*>::const_iterator it = vpcCommands.begin(); it != vpcCommands.end();
-         ++it) {
-        std::string name = (*it)->Name;
-        next = (*it)->getPlacement(last).getPosition();
-        if ((name == "G0") || (name == "G00") || (name == "G1") || (name == "G01")) {
+    for (std::size_t i = 0; i < commands.size(); i++) {
+        CommandView cmd = commands[i];
+        Opcode op = cmd.opcode();
+        next = cmd.getPosition(last);
+        if (op == Opcode::Rapid || op == Opcode::Linear) {
             // straight line
             l += (next - last).Length();
             last = next;
         }
-        else if ((name == "G2") || (name == "G02") || (name == "G3") || (name == "G03")) {
+        else if (op == Opcode::ArcCW || op == Opcode::ArcCCW) {
             // arc
-            Vector3d center = (*it)->getCenter();
+            Vector3d center = cmd.getCenter();
             double radius = (last - center).Length();
             double angle = (next - center).GetAngle(last - center);
             l += angle * radius;
@@ -167,7 +157,7 @@ double Toolpath::getCycleTime(double hFeed, double vFeed, double hRapid, double
         vRapid = vFeed;
     }
 
-    if (vpcCommands.empty()) {
+    if (commands.empty()) {
         return 0;
     }
     double l = 0;
@@ -175,22 +165,21 @@ double Toolpath::getCycleTime(double hFeed, double vFeed, double hRapid, double
     bool verticalMove = false;
     Vector3d last(0, 0, 0);
     Vector3d next;
-    for (std::vector<Command*>::const_iterator it = vpcCommands.begin(); it != vpcCommands.end();
-         ++it) {
-        std::string name = (*it)->Name;
-        float feedrate = (*it)->getParam("F");
+    for (std::size_t i = 0; i < commands.size(); i++) {
+        CommandView cmd = commands[i];
+        Opcode op = cmd.opcode();
+        float feedrate = hFeed;
 
         l = 0;
         verticalMove = false;
-        feedrate = hFeed;
-        next = (*it)->getPlacement(last).getPosition();
+        next = cmd.getPosition(last);
 
         if (last.z != next.z) {
             verticalMove = true;
             feedrate = vFeed;
         }
 
-        if ((name == "G0") || (name == "G00")) {
+        if (op == Opcode::Rapid) {
             // Rapid Move
             l += (next - last).Length();
             feedrate = hRapid;
@@ -198,13 +187,13 @@ double Toolpath::getCycleTime(double hFeed, double vFeed, double hRapid, double
                 feedrate = vRapid;
             }
         }
-        else if ((name == "G1") || (name == "G01")) {
+        else if (op == Opcode::Linear) {
             // Feed Move
             l += (next - last).Length();
         }
-        else if ((name == "G2") || (name == "G02") || (name == "G3") || (name == "G03")) {
+        else if (op == Opcode::ArcCW || op == Opcode::ArcCCW) {
             // Arc Move
-            Vector3d center = (*it)->getCenter();
+            Vector3d center = cmd.getCenter();
             double radius = (last - center).Length();
             double angle = (next - center).GetAngle(last - center);
             l += angle * radius;
@@ -304,96 +293,46 @@ Base::BoundBox3d Toolpath::getBoundBox() const
     return visitor.bb;
 }
 
-static void
-bulkAddCommand(const std::string& gcodestr, std::vector<Command*>& commands, bool& inches)
+void Toolpath::setFromGCode(const std::string instr)
 {
-    Command* cmd = new Command();
-    cmd->setFromGCode(gcodestr);
-    if ("G20" == cmd->Name) {
-        inches = true;
-        delete cmd;
-    }
-    else if ("G21" == cmd->Name) {
-        inches = false;
-        delete cmd;
-    }
-    else {
-        if (inches) {
-            cmd->scaleBy(25.4);
-        }
-        commands.push_back(cmd);
-    }
+    clear();
+
+    PackedToolpath result;
+    GCodeParser().parse(instr, result);
+    commands = std::move(result);
+    recalculate();
 }
 
-void Toolpath::setFromGCode(const std::string instr)
+void Toolpath::setFromGCodeFile(const std::string& fileName)
 {
     clear();
 
-    // remove comments
-    // boost::regex e("\\(.*?\\)");
-    // std::string str = boost::regex_replace(instr, e, "");
-    std::string str(instr);
-
-    // split input string by () or G or M commands
-    std::string mode = "command";
-    std::size_t found = str.find_first_of("(gGmM");
-    int last = -1;
-    bool inches = false;
-    while (found != std::string::npos) {
-        if (str[found] == '(') {
-            // start of comment
-            if ((last > -1) && (mode == "command")) {
-                // before opening a comment, add the last found command
-                std::string gcodestr = str.substr(last, found - last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
-            }
-            mode = "comment";
-            last = found;
-            found = str.find_first_of(')', found + 1);
-        }
-        else if (str[found] == ')') {
-            // end of comment
-            std::string gcodestr = str.substr(last, found - last + 1);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
-            last = -1;
-            found = str.find_first_of("(gGmM", found + 1);
-            mode = "command";
-        }
-        else if (mode == "command") {
-            // command
-            if (last > -1) {
-                std::string gcodestr = str.substr(last, found - last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
-            }
-            last = found;
-            found = str.find_first_of("(gGmM", found + 1);
-        }
-    }
-    // add the last command found, if any
-    if (last > -1) {
-        if (mode == "command") {
-            std::string gcodestr = str.substr(last, std::string::npos);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
-        }
-    }
+    PackedToolpath result;
+    GCodeParser().parseFile(fileName, result);
+    commands = std::move(result);
     recalculate();
 }
 
 std::string Toolpath::toGCode() const
 {
     std::string result;
-    for (std::vector<Command*>::const_iterator it = vpcCommands.begin(); it != vpcCommands.end();
-         ++it) {
-        result += (*it)->toGCode();
-        result += "\n";
+    GCodeWriter writer;
+    for (std::size_t i = 0; i < commands.size(); i++) {
+        writer.append(result, commands[i]);
+        result += '\n';
     }
     return result;
 }
 
+void Toolpath::writeGCodeFile(const std::string& fileName) const
+{
+    GCodeWriter().writeFile(fileName, commands);
+}
+
 void Toolpath::recalculate()  // recalculates the path cache
 {
 
-    if (vpcCommands.empty()) {
+    if (commands.empty()) {
         return;
     }
 
@@ -458,7 +397,7 @@ void Toolpath::recalculate()  // recalculates the path cache
 
 unsigned int Toolpath::getMemSize() const
 {
-    return toGCode().size();
+    return commands.memSize();
 }
 
 void Toolpath::setCenter(const Base::Vector3d& c)
@@ -481,7 +420,7 @@ void Toolpath::Save(Writer& writer) const
         writer.incInd();
         saveCenter(writer, center);
         for (unsigned int i = 0; i < getSize(); i++) {
-            vpcCommands[i]->Save(writer);
+            commands.at(i).Save(writer);
         }
         writer.decInd();
     }
@@ -498,10 +437,10 @@ void Toolpath::Save(Writer& writer) const
 
 void Toolpath::SaveDocFile(Base::Writer& writer) const
 {
-    if (toGCode().empty()) {
+    if (commands.empty()) {
         return;
     }
-    writer.Stream() << toGCode();
+    GCodeWriter().write(writer.Stream(), commands);
 }
 
 void Toolpath::Restore(XMLReader& reader)
@@ -517,11 +456,6 @@ void Toolpath::Restore(XMLReader& reader)
 
 void Toolpath::RestoreDocFile(Base::Reader& reader)
 {
-    std::string gcode;
-    std::string line;
-    while (reader >> line) {
-        gcode += line;
-        gcode += " ";
-    }
+    std::string gcode(std::istreambuf_iterator<char>(reader), {});
     setFromGCode(gcode);
 }
@@ -28,6 +28,7 @@
 #include <Base/Vector3D.h>
 
 #include "Command.h"
+#include "PackedToolpath.h"
 
 
 namespace Path
@@ -63,21 +64,28 @@ public:
     void recalculate();                                   // recalculates the points
     void
     setFromGCode(const std::string);  // sets the path from the contents of the given GCode string
-    std::string toGCode() const;      // gets a gcode string representation from the Path
+    void setFromGCodeFile(const std::string& fileName);  // sets the path from a GCode file
+    std::string toGCode() const;  // gets a gcode string representation from the Path
+    void writeGCodeFile(const std::string& fileName) const;  // writes the Path to a GCode file
     Base::BoundBox3d getBoundBox() const;
 
     // shortcut functions
     unsigned int getSize() const
     {
-        return vpcCommands.size();
+        return commands.size();
     }
-    const std::vector<Command*>& getCommands() const
+    const PackedToolpath& getCommands() const
     {
-        return vpcCommands;
+        return commands;
     }
-    const Command& getCommand(unsigned int pos) const
+    // returns a standalone copy of the command, prefer getCommandView() for read access
+    Command getCommand(unsigned int pos) const
     {
-        return *vpcCommands[pos];
+        return commands.at(pos);
+    }
+    CommandView getCommandView(unsigned int pos) const
+    {
+        return commands[pos];
     }
 
     // support for rotation
@@ -90,7 +98,7 @@ public:
     static const int SchemaVersion = 2;
 
 protected:
-    std::vector<Command*> vpcCommands;
+    PackedToolpath commands;
     Base::Vector3d center;
     // KDL::Path_Composite *pcPath;
 
@@ -33,7 +33,9 @@ class PathPy(Persistence):
 
     def deleteCommand(self) -> Any:
         """deleteCommand([int]):
-        deletes the command found at the given position or from the end of the path"""
+        deletes the command found at the given position or from the end of the path
+        Raises IndexError if the position is not less than the number of commands.
+        Deleting from the end of an empty path does nothing."""
         ...
 
     def setFromGCode(self) -> Any:
@@ -61,7 +63,9 @@ class PathPy(Persistence):
     """the number of commands in this path"""
 
     Commands: list
-    """the list of commands of this path"""
+    """the list of commands of this path
+    The commands are copies, changing them does not change the path.
+    Assign the list again to apply the changes."""
 
     Center: Any
     """the center position for all rotational parameters"""
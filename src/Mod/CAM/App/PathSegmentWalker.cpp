@@ -150,9 +150,10 @@ void PathSegmentWalker::walk(PathSegmentVisitor& cb, const Base::Vector3d& start
     for (unsigned int i = 0; i < tp.getSize(); i++) {
         std::deque<Base::Vector3d> points;
 
-        const Path::Command& cmd = tp.getCommand(i);
-        const std::string& name = cmd.Name;
-        Base::Vector3d next = cmd.getPlacement().getPosition();
+        Path::CommandView cmd = tp.getCommandView(i);
+        const std::string& name = cmd.name();
+        Path::Opcode op = cmd.opcode();
+        Base::Vector3d next = cmd.getPosition(Base::Vector3d());
         double a = A;
         double b = B;
         double c = C;
@@ -160,30 +161,30 @@ void PathSegmentWalker::walk(PathSegmentVisitor& cb, const Base::Vector3d& start
         if (!absolute) {
             next = last + next;
         }
-        if (!cmd.has("X")) {
+        if (!cmd.has('X')) {
             next.x = last.x;
         }
-        if (!cmd.has("Y")) {
+        if (!cmd.has('Y')) {
             next.y = last.y;
         }
-        if (!cmd.has("Z")) {
+        if (!cmd.has('Z')) {
             next.z = last.z;
         }
-        if (cmd.has("A")) {
-            a = cmd.getValue("A");
+        if (cmd.has('A')) {
+            a = cmd.getParam('A');
         }
-        if (cmd.has("B")) {
-            b = cmd.getValue("B");
+        if (cmd.has('B')) {
+            b = cmd.getParam('B');
         }
-        if (cmd.has("C")) {
-            c = cmd.getValue("C");
+        if (cmd.has('C')) {
+            c = cmd.getParam('C');
         }
 
         Base::Rotation nrot = yawPitchRoll(a, b, c);
 
         Base::Vector3d rnext = compensateRotation(next, nrot, rotCenter);
 
-        if ((name == "G0") || (name == "G00") || (name == "G1") || (name == "G01")) {
+        if (op == Path::Opcode::Rapid || op == Path::Opcode::Linear) {
             // straight line
             if (nrot != lrot) {
                 double amax = std::max(fmod(fabs(a - A), 360),
@@ -207,7 +208,7 @@ void PathSegmentWalker::walk(PathSegmentVisitor& cb, const Base::Vector3d& start
                 }
             }
 
-            if ("G0" == name || "G00" == name) {
+            if (op == Path::Opcode::Rapid) {
                 cb.g0(i, last, rnext, points);
             }
             else {
@@ -220,12 +221,12 @@ void PathSegmentWalker::walk(PathSegmentVisitor& cb, const Base::Vector3d& start
             C = c;
             lrot = nrot;
         }
-        else if ((name == "G2") || (name == "G02") || (name == "G3") || (name == "G03")) {
+        else if (op == Path::Opcode::ArcCW || op == Path::Opcode::ArcCCW) {
             // arc
             Base::Vector3d norm;
             Base::Vector3d center;
 
-            if ((name == "G2") || (name == "G02")) {
+            if (op == Path::Opcode::ArcCW) {
                 norm.*pz = -1.0;
             }
             else {
@@ -249,12 +250,12 @@ void PathSegmentWalker::walk(PathSegmentVisitor& cb, const Base::Vector3d& start
             // GetAngle will always return the minor angle. Switch if needed
             Base::Vector3d anorm = (last0 - center0) % (next0 - center0);
             if (anorm.*pz < 0) {
-                if (name == "G3" || name == "G03") {
+                if (op == Path::Opcode::ArcCCW) {
                     angle = std::numbers::pi * 2 - angle;
                 }
             }
             else if (anorm.*pz > 0) {
-                if (name == "G2" || name == "G02") {
+                if (op == Path::Opcode::ArcCW) {
                     angle = std::numbers::pi * 2 - angle;
                 }
             }
@@ -317,8 +318,8 @@ void PathSegmentWalker::walk(PathSegmentVisitor& cb, const Base::Vector3d& start
                  || (name == "G84") || (name == "G85") || (name == "G86") || (name == "G89")) {
             // drill,tap,bore
             double r = 0;
-            if (cmd.has("R")) {
-                r = cmd.getValue("R");
+            if (cmd.has('R')) {
+                r = cmd.getParam('R');
             }
 
             std::deque<Base::Vector3d> plist;
@@ -355,8 +356,8 @@ void PathSegmentWalker::walk(PathSegmentVisitor& cb, const Base::Vector3d& start
             Base::Vector3d p2r = compensateRotation(p2, nrot, rotCenter);
 
             double q;
-            if (cmd.has("Q")) {
-                q = cmd.getValue("Q");
+            if (cmd.has('Q')) {
+                q = cmd.getParam('Q');
                 if (q > 0) {
                     Base::Vector3d temp(next);
                     for (temp.*pz = r; temp.*pz > next.*pz; temp.*pz -= q) {
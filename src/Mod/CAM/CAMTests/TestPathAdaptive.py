@@ -22,8 +22,11 @@
 # *                                                                         *
 # ***************************************************************************
 
+import math
+
 import FreeCAD
 import Part
+import area
 import Path.Op.Adaptive as PathAdaptive
 import Path.Main.Job as PathJob
 from CAMTests.PathTestUtils import PathTestBase
@@ -682,6 +685,42 @@ class TestPathAdaptive(PathTestBase):
 
         self.assertTrue(okAt10 and okAt5, "Path feeds extend excessively in +X")
 
+    def testParallelRegions(self):
+        """testParallelRegions() Tests that regions cleared in parallel give the same toolpaths
+        as a sequential run"""
+
+        def rectangle(x0, y0, x1, y1):
+            return [(x0, y0), (x1, y0), (x1, y1), (x0, y1)]
+
+        # several separate pockets, each of them is a region of its own
+        circle = [
+            (90 + 12 * math.cos(2 * math.pi * i / 48), 40 + 12 * math.sin(2 * math.pi * i / 48))
+            for i in range(48)
+        ]
+        lshape = [(0, 30), (30, 30), (30, 40), (15, 40), (15, 55), (0, 55)]
+        pockets = [rectangle(0, 0, 30, 20), rectangle(40, 0, 70, 25), circle, lshape]
+        stock = [rectangle(-10, -10, 110, 70)]
+
+        def execute(threads):
+            a2d = area.Adaptive2d()
+            a2d.toolDiameter = 5
+            a2d.stepOverFactor = 0.2
+            a2d.tolerance = 0.1
+            a2d.helixRampDiameter = 2
+            a2d.opType = area.AdaptiveOperationType.ClearingInside
+            a2d.threads = threads
+            results = a2d.Execute(stock, pockets, lambda paths: False)
+            return [
+                (r.HelixCenterPoint, r.StartPoint, r.AdaptivePaths, r.ReturnMotionType)
+                for r in results
+            ]
+
+        sequential = execute(1)
+        parallel = execute(0)
+
+        self.assertEqual(len(sequential), len(pockets))
+        self.assertEqual(parallel, sequential)
+
     # POSSIBLY MISSING TESTS:
     # - Something for region ordering
     # - Known-edge cases: cones/spheres/cylinders (especially partials on edges
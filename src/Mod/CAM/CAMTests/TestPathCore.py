@@ -126,6 +126,141 @@ G0 Z0.500000
         p.setFromGCode(lines)
         self.assertEqual(p.toGCode(), output)
 
+    def test20(self):
+        """Test inserting and deleting commands in the middle of a path"""
+        p = Path.Path([Path.Command("G0", {"Z": i}) for i in range(4)])
+        p.insertCommand(Path.Command("G1", {"X": 1, "Y": 2, "F": 3}), 2)
+        self.assertEqual(
+            p.toGCode(),
+            "G0 Z0.000000\nG0 Z1.000000\nG1 F3.000000 X1.000000 Y2.000000\n"
+            "G0 Z2.000000\nG0 Z3.000000\n",
+        )
+
+        p.deleteCommand(1)
+        self.assertEqual(p.Size, 4)
+        self.assertEqual(p.Commands[1].Parameters, {"X": 1, "Y": 2, "F": 3})
+        self.assertEqual(p.Commands[2].Parameters, {"Z": 2})
+
+        p.deleteCommand(1)
+        self.assertEqual(
+            p.toGCode(),
+            "G0 Z0.000000\nG0 Z2.000000\nG0 Z3.000000\n",
+        )
+
+        # an index equal to the size appends
+        p.insertCommand(Path.Command("M5"), 3)
+        self.assertEqual(p.Commands[-1].Name, "M5")
+        self.assertRaises(IndexError, p.insertCommand, Path.Command("M5"), 5)
+
+    def test21(self):
+        """Test parameters with names longer than one letter"""
+        c = Path.Command("G1", {"X": 1, "FOO": 2.5, "Y": 3})
+        p = Path.Path([Path.Command("G0", {"Z": 5}), c])
+        self.assertEqual(p.Commands[1].Parameters, {"X": 1, "FOO": 2.5, "Y": 3})
+        self.assertEqual(p.Commands[1].toGCode(), c.toGCode())
+        self.assertEqual(p.toGCode(), "G0 Z5.000000\n" + c.toGCode() + "\n")
+
+        # moving the command around keeps its parameters
+        p.insertCommand(Path.Command("G0", {"X": 7}), 0)
+        p.insertCommand(Path.Command("G1", {"BAR": -1}), 1)
+        p.deleteCommand(2)
+        self.assertEqual(
+            [cmd.Parameters for cmd in p.Commands],
+            [{"X": 7}, {"BAR": -1}, {"X": 1, "FOO": 2.5, "Y": 3}],
+        )
+
+        # the commands are copies
+        commands = p.Commands
+        commands[2].Parameters = {"X": 2}
+        self.assertEqual(p.Commands[2].Parameters, {"X": 1, "FOO": 2.5, "Y": 3})
+        p.Commands = commands
+        self.assertEqual(p.Commands[2].Parameters, {"X": 2})
+
+    def test22(self):
+        """Test the bounds of Path.deleteCommand"""
+        p = Path.Path([Path.Command("G0", {"X": 1}), Path.Command("G0", {"X": 2})])
+        self.assertRaises(IndexError, p.deleteCommand, 2)
+        self.assertRaises(IndexError, p.deleteCommand, -2)
+        self.assertEqual(p.Size, 2)
+
+        p.deleteCommand()
+        self.assertEqual(p.toGCode(), "G0 X1.000000\n")
+        p.deleteCommand(0)
+        self.assertEqual(p.Size, 0)
+
+        # deleting from the end of an empty path does nothing
+        p.deleteCommand()
+        self.assertEqual(p.Size, 0)
+        self.assertRaises(IndexError, p.deleteCommand, 0)
+
+    def gcodeBlocks(self, count, lineStart):
+        """Returns G-code blocks with unit switches and multi-line comments"""
+        blocks = []
+        for i in range(count):
+            if i % 7919 == 100:
+                blocks.append(lineStart + ("G20" if (i // 7919) % 2 == 0 else "G21"))
+            elif i % 997 == 500:
+                blocks.append(lineStart + "(note %d\nG0 X%d inside\nM3 too)" % (i, i))
+            else:
+                values = (i % 2, i * 0.0173, i * -0.0291, i % 7, 100 + i % 50)
+                blocks.append(lineStart + "G%d X%.4f Y%.4f Z-%.3f F%d" % values)
+        return blocks
+
+    def parseInPieces(self, blocks):
+        """Parses the blocks in pieces below the size that is split for parallel parsing"""
+        gcode = []
+        inches = False
+        for start in range(0, len(blocks), 2000):
+            piece = blocks[start : start + 2000]
+            p = Path.Path()
+            p.setFromGCode(("G20\n" if inches else "") + "\n".join(piece))
+            gcode.append(p.toGCode())
+            for block in piece:
+                if block.strip() in ("G20", "G21"):
+                    inches = block.strip() == "G20"
+        return "".join(gcode)
+
+    def test30(self):
+        """Test parsing G-code that is large enough to be split"""
+        blocks = self.gcodeBlocks(100000, "")
+        text = "\n".join(blocks)
+        self.assertGreater(len(text), 2 * 1024 * 1024)
+
+        p = Path.Path()
+        p.setFromGCode(text)
+        gcode = p.toGCode()
+        self.assertEqual(gcode, self.parseInPieces(blocks))
+        self.assertEqual(Path.Path(gcode).toGCode(), gcode)
+
+        # a unit switch applies to the following commands only
+        commands = p.Commands
+        self.assertAlmostEqual(commands[99].Parameters["X"], 99 * 0.0173)
+        self.assertAlmostEqual(commands[100].Parameters["X"], 101 * 0.0173 * 25.4)
+
+    def test31(self):
+        """Test parsing large G-code with comments across the split points"""
+        # every line that may start a piece lies within a comment
+        blocks = self.gcodeBlocks(100000, " ")
+        text = "\n".join(blocks)
+
+        p = Path.Path()
+        p.setFromGCode(text)
+        gcode = p.toGCode()
+        self.assertEqual(gcode, self.parseInPieces(blocks))
+        self.assertEqual(Path.Path(gcode).toGCode(), gcode)
+        self.assertEqual(p.Commands[499].Name, "(note 500\nG0 X500 inside\nM3 too)")
+
+    def test32(self):
+        """Test that a malformed command in large G-code is reported"""
+        blocks = self.gcodeBlocks(100000, "")
+        blocks.insert(60000, "G1 X Y1")
+        p = Path.Path()
+        with self.assertRaises(Exception) as large:
+            p.setFromGCode("\n".join(blocks))
+        with self.assertRaises(Exception) as small:
+            p.setFromGCode("G1 X Y1")
+        self.assertEqual(str(large.exception), str(small.exception))
+
     def test50(self):
         """Test Path.Length calculation"""
         commands = []
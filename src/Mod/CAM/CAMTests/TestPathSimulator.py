@@ -0,0 +1,83 @@
+# -*- coding: utf-8 -*-
+# ***************************************************************************
+# *   Copyright (c) 2025 The FreeCAD Project Association AISBL              *
+# *                                                                         *
+# *   This program is free software; you can redistribute it and/or modify  *
+# *   it under the terms of the GNU Lesser General Public License (LGPL)    *
+# *   as published by the Free Software Foundation; either version 2 of     *
+# *   the License, or (at your option) any later version.                   *
+# *   for detail see the LICENCE text file.                                 *
+# *                                                                         *
+# *   This program is distributed in the hope that it will be useful,       *
+# *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+# *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+# *   GNU Library General Public License for more details.                  *
+# *                                                                         *
+# *   You should have received a copy of the GNU Library General Public     *
+# *   License along with this program; if not, write to the Free Software   *
+# *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+# *   USA                                                                   *
+# *                                                                         *
+# ***************************************************************************
+
+import math
+
+import FreeCAD
+import Part
+import Path
+import PathSimulator
+from CAMTests.PathTestUtils import PathTestBase
+
+
+class TestPathSimulator(PathTestBase):
+    """Test the tri-dexel simulation of whole toolpaths."""
+
+    def setUp(self):
+        # 50 x 30 x 10 stock and a 6mm flat end mill, the slots run at Y=15.1 so that their
+        # walls do not fall onto the grid nodes
+        self.sim = PathSimulator.PathSim()
+        self.sim.BeginSimulation(stock=Part.makeBox(50, 30, 10), resolution=0.5)
+        self.sim.SetToolShape(Part.makeCylinder(3, 20), 0.05)
+
+    def cutSlot(self):
+        path = Path.Path("G0 X-10 Y15.1 Z15\nG0 Z8\nG1 X60\nG0 Z15")
+        return self.sim.ApplyToolpath(path, start=FreeCAD.Vector(-10, 15.1, 20))
+
+    def test00(self):
+        """Verify that a slot removes width x depth x length of material."""
+        result = self.cutSlot()
+        self.assertRoughly(result["RemovedVolume"], 6 * 2 * 50, 6)
+        self.assertRoughly(result["Volume"], 50 * 30 * 10 - 6 * 2 * 50, 6)
+        self.assertEqual(result["Collisions"], [])
+
+    def test01(self):
+        """Verify that only rapid moves through the stock are reported as collisions."""
+        self.cutSlot()
+
+        # rapid move above the stock
+        path = Path.Path("G0 X25 Y15.1 Z15")
+        result = self.sim.ApplyToolpath(path, start=FreeCAD.Vector(60, 15.1, 15))
+        self.assertEqual(result["Collisions"], [])
+        self.assertRoughly(result["RemovedVolume"], 0)
+
+        # rapid plunge from the top into the bottom of the slot and back up
+        path = Path.Path("G0 X25 Y15.1 Z5\nG0 Z15")
+        result = self.sim.ApplyToolpath(path, start=FreeCAD.Vector(25, 15.1, 15))
+        self.assertEqual(len(result["Collisions"]), 1)
+        command, volume, position = result["Collisions"][0]
+        self.assertEqual(command, 0)
+        self.assertRoughly(volume, math.pi * 3 * 3 * 3, 4)
+        self.assertRoughly(result["RemovedVolume"], volume, 0.01)
+        self.assertCoincide(position, FreeCAD.Vector(25, 15.1, 15))
+
+    def test02(self):
+        """Verify that the mesh of the remaining stock is a closed solid."""
+        self.cutSlot()
+        path = Path.Path("G0 X25 Y15.1 Z5\nG0 Z15")
+        result = self.sim.ApplyToolpath(path, start=FreeCAD.Vector(25, 15.1, 15))
+
+        mesh = self.sim.GetDexelMesh()
+        self.assertTrue(mesh.isSolid())
+        self.assertFalse(mesh.hasSelfIntersections())
+        self.assertRoughly(mesh.Volume, result["Volume"], result["Volume"] * 0.01)
+        self.assertRoughly(mesh.Volume, 50 * 30 * 10 - 6 * 2 * 50 - math.pi * 3 * 3 * 3, 100)
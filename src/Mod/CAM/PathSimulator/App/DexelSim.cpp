@@ -0,0 +1,860 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#endif
+
+#include <Base/Exception.h>
+#include <Base/Rotation.h>
+#include <Mod/CAM/App/Path.h>
+#include <Mod/CAM/App/PathSegmentWalker.h>
+#include <Mod/Mesh/App/Core/Functional.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Mesh.h>
+
+#include "DexelSim.h"
+#include "VolSim.h"
+
+
+using namespace PathSimulator;
+
+namespace
+{
+
+constexpr int TileSize = 32;
+constexpr int ProfileSamples = 128;
+constexpr int RefineSteps = 10;
+
+// Records the straight moves of a toolpath together with the tool axis in stock coordinates
+class MoveCollector: public Path::PathSegmentVisitor
+{
+public:
+    MoveCollector(const Path::Toolpath& path, std::vector<DexelMove>& moves)
+        : path(path)
+        , moves(moves)
+    {}
+
+    void setup(const Base::Vector3d& last) override
+    {
+        position = last;
+        axis = Base::Vector3d(0, 0, 1);
+    }
+
+    void g0(int id,
+            const Base::Vector3d& last,
+            const Base::Vector3d& next,
+            const std::deque<Base::Vector3d>& pts) override
+    {
+        (void)last;
+        addSegments(id, pts, next, true);
+    }
+
+    void g1(int id,
+            const Base::Vector3d& last,
+            const Base::Vector3d& next,
+            const std::deque<Base::Vector3d>& pts) override
+    {
+        (void)last;
+        addSegments(id, pts, next, false);
+    }
+
+    void g23(int id,
+             const Base::Vector3d& last,
+             const Base::Vector3d& next,
+             const std::deque<Base::Vector3d>& pts,
+             const Base::Vector3d& center) override
+    {
+        (void)last;
+        (void)center;
+        addSegments(id, pts, next, false);
+    }
+
+    void g8x(int id,
+             const Base::Vector3d& last,
+             const Base::Vector3d& next,
+             const std::deque<Base::Vector3d>& pts,
+             const std::deque<Base::Vector3d>& p,
+             const std::deque<Base::Vector3d>& q) override
+    {
+        (void)last;
+        (void)q;
+        // rapid over the hole and down to the retract plane, feed to the bottom and retract
+        addSegments(id, pts, p[0], true);
+        Base::Vector3d center = path.getCenter();
+        Base::Vector3d bottom;
+        rotation.multVec(next - center, bottom);
+        addMove(id, p[1], axis, true);
+        addMove(id, bottom + center, axis, false);
+        addMove(id, p[2], axis, true);
+    }
+
+    void g38(int id, const Base::Vector3d& last, const Base::Vector3d& next) override
+    {
+        (void)last;
+        addMove(id, next, axis, false);
+    }
+
+private:
+    // rotary axes are modal, returns the tool axis at the end of the command
+    Base::Vector3d updateAxis(int id)
+    {
+        Path::CommandView cmd = path.getCommandView(id);
+        if (cmd.has('A')) {
+            a = cmd.getParam('A');
+        }
+        if (cmd.has('B')) {
+            b = cmd.getParam('B');
+        }
+        if (cmd.has('C')) {
+            c = cmd.getParam('C');
+        }
+        rotation.setYawPitchRoll(-c, -b, -a);
+        Base::Vector3d dir;
+        rotation.multVec(Base::Vector3d(0, 0, 1), dir);
+        return dir;
+    }
+
+    void addSegments(int id,
+                     const std::deque<Base::Vector3d>& pts,
+                     const Base::Vector3d& next,
+                     bool rapid)
+    {
+        Base::Vector3d start = axis;
+        Base::Vector3d target = updateAxis(id);
+        double segments = static_cast<double>(pts.size() + 1);
+        for (std::size_t i = 0; i < pts.size(); i++) {
+            Base::Vector3d dir = start + (target - start) * ((i + 1) / segments);
+            if (dir.Length() < 1e-9) {
+                dir = target;
+            }
+            addMove(id, pts[i], dir.Normalize(), rapid);
+        }
+        addMove(id, next, target, rapid);
+    }
+
+    void addMove(int id, const Base::Vector3d& to, const Base::Vector3d& dir, bool rapid)
+    {
+        if (to == position && dir == axis) {
+            return;
+        }
+        moves.push_back({position, to, axis, dir, id, rapid});
+        position = to;
+        axis = dir;
+    }
+
+    const Path::Toolpath& path;
+    std::vector<DexelMove>& moves;
+    Base::Vector3d position;
+    Base::Vector3d axis;
+    Base::Rotation rotation;
+    double a {0};
+    double b {0};
+    double c {0};
+};
+
+// axis aligned box around the tool with its tip at tip and pointing along dir
+std::array<double, 6> toolBounds(const Base::Vector3d& tip,
+                                 const Base::Vector3d& dir,
+                                 const DexelTool& tool)
+{
+    std::array<double, 6> box;
+    Base::Vector3d center = tip + dir * (0.5 * tool.length);
+    for (int i = 0; i < 3; i++) {
+        double d = dir[i];
+        double extent = std::abs(d) * 0.5 * tool.length
+            + tool.radius * std::sqrt(std::max(0.0, 1.0 - d * d));
+        box[i] = center[i] - extent;
+        box[i + 3] = center[i] + extent;
+    }
+    return box;
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------------
+
+DexelTool::DexelTool(const std::vector<std::pair<float, float>>& profile,
+                     float radius,
+                     float length)
+    : radius(radius)
+    , length(length)
+{
+    init(profile);
+}
+
+DexelTool::DexelTool(const cSimTool& tool)
+    : radius(tool.radius)
+    , length(tool.length)
+{
+    std::vector<std::pair<float, float>> profile;
+    profile.reserve(tool.m_toolShape.size());
+    for (const auto& pt : tool.m_toolShape) {
+        profile.emplace_back(pt.radiusPos, pt.heightPos);
+    }
+    init(profile);
+}
+
+void DexelTool::init(const std::vector<std::pair<float, float>>& profile)
+{
+    if (!(radius > 0) || !(length > 0)) {
+        throw Base::ValueError("Tool has no volume");
+    }
+
+    std::vector<std::pair<float, float>> sorted(profile);
+    std::sort(sorted.begin(), sorted.end());
+
+    step = radius / (ProfileSamples - 1);
+    heights.resize(ProfileSamples);
+    auto it = sorted.begin();
+    for (int i = 0; i < ProfileSamples; i++) {
+        float r = i * step;
+        while (it != sorted.end() && it->first < r) {
+            ++it;
+        }
+        float h = 0;
+        if (it == sorted.end()) {
+            h = sorted.empty() ? 0.0F : sorted.back().second;
+        }
+        else if (it == sorted.begin() || it->first == r) {
+            h = it->second;
+        }
+        else {
+            auto prev = it - 1;
+            float t = (r - prev->first) / (it->first - prev->first);
+            h = prev->second + t * (it->second - prev->second);
+        }
+        // the lower surface has to rise towards the rim to be swept by rays from above
+        heights[i] = i > 0 ? std::max(heights[i - 1], h) : h;
+    }
+}
+
+float DexelTool::heightAt(float r) const
+{
+    float t = r / step;
+    int i = static_cast<int>(t);
+    if (i >= ProfileSamples - 1) {
+        return heights.back();
+    }
+    return heights[i] + (t - i) * (heights[i + 1] - heights[i]);
+}
+
+float DexelTool::radiusAt(float h) const
+{
+    if (h < heights.front() || h > length) {
+        return -1.0F;
+    }
+    if (h >= heights.back()) {
+        return radius;
+    }
+    // first sample above h, the one before it is not
+    auto it = std::upper_bound(heights.begin(), heights.end(), h);
+    int i = static_cast<int>(it - heights.begin()) - 1;
+    return (i + (h - heights[i]) / (heights[i + 1] - heights[i])) * step;
+}
+
+// ----------------------------------------------------------------------------
+
+DexelSim::DexelSim(const Base::BoundBox3d& stock, double resolution)
+{
+    if (!stock.IsValid() || !(resolution > 0)) {
+        throw Base::ValueError("Invalid stock or resolution");
+    }
+
+    double length[3] = {stock.LengthX(), stock.LengthY(), stock.LengthZ()};
+    origin = Base::Vector3d(stock.MinX, stock.MinY, stock.MinZ);
+    for (int i = 0; i < 3; i++) {
+        if (!(length[i] > 0)) {
+            throw Base::ValueError("Stock has no volume");
+        }
+        count[i] = std::max(2, static_cast<int>(std::ceil(length[i] / resolution - 1e-9)) + 1);
+        spacing[i] = length[i] / (count[i] - 1);
+    }
+
+    for (int axis = 0; axis < 3; axis++) {
+        float lo = static_cast<float>(origin[axis]);
+        float hi = static_cast<float>(origin[axis] + length[axis]);
+        std::size_t size = static_cast<std::size_t>(count[(axis + 1) % 3]) * count[(axis + 2) % 3];
+        rays[axis].assign(size, Ray {lo, hi});
+    }
+    initialVolume = getVolume();
+}
+
+void DexelSim::setThreads(int threads)
+{
+    this->threads = threads;
+}
+
+double DexelSim::weight(int axis, int index) const
+{
+    // every ray stands for the area half way to its neighbours
+    if (index == 0 || index == count[axis] - 1) {
+        return 0.5 * spacing[axis];
+    }
+    return spacing[axis];
+}
+
+double DexelSim::getVolume() const
+{
+    double volume = 0;
+    for (int j = 0; j < count[1]; j++) {
+        for (int i = 0; i < count[0]; i++) {
+            const Ray& r = ray(2, i, j);
+            double length = 0;
+            for (std::size_t k = 0; k < r.size(); k += 2) {
+                length += r[k + 1] - r[k];
+            }
+            volume += length * weight(0, i) * weight(1, j);
+        }
+    }
+    return volume;
+}
+
+std::vector<DexelMove> DexelSim::collectMoves(const Path::Toolpath& path,
+                                              const Base::Vector3d& start)
+{
+    std::vector<DexelMove> moves;
+    MoveCollector collector(path, moves);
+    Path::PathSegmentWalker walker(path);
+    walker.walk(collector, start);
+    return moves;
+}
+
+void DexelSim::apply(const Path::Toolpath& path,
+                     const Base::Vector3d& start,
+                     const DexelTool& tool)
+{
+    apply(collectMoves(path, start), tool);
+}
+
+void DexelSim::apply(const std::vector<DexelMove>& moves, const DexelTool& tool)
+{
+    if (moves.empty()) {
+        return;
+    }
+
+    // conservative bounds of the volume swept by every move
+    double reach = std::sqrt(tool.radius * tool.radius + tool.length * tool.length);
+    std::vector<std::array<double, 6>> bounds;
+    bounds.reserve(moves.size());
+    for (const auto& move : moves) {
+        std::array<double, 6> box;
+        if (move.axisFrom == move.axisTo) {
+            box = toolBounds(move.from, move.axisFrom, tool);
+            std::array<double, 6> end = toolBounds(move.to, move.axisTo, tool);
+            for (int i = 0; i < 3; i++) {
+                box[i] = std::min(box[i], end[i]);
+                box[i + 3] = std::max(box[i + 3], end[i + 3]);
+            }
+        }
+        else {
+            for (int i = 0; i < 3; i++) {
+                box[i] = std::min(move.from[i], move.to[i]) - reach;
+                box[i + 3] = std::max(move.from[i], move.to[i]) + reach;
+            }
+        }
+        bounds.push_back(box);
+    }
+
+    std::vector<Tile> tiles;
+    for (int axis = 0; axis < 3; axis++) {
+        int nu = count[(axis + 1) % 3];
+        int nv = count[(axis + 2) % 3];
+        for (int v0 = 0; v0 < nv; v0 += TileSize) {
+            for (int u0 = 0; u0 < nu; u0 += TileSize) {
+                tiles.push_back(
+                    {axis, u0, std::min(u0 + TileSize, nu), v0, std::min(v0 + TileSize, nv)});
+            }
+        }
+    }
+
+    // tiles are handed out on demand, the cost of a tile depends on how much the tool visits it
+    int workers = threads;
+    if (workers < 1) {
+        workers = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    workers = std::min(workers, static_cast<int>(tiles.size()));
+    std::vector<std::vector<std::pair<int, double>>> hits(workers);
+    std::atomic<std::size_t> nextTile {0};
+    MeshCore::parallel_for(workers, workers, [&](std::size_t, std::size_t, std::size_t block) {
+        for (std::size_t index = nextTile++; index < tiles.size(); index = nextTile++) {
+            processTile(tiles[index], moves, bounds, tool, hits[block]);
+        }
+    });
+
+    // a rapid move is reported once with the volume that its Z rays lost
+    std::vector<std::pair<int, double>> merged;
+    for (const auto& list : hits) {
+        merged.insert(merged.end(), list.begin(), list.end());
+    }
+    std::sort(merged.begin(), merged.end());
+    for (const auto& hit : merged) {
+        const DexelMove& move = moves[hit.first];
+        if (!collisions.empty() && collisions.back().command == move.command) {
+            collisions.back().volume += hit.second;
+        }
+        else {
+            collisions.push_back({move.command, hit.second, move.from});
+        }
+    }
+}
+
+void DexelSim::processTile(const Tile& tile,
+                           const std::vector<DexelMove>& moves,
+                           const std::vector<std::array<double, 6>>& bounds,
+                           const DexelTool& tool,
+                           std::vector<std::pair<int, double>>& hits)
+{
+    int u = (tile.axis + 1) % 3;
+    int v = (tile.axis + 2) % 3;
+    double uMin = coord(u, tile.u0);
+    double uMax = coord(u, tile.u1 - 1);
+    double vMin = coord(v, tile.v0);
+    double vMax = coord(v, tile.v1 - 1);
+    double step = 0.5 * std::min({spacing[0], spacing[1], spacing[2]});
+    double tolerance = 1e-3 * step;
+    // range of ray indices within [lo, hi], clamped before the conversion
+    auto firstIndex = [this](int axis, double lo) {
+        double index = std::ceil((lo - origin[axis]) / spacing[axis]);
+        return static_cast<int>(std::clamp(index, -1.0, static_cast<double>(count[axis])));
+    };
+    auto lastIndex = [this](int axis, double hi) {
+        double index = std::floor((hi - origin[axis]) / spacing[axis]);
+        return static_cast<int>(std::clamp(index, -1.0, static_cast<double>(count[axis])));
+    };
+
+    for (std::size_t m = 0; m < moves.size(); m++) {
+        const std::array<double, 6>& box = bounds[m];
+        if (box[u] > uMax || box[u + 3] < uMin || box[v] > vMax || box[v + 3] < vMin) {
+            continue;
+        }
+
+        const DexelMove& move = moves[m];
+        double angle = std::acos(std::clamp(move.axisFrom * move.axisTo, -1.0, 1.0));
+        double distance = std::max((move.to - move.from).Length(), angle * tool.length);
+        int steps = std::max(1, static_cast<int>(std::ceil(distance / step)));
+
+        double removed = 0;
+        bool hit = false;
+        // the start pose is the end of the previous move, only the first one has to cut it
+        for (int s = m == 0 ? 0 : 1; s <= steps; s++) {
+            double t = static_cast<double>(s) / steps;
+            Pose pose;
+            pose.tip = move.from + (move.to - move.from) * t;
+            pose.axis = move.axisFrom + (move.axisTo - move.axisFrom) * t;
+            if (pose.axis.Length() < 1e-9) {
+                pose.axis = move.axisTo;
+            }
+            pose.axis.Normalize();
+
+            std::array<double, 6> poseBox = toolBounds(pose.tip, pose.axis, tool);
+            int iu0 = std::max(tile.u0, firstIndex(u, poseBox[u]));
+            int iu1 = std::min(tile.u1 - 1, lastIndex(u, poseBox[u + 3]));
+            int iv0 = std::max(tile.v0, firstIndex(v, poseBox[v]));
+            int iv1 = std::min(tile.v1 - 1, lastIndex(v, poseBox[v + 3]));
+            for (int iv = iv0; iv <= iv1; iv++) {
+                for (int iu = iu0; iu <= iu1; iu++) {
+                    double length = cutRay(tile.axis, iu, iv, pose, tool);
+                    if (length > tolerance) {
+                        hit = true;
+                    }
+                    if (tile.axis == 2) {
+                        removed += length * weight(u, iu) * weight(v, iv);
+                    }
+                }
+            }
+        }
+
+        if (move.rapid && hit) {
+            hits.emplace_back(static_cast<int>(m), removed);
+        }
+    }
+}
+
+double DexelSim::cutRay(int axis, int iu, int iv, const Pose& pose, const DexelTool& tool)
+{
+    Ray& r = ray(axis, iu, iv);
+    if (r.empty()) {
+        return 0;
+    }
+
+    // offset of the ray from the tip, positions along the ray are measured from the tip
+    int u = (axis + 1) % 3;
+    int v = (axis + 2) % 3;
+    Base::Vector3d w;
+    w[u] = coord(u, iu) - pose.tip[u];
+    w[v] = coord(v, iv) - pose.tip[v];
+    double base = pose.tip[axis];
+    const Base::Vector3d& d = pose.axis;
+
+    if (d.z > 1.0 - 1e-9) {
+        // vertical tool, the common case has closed forms for all three directions
+        if (axis == 2) {
+            double distance = std::sqrt(w.x * w.x + w.y * w.y);
+            if (distance > tool.radius) {
+                return 0;
+            }
+            return subtract(r,
+                            static_cast<float>(base + tool.heightAt(static_cast<float>(distance))),
+                            static_cast<float>(base + tool.length));
+        }
+        double radius = tool.radiusAt(static_cast<float>(w.z));
+        double offset = axis == 0 ? w.y : w.x;
+        double half = radius * radius - offset * offset;
+        if (radius < 0 || half < 0) {
+            return 0;
+        }
+        half = std::sqrt(half);
+        return subtract(r, static_cast<float>(base - half), static_cast<float>(base + half));
+    }
+
+    double da = d[axis];
+    double h0 = w * d;
+    double ww = w.Sqr();
+    double bottom = tool.heightAt(0.0F);
+    double radius = tool.radius;
+    double a = 1.0 - da * da;
+    double lo = 0;
+    double hi = 0;
+
+    if (a < 1e-12) {
+        // ray parallel to the tool axis at a constant distance
+        double distance = std::sqrt(std::max(0.0, ww - h0 * h0));
+        if (distance > radius) {
+            return 0;
+        }
+        lo = (tool.heightAt(static_cast<float>(distance)) - h0) / da;
+        hi = (tool.length - h0) / da;
+        if (lo > hi) {
+            std::swap(lo, hi);
+        }
+        return subtract(r, static_cast<float>(base + lo), static_cast<float>(base + hi));
+    }
+
+    // part of the ray within the radius of the axis, a*s^2 + 2*b*s + c <= 0
+    double b = -h0 * da;
+    double c = ww - h0 * h0 - radius * radius;
+    double disc = b * b - a * c;
+    if (disc < 0) {
+        return 0;
+    }
+    disc = std::sqrt(disc);
+    lo = (-b - disc) / a;
+    hi = (-b + disc) / a;
+
+    // and between the tip and the top of the tool
+    if (std::abs(da) > 1e-12) {
+        double s1 = (bottom - h0) / da;
+        double s2 = (tool.length - h0) / da;
+        lo = std::max(lo, std::min(s1, s2));
+        hi = std::min(hi, std::max(s1, s2));
+    }
+    else if (h0 < bottom || h0 > tool.length) {
+        return 0;
+    }
+    if (hi <= lo) {
+        return 0;
+    }
+
+    // the lower surface is only sampled, sign changes are refined by bisection
+    auto inside = [&](double s) {
+        double h = h0 + s * da;
+        double distance = std::sqrt(std::max(0.0, ww + s * s - h * h));
+        return h >= tool.heightAt(static_cast<float>(std::min(distance, radius)));
+    };
+    double step = 0.25 * std::min({spacing[0], spacing[1], spacing[2]});
+    int samples = std::max(1, static_cast<int>(std::ceil((hi - lo) / step)));
+    double removed = 0;
+    double last = lo;
+    bool lastInside = inside(lo);
+    double start = lo;
+    for (int i = 1; i <= samples; i++) {
+        double s = lo + (hi - lo) * i / samples;
+        bool in = inside(s);
+        if (in != lastInside) {
+            double s0 = last;
+            double s1 = s;
+            for (int k = 0; k < RefineSteps; k++) {
+                double mid = 0.5 * (s0 + s1);
+                if (inside(mid) == lastInside) {
+                    s0 = mid;
+                }
+                else {
+                    s1 = mid;
+                }
+            }
+            double edge = 0.5 * (s0 + s1);
+            if (in) {
+                start = edge;
+            }
+            else {
+                removed += subtract(r,
+                                    static_cast<float>(base + start),
+                                    static_cast<float>(base + edge));
+            }
+        }
+        last = s;
+        lastInside = in;
+    }
+    if (lastInside) {
+        removed += subtract(r, static_cast<float>(base + start), static_cast<float>(base + hi));
+    }
+    return removed;
+}
+
+double DexelSim::subtract(Ray& ray, float a, float b)
+{
+    if (!(a < b) || ray.empty() || b <= ray.front() || a >= ray.back()) {
+        return 0;
+    }
+
+    // intervals [first, last) overlap [a, b]
+    std::size_t size = ray.size();
+    std::size_t first = 0;
+    while (first < size && ray[first + 1] <= a) {
+        first += 2;
+    }
+    std::size_t last = first;
+    while (last < size && ray[last] < b) {
+        last += 2;
+    }
+    if (first == last) {
+        return 0;
+    }
+
+    double removed = 0;
+    for (std::size_t i = first; i < last; i += 2) {
+        removed += std::min(ray[i + 1], b) - std::max(ray[i], a);
+    }
+
+    // what is left of the first and the last overlapping interval
+    float pieces[4];
+    int count = 0;
+    if (ray[first] < a) {
+        pieces[count++] = ray[first];
+        pieces[count++] = a;
+    }
+    if (ray[last - 1] > b) {
+        pieces[count++] = b;
+        pieces[count++] = ray[last - 1];
+    }
+    ray.erase(ray.begin() + first, ray.begin() + last);
+    ray.insert(ray.begin() + first, pieces, pieces + count);
+    return removed;
+}
+
+bool DexelSim::isInside(int i, int j, int k) const
+{
+    if (i < 0 || j < 0 || k < 0 || i >= count[0] || j >= count[1] || k >= count[2]) {
+        return false;
+    }
+    const Ray& r = ray(2, i, j);
+    float z = static_cast<float>(coord(2, k));
+    for (std::size_t n = 0; n < r.size(); n += 2) {
+        if (r[n] <= z && z <= r[n + 1]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Base::Vector3f DexelSim::crossing(int axis, int i, int j, int k) const
+{
+    // the edge from node (i, j, k) to its neighbour along axis, the ray through both nodes
+    // knows where the surface crosses it
+    int index[3] = {i, j, k};
+    Base::Vector3d pos(coord(0, i), coord(1, j), coord(2, k));
+    double lo = pos[axis];
+    double hi = lo + spacing[axis];
+    pos[axis] = 0.5 * (lo + hi);
+
+    int u = (axis + 1) % 3;
+    int v = (axis + 2) % 3;
+    if (index[u] >= 0 && index[u] < count[u] && index[v] >= 0 && index[v] < count[v]) {
+        const Ray& r = ray(axis, index[u], index[v]);
+        auto it = std::lower_bound(r.begin(), r.end(), static_cast<float>(lo));
+        if (it != r.end() && *it <= hi) {
+            pos[axis] = *it;
+        }
+    }
+    return Base::toVector<float>(pos);
+}
+
+Mesh::MeshObject* DexelSim::createMesh() const
+{
+    // Surface nets on the nodes of the grid with one empty layer around the stock. Every cell
+    // with mixed corners gets a vertex at the mean of its edge crossings, every edge that
+    // leaves the stock a quad between the four cells around it.
+    int nx = count[0];
+    int ny = count[1];
+    int nz = count[2];
+    int rowNodes = nx + 2;
+    int rowCells = nx + 1;
+    std::size_t layerNodes = static_cast<std::size_t>(rowNodes) * (ny + 2);
+    std::size_t layerCells = static_cast<std::size_t>(rowCells) * (ny + 1);
+
+    // nodes and cells are stored from index -1
+    auto node = [&](int i, int j) {
+        return static_cast<std::size_t>(j + 1) * rowNodes + (i + 1);
+    };
+    auto cell = [&](int i, int j) {
+        return static_cast<std::size_t>(j + 1) * rowCells + (i + 1);
+    };
+    auto fillLayer = [&](std::vector<char>& layer, int k) {
+        std::fill(layer.begin(), layer.end(), 0);
+        if (k < 0 || k >= nz) {
+            return;
+        }
+        MeshCore::parallel_for(ny, threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (int j = static_cast<int>(begin); j < static_cast<int>(end); j++) {
+                for (int i = 0; i < nx; i++) {
+                    layer[node(i, j)] = isInside(i, j, k) ? 1 : 0;
+                }
+            }
+        });
+    };
+
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    std::vector<char> lower(layerNodes);
+    std::vector<char> upper(layerNodes);
+    std::vector<int> prevCells(layerCells, -1);
+    std::vector<int> cells(layerCells, -1);
+    fillLayer(upper, -1);
+
+    auto addQuad = [&](int p0, int p1, int p2, int p3, bool reverse) {
+        if (p0 < 0 || p1 < 0 || p2 < 0 || p3 < 0) {
+            return;
+        }
+        if (reverse) {
+            std::swap(p1, p3);
+        }
+        facets.push_back(MeshCore::MeshFacet(p0, p1, p2));
+        facets.push_back(MeshCore::MeshFacet(p0, p2, p3));
+    };
+
+    for (int ck = -1; ck < nz; ck++) {
+        // lower holds the nodes of layer ck, upper those of layer ck + 1
+        std::swap(lower, upper);
+        fillLayer(upper, ck + 1);
+
+        for (int cj = -1; cj < ny; cj++) {
+            for (int ci = -1; ci < nx; ci++) {
+                std::size_t index = cell(ci, cj);
+                cells[index] = -1;
+                const std::vector<char>* layer[2] = {&lower, &upper};
+                char corner[2][2][2];
+                int sum = 0;
+                for (int dk = 0; dk < 2; dk++) {
+                    for (int dj = 0; dj < 2; dj++) {
+                        for (int di = 0; di < 2; di++) {
+                            corner[dk][dj][di] = (*layer[dk])[node(ci + di, cj + dj)];
+                            sum += corner[dk][dj][di];
+                        }
+                    }
+                }
+                if (sum == 0 || sum == 8) {
+                    continue;
+                }
+
+                Base::Vector3f vertex;
+                int crossings = 0;
+                for (int a = 0; a < 2; a++) {
+                    for (int b = 0; b < 2; b++) {
+                        if (corner[b][a][0] != corner[b][a][1]) {
+                            vertex += crossing(0, ci, cj + a, ck + b);
+                            crossings++;
+                        }
+                        if (corner[b][0][a] != corner[b][1][a]) {
+                            vertex += crossing(1, ci + a, cj, ck + b);
+                            crossings++;
+                        }
+                        if (corner[0][b][a] != corner[1][b][a]) {
+                            vertex += crossing(2, ci + a, cj + b, ck);
+                            crossings++;
+                        }
+                    }
+                }
+                cells[index] = static_cast<int>(points.size());
+                points.push_back(vertex / static_cast<float>(crossings));
+            }
+        }
+
+        // edges along Z between the two node layers
+        for (int j = 0; j < ny; j++) {
+            for (int i = 0; i < nx; i++) {
+                char below = lower[node(i, j)];
+                if (below != upper[node(i, j)]) {
+                    addQuad(cells[cell(i - 1, j - 1)],
+                            cells[cell(i, j - 1)],
+                            cells[cell(i, j)],
+                            cells[cell(i - 1, j)],
+                            !below);
+                }
+            }
+        }
+
+        // edges along X and Y within the lower node layer, between the previous and this cell
+        // layer
+        if (ck < 0) {
+            std::swap(prevCells, cells);
+            continue;
+        }
+        for (int j = 0; j < ny; j++) {
+            for (int i = -1; i < nx; i++) {
+                char first = lower[node(i, j)];
+                if (first != lower[node(i + 1, j)]) {
+                    addQuad(prevCells[cell(i, j - 1)],
+                            prevCells[cell(i, j)],
+                            cells[cell(i, j)],
+                            cells[cell(i, j - 1)],
+                            !first);
+                }
+            }
+        }
+        for (int j = -1; j < ny; j++) {
+            for (int i = 0; i < nx; i++) {
+                char first = lower[node(i, j)];
+                if (first != lower[node(i, j + 1)]) {
+                    addQuad(prevCells[cell(i - 1, j)],
+                            cells[cell(i - 1, j)],
+                            cells[cell(i, j)],
+                            prevCells[cell(i, j)],
+                            !first);
+                }
+            }
+        }
+        std::swap(prevCells, cells);
+    }
+
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+    Mesh::MeshObject* mesh = new Mesh::MeshObject();
+    mesh->swap(kernel);
+    return mesh;
+}
@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef PATHSIMULATOR_DexelSim_H
+#define PATHSIMULATOR_DexelSim_H
+
+#include <array>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/Vector3D.h>
+#include <Mod/CAM/PathGlobal.h>
+
+class cSimTool;
+
+namespace Mesh
+{
+class MeshObject;
+}
+
+namespace Path
+{
+class Toolpath;
+}
+
+namespace PathSimulator
+{
+
+/** Rotationally symmetric tool given by the height of its lower surface over the radius.
+ * The profile is made monotone, the tool is the solid above it up to its length.
+ */
+class PathSimulatorExport DexelTool
+{
+public:
+    // profile holds (radius, height) pairs with the tip at height zero
+    DexelTool(const std::vector<std::pair<float, float>>& profile, float radius, float length);
+    explicit DexelTool(const cSimTool& tool);
+
+    // height of the lower surface at distance r from the axis, r must not exceed the radius
+    float heightAt(float r) const;
+    // radius of the cross section at height h above the tip, negative if there is none
+    float radiusAt(float h) const;
+
+    float radius;
+    float length;
+
+private:
+    void init(const std::vector<std::pair<float, float>>& profile);
+
+    std::vector<float> heights;  // lower surface sampled at equidistant radii
+    float step {0};
+};
+
+/** Tool pose at the two ends of a straight move, in stock coordinates */
+struct DexelMove
+{
+    Base::Vector3d from;
+    Base::Vector3d to;
+    Base::Vector3d axisFrom;  // tool axis pointing from the tip to the shank
+    Base::Vector3d axisTo;
+    int command;  // index of the command in the toolpath
+    bool rapid;
+};
+
+/** Tri-dexel material removal simulation.
+ * The stock is sampled by three families of rays along X, Y and Z through the nodes of a
+ * regular grid, every ray keeps the list of intervals that are still material. Moves are
+ * swept by placing the tool at poses not further apart than half the grid spacing, which
+ * also covers 4th and 5th axis moves with a tilted tool. The rays are processed in tiles on
+ * all cores, every tile sees the moves in program order so collisions are found exactly
+ * where the material still was when the rapid move happened.
+ */
+class PathSimulatorExport DexelSim
+{
+public:
+    struct Collision
+    {
+        int command;      // index of the rapid move in the toolpath
+        double volume;    // material removed by it
+        Base::Vector3d position;  // start of the move
+    };
+
+    DexelSim(const Base::BoundBox3d& stock, double resolution);
+
+    // threads < 1 uses the hardware concurrency
+    void setThreads(int threads);
+    // splits the toolpath into straight moves, arcs and rotary moves are segmented
+    static std::vector<DexelMove> collectMoves(const Path::Toolpath& path,
+                                               const Base::Vector3d& start);
+    // removes the volume swept by the tool, collisions are appended to the previous ones
+    void apply(const std::vector<DexelMove>& moves, const DexelTool& tool);
+    void apply(const Path::Toolpath& path, const Base::Vector3d& start, const DexelTool& tool);
+
+    double getVolume() const;
+    double getRemovedVolume() const
+    {
+        return initialVolume - getVolume();
+    }
+    const std::vector<Collision>& getCollisions() const
+    {
+        return collisions;
+    }
+
+    // returns a closed mesh of the remaining stock
+    Mesh::MeshObject* createMesh() const;
+
+private:
+    using Ray = std::vector<float>;  // sorted pairs of interval bounds
+
+    struct Tile
+    {
+        int axis;
+        int u0, u1, v0, v1;  // ray index range [u0, u1) x [v0, v1)
+    };
+
+    struct Pose
+    {
+        Base::Vector3d tip;
+        Base::Vector3d axis;
+    };
+
+    Ray& ray(int axis, int iu, int iv)
+    {
+        return rays[axis][iv * count[(axis + 1) % 3] + iu];
+    }
+    const Ray& ray(int axis, int iu, int iv) const
+    {
+        return rays[axis][iv * count[(axis + 1) % 3] + iu];
+    }
+    double coord(int axis, int index) const
+    {
+        return origin[axis] + index * spacing[axis];
+    }
+    double weight(int axis, int index) const;
+
+    void processTile(const Tile& tile,
+                     const std::vector<DexelMove>& moves,
+                     const std::vector<std::array<double, 6>>& bounds,
+                     const DexelTool& tool,
+                     std::vector<std::pair<int, double>>& hits);
+    double cutRay(int axis, int iu, int iv, const Pose& pose, const DexelTool& tool);
+    static double subtract(Ray& ray, float a, float b);
+    bool isInside(int i, int j, int k) const;
+    Base::Vector3f crossing(int axis, int i, int j, int k) const;
+
+    Base::Vector3d origin;
+    std::array<double, 3> spacing;
+    std::array<int, 3> count;
+    std::array<std::vector<Ray>, 3> rays;  // indexed by the ray direction
+    double initialVolume;
+    int threads {0};
+    std::vector<Collision> collisions;
+};
+
+}  // namespace PathSimulator
+
+#endif  // PATHSIMULATOR_DexelSim_H
@@ -22,6 +22,8 @@
 
 #include "PreCompiled.h"
 
+#include <Base/Exception.h>
+
 #include "PathSim.h"
 
 
@@ -46,6 +48,9 @@ void PathSim::BeginSimulation(Part::TopoShape* stock, float resolution)
                                        bbox.LengthY(),
                                        bbox.LengthZ(),
                                        resolution);
+    m_stockBox = bbox;
+    m_resolution = resolution;
+    m_dexel.reset();
 }
 
 void PathSim::SetToolShape(const TopoDS_Shape& toolShape, float resolution)
@@ -79,3 +84,18 @@ Base::Placement* PathSim::ApplyCommand(Base::Placement* pos, Command* cmd)
     plc->setPosition(vec);
     return plc;
 }
+
+void PathSim::ApplyToolpath(const Toolpath& path, const Base::Vector3d& start, int threads)
+{
+    if (!m_tool) {
+        throw Base::RuntimeError("Simulation has no tool");
+    }
+    if (!m_dexel) {
+        if (!(m_resolution > 0)) {
+            throw Base::RuntimeError("Simulation has no stock object");
+        }
+        m_dexel = std::make_unique<DexelSim>(m_stockBox, m_resolution);
+    }
+    m_dexel->setThreads(threads);
+    m_dexel->apply(path, start, DexelTool(*m_tool));
+}
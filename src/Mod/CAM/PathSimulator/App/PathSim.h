@@ -27,9 +27,11 @@
 #include <TopoDS_Shape.hxx>
 
 #include <Mod/CAM/App/Command.h>
+#include <Mod/CAM/App/Path.h>
 #include <Mod/Part/App/TopoShape.h>
 #include <Mod/CAM/PathGlobal.h>
 
+#include "DexelSim.h"
 #include "VolSim.h"
 
 
@@ -51,10 +53,18 @@ public:
     void BeginSimulation(Part::TopoShape* stock, float resolution);
     void SetToolShape(const TopoDS_Shape& toolShape, float resolution);
     Base::Placement* ApplyCommand(Base::Placement* pos, Command* cmd);
+    /** Simulates a whole toolpath on the tri-dexel stock, which is created on first use with
+     * the box and resolution of the last BeginSimulation() */
+    void ApplyToolpath(const Toolpath& path, const Base::Vector3d& start, int threads);
 
 public:
     std::unique_ptr<cStock> m_stock;
     std::unique_ptr<cSimTool> m_tool;
+    std::unique_ptr<DexelSim> m_dexel;
+
+private:
+    Base::BoundBox3d m_stockBox;
+    float m_resolution {0};
 };
 
 }  // namespace PathSimulator
@@ -22,11 +22,15 @@
 
 #include "PreCompiled.h"
 
+#include <Base/GeometryPyCXX.h>
+#include <Base/Interpreter.h>
 #include <Base/PlacementPy.h>
 #include <Base/PyWrapParseTupleAndKeywords.h>
+#include <Base/VectorPy.h>
 
 #include <Mod/Mesh/App/MeshPy.h>
 #include <Mod/CAM/App/CommandPy.h>
+#include <Mod/CAM/App/PathPy.h>
 #include <Mod/Part/App/TopoShapePy.h>
 
 #include "PathSim.h"
@@ -140,6 +144,73 @@ PyObject* PathSimPy::ApplyCommand(PyObject* args, PyObject* kwds)
     return newposPy;
 }
 
+PyObject* PathSimPy::ApplyToolpath(PyObject* args, PyObject* kwds)
+{
+    static const std::array<const char*, 4> kwlist {"path", "start", "threads", nullptr};
+    PyObject* pObjPath;
+    PyObject* pObjStart = nullptr;
+    int threads = 0;
+    if (!Base::Wrapped_ParseTupleAndKeywords(args,
+                                             kwds,
+                                             "O!|O!i",
+                                             kwlist,
+                                             &(Path::PathPy::Type),
+                                             &pObjPath,
+                                             &(Base::VectorPy::Type),
+                                             &pObjStart,
+                                             &threads)) {
+        return nullptr;
+    }
+    PathSim* sim = getPathSimPtr();
+    const Path::Toolpath* path = static_cast<Path::PathPy*>(pObjPath)->getToolpathPtr();
+    Base::Vector3d start;
+    if (pObjStart) {
+        start = *static_cast<Base::VectorPy*>(pObjStart)->getVectorPtr();
+    }
+
+    // the dexel stock may be created by this call
+    bool created = !sim->m_dexel;
+    std::size_t known = created ? 0 : sim->m_dexel->getCollisions().size();
+    double volume = created ? 0 : sim->m_dexel->getVolume();
+    try {
+        Base::PyGILStateRelease releaser {};
+        sim->ApplyToolpath(*path, start, threads);
+    }
+    catch (const Base::Exception& e) {
+        e.setPyException();
+        return nullptr;
+    }
+    if (created) {
+        volume = sim->m_dexel->getVolume() + sim->m_dexel->getRemovedVolume();
+    }
+
+    Py::List collisions;
+    const auto& list = sim->m_dexel->getCollisions();
+    for (std::size_t i = known; i < list.size(); i++) {
+        collisions.append(Py::TupleN(Py::Long(list[i].command),
+                                     Py::Float(list[i].volume),
+                                     Py::Vector(list[i].position)));
+    }
+    Py::Dict result;
+    result.setItem("RemovedVolume", Py::Float(volume - sim->m_dexel->getVolume()));
+    result.setItem("Volume", Py::Float(sim->m_dexel->getVolume()));
+    result.setItem("Collisions", collisions);
+    return Py::new_reference_to(result);
+}
+
+PyObject* PathSimPy::GetDexelMesh(PyObject* args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return nullptr;
+    }
+    DexelSim* dexel = getPathSimPtr()->m_dexel.get();
+    if (!dexel) {
+        PyErr_SetString(PyExc_RuntimeError, "Simulation has no toolpath applied");
+        return nullptr;
+    }
+    return new Mesh::MeshPy(dexel->createMesh());
+}
+
 Py::Object PathSimPy::getTool() const
 {
     // return Py::Object();
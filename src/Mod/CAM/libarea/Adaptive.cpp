@@ -26,7 +26,13 @@
 #include <cstring>
 #include <ctime>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
 #include <numbers>
+#include <random>
+#include <thread>
 
 namespace ClipperLib
 {
@@ -1063,10 +1069,29 @@ public:
         clip.AddPath(bbPath, PolyType::ptSubject, true);
         clip.AddPaths(clearedPaths, PolyType::ptClip, true);
         clip.Execute(ClipType::ctIntersection, clearedBoundedClipped);
+
+        // path bounds are reused by every cut area evaluation around this focus
+        clearedBoundedClippedBoxes.clear();
+        for (const auto& pth : clearedBoundedClipped) {
+            BoundBox pathBB;
+            if (!pth.empty()) {
+                pathBB.SetFirstPoint(pth.front());
+                for (const auto& pt : pth) {
+                    pathBB.AddPoint(pt);
+                }
+            }
+            clearedBoundedClippedBoxes.push_back(pathBB);
+        }
         bboxClippedInvalid = false;
         return clearedBoundedClipped;
     }
 
+    // bound boxes of the paths returned by the last GetBoundedClearedAreaClipped()
+    const vector<BoundBox>& GetBoundedClearedAreaBoxes()
+    {
+        return clearedBoundedClippedBoxes;
+    }
+
     // get full cleared area
     Paths& GetCleared()
     {
@@ -1078,6 +1103,7 @@ private:
     ClipperOffset clipof;
     Paths clearedPaths;
     Paths clearedBoundedClipped;
+    vector<BoundBox> clearedBoundedClippedBoxes;
     Paths clearedBoundedPaths;
 
     ClipperLib::cInt toolRadiusScaled;
@@ -1156,9 +1182,11 @@ public:
         return angle;
     }
 
+    // own generator so that every region gives the same result in whatever thread it runs
     double getRandomAngle()
     {
-        return MIN_ANGLE + (MAX_ANGLE - MIN_ANGLE) * double(rand()) / double(RAND_MAX);
+        double value = double(random() - random.min()) / double(random.max() - random.min());
+        return MIN_ANGLE + (MAX_ANGLE - MIN_ANGLE) * value;
     }
     size_t getPointCount()
     {
@@ -1168,6 +1196,7 @@ public:
 private:
     vector<double> angles;
     vector<double> areas;
+    std::minstd_rand random;
 };
 
 //***************************************
@@ -1417,19 +1446,17 @@ double Adaptive2d::CalcCutArea(Clipper& clip,
     BoundBox c2BB(c2, toolRadiusScaled);
     BoundBox c1BB(c1, toolRadiusScaled);
     Paths& clearedBounded = clearedArea.GetBoundedClearedAreaClipped(c2);
-    for (const Path& path : clearedBounded) {
+    const vector<BoundBox>& clearedBoxes = clearedArea.GetBoundedClearedAreaBoxes();
+    for (size_t pathIndex = 0; pathIndex < clearedBounded.size(); pathIndex++) {
+        const Path& path = clearedBounded[pathIndex];
         size_t size = path.size();
         if (size == 0) {
             continue;
         }
 
         //** bound box check
-        // construct bound box for path
-        BoundBox pathBB(path.front());
-        for (const auto& pt : path) {
-            pathBB.AddPoint(pt);
-        }
-        if (!c2BB.CollidesWith(c2)) {
+        BoundBox pathBB = clearedBoxes[pathIndex];
+        if (!pathBB.CollidesWith(c2BB)) {
             continue;  // this path cannot colide with tool
         }
         //** end of BB check
@@ -1826,6 +1853,7 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths& stockPaths,
     //	Resolve hierarchy and run processing
     //***************************************
     double cornerRoundingOffset = 0.15 * toolRadiusScaled / 2;
+    vector<pair<Paths, Paths>> regions;  // bound paths and tool bound paths of every region
     if (opType == OperationType::otClearingInside || opType == OperationType::otClearingOutside) {
 
         // prepare stock boundary overshooted paths
@@ -1877,7 +1905,7 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths& stockPaths,
                 clipof.Clear();
                 clipof.AddPaths(toolBoundPaths, JoinType::jtRound, EndType::etClosedPolygon);
                 clipof.Execute(boundPaths, toolRadiusScaled + finishPassOffsetScaled);
-                ProcessPolyNode(boundPaths, toolBoundPaths);
+                regions.emplace_back(boundPaths, toolBoundPaths);
             }
         }
     }
@@ -1934,14 +1962,90 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths& stockPaths,
                     clipof.AddPaths(toolBoundPaths, JoinType::jtRound, EndType::etClosedPolygon);
                     clipof.Execute(boundPaths, toolRadiusScaled + finishPassOffsetScaled);
 
-                    ProcessPolyNode(boundPaths, toolBoundPaths);
+                    regions.emplace_back(boundPaths, toolBoundPaths);
                 }
             }
         }
     }
+    ProcessRegions(regions);
     return results;
 }
 
+//********************************************
+// Adaptive2d - ProcessRegions
+//********************************************
+
+void Adaptive2d::ProcessRegions(const vector<pair<Paths, Paths>>& regions)
+{
+    size_t workers = threads > 0 ? size_t(threads) : size_t(std::thread::hardware_concurrency());
+#ifdef DEV_MODE
+    workers = 1;  // performance counters and drawing functions are shared
+#endif
+    workers = min(workers, regions.size());
+    if (workers < 2) {
+        for (const auto& region : regions) {
+            ProcessPolyNode(region.first, region.second);
+        }
+        return;
+    }
+
+    // Regions are independent, each is cleared by its own copy of this instance. Workers only
+    // queue their progress paths, the callback is called from this thread as the python
+    // function behind it must not be called from another one.
+    vector<std::list<AdaptiveOutput>> outputs(regions.size());
+    std::mutex progressMutex;
+    TPaths pendingProgress;
+    std::atomic<bool> stop {false};
+    std::function<bool(TPaths)> queueProgress = [&](TPaths paths) {
+        std::lock_guard<std::mutex> lock(progressMutex);
+        pendingProgress.insert(pendingProgress.end(), paths.begin(), paths.end());
+        return stop.load();
+    };
+    auto reportProgress = [&]() {
+        TPaths paths;
+        {
+            std::lock_guard<std::mutex> lock(progressMutex);
+            paths.swap(pendingProgress);
+        }
+        if (!paths.empty() && progressCallback && (*progressCallback)(paths)) {
+            stop = true;
+            stopProcessing = true;
+        }
+    };
+
+    // copied before any worker starts, this thread keeps writing stopProcessing
+    Adaptive2d prototype(*this);
+    prototype.results.clear();
+    std::atomic<size_t> nextRegion {0};
+    auto worker = [&]() {
+        for (size_t index = nextRegion++; index < regions.size(); index = nextRegion++) {
+            Adaptive2d region(prototype);
+            region.current_region = int(index);
+            region.progressCallback = &queueProgress;
+            region.ProcessPolyNode(regions[index].first, regions[index].second);
+            outputs[index].swap(region.results);
+        }
+    };
+    vector<std::future<void>> futures;
+    for (size_t i = 0; i < workers; i++) {
+        futures.push_back(std::async(std::launch::async, worker));
+    }
+    for (auto& future : futures) {
+        while (future.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready) {
+            reportProgress();
+        }
+    }
+    reportProgress();
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    // same order as processing the regions one after the other
+    for (auto& output : outputs) {
+        results.splice(results.end(), output);
+    }
+}
+
 bool Adaptive2d::FindEntryPoint(TPaths& progressPaths,
                                 const Paths& toolBoundPaths,
                                 const Paths& boundPaths,
@@ -21,6 +21,7 @@
  ***************************************************************************/
 
 #include "clipper.hpp"
+#include <functional>
 #include <vector>
 #include <list>
 #include <time.h>
@@ -78,7 +79,7 @@ struct AdaptiveOutput
     int ReturnMotionType;  // MotionType enum, problem with serialization if enum is used
 };
 
-// used to isolate state -> enable potential adding of multi-threaded processing of separate regions
+// used to isolate state -> separate regions are processed in parallel by copies of the instance
 
 class Adaptive2d
 {
@@ -93,6 +94,7 @@ public:
     bool finishingProfile = true;
     double keepToolDownDistRatio = 3.0;  // keep tool down distance ratio
     OperationType opType = OperationType::otClearingInside;
+    int threads = 0;  // regions cleared in parallel, less than 1 uses all cores
 
     std::list<AdaptiveOutput> Execute(const DPaths& stockPaths,
                                       const DPaths& paths,
@@ -124,6 +126,7 @@ private:
     std::function<bool(TPaths)>* progressCallback = NULL;
     Path toolGeometry;  // tool geometry at coord 0,0, should not be modified
 
+    void ProcessRegions(const std::vector<std::pair<Paths, Paths>>& regions);
     void ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths);
     bool FindEntryPoint(TPaths& progressPaths,
                         const Paths& toolBoundPaths,
@@ -24,16 +24,32 @@
 
 #ifndef _PreComp_
 #include <boost/core/ignore_unused.hpp>
+#include <algorithm>
+#include <map>
 #include <numeric>
 #include <limits>
 
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepClass3d_SolidClassifier.hxx>
+#include <BRepClass_FaceClassifier.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
 #include <BRepGProp_Face.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepTools.hxx>
+#include <BRep_Tool.hxx>
+#include <GeomAPI_ProjectPointOnSurf.hxx>
+#include <Geom_Surface.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Precision.hxx>
+#include <Standard_Version.hxx>
 #include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
 #include <gp_Pnt.hxx>
+#include <gp_Pnt2d.hxx>
 
 #include <QEventLoop>
 #include <QFuture>
@@ -47,11 +63,13 @@
 #include <Base/Stream.h>
 
 #include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Mesh/App/MeshFeature.h>
 #include <Mod/Part/App/PartFeature.h>
+#include <Mod/Part/App/Tools.h>
 #include <Mod/Points/App/PointsFeature.h>
 #include <Mod/Points/App/PointsGrid.h>
 
@@ -288,30 +306,16 @@ InspectNominalMesh::InspectNominalMesh(const Mesh::MeshObject& rMesh, float offs
     _clTrf = rMesh.getTransform();
     _bApply = _clTrf != tmp;
 
-    // Max. limit of grid elements
-    float fMaxGridElements = 8000000.0f;
-    Base::BoundBox3f box = _mesh.GetBoundBox().Transformed(rMesh.getTransform());
-
-    // estimate the minimum allowed grid length
-    float fMinGridLen =
-        (float)pow((box.LengthX() * box.LengthY() * box.LengthZ() / fMaxGridElements), 0.3333f);
-    float fGridLen = 5.0f * MeshCore::MeshAlgorithm(_mesh).GetAverageEdgeLength();
-
-    // We want to avoid to get too small grid elements otherwise building up the grid structure
-    // would take too much time and memory. Having quite a dense grid speeds up more the following
-    // algorithms extremely. Due to the issue above it's always a compromise between speed and
-    // memory usage.
-    fGridLen = std::max<float>(fMinGridLen, fGridLen);
-
-    // build up grid structure to speed up algorithms
-    _pGrid = new MeshInspectGrid(_mesh, fGridLen, rMesh.getTransform());
-    _box = box;
+    // Unlike a grid the bounding volume hierarchy doesn't depend on the facet sizes and always
+    // finds the nearest facet
+    _pBVH = new MeshCore::MeshFacetBVH(_mesh, rMesh.getTransform());
+    _box = _mesh.GetBoundBox().Transformed(rMesh.getTransform());
     _box.Enlarge(offset);
 }
 
 InspectNominalMesh::~InspectNominalMesh()
 {
-    delete this->_pGrid;
+    delete this->_pBVH;
 }
 
 float InspectNominalMesh::getDistance(const Base::Vector3f& point) const
@@ -320,29 +324,19 @@ float InspectNominalMesh::getDistance(const Base::Vector3f& point) const
         return std::numeric_limits<float>::max();  // must be inside bbox
     }
 
-    std::vector<unsigned long> indices;
-    //_pGrid->GetElements(point, indices);
-    if (indices.empty()) {
-        std::set<unsigned long> inds;
-        _pGrid->MeshGrid::SearchNearestFromPoint(point, inds);
-        indices.insert(indices.begin(), inds.begin(), inds.end());
+    Base::Vector3f closest;
+    MeshCore::FacetIndex index = _pBVH->NearestFacet(point, closest);
+    if (index == MeshCore::FACET_INDEX_MAX) {
+        return std::numeric_limits<float>::max();
     }
 
-    float fMinDist = std::numeric_limits<float>::max();
-    bool positive = true;
-    for (unsigned long it : indices) {
-        MeshCore::MeshGeomFacet geomFace = _mesh.GetFacet(it);
-        if (_bApply) {
-            geomFace.Transform(_clTrf);
-        }
-
-        float fDist = geomFace.DistanceToPoint(point);
-        if (fabs(fDist) < fabs(fMinDist)) {
-            fMinDist = fDist;
-            positive = point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) > 0;
-        }
+    MeshCore::MeshGeomFacet geomFace = _mesh.GetFacet(index);
+    if (_bApply) {
+        geomFace.Transform(_clTrf);
     }
 
+    float fMinDist = Base::Distance(point, closest);
+    bool positive = point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) > 0;
     if (!positive) {
         fMinDist = -fMinDist;
     }
@@ -472,39 +466,338 @@ float InspectNominalPoints::getDistance(const Base::Vector3f& point) const
 
 // ----------------------------------------------------------------
 
-InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float /*radius*/)
-    : _rShape(shape)
+namespace
+{
+struct NominalFace
+{
+    TopoDS_Face face;
+    Handle(Geom_Surface) surface;
+    double umin {0.0};
+    double umax {0.0};
+    double vmin {0.0};
+    double vmax {0.0};
+    bool hasUV {false};
+};
+
+bool isBelowFace(const BRepExtrema_DistShapeShape& distss, const gp_Pnt& pnt3d)
+{
+    // check if the distance was computed from a face
+    for (Standard_Integer index = 1; index <= distss.NbSolution(); index++) {
+        if (distss.SupportTypeShape1(index) == BRepExtrema_IsInFace) {
+            TopoDS_Shape face = distss.SupportOnShape1(index);
+            Standard_Real u, v;
+            distss.ParOnFaceS1(index, u, v);
+            BRepGProp_Face props(TopoDS::Face(face));
+            gp_Vec normal;
+            gp_Pnt center;
+            props.Normal(u, v, center, normal);
+            gp_Vec dir(center, pnt3d);
+            Standard_Real scalar = normal.Dot(dir);
+            if (scalar < 0) {
+                return true;
+            }
+            break;
+        }
+    }
+
+    return false;
+}
+}  // namespace
+
+/** Tessellation of the nominal faces together with the data needed to refine a triangle hit on
+ * the underlying surface.
+ */
+class InspectNominalShape::FaceIndex
+{
+public:
+    explicit FaceIndex(const TopoDS_Shape& shape);
+
+    bool isEmpty() const
+    {
+        return faces.empty();
+    }
+    /// Exact distance of \a pnt3d to the face of \a facet, seeded with the triangle parameters.
+    double projectOnFace(MeshCore::FacetIndex facet,
+                         const gp_Pnt& pnt3d,
+                         bool& inFace,
+                         gp_Pnt2d& uv) const;
+
+    std::vector<NominalFace> faces;
+    std::vector<std::size_t> faceOfFacet;
+    std::vector<gp_Pnt2d> uvOfPoint;
+    MeshCore::MeshKernel mesh;
+    MeshCore::MeshFacetBVH bvh;
+    double deflection {0.0};
+};
+
+InspectNominalShape::FaceIndex::FaceIndex(const TopoDS_Shape& shape)
+{
+    // Mesh a copy because the triangulation is stored in the faces and would otherwise
+    // replace the one of the shape in the document. The faces of the copy are kept alive by
+    // the index.
+    TopoDS_Shape copy = BRepBuilderAPI_Copy(shape).Shape();
+
+    // the same accuracy as used for the tessellation of an actual shape
+    Standard_Real accuracy = Part::TopoShape(copy).getAccuracy();
+    BRepMesh_IncrementalMesh mesher(copy, std::max(accuracy, Precision::Confusion()));
+
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+
+    TopTools_IndexedMapOfShape faceMap;
+    TopExp::MapShapes(copy, TopAbs_FACE, faceMap);
+    for (int i = 1; i <= faceMap.Extent(); i++) {
+        const TopoDS_Face& face = TopoDS::Face(faceMap(i));
+        std::vector<gp_Pnt> nodes;
+        std::vector<Poly_Triangle> triangles;
+        if (!Part::Tools::getTriangulation(face, nodes, triangles) || triangles.empty()) {
+            continue;
+        }
+
+        NominalFace info;
+        info.face = face;
+        info.surface = BRep_Tool::Surface(face);
+        if (info.surface.IsNull()) {
+            continue;
+        }
+        BRepTools::UVBounds(face, info.umin, info.umax, info.vmin, info.vmax);
+
+        TopLoc_Location loc;
+        Handle(Poly_Triangulation) hTria = BRep_Tool::Triangulation(face, loc);
+        deflection = std::max(deflection, hTria->Deflection());
+        info.hasUV = hTria->HasUVNodes();
+
+        auto offset = static_cast<MeshCore::PointIndex>(points.size());
+        for (std::size_t j = 0; j < nodes.size(); j++) {
+            const gp_Pnt& p = nodes[j];
+            points.emplace_back(float(p.X()), float(p.Y()), float(p.Z()));
+            if (info.hasUV) {
+                auto index = static_cast<Standard_Integer>(j + 1);
+#if OCC_VERSION_HEX < 0x070600
+                uvOfPoint.push_back(hTria->UVNodes()(index));
+#else
+                uvOfPoint.push_back(hTria->UVNode(index));
+#endif
+            }
+            else {
+                uvOfPoint.emplace_back();
+            }
+        }
+
+        for (const auto& it : triangles) {
+            Standard_Integer n1, n2, n3;
+            it.Get(n1, n2, n3);
+            facets.emplace_back(offset + n1, offset + n2, offset + n3);
+            faceOfFacet.push_back(faces.size());
+        }
+
+        faces.push_back(info);
+    }
+
+    mesh.Adopt(points, facets);
+    bvh.Rebuild(mesh);
+}
+
+double InspectNominalShape::FaceIndex::projectOnFace(MeshCore::FacetIndex facet,
+                                                     const gp_Pnt& pnt3d,
+                                                     bool& inFace,
+                                                     gp_Pnt2d& uv) const
 {
-    distss = new BRepExtrema_DistShapeShape();
-    distss->LoadS1(_rShape);
+    const NominalFace& info = faces[faceOfFacet[facet]];
+    inFace = false;
+
+    // restrict the projection to a window around the parameters of the triangle hit
+    Standard_Real umin = info.umin;
+    Standard_Real umax = info.umax;
+    Standard_Real vmin = info.vmin;
+    Standard_Real vmax = info.vmax;
+    if (info.hasUV) {
+        const MeshCore::MeshFacet& face = mesh.GetFacets()[facet];
+        const gp_Pnt2d& uv0 = uvOfPoint[face._aulPoints[0]];
+        const gp_Pnt2d& uv1 = uvOfPoint[face._aulPoints[1]];
+        const gp_Pnt2d& uv2 = uvOfPoint[face._aulPoints[2]];
+        Standard_Real u0 = std::min({uv0.X(), uv1.X(), uv2.X()});
+        Standard_Real u1 = std::max({uv0.X(), uv1.X(), uv2.X()});
+        Standard_Real v0 = std::min({uv0.Y(), uv1.Y(), uv2.Y()});
+        Standard_Real v1 = std::max({uv0.Y(), uv1.Y(), uv2.Y()});
+        Standard_Real du = u1 - u0;
+        Standard_Real dv = v1 - v0;
+        umin = std::max(umin, u0 - du);
+        umax = std::min(umax, u1 + du);
+        vmin = std::max(vmin, v0 - dv);
+        vmax = std::min(vmax, v1 + dv);
+    }
+
+    if (umin < umax && vmin < vmax) {
+        GeomAPI_ProjectPointOnSurf proj(pnt3d, info.surface, umin, umax, vmin, vmax);
+        if (proj.NbPoints() > 0) {
+            Standard_Real u, v;
+            proj.LowerDistanceParameters(u, v);
+            BRepClass_FaceClassifier classifier(info.face,
+                                                gp_Pnt2d(u, v),
+                                                BRep_Tool::Tolerance(info.face));
+            if (classifier.State() == TopAbs_IN) {
+                inFace = true;
+                uv.SetCoord(u, v);
+                return proj.LowerDistance();
+            }
+        }
+    }
+
+    // the closest point lies on the boundary of the face or outside the window
+    BRepExtrema_DistShapeShape distss(info.face, BRepBuilderAPI_MakeVertex(pnt3d).Vertex());
+    if (!distss.IsDone() || distss.NbSolution() == 0) {
+        return std::numeric_limits<double>::max();
+    }
+    if (distss.SupportTypeShape1(1) == BRepExtrema_IsInFace) {
+        Standard_Real u, v;
+        distss.ParOnFaceS1(1, u, v);
+        inFace = true;
+        uv.SetCoord(u, v);
+    }
+    return distss.Value();
+}
+
+// ----------------------------------------------------------------
 
+InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float /*radius*/)
+    : _pShape(new TopoDS_Shape(shape))
+    , _rShape(shape)
+{
     // When having a solid then use its shell because otherwise the distance
     // for inner points will always be zero
     if (!_rShape.IsNull() && _rShape.ShapeType() == TopAbs_SOLID) {
         TopExp_Explorer xp;
         xp.Init(_rShape, TopAbs_SHELL);
         if (xp.More()) {
-            distss->LoadS1(xp.Current());
+            *_pShape = xp.Current();
             isSolid = true;
         }
     }
-    // distss->SetDeflection(radius);
+
+    if (!_rShape.IsNull()) {
+        _pIndex = new FaceIndex(*_pShape);
+        if (_pIndex->isEmpty()) {
+            delete _pIndex;
+            _pIndex = nullptr;
+        }
+    }
 }
 
 InspectNominalShape::~InspectNominalShape()
 {
-    delete distss;
+    delete _pIndex;
+    delete _pShape;
 }
 
 float InspectNominalShape::getDistance(const Base::Vector3f& point) const
 {
     gp_Pnt pnt3d(point.x, point.y, point.z);
-    BRepBuilderAPI_MakeVertex mkVert(pnt3d);
-    distss->LoadS2(mkVert.Vertex());
+    if (!_pIndex) {
+        return getShapeDistance(pnt3d);
+    }
+
+    // No triangle deviates more than the deflection from its face. So, only faces with a
+    // triangle closer than the closest triangle plus twice the deflection can contain the
+    // closest point of the shape.
+    Base::Vector3f closest;
+    MeshCore::FacetIndex index = _pIndex->bvh.NearestFacet(point, closest);
+    if (index == MeshCore::FACET_INDEX_MAX) {
+        return std::numeric_limits<float>::max();
+    }
+
+    float deflection = static_cast<float>(_pIndex->deflection);
+    float radius = Base::Distance(point, closest) + 2.0F * deflection;
+    radius += radius * 1.0e-4F + std::numeric_limits<float>::epsilon();
+    Base::BoundBox3f box(point.x - radius,
+                         point.y - radius,
+                         point.z - radius,
+                         point.x + radius,
+                         point.y + radius,
+                         point.z + radius);
+    std::vector<MeshCore::FacetIndex> facets;
+    _pIndex->bvh.FacetsInBox(box, facets);
+
+    // per face keep the closest triangle as seed for the projection
+    struct Candidate
+    {
+        float dist;
+        MeshCore::FacetIndex facet;
+    };
+    std::map<std::size_t, Candidate> candidates;
+    candidates[_pIndex->faceOfFacet[index]] = {Base::Distance(point, closest), index};
+    for (auto it : facets) {
+        float dist = _pIndex->mesh.GetFacet(it).DistanceToPoint(point);
+        if (dist > radius) {
+            continue;
+        }
+        auto res = candidates.emplace(_pIndex->faceOfFacet[it], Candidate {dist, it});
+        if (!res.second && dist < res.first->second.dist) {
+            res.first->second = {dist, it};
+        }
+    }
+
+    std::vector<Candidate> sorted;
+    sorted.reserve(candidates.size());
+    for (const auto& it : candidates) {
+        sorted.push_back(it.second);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Candidate& c1, const Candidate& c2) {
+        return c1.dist < c2.dist;
+    });
+
+    double fMinDist = std::numeric_limits<double>::max();
+    bool inFace = false;
+    gp_Pnt2d uv;
+    MeshCore::FacetIndex best = index;
+    for (const auto& it : sorted) {
+        if (double(it.dist) - double(deflection) >= fMinDist) {
+            break;
+        }
+        bool faceHit = false;
+        gp_Pnt2d param;
+        double dist = _pIndex->projectOnFace(it.facet, pnt3d, faceHit, param);
+        if (dist < fMinDist) {
+            fMinDist = dist;
+            inFace = faceHit;
+            uv = param;
+            best = it.facet;
+        }
+    }
+
+    if (fMinDist == std::numeric_limits<double>::max()) {
+        return std::numeric_limits<float>::max();
+    }
+
+    bool below = false;
+    if (inFace) {
+        BRepGProp_Face props(_pIndex->faces[_pIndex->faceOfFacet[best]].face);
+        gp_Vec normal;
+        gp_Pnt center;
+        props.Normal(uv.X(), uv.Y(), center, normal);
+        below = normal.Dot(gp_Vec(center, pnt3d)) < 0;
+    }
+    else if (isSolid) {
+        below = isInsideSolid(pnt3d);
+    }
+    else {
+        // the closest point is on an edge or vertex, use the tessellation instead
+        MeshCore::MeshGeomFacet geomFace = _pIndex->mesh.GetFacet(best);
+        below = point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) < 0;
+    }
+
+    return below ? -static_cast<float>(fMinDist) : static_cast<float>(fMinDist);
+}
+
+float InspectNominalShape::getShapeDistance(const gp_Pnt& pnt3d) const
+{
+    BRepExtrema_DistShapeShape distss;
+    distss.LoadS1(*_pShape);
+    distss.LoadS2(BRepBuilderAPI_MakeVertex(pnt3d).Vertex());
 
     float fMinDist = std::numeric_limits<float>::max();
-    if (distss->Perform() && distss->NbSolution() > 0) {
-        fMinDist = (float)distss->Value();
+    if (distss.Perform() && distss.NbSolution() > 0) {
+        fMinDist = (float)distss.Value();
         // the shape is a solid, check if the vertex is inside
         if (isSolid) {
             if (isInsideSolid(pnt3d)) {
@@ -513,7 +806,7 @@ float InspectNominalShape::getDistance(const Base::Vector3f& point) const
         }
         else if (fMinDist > 0) {
             // check if the distance was computed from a face
-            if (isBelowFace(pnt3d)) {
+            if (isBelowFace(distss, pnt3d)) {
                 fMinDist = -fMinDist;
             }
         }
@@ -528,32 +821,6 @@ bool InspectNominalShape::isInsideSolid(const gp_Pnt& pnt3d) const
     classifier.Perform(pnt3d, tol);
     return (classifier.State() == TopAbs_IN);
 }
-
-bool InspectNominalShape::isBelowFace(const gp_Pnt& pnt3d) const
-{
-    // check if the distance was computed from a face
-    for (Standard_Integer index = 1; index <= distss->NbSolution(); index++) {
-        if (distss->SupportTypeShape1(index) == BRepExtrema_IsInFace) {
-            TopoDS_Shape face = distss->SupportOnShape1(index);
-            Standard_Real u, v;
-            distss->ParOnFaceS1(index, u, v);
-            // gp_Pnt pnt = distss->PointOnShape1(index);
-            BRepGProp_Face props(TopoDS::Face(face));
-            gp_Vec normal;
-            gp_Pnt center;
-            props.Normal(u, v, center, normal);
-            gp_Vec dir(center, pnt3d);
-            Standard_Real scalar = normal.Dot(dir);
-            if (scalar < 0) {
-                return true;
-            }
-            break;
-        }
-    }
-
-    return false;
-}
-
 // ----------------------------------------------------------------
 
 TYPESYSTEM_SOURCE(Inspection::PropertyDistanceList, App::PropertyLists)
@@ -833,7 +1100,6 @@ App::DocumentObjectExecReturn* Feature::execute()
             nominal = new InspectNominalPoints(pts->Points.getValue(), this->SearchRadius.getValue());
         }
         else if (it->isDerivedFrom<Part::Feature>()) {
-            useMultithreading = false;
             Part::Feature* part = static_cast<Part::Feature*>(it);
             nominal = new InspectNominalShape(part->Shape.getValue(), this->SearchRadius.getValue());
         }
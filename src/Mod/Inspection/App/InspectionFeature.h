@@ -31,13 +31,13 @@
 
 
 class TopoDS_Shape;
-class BRepExtrema_DistShapeShape;
 class gp_Pnt;
 
 namespace MeshCore
 {
 class MeshKernel;
 class MeshGrid;
+class MeshFacetBVH;
 }  // namespace MeshCore
 
 namespace Mesh
@@ -125,7 +125,7 @@ public:
 
 private:
     const MeshCore::MeshKernel& _mesh;
-    MeshCore::MeshGrid* _pGrid;
+    MeshCore::MeshFacetBVH* _pBVH;
     Base::BoundBox3f _box;
     bool _bApply;
     Base::Matrix4D _clTrf;
@@ -159,6 +159,11 @@ private:
     Points::PointsGrid* _pGrid;
 };
 
+/** The faces of the shape are tessellated once and indexed by a BVH. For each point the
+ * closest triangle limits the faces that need an exact projection, which is seeded with the
+ * parameters of the triangle hit. getDistance() doesn't modify any state and can be used from
+ * several threads.
+ */
 class InspectionExport InspectNominalShape: public InspectNominalGeometry
 {
 public:
@@ -167,11 +172,13 @@ public:
     float getDistance(const Base::Vector3f&) const override;
 
 private:
+    float getShapeDistance(const gp_Pnt&) const;
     bool isInsideSolid(const gp_Pnt&) const;
-    bool isBelowFace(const gp_Pnt&) const;
 
 private:
-    BRepExtrema_DistShapeShape* distss;
+    class FaceIndex;
+    FaceIndex* _pIndex {nullptr};
+    TopoDS_Shape* _pShape;
     const TopoDS_Shape& _rShape;
     bool isSolid {false};
 };
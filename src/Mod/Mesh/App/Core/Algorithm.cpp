@@ -32,7 +32,9 @@
 
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "BVH.h"
 #include "Elements.h"
+#include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "Triangulation.h"
@@ -70,6 +72,14 @@ bool MeshAlgorithm::IsVertexVisible(const Base::Vector3f& rcVertex,
     return true;  // no facet between the two points
 }
 
+bool MeshAlgorithm::IsVertexVisible(const Base::Vector3f& rcVertex,
+                                    const Base::Vector3f& rcView,
+                                    const MeshFacetBVH& rclBVH) const
+{
+    const float fMaxDistance = 0.001F;
+    return !rclBVH.IsSegmentBlocked(rcView, rcVertex, fMaxDistance);
+}
+
 bool MeshAlgorithm::NearestFacetOnRay(const Base::Vector3f& rclPt,
                                       const Base::Vector3f& rclDir,
                                       Base::Vector3f& rclRes,
@@ -143,6 +153,15 @@ bool MeshAlgorithm::NearestFacetOnRay(const Base::Vector3f& rclPt,
     return false;
 }
 
+bool MeshAlgorithm::NearestFacetOnRay(const Base::Vector3f& rclPt,
+                                      const Base::Vector3f& rclDir,
+                                      const MeshFacetBVH& rclBVH,
+                                      Base::Vector3f& rclRes,
+                                      FacetIndex& rulFacet) const
+{
+    return rclBVH.NearestFacetOnRay(rclPt, rclDir, rclRes, rulFacet);
+}
+
 bool MeshAlgorithm::NearestFacetOnRay(const Base::Vector3f& rclPt,
                                       const Base::Vector3f& rclDir,
                                       float fMaxSearchArea,
@@ -2108,6 +2127,81 @@ void MeshRefPointToPoints::RemoveNeighbour(PointIndex pos, PointIndex facet)
 
 //----------------------------------------------------------------------------
 
+void MeshPointAdjacency::Rebuild()
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::size_t numPoints = _rclMesh.CountPoints();
+    _numFacets.assign(numPoints, 0);
+
+    // count the distinct corners of all facets
+    for (const auto& rFacet : rFacets) {
+        const PointIndex* pts = rFacet._aulPoints;
+        _numFacets[pts[0]]++;
+        if (pts[1] != pts[0]) {
+            _numFacets[pts[1]]++;
+        }
+        if (pts[2] != pts[0] && pts[2] != pts[1]) {
+            _numFacets[pts[2]]++;
+        }
+    }
+
+    // reserve two slots per facet a point belongs to and scatter the other two corners there
+    std::vector<std::size_t> slots(numPoints + 1, 0);
+    for (std::size_t i = 0; i < numPoints; i++) {
+        slots[i + 1] = slots[i] + 2 * std::size_t(_numFacets[i]);
+    }
+
+    std::vector<PointIndex> candidates(slots.back());
+    std::vector<std::size_t> fill(slots.begin(), slots.end() - 1);
+    for (const auto& rFacet : rFacets) {
+        const PointIndex* pts = rFacet._aulPoints;
+        for (int i = 0; i < 3; i++) {
+            PointIndex pos = pts[i];
+            if ((i > 0 && pos == pts[0]) || (i > 1 && pos == pts[1])) {
+                continue;
+            }
+            candidates[fill[pos]++] = pts[(i + 1) % 3];
+            candidates[fill[pos]++] = pts[(i + 2) % 3];
+        }
+    }
+    fill.clear();
+    fill.shrink_to_fit();
+
+    // edges shared by two facets are stored twice, so sort and remove duplicates per point
+    int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::vector<std::size_t> counts(numPoints);
+    parallel_for(numPoints, threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; i++) {
+            auto first = candidates.begin() + std::ptrdiff_t(slots[i]);
+            auto last = candidates.begin() + std::ptrdiff_t(slots[i + 1]);
+            std::sort(first, last);
+            last = std::unique(first, last);
+            // a degenerated facet may reference the point itself
+            last = std::remove(first, last, PointIndex(i));
+            counts[i] = std::size_t(last - first);
+        }
+    });
+
+    _offsets.resize(numPoints + 1);
+    _offsets[0] = 0;
+    for (std::size_t i = 0; i < numPoints; i++) {
+        _offsets[i + 1] = _offsets[i] + counts[i];
+    }
+
+    _neighbours.resize(_offsets.back());
+    _neighbours.shrink_to_fit();
+    parallel_for(numPoints, threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; i++) {
+            auto first = candidates.begin() + std::ptrdiff_t(slots[i]);
+            std::copy(first,
+                      first + std::ptrdiff_t(counts[i]),
+                      _neighbours.begin() + std::ptrdiff_t(_offsets[i]));
+        }
+    });
+}
+
+//----------------------------------------------------------------------------
+
 void MeshRefEdgeToFacets::Rebuild()
 {
     _map.clear();
@@ -45,6 +45,7 @@ namespace MeshCore
 class MeshGeomFacet;
 class MeshGeomEdge;
 class MeshKernel;
+class MeshFacetBVH;
 class MeshFacetGrid;
 class MeshFacetArray;
 class MeshRefPointToFacets;
@@ -99,6 +100,20 @@ public:
                            const MeshFacetGrid& rclGrid,
                            Base::Vector3f& rclRes,
                            FacetIndex& rulFacet) const;
+    /**
+     * Searches for the nearest facet to the ray defined by
+     * (\a rclPt, \a rclDir).
+     * The point \a rclRes holds the intersection point with the ray and the
+     * nearest facet with index \a rulFacet.
+     * \note This method uses a bounding volume hierarchy which performs better
+     * than a grid on meshes with very different facet sizes. Unlike the grid
+     * version only intersections in direction of \a rclDir are found.
+     */
+    bool NearestFacetOnRay(const Base::Vector3f& rclPt,
+                           const Base::Vector3f& rclDir,
+                           const MeshFacetBVH& rclBVH,
+                           Base::Vector3f& rclRes,
+                           FacetIndex& rulFacet) const;
     /**
      * Searches for the nearest facet to the ray defined by
      * (\a rclPt, \a rclDir).
@@ -142,6 +157,13 @@ public:
     bool IsVertexVisible(const Base::Vector3f& rcVertex,
                          const Base::Vector3f& rcView,
                          const MeshFacetGrid& rclGrid) const;
+    /**
+     * Checks from the viewpoint \a rcView if the vertex \a rcVertex is visible or it is hidden by a
+     * facet of the bounding volume hierarchy \a rclBVH.
+     */
+    bool IsVertexVisible(const Base::Vector3f& rcVertex,
+                         const Base::Vector3f& rcView,
+                         const MeshFacetBVH& rclBVH) const;
     /**
      * Calculates the average length of edges.
      */
@@ -566,6 +588,60 @@ private:
     std::vector<std::set<PointIndex>> _map;
 };
 
+/**
+ * The MeshPointAdjacency class gives read-only access to the neighbour points of all points
+ * like MeshRefPointToPoints does but stores them in a compressed sparse row layout: the sorted
+ * neighbours of a point are kept in a contiguous range of one single array. This needs only a
+ * fraction of the memory of a vector of sets, is built concurrently and is cheap to traverse
+ * from several threads.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshPointAdjacency
+{
+public:
+    /// Construction
+    explicit MeshPointAdjacency(const MeshKernel& rclM)
+        : _rclMesh(rclM)
+    {
+        Rebuild();
+    }
+
+    /// Rebuilds up data structure
+    void Rebuild();
+    /// Returns the number of points the structure was built for
+    std::size_t CountPoints() const
+    {
+        return _numFacets.size();
+    }
+    /// Returns the first neighbour of the point \a pos
+    const PointIndex* Begin(PointIndex pos) const
+    {
+        return _neighbours.data() + _offsets[pos];
+    }
+    /// Returns the position past the last neighbour of the point \a pos
+    const PointIndex* End(PointIndex pos) const
+    {
+        return _neighbours.data() + _offsets[pos + 1];
+    }
+    /// Returns the number of neighbour points of the point \a pos
+    std::size_t CountNeighbours(PointIndex pos) const
+    {
+        return _offsets[pos + 1] - _offsets[pos];
+    }
+    /// Returns the number of facets referencing the point \a pos
+    std::size_t CountFacets(PointIndex pos) const
+    {
+        return _numFacets[pos];
+    }
+
+private:
+    const MeshKernel& _rclMesh; /**< The mesh kernel. */
+    std::vector<std::size_t> _offsets;
+    std::vector<PointIndex> _neighbours;
+    std::vector<unsigned int> _numFacets;
+};
+
 /**
  * The MeshRefEdgeToFacets builds up a structure to have access to all facets
  * of an edge. On a manifold mesh an edge has one or two facets associated.
@@ -0,0 +1,688 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#endif
+
+#include <Base/Exception.h>
+
+#include "BVH.h"
+#include "Functional.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+constexpr std::size_t numBins = 16;
+constexpr std::size_t maxLeafSize = 4;
+// Ranges with more facets are reduced in parallel during the build
+constexpr std::size_t parallelThreshold = 1 << 16;
+// Beyond this depth the ranges are split in halves, so that the tree depth is at most 64 and
+// fits into the fixed traversal stacks
+constexpr std::size_t maxSahDepth = 32;
+constexpr std::size_t maxStackSize = 64;
+constexpr std::size_t packetSize = 8;
+
+float surfaceArea(const Base::BoundBox3f& box)
+{
+    float dx = box.LengthX();
+    float dy = box.LengthY();
+    float dz = box.LengthZ();
+    return 2.0F * (dx * dy + dy * dz + dz * dx);
+}
+
+float coord(const Base::Vector3f& v, int axis)
+{
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+struct RangeBounds
+{
+    Base::BoundBox3f box;
+    Base::BoundBox3f centroids;
+
+    void Add(const RangeBounds& other)
+    {
+        box.Add(other.box);
+        centroids.Add(other.centroids);
+    }
+};
+
+struct Bin
+{
+    Base::BoundBox3f box;
+    std::size_t count = 0;
+};
+
+}  // namespace
+
+struct MeshFacetBVH::Ray
+{
+    Base::Vector3f origin;
+    Base::Vector3f dir;
+    Base::Vector3f invDir;
+    float tmax;
+
+    Ray(const Base::Vector3f& pnt, const Base::Vector3f& d, float t)
+        : origin(pnt)
+        , dir(d)
+        , tmax(t)
+    {
+        // avoid NaNs in the slab test for axis-parallel rays
+        auto inv = [](float value) {
+            const float tiny = 1e-30F;
+            return 1.0F / (std::fabs(value) < tiny ? std::copysign(tiny, value) : value);
+        };
+        invDir.Set(inv(d.x), inv(d.y), inv(d.z));
+    }
+
+    // returns the entry distance into the box or infinity if it's missed
+    float Enter(const Node& node) const
+    {
+        float tx0 = (node.bmin[0] - origin.x) * invDir.x;
+        float tx1 = (node.bmax[0] - origin.x) * invDir.x;
+        float ty0 = (node.bmin[1] - origin.y) * invDir.y;
+        float ty1 = (node.bmax[1] - origin.y) * invDir.y;
+        float tz0 = (node.bmin[2] - origin.z) * invDir.z;
+        float tz1 = (node.bmax[2] - origin.z) * invDir.z;
+        float tnear = std::max({std::min(tx0, tx1), std::min(ty0, ty1), std::min(tz0, tz1), 0.0F});
+        float tfar = std::min({std::max(tx0, tx1), std::max(ty0, ty1), std::max(tz0, tz1), tmax});
+        return tnear <= tfar ? tnear : std::numeric_limits<float>::infinity();
+    }
+
+    // double-sided intersection with a triangle, returns the distance along the ray
+    bool Hit(const Triangle& tria, float& t) const
+    {
+        const float eps = 1e-06F;
+        Base::Vector3f e1 = tria.points[1] - tria.points[0];
+        Base::Vector3f e2 = tria.points[2] - tria.points[0];
+        Base::Vector3f p = dir % e2;
+        float det = e1 * p;
+        // the ray mustn't be parallel to the triangle
+        Base::Vector3f n = e1 % e2;
+        if (det * det <= eps * (n * n) * (dir * dir)) {
+            return false;
+        }
+
+        float inv = 1.0F / det;
+        Base::Vector3f s = origin - tria.points[0];
+        float u = (s * p) * inv;
+        if (u < 0.0F || u > 1.0F) {
+            return false;
+        }
+        Base::Vector3f q = s % e1;
+        float v = (dir * q) * inv;
+        if (v < 0.0F || u + v > 1.0F) {
+            return false;
+        }
+        t = (e2 * q) * inv;
+        return t >= 0.0F && t < tmax;
+    }
+};
+
+MeshFacetBVH::MeshFacetBVH(const MeshKernel& mesh)
+{
+    Rebuild(mesh);
+}
+
+MeshFacetBVH::MeshFacetBVH(const MeshKernel& mesh, const Base::Matrix4D& mat)
+{
+    Rebuild(mesh, &mat);
+}
+
+void MeshFacetBVH::Rebuild(const MeshKernel& mesh, const Base::Matrix4D* mat)
+{
+    nodes.clear();
+    triangles.clear();
+    facetIndices.clear();
+
+    const MeshPointArray& points = mesh.GetPoints();
+    const MeshFacetArray& facets = mesh.GetFacets();
+    const std::size_t numFacets = facets.size();
+    if (numFacets == 0) {
+        return;
+    }
+    if (numFacets > std::numeric_limits<std::uint32_t>::max()) {
+        throw Base::ValueError("Too many facets for a bounding volume hierarchy");
+    }
+
+    std::vector<Triangle> unsorted(numFacets);
+    std::vector<Base::BoundBox3f> boxes(numFacets);
+    parallel_for(numFacets, 0, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; i++) {
+            Triangle& tria = unsorted[i];
+            Base::BoundBox3f& box = boxes[i];
+            for (int j = 0; j < 3; j++) {
+                Base::Vector3f pnt = points[facets[i]._aulPoints[j]];
+                tria.points[j] = mat ? (*mat) * pnt : pnt;
+                box.Add(tria.points[j]);
+            }
+        }
+    });
+
+    Build(boxes);
+
+    triangles.resize(numFacets);
+    parallel_for(numFacets, 0, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; i++) {
+            triangles[i] = unsorted[facetIndices[i]];
+        }
+    });
+}
+
+void MeshFacetBVH::Build(std::vector<Base::BoundBox3f>& boxes)
+{
+    const std::size_t numFacets = boxes.size();
+    facetIndices.resize(numFacets);
+    std::iota(facetIndices.begin(), facetIndices.end(), FacetIndex(0));
+
+    std::vector<Base::Vector3f> centers(numFacets);
+    for (std::size_t i = 0; i < numFacets; i++) {
+        centers[i] = boxes[i].GetCenter();
+    }
+
+    // Applies func(begin, end, result) to sub-ranges of [first, last) and merges the results
+    auto reduce = [this](std::size_t first, std::size_t last, auto init, auto func, auto merge) {
+        std::size_t count = last - first;
+        if (count < parallelThreshold) {
+            func(first, last, init);
+            return init;
+        }
+
+        int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        std::vector<decltype(init)> partial(static_cast<std::size_t>(threads), init);
+        parallel_for(count, threads, [&](std::size_t begin, std::size_t end, std::size_t block) {
+            func(first + begin, first + end, partial[block]);
+        });
+        for (const auto& it : partial) {
+            merge(init, it);
+        }
+        return init;
+    };
+
+    struct Item
+    {
+        std::size_t begin;
+        std::size_t end;
+        std::size_t depth;
+        // index of the parent node if this is the second child
+        std::size_t parent;
+    };
+
+    const std::size_t noParent = std::numeric_limits<std::size_t>::max();
+    std::vector<Item> stack;
+    stack.push_back({0, numFacets, 0, noParent});
+    nodes.reserve(2 * numFacets / maxLeafSize + 1);
+
+    while (!stack.empty()) {
+        Item item = stack.back();
+        stack.pop_back();
+
+        const std::size_t index = nodes.size();
+        if (item.parent != noParent) {
+            nodes[item.parent].offset = static_cast<std::uint32_t>(index);
+        }
+
+        RangeBounds bounds = reduce(
+            item.begin,
+            item.end,
+            RangeBounds(),
+            [&](std::size_t begin, std::size_t end, RangeBounds& result) {
+                for (std::size_t i = begin; i < end; i++) {
+                    result.box.Add(boxes[facetIndices[i]]);
+                    result.centroids.Add(centers[facetIndices[i]]);
+                }
+            },
+            [](RangeBounds& result, const RangeBounds& other) {
+                result.Add(other);
+            });
+
+        Node node {};
+        node.bmin[0] = bounds.box.MinX;
+        node.bmin[1] = bounds.box.MinY;
+        node.bmin[2] = bounds.box.MinZ;
+        node.bmax[0] = bounds.box.MaxX;
+        node.bmax[1] = bounds.box.MaxY;
+        node.bmax[2] = bounds.box.MaxZ;
+
+        const std::size_t count = item.end - item.begin;
+        if (count <= maxLeafSize) {
+            node.offset = static_cast<std::uint32_t>(item.begin);
+            node.count = static_cast<std::uint32_t>(count);
+            nodes.push_back(node);
+            continue;
+        }
+        nodes.push_back(node);
+
+        // find the split with the lowest surface area heuristic over all axes
+        const Base::BoundBox3f& cbox = bounds.centroids;
+        const float cmin[3] = {cbox.MinX, cbox.MinY, cbox.MinZ};
+        const float extent[3] = {cbox.LengthX(), cbox.LengthY(), cbox.LengthZ()};
+        auto binOf = [&](const Base::Vector3f& center, int axis) {
+            auto bin = static_cast<std::size_t>((coord(center, axis) - cmin[axis]) * numBins
+                                                / extent[axis]);
+            return std::min(bin, numBins - 1);
+        };
+
+        int bestAxis = -1;
+        std::size_t bestSplit = 0;
+        float bestCost = std::numeric_limits<float>::max();
+        if (item.depth < maxSahDepth) {
+            using Bins = std::array<std::array<Bin, numBins>, 3>;
+            Bins bins = reduce(
+                item.begin,
+                item.end,
+                Bins(),
+                [&](std::size_t begin, std::size_t end, Bins& result) {
+                    for (std::size_t i = begin; i < end; i++) {
+                        FacetIndex facet = facetIndices[i];
+                        for (int axis = 0; axis < 3; axis++) {
+                            if (extent[axis] > 0.0F) {
+                                Bin& bin = result[axis][binOf(centers[facet], axis)];
+                                bin.box.Add(boxes[facet]);
+                                bin.count++;
+                            }
+                        }
+                    }
+                },
+                [](Bins& result, const Bins& other) {
+                    for (std::size_t axis = 0; axis < 3; axis++) {
+                        for (std::size_t i = 0; i < numBins; i++) {
+                            result[axis][i].box.Add(other[axis][i].box);
+                            result[axis][i].count += other[axis][i].count;
+                        }
+                    }
+                });
+
+            for (int axis = 0; axis < 3; axis++) {
+                if (extent[axis] <= 0.0F) {
+                    continue;
+                }
+
+                // areas and counts right of each split
+                std::array<float, numBins> rightArea {};
+                std::array<std::size_t, numBins> rightCount {};
+                Base::BoundBox3f box;
+                std::size_t num = 0;
+                for (std::size_t i = numBins - 1; i > 0; i--) {
+                    box.Add(bins[axis][i].box);
+                    num += bins[axis][i].count;
+                    rightArea[i] = num > 0 ? surfaceArea(box) : 0.0F;
+                    rightCount[i] = num;
+                }
+
+                box = Base::BoundBox3f();
+                num = 0;
+                for (std::size_t i = 0; i + 1 < numBins; i++) {
+                    box.Add(bins[axis][i].box);
+                    num += bins[axis][i].count;
+                    if (num == 0 || rightCount[i + 1] == 0) {
+                        continue;
+                    }
+                    float cost = surfaceArea(box) * float(num)
+                        + rightArea[i + 1] * float(rightCount[i + 1]);
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestSplit = i;
+                    }
+                }
+            }
+        }
+
+        auto first = facetIndices.begin() + static_cast<std::ptrdiff_t>(item.begin);
+        auto last = facetIndices.begin() + static_cast<std::ptrdiff_t>(item.end);
+        std::size_t mid {};
+        if (bestAxis >= 0) {
+            auto it = std::partition(first, last, [&](FacetIndex facet) {
+                return binOf(centers[facet], bestAxis) <= bestSplit;
+            });
+            mid = item.begin + static_cast<std::size_t>(it - first);
+        }
+        else {
+            // all centroids coincide or the tree is too deep: split in halves along the longest
+            // axis of the centroids
+            int axis = 0;
+            if (extent[1] > extent[axis]) {
+                axis = 1;
+            }
+            if (extent[2] > extent[axis]) {
+                axis = 2;
+            }
+            mid = item.begin + count / 2;
+            std::nth_element(first,
+                             facetIndices.begin() + static_cast<std::ptrdiff_t>(mid),
+                             last,
+                             [&](FacetIndex lhs, FacetIndex rhs) {
+                                 return coord(centers[lhs], axis) < coord(centers[rhs], axis);
+                             });
+        }
+
+        // the first child directly follows its parent
+        stack.push_back({mid, item.end, item.depth + 1, index});
+        stack.push_back({item.begin, mid, item.depth + 1, noParent});
+    }
+}
+
+Base::BoundBox3f MeshFacetBVH::GetBoundBox() const
+{
+    if (nodes.empty()) {
+        return Base::BoundBox3f();
+    }
+
+    const Node& root = nodes.front();
+    return Base::BoundBox3f(root.bmin[0],
+                            root.bmin[1],
+                            root.bmin[2],
+                            root.bmax[0],
+                            root.bmax[1],
+                            root.bmax[2]);
+}
+
+bool MeshFacetBVH::IntersectRay(const Ray& ray, float& dist, std::uint32_t& triangle) const
+{
+    if (nodes.empty()) {
+        return false;
+    }
+
+    std::array<std::pair<std::uint32_t, float>, maxStackSize> stack;
+    std::size_t size = 0;
+    stack[size++] = {0, 0.0F};
+
+    Ray test(ray);
+    bool hit = false;
+    while (size > 0) {
+        auto [index, tnear] = stack[--size];
+        if (tnear >= test.tmax) {
+            continue;
+        }
+
+        const Node& node = nodes[index];
+        if (node.count > 0) {
+            for (std::uint32_t i = node.offset; i < node.offset + node.count; i++) {
+                float t {};
+                if (test.Hit(triangles[i], t)) {
+                    test.tmax = t;
+                    triangle = i;
+                    hit = true;
+                }
+            }
+            continue;
+        }
+
+        // visit the nearer child first
+        std::uint32_t child1 = index + 1;
+        std::uint32_t child2 = node.offset;
+        float t1 = test.Enter(nodes[child1]);
+        float t2 = test.Enter(nodes[child2]);
+        if (t2 < t1) {
+            std::swap(child1, child2);
+            std::swap(t1, t2);
+        }
+        if (t2 < test.tmax) {
+            stack[size++] = {child2, t2};
+        }
+        if (t1 < test.tmax) {
+            stack[size++] = {child1, t1};
+        }
+    }
+
+    dist = test.tmax;
+    return hit;
+}
+
+bool MeshFacetBVH::NearestFacetOnRay(const Base::Vector3f& pnt,
+                                     const Base::Vector3f& dir,
+                                     Base::Vector3f& res,
+                                     FacetIndex& facet) const
+{
+    Ray ray(pnt, dir, std::numeric_limits<float>::max());
+    float dist {};
+    std::uint32_t triangle {};
+    if (IntersectRay(ray, dist, triangle)) {
+        res = pnt + dist * dir;
+        facet = facetIndices[triangle];
+        return true;
+    }
+
+    return false;
+}
+
+void MeshFacetBVH::NearestFacetsOnRays(const std::vector<Base::Vector3f>& pnts,
+                                       const std::vector<Base::Vector3f>& dirs,
+                                       std::vector<Base::Vector3f>& res,
+                                       std::vector<FacetIndex>& facets,
+                                       int threads) const
+{
+    const std::size_t numRays = std::min(pnts.size(), dirs.size());
+    res.resize(numRays);
+    facets.assign(numRays, FACET_INDEX_MAX);
+    if (nodes.empty()) {
+        return;
+    }
+
+    const std::size_t numPackets = (numRays + packetSize - 1) / packetSize;
+    parallel_for(numPackets, threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+        std::vector<Ray> rays;
+        rays.reserve(packetSize);
+        std::array<std::uint32_t, packetSize> hits {};
+        for (std::size_t packet = begin; packet < end; packet++) {
+            const std::size_t first = packet * packetSize;
+            const std::size_t last = std::min(first + packetSize, numRays);
+            rays.clear();
+            for (std::size_t i = first; i < last; i++) {
+                rays.emplace_back(pnts[i], dirs[i], std::numeric_limits<float>::max());
+            }
+            hits.fill(std::numeric_limits<std::uint32_t>::max());
+
+            // a node is entered as long as one of the rays of the packet hits its box
+            std::array<std::uint32_t, maxStackSize> stack {};
+            std::size_t size = 0;
+            stack[size++] = 0;
+            while (size > 0) {
+                const std::uint32_t index = stack[--size];
+                const Node& node = nodes[index];
+                if (node.count > 0) {
+                    for (std::size_t r = 0; r < rays.size(); r++) {
+                        for (std::uint32_t i = node.offset; i < node.offset + node.count; i++) {
+                            float t {};
+                            if (rays[r].Hit(triangles[i], t)) {
+                                rays[r].tmax = t;
+                                hits[r] = i;
+                            }
+                        }
+                    }
+                    continue;
+                }
+
+                // order the children by the entry distance of the first ray that hits them
+                std::uint32_t child1 = index + 1;
+                std::uint32_t child2 = node.offset;
+                float t1 = std::numeric_limits<float>::infinity();
+                float t2 = std::numeric_limits<float>::infinity();
+                for (const Ray& ray : rays) {
+                    t1 = std::min(t1, ray.Enter(nodes[child1]));
+                    t2 = std::min(t2, ray.Enter(nodes[child2]));
+                }
+                if (t2 < t1) {
+                    std::swap(child1, child2);
+                    std::swap(t1, t2);
+                }
+                if (t2 < std::numeric_limits<float>::infinity()) {
+                    stack[size++] = child2;
+                }
+                if (t1 < std::numeric_limits<float>::infinity()) {
+                    stack[size++] = child1;
+                }
+            }
+
+            for (std::size_t r = 0; r < rays.size(); r++) {
+                if (hits[r] != std::numeric_limits<std::uint32_t>::max()) {
+                    res[first + r] = rays[r].origin + rays[r].tmax * rays[r].dir;
+                    facets[first + r] = facetIndices[hits[r]];
+                }
+            }
+        }
+    });
+}
+
+bool MeshFacetBVH::IsSegmentBlocked(const Base::Vector3f& pnt1,
+                                    const Base::Vector3f& pnt2,
+                                    float tolerance) const
+{
+    Base::Vector3f dir = pnt2 - pnt1;
+    float length = dir.Length();
+    if (length <= tolerance) {
+        return false;
+    }
+
+    dir /= length;
+    Ray ray(pnt1, dir, length - tolerance);
+    float dist {};
+    std::uint32_t triangle {};
+    return IntersectRay(ray, dist, triangle);
+}
+
+FacetIndex MeshFacetBVH::NearestFacet(const Base::Vector3f& pnt, Base::Vector3f& res) const
+{
+    return NearestFacet(pnt, std::numeric_limits<float>::max(), res);
+}
+
+FacetIndex
+MeshFacetBVH::NearestFacet(const Base::Vector3f& pnt, float maxDist, Base::Vector3f& res) const
+{
+    auto boxDistance2 = [&pnt](const Node& node) {
+        float dx = std::max({node.bmin[0] - pnt.x, 0.0F, pnt.x - node.bmax[0]});
+        float dy = std::max({node.bmin[1] - pnt.y, 0.0F, pnt.y - node.bmax[1]});
+        float dz = std::max({node.bmin[2] - pnt.z, 0.0F, pnt.z - node.bmax[2]});
+        return dx * dx + dy * dy + dz * dz;
+    };
+
+    FacetIndex facet = FACET_INDEX_MAX;
+    if (nodes.empty()) {
+        return facet;
+    }
+
+    float best = maxDist < std::sqrt(std::numeric_limits<float>::max())
+        ? maxDist * maxDist
+        : std::numeric_limits<float>::max();
+    std::array<std::pair<std::uint32_t, float>, maxStackSize> stack;
+    std::size_t size = 0;
+    stack[size++] = {0, boxDistance2(nodes.front())};
+
+    while (size > 0) {
+        auto [index, dist2] = stack[--size];
+        if (dist2 > best) {
+            continue;
+        }
+
+        const Node& node = nodes[index];
+        if (node.count > 0) {
+            for (std::uint32_t i = node.offset; i < node.offset + node.count; i++) {
+                const Triangle& tria = triangles[i];
+                MeshGeomFacet geom(tria.points[0], tria.points[1], tria.points[2]);
+                Base::Vector3f closest;
+                float dist = geom.DistanceToPoint(pnt, closest);
+                if (dist * dist <= best) {
+                    best = dist * dist;
+                    res = closest;
+                    facet = facetIndices[i];
+                }
+            }
+            continue;
+        }
+
+        std::uint32_t child1 = index + 1;
+        std::uint32_t child2 = node.offset;
+        float d1 = boxDistance2(nodes[child1]);
+        float d2 = boxDistance2(nodes[child2]);
+        if (d2 < d1) {
+            std::swap(child1, child2);
+            std::swap(d1, d2);
+        }
+        if (d2 <= best) {
+            stack[size++] = {child2, d2};
+        }
+        if (d1 <= best) {
+            stack[size++] = {child1, d1};
+        }
+    }
+
+    return facet;
+}
+
+void MeshFacetBVH::FacetsInBox(const Base::BoundBox3f& box, std::vector<FacetIndex>& facets) const
+{
+    auto overlaps = [&box](const float* bmin, const float* bmax) {
+        return bmin[0] <= box.MaxX && bmax[0] >= box.MinX && bmin[1] <= box.MaxY
+            && bmax[1] >= box.MinY && bmin[2] <= box.MaxZ && bmax[2] >= box.MinZ;
+    };
+
+    if (nodes.empty() || !overlaps(nodes.front().bmin, nodes.front().bmax)) {
+        return;
+    }
+
+    std::array<std::uint32_t, maxStackSize> stack;
+    std::size_t size = 0;
+    stack[size++] = 0;
+
+    while (size > 0) {
+        const Node& node = nodes[stack[--size]];
+        if (node.count > 0) {
+            for (std::uint32_t i = node.offset; i < node.offset + node.count; i++) {
+                const Triangle& tria = triangles[i];
+                float bmin[3], bmax[3];
+                for (int k = 0; k < 3; k++) {
+                    bmin[k] = std::min({coord(tria.points[0], k),
+                                        coord(tria.points[1], k),
+                                        coord(tria.points[2], k)});
+                    bmax[k] = std::max({coord(tria.points[0], k),
+                                        coord(tria.points[1], k),
+                                        coord(tria.points[2], k)});
+                }
+                if (overlaps(bmin, bmax)) {
+                    facets.push_back(facetIndices[i]);
+                }
+            }
+            continue;
+        }
+
+        std::uint32_t child1 = std::uint32_t(&node - nodes.data()) + 1;
+        std::uint32_t child2 = node.offset;
+        if (overlaps(nodes[child2].bmin, nodes[child2].bmax)) {
+            stack[size++] = child2;
+        }
+        if (overlaps(nodes[child1].bmin, nodes[child1].bmax)) {
+            stack[size++] = child1;
+        }
+    }
+}
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#ifndef MESH_BVH_H
+#define MESH_BVH_H
+
+#include <cstdint>
+#include <vector>
+
+#include <Base/Matrix.h>
+
+#include "Elements.h"
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * Bounding volume hierarchy over the facets of a mesh.
+ * The tree is built with the surface area heuristic which, unlike MeshFacetGrid, adapts to meshes
+ * with very different facet sizes. The nodes are stored depth-first in a flat array and the
+ * facets are copied in leaf order, so queries only touch contiguous memory and don't need the
+ * mesh kernel. The structure is read-only after construction and can be queried concurrently.
+ * \code
+ * MeshFacetBVH bvh(kernel);
+ * Base::Vector3f hit;
+ * FacetIndex facet;
+ * if (bvh.NearestFacetOnRay(pnt, dir, hit, facet)) {
+ *   ...
+ * }
+ * \endcode
+ */
+class MeshExport MeshFacetBVH
+{
+public:
+    MeshFacetBVH() = default;
+    /// Builds the hierarchy for all facets of the mesh.
+    explicit MeshFacetBVH(const MeshKernel& mesh);
+    /// Builds the hierarchy for the facets of the mesh transformed by \a mat.
+    MeshFacetBVH(const MeshKernel& mesh, const Base::Matrix4D& mat);
+
+    /// Rebuilds the hierarchy. If \a mat is given the facets are transformed.
+    void Rebuild(const MeshKernel& mesh, const Base::Matrix4D* mat = nullptr);
+    bool IsEmpty() const
+    {
+        return nodes.empty();
+    }
+    std::size_t CountNodes() const
+    {
+        return nodes.size();
+    }
+    Base::BoundBox3f GetBoundBox() const;
+
+    /** @name Ray queries */
+    //@{
+    /**
+     * Searches for the facet nearest to \a pnt that is hit by the ray starting at \a pnt in
+     * direction \a dir. \a res is the intersection point and \a facet the index of the facet.
+     * Returns false if no facet is hit.
+     */
+    bool NearestFacetOnRay(const Base::Vector3f& pnt,
+                           const Base::Vector3f& dir,
+                           Base::Vector3f& res,
+                           FacetIndex& facet) const;
+    /**
+     * Performs NearestFacetOnRay() for many rays. Adjacent rays are traversed as packets which
+     * share the node tests, so neighbouring rays should be coherent, e.g. from a view or a grid.
+     * The packets are processed in parallel with \a threads threads, or the number of hardware
+     * threads if \a threads is less than one. \a facets is set to FACET_INDEX_MAX for rays that
+     * don't hit the mesh.
+     */
+    void NearestFacetsOnRays(const std::vector<Base::Vector3f>& pnts,
+                             const std::vector<Base::Vector3f>& dirs,
+                             std::vector<Base::Vector3f>& res,
+                             std::vector<FacetIndex>& facets,
+                             int threads = 0) const;
+    /**
+     * Checks if a facet is hit by the segment from \a pnt1 to \a pnt2. Facets closer than
+     * \a tolerance to \a pnt2 are ignored.
+     */
+    bool IsSegmentBlocked(const Base::Vector3f& pnt1,
+                          const Base::Vector3f& pnt2,
+                          float tolerance) const;
+    //@}
+
+    /** @name Distance queries */
+    //@{
+    /**
+     * Searches for the facet with the smallest distance to \a pnt. Only facets closer than
+     * \a maxDist are considered. \a res is the closest point on the facet.
+     * Returns FACET_INDEX_MAX if no such facet exists.
+     */
+    FacetIndex NearestFacet(const Base::Vector3f& pnt, float maxDist, Base::Vector3f& res) const;
+    /// Same as above without a distance limit.
+    FacetIndex NearestFacet(const Base::Vector3f& pnt, Base::Vector3f& res) const;
+    //@}
+
+    /** @name Box queries */
+    //@{
+    /// Appends the indices of all facets whose bounding box overlaps \a box to \a facets.
+    void FacetsInBox(const Base::BoundBox3f& box, std::vector<FacetIndex>& facets) const;
+    //@}
+
+private:
+    struct Node
+    {
+        float bmin[3];
+        float bmax[3];
+        // first facet of a leaf or index of the second child of an inner node
+        std::uint32_t offset;
+        // number of facets of a leaf, 0 for inner nodes
+        std::uint32_t count;
+    };
+
+    struct Triangle
+    {
+        Base::Vector3f points[3];
+    };
+
+    struct Ray;
+    void Build(std::vector<Base::BoundBox3f>& boxes);
+    bool IntersectRay(const Ray& ray, float& dist, std::uint32_t& triangle) const;
+
+private:
+    std::vector<Node> nodes;
+    std::vector<Triangle> triangles;
+    std::vector<FacetIndex> facetIndices;
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_BVH_H
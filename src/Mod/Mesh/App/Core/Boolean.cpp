@@ -0,0 +1,1319 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <numeric>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#endif
+
+#include <Base/Vector3D.h>
+
+#include "BVH.h"
+#include "Boolean.h"
+#include "Functional.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+using Point3 = Base::Vector3d;
+
+struct Point2
+{
+    double x, y;
+};
+
+// ------------------------------------------------------------------------------------------
+// Robust predicates
+//
+// The orientation tests evaluate the determinant in double precision and use the static error
+// bounds of Shewchuk's predicates. Only if the sign is uncertain the determinant is computed
+// exactly with floating-point expansions, i.e. sums of non-overlapping doubles of increasing
+// magnitude.
+
+using Expansion = std::vector<double>;
+
+constexpr double epsilon = std::numeric_limits<double>::epsilon() / 2.0;
+constexpr double orient2dBound = (3.0 + 16.0 * epsilon) * epsilon;
+constexpr double orient3dBound = (7.0 + 56.0 * epsilon) * epsilon;
+
+void twoSum(double a, double b, double& sum, double& err)
+{
+    sum = a + b;
+    double bv = sum - a;
+    double av = sum - bv;
+    err = (a - av) + (b - bv);
+}
+
+void twoProduct(double a, double b, double& prod, double& err)
+{
+    prod = a * b;
+    err = std::fma(a, b, -prod);
+}
+
+// Adds b to the expansion e and removes zero components
+Expansion grow(const Expansion& e, double b)
+{
+    Expansion h;
+    h.reserve(e.size() + 1);
+    double q = b;
+    for (double c : e) {
+        double sum {};
+        double err {};
+        twoSum(q, c, sum, err);
+        if (err != 0.0) {
+            h.push_back(err);
+        }
+        q = sum;
+    }
+    if (q != 0.0 || h.empty()) {
+        h.push_back(q);
+    }
+    return h;
+}
+
+Expansion add(Expansion e, const Expansion& f)
+{
+    for (double c : f) {
+        e = grow(e, c);
+    }
+    return e;
+}
+
+Expansion subtract(Expansion e, const Expansion& f)
+{
+    for (double c : f) {
+        e = grow(e, -c);
+    }
+    return e;
+}
+
+Expansion multiply(const Expansion& e, const Expansion& f)
+{
+    Expansion h;
+    for (double a : e) {
+        for (double b : f) {
+            double prod {};
+            double err {};
+            twoProduct(a, b, prod, err);
+            h = grow(grow(h, err), prod);
+        }
+    }
+    return h;
+}
+
+Expansion difference(double a, double b)
+{
+    double diff {};
+    double err {};
+    twoSum(a, -b, diff, err);
+    return err != 0.0 ? Expansion {err, diff} : Expansion {diff};
+}
+
+// The sign of an expansion is the sign of its largest component
+int sign(const Expansion& e)
+{
+    double value = e.empty() ? 0.0 : e.back();
+    return (value > 0.0) - (value < 0.0);
+}
+
+// Returns 1 if c lies left of the line from a to b, -1 if it lies right and 0 if it lies on it
+int orient2d(const Point2& a, const Point2& b, const Point2& c)
+{
+    double detleft = (a.x - c.x) * (b.y - c.y);
+    double detright = (a.y - c.y) * (b.x - c.x);
+    double det = detleft - detright;
+    double bound = orient2dBound * (std::fabs(detleft) + std::fabs(detright));
+    if (det > bound) {
+        return 1;
+    }
+    if (-det > bound) {
+        return -1;
+    }
+
+    Expansion left = multiply(difference(a.x, c.x), difference(b.y, c.y));
+    Expansion right = multiply(difference(a.y, c.y), difference(b.x, c.x));
+    return sign(subtract(left, right));
+}
+
+// Returns the sign of the determinant of (a-d, b-d, c-d) which is positive if d lies below the
+// plane through a, b and c, seen from the side where they appear counterclockwise
+int orient3d(const Point3& a, const Point3& b, const Point3& c, const Point3& d)
+{
+    double adx = a.x - d.x;
+    double ady = a.y - d.y;
+    double adz = a.z - d.z;
+    double bdx = b.x - d.x;
+    double bdy = b.y - d.y;
+    double bdz = b.z - d.z;
+    double cdx = c.x - d.x;
+    double cdy = c.y - d.y;
+    double cdz = c.z - d.z;
+
+    double bdxcdy = bdx * cdy;
+    double cdxbdy = cdx * bdy;
+    double cdxady = cdx * ady;
+    double adxcdy = adx * cdy;
+    double adxbdy = adx * bdy;
+    double bdxady = bdx * ady;
+
+    double det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+    double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * std::fabs(adz)
+        + (std::fabs(cdxady) + std::fabs(adxcdy)) * std::fabs(bdz)
+        + (std::fabs(adxbdy) + std::fabs(bdxady)) * std::fabs(cdz);
+    double bound = orient3dBound * permanent;
+    if (det > bound) {
+        return 1;
+    }
+    if (-det > bound) {
+        return -1;
+    }
+
+    Expansion eadx = difference(a.x, d.x);
+    Expansion eady = difference(a.y, d.y);
+    Expansion eadz = difference(a.z, d.z);
+    Expansion ebdx = difference(b.x, d.x);
+    Expansion ebdy = difference(b.y, d.y);
+    Expansion ebdz = difference(b.z, d.z);
+    Expansion ecdx = difference(c.x, d.x);
+    Expansion ecdy = difference(c.y, d.y);
+    Expansion ecdz = difference(c.z, d.z);
+
+    Expansion abc = multiply(eadz, subtract(multiply(ebdx, ecdy), multiply(ecdx, ebdy)));
+    Expansion bca = multiply(ebdz, subtract(multiply(ecdx, eady), multiply(eadx, ecdy)));
+    Expansion cab = multiply(ecdz, subtract(multiply(eadx, ebdy), multiply(ebdx, eady)));
+    return sign(add(add(abc, bca), cab));
+}
+
+// Returns true if d lies clearly inside the circumcircle of the counterclockwise triangle a, b, c.
+// This is only used to improve the shape of the triangles, so it doesn't need to be exact.
+bool inCircle(const Point2& a, const Point2& b, const Point2& c, const Point2& d)
+{
+    double adx = a.x - d.x;
+    double ady = a.y - d.y;
+    double bdx = b.x - d.x;
+    double bdy = b.y - d.y;
+    double cdx = c.x - d.x;
+    double cdy = c.y - d.y;
+
+    double alift = adx * adx + ady * ady;
+    double blift = bdx * bdx + bdy * bdy;
+    double clift = cdx * cdx + cdy * cdy;
+    double t1 = alift * (bdx * cdy - cdx * bdy);
+    double t2 = blift * (cdx * ady - adx * cdy);
+    double t3 = clift * (adx * bdy - bdx * ady);
+    double permanent = std::fabs(t1) + std::fabs(t2) + std::fabs(t3);
+    return t1 + t2 + t3 > 1e-12 * permanent;
+}
+
+bool samePoint(const Point3& p, const Point3& q)
+{
+    return p.x == q.x && p.y == q.y && p.z == q.z;
+}
+
+template<class Prec>
+struct PointHash
+{
+    std::size_t operator()(const Base::Vector3<Prec>& p) const
+    {
+        std::hash<Prec> hash;
+        std::size_t h = hash(p.x);
+        h ^= hash(p.y) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        h ^= hash(p.z) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        return h;
+    }
+};
+
+template<class Prec>
+struct PointEqual
+{
+    bool operator()(const Base::Vector3<Prec>& p, const Base::Vector3<Prec>& q) const
+    {
+        return p.x == q.x && p.y == q.y && p.z == q.z;
+    }
+};
+
+// ------------------------------------------------------------------------------------------
+// Facet intersection
+
+struct Facet3
+{
+    Point3 pnt[3];
+    PointIndex index[3];
+};
+
+Facet3 getFacet(const MeshKernel& mesh, FacetIndex index)
+{
+    const MeshFacet& facet = mesh.GetFacets()[index];
+    const MeshPointArray& points = mesh.GetPoints();
+    Facet3 f;
+    for (int i = 0; i < 3; i++) {
+        const MeshPoint& p = points[facet._aulPoints[i]];
+        f.pnt[i] = Point3(p.x, p.y, p.z);
+        f.index[i] = facet._aulPoints[i];
+    }
+    return f;
+}
+
+// An intersection point of two facets. For each of the facets it stores the index of the edge
+// the point lies on or -1 if it lies inside.
+struct CutPoint
+{
+    Point3 pnt;
+    int edge[2];
+};
+
+// The intersection segment of a facet of the first and a facet of the second mesh
+struct Segment
+{
+    FacetIndex facet[2];
+    CutPoint points[2];
+};
+
+bool onOneSide(const int signs[3])
+{
+    return (signs[0] > 0 && signs[1] > 0 && signs[2] > 0)
+        || (signs[0] < 0 && signs[1] < 0 && signs[2] < 0);
+}
+
+bool allZero(const int signs[3])
+{
+    return signs[0] == 0 && signs[1] == 0 && signs[2] == 0;
+}
+
+// Intersects the edges of the facet f with the facet other. signs are the orientations of the
+// corners of f to the plane of other.
+template<class Func>
+void crossEdges(const Facet3& f, const int signs[3], const Facet3& other, Func addPoint)
+{
+    for (int k = 0; k < 3; k++) {
+        int i = k;
+        int j = (k + 1) % 3;
+        if (signs[i] * signs[j] > 0 || (signs[i] == 0 && signs[j] == 0)) {
+            continue;
+        }
+
+        // both facets of an edge must compute exactly the same point, so the direction of the
+        // edge doesn't depend on the facet
+        if (f.index[j] < f.index[i]) {
+            std::swap(i, j);
+        }
+
+        const Point3& p = f.pnt[i];
+        const Point3& q = f.pnt[j];
+        int o0 = orient3d(p, q, other.pnt[0], other.pnt[1]);
+        int o1 = orient3d(p, q, other.pnt[1], other.pnt[2]);
+        int o2 = orient3d(p, q, other.pnt[2], other.pnt[0]);
+        bool inside = (o0 >= 0 && o1 >= 0 && o2 >= 0) || (o0 <= 0 && o1 <= 0 && o2 <= 0);
+        if (!inside) {
+            continue;
+        }
+
+        if (signs[i] == 0) {
+            addPoint(p, k);
+        }
+        else if (signs[j] == 0) {
+            addPoint(q, k);
+        }
+        else {
+            Point3 normal = (other.pnt[1] - other.pnt[0]) % (other.pnt[2] - other.pnt[0]);
+            double dp = normal * (p - other.pnt[0]);
+            double dq = normal * (q - other.pnt[0]);
+            double t = std::clamp(dp / (dp - dq), 0.0, 1.0);
+            addPoint(p + (q - p) * t, k);
+        }
+    }
+}
+
+bool intersectFacets(const Facet3& f1, const Facet3& f2, Segment& seg)
+{
+    int signs1[3];
+    for (int i = 0; i < 3; i++) {
+        signs1[i] = orient3d(f2.pnt[0], f2.pnt[1], f2.pnt[2], f1.pnt[i]);
+    }
+    // coplanar facets are not handled
+    if (onOneSide(signs1) || allZero(signs1)) {
+        return false;
+    }
+
+    int signs2[3];
+    for (int i = 0; i < 3; i++) {
+        signs2[i] = orient3d(f1.pnt[0], f1.pnt[1], f1.pnt[2], f2.pnt[i]);
+    }
+    if (onOneSide(signs2) || allZero(signs2)) {
+        return false;
+    }
+
+    std::array<CutPoint, 6> points;
+    int count = 0;
+    auto addPoint = [&](const Point3& pnt, int side, int edge) {
+        for (int i = 0; i < count; i++) {
+            if (samePoint(points[i].pnt, pnt)) {
+                if (points[i].edge[side] < 0) {
+                    points[i].edge[side] = edge;
+                }
+                return;
+            }
+        }
+        CutPoint& cut = points[count++];
+        cut.pnt = pnt;
+        cut.edge[side] = edge;
+        cut.edge[1 - side] = -1;
+    };
+
+    crossEdges(f1, signs1, f2, [&](const Point3& pnt, int edge) {
+        addPoint(pnt, 0, edge);
+    });
+    crossEdges(f2, signs2, f1, [&](const Point3& pnt, int edge) {
+        addPoint(pnt, 1, edge);
+    });
+
+    if (count < 2) {
+        return false;
+    }
+
+    // in degenerate cases more than two points are found, then use the outermost ones
+    int first = 0;
+    int second = 1;
+    double maxDist = Base::DistanceP2(points[0].pnt, points[1].pnt);
+    for (int i = 0; i < count; i++) {
+        for (int j = i + 1; j < count; j++) {
+            double dist = Base::DistanceP2(points[i].pnt, points[j].pnt);
+            if (dist > maxDist) {
+                maxDist = dist;
+                first = i;
+                second = j;
+            }
+        }
+    }
+
+    seg.points[0] = points[first];
+    seg.points[1] = points[second];
+    return true;
+}
+
+std::vector<Segment> intersectMeshes(const MeshKernel& mesh1,
+                                     const MeshKernel& mesh2,
+                                     const MeshFacetBVH& bvh,
+                                     int threads)
+{
+    std::size_t count = mesh1.CountFacets();
+
+    // the facets are handed out in chunks because their costs vary a lot
+    const std::size_t chunkSize = 1024;
+    std::atomic<std::size_t> next {0};
+    std::vector<std::vector<Segment>> blockSegments(threads);
+    parallel_for(threads, threads, [&](std::size_t, std::size_t, std::size_t block) {
+        std::vector<FacetIndex> candidates;
+        std::size_t begin {};
+        while ((begin = next.fetch_add(chunkSize)) < count) {
+            std::size_t end = std::min(begin + chunkSize, count);
+            for (std::size_t i = begin; i < end; i++) {
+                candidates.clear();
+                bvh.FacetsInBox(mesh1.GetFacet(i).GetBoundBox(), candidates);
+                if (candidates.empty()) {
+                    continue;
+                }
+
+                Facet3 f1 = getFacet(mesh1, i);
+                for (FacetIndex j : candidates) {
+                    Segment seg;
+                    if (intersectFacets(f1, getFacet(mesh2, j), seg)) {
+                        seg.facet[0] = i;
+                        seg.facet[1] = j;
+                        blockSegments[block].push_back(seg);
+                    }
+                }
+            }
+        }
+    });
+
+    std::vector<Segment> segments;
+    for (auto& it : blockSegments) {
+        segments.insert(segments.end(), it.begin(), it.end());
+    }
+
+    // make the result independent of the scheduling
+    std::sort(segments.begin(), segments.end(), [](const Segment& s1, const Segment& s2) {
+        return std::make_pair(s1.facet[0], s1.facet[1])
+            < std::make_pair(s2.facet[0], s2.facet[1]);
+    });
+    return segments;
+}
+
+// ------------------------------------------------------------------------------------------
+// Re-triangulation of a cut facet
+
+/*
+ * Triangulates a facet together with the intersection points inside or on the border of it.
+ * The points are inserted into a Delaunay triangulation of the projected facet and then the
+ * intersection segments are enforced by edge flips (Sloan's algorithm). The triangles have
+ * the orientation of the facet.
+ */
+class FacetTriangulator
+{
+public:
+    explicit FacetTriangulator(const Point3 (&corners)[3])
+    {
+        Point3 normal = (corners[1] - corners[0]) % (corners[2] - corners[0]);
+        double nx = std::fabs(normal.x);
+        double ny = std::fabs(normal.y);
+        double nz = std::fabs(normal.z);
+        int axis = (nx >= ny && nx >= nz) ? 0 : (ny >= nz ? 1 : 2);
+
+        // project onto the coordinate plane that keeps the orientation of the facet
+        axisU = (axis + 1) % 3;
+        axisV = (axis + 2) % 3;
+        if (normal[axis] < 0.0) {
+            std::swap(axisU, axisV);
+        }
+
+        for (const auto& it : corners) {
+            AddPoint(it, -1);
+        }
+    }
+
+    // Adds a point that lies on the edge of the facet or inside if edge is -1
+    int AddPoint(const Point3& pnt, int edge)
+    {
+        auto it = indices.find(pnt);
+        if (it != indices.end()) {
+            if (edgeOf[it->second] < 0) {
+                edgeOf[it->second] = edge;
+            }
+            return it->second;
+        }
+
+        int index = static_cast<int>(points.size());
+        indices[pnt] = index;
+        points.push_back(pnt);
+        projected.push_back(Point2 {pnt[axisU], pnt[axisV]});
+        edgeOf.push_back(edge);
+        alias.push_back(index);
+        return index;
+    }
+
+    void AddConstraint(int p, int q)
+    {
+        constraints.emplace_back(p, q);
+    }
+
+    // Returns false if not all constraints could be enforced
+    bool Compute()
+    {
+        addTriangle(0, 1, 2);
+        if (orient(0, 1, 2) <= 0) {
+            // degenerated facet
+            return true;
+        }
+
+        insertEdgePoints();
+        for (int i = 3; i < static_cast<int>(points.size()); i++) {
+            if (edgeOf[i] < 0) {
+                insertPoint(i);
+            }
+        }
+        bool success = true;
+        for (const auto& it : constraints) {
+            if (!recoverEdge(alias[it.first], alias[it.second])) {
+                success = false;
+            }
+        }
+        return success;
+    }
+
+    const std::vector<Point3>& GetPoints() const
+    {
+        return points;
+    }
+
+    const std::vector<std::array<int, 3>>& GetTriangles() const
+    {
+        return triangles;
+    }
+
+    // Returns the edges that are part of the intersection curves
+    const std::vector<std::pair<int, int>>& GetCurveEdges() const
+    {
+        return curve;
+    }
+
+private:
+    static std::uint64_t edgeKey(int a, int b)
+    {
+        return (std::uint64_t(std::uint32_t(a)) << 32) | std::uint32_t(b);
+    }
+
+    int orient(int a, int b, int c) const
+    {
+        return orient2d(projected[a], projected[b], projected[c]);
+    }
+
+    // Returns the triangle with the directed edge from a to b or -1
+    int findEdge(int a, int b) const
+    {
+        auto it = edges.find(edgeKey(a, b));
+        return it != edges.end() ? it->second : -1;
+    }
+
+    bool isFixed(int a, int b) const
+    {
+        return fixed.find(edgeKey(std::min(a, b), std::max(a, b))) != fixed.end();
+    }
+
+    void removeEdges(int t)
+    {
+        const auto& tria = triangles[t];
+        for (int i = 0; i < 3; i++) {
+            auto it = edges.find(edgeKey(tria[i], tria[(i + 1) % 3]));
+            if (it != edges.end() && it->second == t) {
+                edges.erase(it);
+            }
+        }
+    }
+
+    void addEdges(int t)
+    {
+        const auto& tria = triangles[t];
+        for (int i = 0; i < 3; i++) {
+            edges[edgeKey(tria[i], tria[(i + 1) % 3])] = t;
+        }
+    }
+
+    int addTriangle(int a, int b, int c)
+    {
+        int t = static_cast<int>(triangles.size());
+        triangles.push_back({a, b, c});
+        addEdges(t);
+        return t;
+    }
+
+    void setTriangle(int t, int a, int b, int c)
+    {
+        removeEdges(t);
+        triangles[t] = {a, b, c};
+        addEdges(t);
+    }
+
+    static int thirdPoint(const std::array<int, 3>& tria, int a, int b)
+    {
+        for (int p : tria) {
+            if (p != a && p != b) {
+                return p;
+            }
+        }
+        return -1;
+    }
+
+    // Replaces the edge from a to b shared by the triangles t1 = (a, b, p) and t2 = (b, a, q)
+    // with the edge from p to q
+    void flip(int t1, int t2, int a, int b, int p, int q)
+    {
+        removeEdges(t1);
+        removeEdges(t2);
+        triangles[t1] = {p, a, q};
+        triangles[t2] = {p, q, b};
+        addEdges(t1);
+        addEdges(t2);
+    }
+
+    // Restores the Delaunay property of the edges opposite to the point p
+    void legalize(int p, std::vector<std::pair<int, int>> stack)
+    {
+        std::size_t maxFlips = 16 * triangles.size() + 64;
+        while (!stack.empty() && maxFlips > 0) {
+            auto [a, b] = stack.back();
+            stack.pop_back();
+            int t1 = findEdge(a, b);
+            int t2 = findEdge(b, a);
+            if (t1 < 0 || t2 < 0) {
+                continue;
+            }
+
+            int q = thirdPoint(triangles[t2], a, b);
+            if (inCircle(projected[a], projected[b], projected[p], projected[q])) {
+                flip(t1, t2, a, b, p, q);
+                stack.emplace_back(a, q);
+                stack.emplace_back(q, b);
+                maxFlips--;
+            }
+        }
+    }
+
+    // Inserts the points on the edges of the facet ordered along the edges
+    void insertEdgePoints()
+    {
+        for (int k = 0; k < 3; k++) {
+            int start = k;
+            int end = (k + 1) % 3;
+            Point3 dir = points[end] - points[start];
+
+            std::vector<std::pair<double, int>> onEdge;
+            for (int i = 3; i < static_cast<int>(points.size()); i++) {
+                if (edgeOf[i] == k) {
+                    onEdge.emplace_back(dir * (points[i] - points[start]), i);
+                }
+            }
+            std::sort(onEdge.begin(), onEdge.end());
+
+            int prev = start;
+            for (const auto& it : onEdge) {
+                int p = it.second;
+                int t = findEdge(prev, end);
+                if (t < 0) {
+                    edgeOf[p] = -1;
+                    continue;
+                }
+
+                int c = thirdPoint(triangles[t], prev, end);
+                setTriangle(t, prev, p, c);
+                addTriangle(p, end, c);
+                legalize(p, {{c, prev}, {end, c}});
+                prev = p;
+            }
+        }
+    }
+
+    // Inserts a point inside the facet
+    void insertPoint(int p)
+    {
+        int best = -1;
+        int bestEdge = -1;
+        double bestValue = -std::numeric_limits<double>::max();
+        for (int t = 0; t < static_cast<int>(triangles.size()); t++) {
+            const auto& tria = triangles[t];
+            int signs[3];
+            int zeros = 0;
+            int zeroEdge = -1;
+            for (int i = 0; i < 3; i++) {
+                signs[i] = orient(tria[i], tria[(i + 1) % 3], p);
+                if (signs[i] == 0) {
+                    zeros++;
+                    zeroEdge = i;
+                }
+            }
+
+            if (signs[0] >= 0 && signs[1] >= 0 && signs[2] >= 0) {
+                if (zeros == 0) {
+                    splitTriangle(t, p);
+                }
+                else if (zeros == 1) {
+                    splitEdge(t, zeroEdge, p);
+                }
+                else {
+                    // the point coincides with a corner of the triangle
+                    for (int i = 0; i < 3; i++) {
+                        if (signs[i] != 0) {
+                            alias[p] = tria[(i + 2) % 3];
+                        }
+                    }
+                }
+                return;
+            }
+
+            // due to rounding the point may lie slightly outside of the facet, then it's
+            // put on the nearest edge
+            for (int i = 0; i < 3; i++) {
+                const Point2& a = projected[tria[i]];
+                const Point2& b = projected[tria[(i + 1) % 3]];
+                const Point2& c = projected[p];
+                double len = std::hypot(b.x - a.x, b.y - a.y);
+                double dist = ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) / len;
+                if (signs[i] < 0 && dist > bestValue && findEdge(tria[(i + 1) % 3], tria[i]) < 0) {
+                    bestValue = dist;
+                    best = t;
+                    bestEdge = i;
+                }
+            }
+        }
+
+        if (best >= 0) {
+            // move the projected point onto the edge
+            const auto& tria = triangles[best];
+            Point2& c = projected[p];
+            const Point2& a = projected[tria[bestEdge]];
+            const Point2& b = projected[tria[(bestEdge + 1) % 3]];
+            double dx = b.x - a.x;
+            double dy = b.y - a.y;
+            double t = ((c.x - a.x) * dx + (c.y - a.y) * dy) / (dx * dx + dy * dy);
+            t = std::clamp(t, 0.01, 0.99);
+            c = Point2 {a.x + t * dx, a.y + t * dy};
+            splitEdge(best, bestEdge, p);
+        }
+    }
+
+    void splitTriangle(int t, int p)
+    {
+        auto [a, b, c] = triangles[t];
+        setTriangle(t, a, b, p);
+        addTriangle(b, c, p);
+        addTriangle(c, a, p);
+        legalize(p, {{a, b}, {b, c}, {c, a}});
+    }
+
+    // Splits the edge with index edge of the triangle t and its neighbour
+    void splitEdge(int t, int edge, int p)
+    {
+        const auto& tria = triangles[t];
+        int a = tria[edge];
+        int b = tria[(edge + 1) % 3];
+        int c = tria[(edge + 2) % 3];
+        int other = findEdge(b, a);
+
+        setTriangle(t, a, p, c);
+        addTriangle(p, b, c);
+        if (other < 0) {
+            legalize(p, {{c, a}, {b, c}});
+            return;
+        }
+
+        int d = thirdPoint(triangles[other], a, b);
+        setTriangle(other, b, p, d);
+        addTriangle(p, a, d);
+        legalize(p, {{c, a}, {b, c}, {d, b}, {a, d}});
+    }
+
+    bool crosses(int u, int v, int a, int b) const
+    {
+        return orient(u, v, a) * orient(u, v, b) < 0 && orient(a, b, u) * orient(a, b, v) < 0;
+    }
+
+    // Enforces the edge from u to v by flipping the edges crossing it, returns false if the
+    // edge couldn't be created
+    bool recoverEdge(int u, int v)
+    {
+        if (u == v) {
+            return true;
+        }
+
+        // a point on the segment splits it into two
+        const Point2& pu = projected[u];
+        const Point2& pv = projected[v];
+        for (int w = 0; w < static_cast<int>(points.size()); w++) {
+            if (w == u || w == v || alias[w] != w || orient(u, v, w) != 0) {
+                continue;
+            }
+            const Point2& pw = projected[w];
+            double dot1 = (pw.x - pu.x) * (pv.x - pu.x) + (pw.y - pu.y) * (pv.y - pu.y);
+            double dot2 = (pw.x - pv.x) * (pu.x - pv.x) + (pw.y - pv.y) * (pu.y - pv.y);
+            if (dot1 > 0.0 && dot2 > 0.0) {
+                bool first = recoverEdge(u, w);
+                bool second = recoverEdge(w, v);
+                return first && second;
+            }
+        }
+
+        if (findEdge(u, v) < 0 && findEdge(v, u) < 0) {
+            std::vector<std::pair<int, int>> crossing;
+            for (const auto& it : edges) {
+                int a = static_cast<int>(it.first >> 32);
+                int b = static_cast<int>(it.first & 0xffffffff);
+                if (a < b && findEdge(b, a) >= 0 && crosses(u, v, a, b)) {
+                    crossing.emplace_back(a, b);
+                }
+            }
+
+            std::size_t maxFlips = 8 * crossing.size() * crossing.size() + 64;
+            std::size_t pos = 0;
+            while (pos < crossing.size() && maxFlips > 0) {
+                auto [a, b] = crossing[pos++];
+                int t1 = findEdge(a, b);
+                int t2 = findEdge(b, a);
+                if (t1 < 0 || t2 < 0 || isFixed(a, b)) {
+                    continue;
+                }
+
+                maxFlips--;
+                int p = thirdPoint(triangles[t1], a, b);
+                int q = thirdPoint(triangles[t2], a, b);
+                if (orient(p, q, a) * orient(p, q, b) < 0) {
+                    flip(t1, t2, a, b, p, q);
+                    if (crosses(u, v, p, q)) {
+                        crossing.emplace_back(p, q);
+                    }
+                }
+                else {
+                    // the quadrilateral isn't convex, try again later
+                    crossing.emplace_back(a, b);
+                }
+            }
+        }
+
+        // the flips may run out or be blocked by fixed edges
+        if (findEdge(u, v) < 0 && findEdge(v, u) < 0) {
+            return false;
+        }
+
+        fixed.insert(edgeKey(std::min(u, v), std::max(u, v)));
+        curve.emplace_back(u, v);
+        return true;
+    }
+
+private:
+    int axisU {0};
+    int axisV {1};
+    std::vector<Point3> points;
+    std::vector<Point2> projected;
+    std::vector<int> edgeOf;
+    std::vector<int> alias;
+    std::unordered_map<Point3, int, PointHash<double>, PointEqual<double>> indices;
+    std::vector<std::pair<int, int>> constraints;
+    std::vector<std::array<int, 3>> triangles;
+    std::unordered_map<std::uint64_t, int> edges;
+    std::unordered_set<std::uint64_t> fixed;
+    std::vector<std::pair<int, int>> curve;
+};
+
+// ------------------------------------------------------------------------------------------
+// Splitting and classification
+
+// A mesh whose facets are re-triangulated along the intersection curves
+struct SplitMesh
+{
+    std::vector<Point3> points;
+    std::vector<std::array<PointIndex, 3>> facets;
+    // sorted edges of the intersection curves with the lower point index first
+    std::vector<std::pair<PointIndex, PointIndex>> curve;
+    // false if in a cut facet not all intersection segments could be enforced
+    bool complete {true};
+};
+
+SplitMesh
+splitMesh(const MeshKernel& mesh, const std::vector<Segment>& segments, int side, int threads)
+{
+    // group the segments by the facets they cut
+    std::vector<std::pair<FacetIndex, std::size_t>> order(segments.size());
+    for (std::size_t i = 0; i < segments.size(); i++) {
+        order[i] = std::make_pair(segments[i].facet[side], i);
+    }
+    parallel_sort(order.begin(), order.end(), std::less<>(), threads);
+
+    std::vector<std::size_t> starts;
+    for (std::size_t i = 0; i < order.size(); i++) {
+        if (i == 0 || order[i].first != order[i - 1].first) {
+            starts.push_back(i);
+        }
+    }
+    starts.push_back(order.size());
+
+    struct Piece
+    {
+        std::vector<Point3> points;
+        std::vector<std::array<int, 3>> triangles;
+        std::vector<std::pair<int, int>> curve;
+        bool complete {true};
+    };
+
+    std::size_t numCut = starts.size() - 1;
+    std::vector<Piece> pieces(numCut);
+    std::atomic<std::size_t> next {0};
+    parallel_for(threads, threads, [&](std::size_t, std::size_t, std::size_t) {
+        std::size_t k {};
+        while ((k = next.fetch_add(1)) < numCut) {
+            Facet3 facet = getFacet(mesh, order[starts[k]].first);
+            FacetTriangulator tria(facet.pnt);
+            for (std::size_t i = starts[k]; i < starts[k + 1]; i++) {
+                const Segment& seg = segments[order[i].second];
+                int p = tria.AddPoint(seg.points[0].pnt, seg.points[0].edge[side]);
+                int q = tria.AddPoint(seg.points[1].pnt, seg.points[1].edge[side]);
+                tria.AddConstraint(p, q);
+            }
+            Piece& piece = pieces[k];
+            piece.complete = tria.Compute();
+            piece.points = tria.GetPoints();
+            piece.triangles = tria.GetTriangles();
+            piece.curve = tria.GetCurveEdges();
+        }
+    });
+
+    SplitMesh split;
+    const MeshPointArray& points = mesh.GetPoints();
+    const MeshFacetArray& facets = mesh.GetFacets();
+    split.points.reserve(points.size());
+    for (const auto& it : points) {
+        split.points.emplace_back(it.x, it.y, it.z);
+    }
+
+    std::vector<bool> isCut(facets.size(), false);
+    for (std::size_t k = 0; k < numCut; k++) {
+        isCut[order[starts[k]].first] = true;
+    }
+    for (std::size_t i = 0; i < facets.size(); i++) {
+        if (!isCut[i]) {
+            const PointIndex* pts = facets[i]._aulPoints;
+            split.facets.push_back({pts[0], pts[1], pts[2]});
+        }
+    }
+
+    // the intersection points are shared by neighbouring facets
+    std::unordered_map<Point3, PointIndex, PointHash<double>, PointEqual<double>> newPoints;
+    for (std::size_t k = 0; k < numCut; k++) {
+        const Piece& piece = pieces[k];
+        const PointIndex* corners = facets[order[starts[k]].first]._aulPoints;
+        std::vector<PointIndex> global(piece.points.size());
+        for (std::size_t i = 0; i < piece.points.size(); i++) {
+            if (i < 3) {
+                global[i] = corners[i];
+                continue;
+            }
+            auto it = newPoints.emplace(piece.points[i], split.points.size());
+            if (it.second) {
+                split.points.push_back(piece.points[i]);
+            }
+            global[i] = it.first->second;
+        }
+
+        for (const auto& it : piece.triangles) {
+            split.facets.push_back({global[it[0]], global[it[1]], global[it[2]]});
+        }
+        for (const auto& it : piece.curve) {
+            PointIndex p = global[it.first];
+            PointIndex q = global[it.second];
+            split.curve.emplace_back(std::min(p, q), std::max(p, q));
+        }
+        if (!piece.complete) {
+            split.complete = false;
+        }
+    }
+
+    std::sort(split.curve.begin(), split.curve.end());
+    split.curve.erase(std::unique(split.curve.begin(), split.curve.end()), split.curve.end());
+    return split;
+}
+
+// Assigns a region to each facet. Two facets belong to the same region if they are connected
+// over edges that are not part of an intersection curve. Returns the number of regions.
+std::size_t findRegions(const SplitMesh& split, std::vector<std::size_t>& regions, int threads)
+{
+    std::size_t count = split.facets.size();
+    std::vector<std::pair<std::pair<PointIndex, PointIndex>, std::size_t>> edges;
+    edges.reserve(3 * count);
+    for (std::size_t i = 0; i < count; i++) {
+        const auto& facet = split.facets[i];
+        for (int j = 0; j < 3; j++) {
+            PointIndex p = facet[j];
+            PointIndex q = facet[(j + 1) % 3];
+            edges.emplace_back(std::make_pair(std::min(p, q), std::max(p, q)), i);
+        }
+    }
+    parallel_sort(edges.begin(), edges.end(), std::less<>(), threads);
+
+    std::vector<std::size_t> parent(count);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](std::size_t i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+
+    for (std::size_t i = 0; i < edges.size();) {
+        std::size_t j = i + 1;
+        while (j < edges.size() && edges[j].first == edges[i].first) {
+            j++;
+        }
+        if (!std::binary_search(split.curve.begin(), split.curve.end(), edges[i].first)) {
+            for (std::size_t k = i + 1; k < j; k++) {
+                std::size_t r1 = find(edges[i].second);
+                std::size_t r2 = find(edges[k].second);
+                if (r1 != r2) {
+                    parent[std::max(r1, r2)] = std::min(r1, r2);
+                }
+            }
+        }
+        i = j;
+    }
+
+    std::vector<std::size_t> numbers(count, std::numeric_limits<std::size_t>::max());
+    std::size_t numRegions = 0;
+    regions.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        std::size_t root = find(i);
+        if (numbers[root] == std::numeric_limits<std::size_t>::max()) {
+            numbers[root] = numRegions++;
+        }
+        regions[i] = numbers[root];
+    }
+
+    return numRegions;
+}
+
+// Returns for each region the centre of its largest facet which is the most reliable point to
+// classify
+std::vector<Point3> regionProbes(const SplitMesh& split,
+                                 const std::vector<std::size_t>& regions,
+                                 std::size_t numRegions)
+{
+    std::vector<Point3> probes(numRegions);
+    std::vector<double> areas(numRegions, -1.0);
+    for (std::size_t i = 0; i < split.facets.size(); i++) {
+        const Point3& p0 = split.points[split.facets[i][0]];
+        const Point3& p1 = split.points[split.facets[i][1]];
+        const Point3& p2 = split.points[split.facets[i][2]];
+        double area = ((p1 - p0) % (p2 - p0)).Sqr();
+        std::size_t region = regions[i];
+        if (area > areas[region]) {
+            areas[region] = area;
+            probes[region] = (p0 + p1 + p2) / 3.0;
+        }
+    }
+    return probes;
+}
+
+// Computes the generalized winding number of the point with respect to the mesh as the sum of
+// the solid angles of all facets. This works for every point but costs a pass over all facets.
+double solidAngleWinding(const MeshKernel& mesh, const Point3& p)
+{
+    double sum = 0.0;
+    for (std::size_t i = 0; i < mesh.CountFacets(); i++) {
+        Facet3 f = getFacet(mesh, i);
+        // solid angle of the triangle (Van Oosterom and Strackee)
+        Point3 a = f.pnt[0] - p;
+        Point3 b = f.pnt[1] - p;
+        Point3 c = f.pnt[2] - p;
+        double la = a.Length();
+        double lb = b.Length();
+        double lc = c.Length();
+        double num = a * (b % c);
+        double den = la * lb * lc + (a * b) * lc + (a * c) * lb + (b * c) * la;
+        sum += 2.0 * std::atan2(num, den);
+    }
+    return sum / (4.0 * std::numbers::pi);
+}
+
+// Computes the winding number of the point by counting the signed crossings of the ray from p
+// along the coordinate axis. Only the facets the BVH finds near the ray are tested, with exact
+// predicates. Returns no value if the ray touches an edge or a vertex of the mesh.
+std::optional<double> rayWinding(const MeshKernel& mesh,
+                                 const MeshFacetBVH& bvh,
+                                 const Point3& p,
+                                 int axis,
+                                 std::vector<FacetIndex>& candidates)
+{
+    Base::BoundBox3f box = bvh.GetBoundBox();
+    float margin = 1e-5F * box.CalcDiagonalLength();
+    float lower[3] = {float(p.x) - margin, float(p.y) - margin, float(p.z) - margin};
+    float upper[3] = {float(p.x) + margin, float(p.y) + margin, float(p.z) + margin};
+    float end[3] = {box.MaxX, box.MaxY, box.MaxZ};
+    upper[axis] = std::max(upper[axis], end[axis] + margin);
+
+    candidates.clear();
+    bvh.FacetsInBox(Base::BoundBox3f(lower[0], lower[1], lower[2], upper[0], upper[1], upper[2]),
+                    candidates);
+
+    const int u = (axis + 1) % 3;
+    const int v = (axis + 2) % 3;
+    const Point2 q {p[u], p[v]};
+    int winding = 0;
+    for (FacetIndex index : candidates) {
+        Facet3 f = getFacet(mesh, index);
+        Point2 a {f.pnt[0][u], f.pnt[0][v]};
+        Point2 b {f.pnt[1][u], f.pnt[1][v]};
+        Point2 c {f.pnt[2][u], f.pnt[2][v]};
+        int signs[3] = {orient2d(a, b, q), orient2d(b, c, q), orient2d(c, a, q)};
+        if (!onOneSide(signs)) {
+            bool left = signs[0] > 0 || signs[1] > 0 || signs[2] > 0;
+            bool right = signs[0] < 0 || signs[1] < 0 || signs[2] < 0;
+            if (left && right) {
+                continue;
+            }
+            return std::nullopt;
+        }
+
+        // the sign of the projected facet is the sign of its normal along the ray
+        int side = signs[0];
+        int height = orient3d(f.pnt[0], f.pnt[1], f.pnt[2], p);
+        if (height == 0) {
+            return 0.5;
+        }
+        if (height == side) {
+            winding += side;
+        }
+    }
+    return double(winding);
+}
+
+// Computes the winding numbers of the points with respect to the mesh. For closed meshes it's 1
+// inside, 0 outside and 0.5 on the surface.
+std::vector<double> windingNumbers(const MeshKernel& mesh,
+                                   const MeshFacetBVH& bvh,
+                                   const std::vector<Point3>& probes,
+                                   int threads)
+{
+    std::vector<double> winding(probes.size(), 0.0);
+    Base::BoundBox3f box = bvh.GetBoundBox();
+
+    parallel_for(probes.size(), threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+        std::vector<FacetIndex> candidates;
+        for (std::size_t i = begin; i < end; i++) {
+            // points outside of the bounding box are outside of the mesh
+            const Point3& p = probes[i];
+            if (p.x < box.MinX || p.x > box.MaxX || p.y < box.MinY || p.y > box.MaxY
+                || p.z < box.MinZ || p.z > box.MaxZ) {
+                continue;
+            }
+
+            std::optional<double> value;
+            for (int axis = 0; axis < 3 && !value; axis++) {
+                value = rayWinding(mesh, bvh, p, axis, candidates);
+            }
+            winding[i] = value ? *value : solidAngleWinding(mesh, p);
+        }
+    });
+
+    return winding;
+}
+
+enum class Location
+{
+    Outside,
+    Inside,
+    OnSurface
+};
+
+Location classify(double winding)
+{
+    if (std::fabs(winding - 0.5) < 0.25) {
+        return Location::OnSurface;
+    }
+    return winding > 0.5 ? Location::Inside : Location::Outside;
+}
+
+bool keepFacets(MeshBoolean::OperationType type, int side, Location loc)
+{
+    if (side == 0) {
+        switch (type) {
+            case MeshBoolean::Union:
+            case MeshBoolean::Outer:
+                return loc != Location::Inside;
+            case MeshBoolean::Intersect:
+            case MeshBoolean::Inner:
+                return loc != Location::Outside;
+            case MeshBoolean::Difference:
+                return loc == Location::Outside;
+        }
+        return false;
+    }
+
+    switch (type) {
+        case MeshBoolean::Union:
+            return loc == Location::Outside;
+        case MeshBoolean::Intersect:
+        case MeshBoolean::Difference:
+            return loc == Location::Inside;
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
+MeshBoolean::MeshBoolean(const MeshKernel& mesh1, const MeshKernel& mesh2)
+    : _mesh1(mesh1)
+    , _mesh2(mesh2)
+{}
+
+bool MeshBoolean::Compute(OperationType type, MeshKernel& result) const
+{
+    int threads = _threads;
+    if (threads < 1) {
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    MeshFacetBVH bvhs[2];
+    bvhs[1].Rebuild(_mesh2);
+    std::vector<Segment> segments = intersectMeshes(_mesh1, _mesh2, bvhs[1], threads);
+
+    MeshPointArray points;
+    MeshFacetArray facets;
+    std::unordered_map<Base::Vector3f, PointIndex, PointHash<float>, PointEqual<float>> indices;
+
+    const MeshKernel* meshes[2] = {&_mesh1, &_mesh2};
+    bool complete = true;
+    int numSides = (type == Inner || type == Outer) ? 1 : 2;
+    for (int side = 0; side < numSides; side++) {
+        SplitMesh split = splitMesh(*meshes[side], segments, side, threads);
+        if (!split.complete) {
+            complete = false;
+        }
+        std::vector<std::size_t> regions;
+        std::size_t numRegions = findRegions(split, regions, threads);
+        if (bvhs[1 - side].IsEmpty()) {
+            bvhs[1 - side].Rebuild(*meshes[1 - side]);
+        }
+        std::vector<double> winding = windingNumbers(*meshes[1 - side],
+                                                     bvhs[1 - side],
+                                                     regionProbes(split, regions, numRegions),
+                                                     threads);
+
+        // the points are merged in single precision, so close points may collapse
+        std::vector<PointIndex> remap(split.points.size(), POINT_INDEX_MAX);
+        auto pointIndex = [&](PointIndex p) {
+            if (remap[p] == POINT_INDEX_MAX) {
+                const Point3& pnt = split.points[p];
+                Base::Vector3f key(float(pnt.x), float(pnt.y), float(pnt.z));
+                auto it = indices.emplace(key, points.size());
+                if (it.second) {
+                    points.push_back(key);
+                }
+                remap[p] = it.first->second;
+            }
+            return remap[p];
+        };
+
+        bool reverse = side == 1 && type == Difference;
+        for (std::size_t i = 0; i < split.facets.size(); i++) {
+            if (!keepFacets(type, side, classify(winding[regions[i]]))) {
+                continue;
+            }
+
+            PointIndex p0 = pointIndex(split.facets[i][0]);
+            PointIndex p1 = pointIndex(split.facets[i][1]);
+            PointIndex p2 = pointIndex(split.facets[i][2]);
+            if (p0 == p1 || p1 == p2 || p2 == p0) {
+                continue;
+            }
+            if (reverse) {
+                std::swap(p1, p2);
+            }
+            facets.push_back(MeshFacet(p0, p1, p2));
+        }
+    }
+
+    result.Adopt(points, facets, true);
+    return complete;
+}
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef MESH_BOOLEAN_H
+#define MESH_BOOLEAN_H
+
+#include "Definitions.h"
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshBoolean class computes boolean operations of two closed meshes.
+ * It works in these steps:
+ * \li The facet pairs whose bounding boxes overlap are searched with a bounding volume hierarchy
+ * and intersected concurrently. The intersection points are computed per pair of edge and facet,
+ * so that neighbouring facets get exactly the same points, and all orientation tests use filtered
+ * predicates that fall back to exact arithmetic.
+ * \li The facets that are cut are re-triangulated concurrently with the intersection segments as
+ * constrained edges.
+ * \li The parts of each mesh that are separated by the intersection curves are classified as
+ * inside or outside of the other mesh by their generalized winding number.
+ *
+ * Both meshes should be closed and consistently oriented. Overlapping coplanar facets are not cut,
+ * regions lying on the surface of the other mesh are taken from the first mesh for unions and
+ * intersections and dropped for differences.
+ * \code
+ * MeshKernel result;
+ * MeshBoolean boolean(mesh1, mesh2);
+ * boolean.Compute(MeshBoolean::Union, result);
+ * \endcode
+ */
+class MeshExport MeshBoolean
+{
+public:
+    enum OperationType
+    {
+        Union,       ///< Parts of both meshes outside of the other mesh
+        Intersect,   ///< Parts of both meshes inside of the other mesh
+        Difference,  ///< Parts of the first mesh outside and of the second mesh inside the other
+        Inner,       ///< Parts of the first mesh inside of the second mesh
+        Outer        ///< Parts of the first mesh outside of the second mesh
+    };
+
+    /// Construction
+    MeshBoolean(const MeshKernel& mesh1, const MeshKernel& mesh2);
+    /**
+     * Sets the number of threads to use. If \a threads is less than one the number of hardware
+     * threads is used which is also the default.
+     */
+    void SetThreads(int threads)
+    {
+        _threads = threads;
+    }
+    /**
+     * Computes the operation \a type and writes the result into \a result. Returns false if
+     * not all intersection curves could be inserted into the cut facets, then the result may
+     * contain wrongly classified parts.
+     */
+    bool Compute(OperationType type, MeshKernel& result) const;
+
+private:
+    const MeshKernel& _mesh1;
+    const MeshKernel& _mesh2;
+    int _threads {0};
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_BOOLEAN_H
@@ -60,45 +60,6 @@ class MeshGeomFacet;
 class MeshExport MeshBuilder
 {
 private:
-    /** @name Helper class */
-    //@{
-    class Edge
-    {
-    public:
-        PointIndex pt1;
-        PointIndex pt2;
-        FacetIndex facetIdx;
-
-        Edge(PointIndex p1, PointIndex p2, FacetIndex idx)
-            : facetIdx {idx}
-        {
-            if (p1 > p2) {
-                pt1 = p2;
-                pt2 = p1;
-            }
-            else {
-                pt1 = p1;
-                pt2 = p2;
-            }
-        }
-
-        bool operator<(const Edge& e) const
-        {
-            return (pt1 == e.pt1) ? (pt2 < e.pt2) : (pt1 < e.pt1);
-        }
-
-        bool operator>(const Edge& e) const
-        {
-            return (pt1 == e.pt1) ? (pt2 > e.pt2) : (pt1 > e.pt1);
-        }
-
-        bool operator==(const Edge& e) const
-        {
-            return (pt1 == e.pt1) && (pt2 == e.pt2);
-        }
-    };
-    //@}
-
     MeshKernel& _meshKernel;
     std::set<MeshPoint> _points;
     Base::SequencerLauncher* _seq {nullptr};
@@ -228,6 +189,36 @@ private:
     Private* p;
 };
 
+/**
+ * Class for welding the corners of a triangle soup into a shared point array in parallel.
+ * Corners with identical coordinates become the same point. Points keep the order of the
+ * first occurrence of their coordinates, so the result is independent of the number of threads.
+ * \code
+ * // corners holds three consecutive points per facet
+ * MeshPointArray points;
+ * MeshFacetArray facets;
+ * MeshPointWelder welder;
+ * welder.Weld(corners, points, facets);
+ * kernel.Adopt(points, facets, true);
+ * \endcode
+ */
+class MeshExport MeshPointWelder
+{
+public:
+    /// If \a threads is less than one the number of hardware threads is used.
+    explicit MeshPointWelder(int threads = 0);
+
+    /** Welds the corners. The size of \a corners must be a multiple of three.
+     * The neighbourhood of the returned facets is not set.
+     */
+    void Weld(const std::vector<Base::Vector3f>& corners,
+              MeshPointArray& points,
+              MeshFacetArray& facets) const;
+
+private:
+    int threads;
+};
+
 }  // namespace MeshCore
 
 #endif
@@ -22,22 +22,286 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
 #include <limits>
+#include <numeric>
+#include <thread>
 #endif
 
 #include "Decimation.h"
+#include "Functional.h"
 #include "MeshKernel.h"
 #include "Simplify.h"
 
 
 using namespace MeshCore;
 
+namespace
+{
+
+struct BlockRange
+{
+    std::size_t begin;
+    std::size_t end;
+};
+
+/**
+ * Sorts the facet indices into spatial blocks of at most \a blockSize facets by splitting
+ * them recursively at the median of their centers. The first split is along the axis
+ * given by \a pass while all further splits are along the longest side of the bounding
+ * box of the centers. So, every pass gets blocks with different boundaries.
+ */
+std::vector<BlockRange> splitIntoBlocks(const MeshKernel& kernel,
+                                        std::size_t blockSize,
+                                        int pass,
+                                        int threads,
+                                        std::vector<FacetIndex>& order)
+{
+    const MeshPointArray& points = kernel.GetPoints();
+    const MeshFacetArray& facets = kernel.GetFacets();
+    std::vector<Base::Vector3f> centers(facets.size());
+    parallel_for(facets.size(), threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshFacet& face = facets[i];
+            centers[i] = (points[face._aulPoints[0]] + points[face._aulPoints[1]]
+                          + points[face._aulPoints[2]])
+                / 3.0F;
+        }
+    });
+
+    order.resize(facets.size());
+    std::iota(order.begin(), order.end(), FacetIndex(0));
+
+    std::vector<BlockRange> blocks;
+    std::vector<std::pair<BlockRange, int>> todo;
+    todo.emplace_back(BlockRange {0, order.size()}, 0);
+    while (!todo.empty()) {
+        auto [range, depth] = todo.back();
+        todo.pop_back();
+        if (range.end - range.begin <= blockSize) {
+            blocks.push_back(range);
+            continue;
+        }
+
+        int axis = pass % 3;
+        if (depth > 0) {
+            Base::BoundBox3f box;
+            for (std::size_t i = range.begin; i < range.end; i++) {
+                box.Add(centers[order[i]]);
+            }
+            float len[3] = {box.LengthX(), box.LengthY(), box.LengthZ()};
+            axis = int(std::max_element(len, len + 3) - len);
+        }
+
+        std::size_t mid = range.begin + (range.end - range.begin) / 2;
+        std::nth_element(order.begin() + range.begin,
+                         order.begin() + mid,
+                         order.begin() + range.end,
+                         [&centers, axis](FacetIndex a, FacetIndex b) {
+                             return centers[a][axis] < centers[b][axis];
+                         });
+        todo.emplace_back(BlockRange {mid, range.end}, depth + 1);
+        todo.emplace_back(BlockRange {range.begin, mid}, depth + 1);
+    }
+
+    return blocks;
+}
+
+// A simplified block whose point indices below the number of locked points
+// refer to the locked points, the others to the points of the block
+struct SimplifiedBlock
+{
+    std::vector<Base::Vector3f> points;
+    std::vector<PointIndex> facets;
+};
+
+}  // namespace
+
 MeshSimplify::MeshSimplify(MeshKernel& mesh)
     : myKernel(mesh)
 {}
 
+void MeshSimplify::simplifyBlocks(int targetSize, double tolerance)
+{
+    // Every pass uses differently shaped blocks so that the facets around the locked
+    // vertices of a pass can be simplified by the next one. The passes go on as long as
+    // they remove at least 1% of the facets, the rest is left to the global pass.
+    for (int pass = 0;; pass++) {
+        std::size_t numFacets = myKernel.CountFacets();
+        if (blockSize == 0 || numFacets <= blockSize
+            || numFacets <= static_cast<std::size_t>(std::max(targetSize, 0))) {
+            break;
+        }
+
+        simplifyBlockPass(targetSize, tolerance, pass);
+        if (myKernel.CountFacets() * 100 > numFacets * 99) {
+            break;
+        }
+    }
+}
+
+void MeshSimplify::simplifyBlockPass(int targetSize, double tolerance, int pass)
+{
+    int numThreads = threads;
+    if (numThreads < 1) {
+        numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    const MeshPointArray& points = myKernel.GetPoints();
+    const MeshFacetArray& facets = myKernel.GetFacets();
+    std::vector<FacetIndex> order;
+    std::vector<BlockRange> blocks = splitIntoBlocks(myKernel, blockSize, pass, numThreads, order);
+
+    // Vertices used by facets of different blocks are locked
+    const std::uint32_t unused = std::numeric_limits<std::uint32_t>::max();
+    const std::uint32_t locked = unused - 1;
+    std::vector<std::uint32_t> owner(points.size(), unused);
+    for (std::size_t b = 0; b < blocks.size(); b++) {
+        for (std::size_t i = blocks[b].begin; i < blocks[b].end; i++) {
+            for (PointIndex p : facets[order[i]]._aulPoints) {
+                if (owner[p] == unused) {
+                    owner[p] = static_cast<std::uint32_t>(b);
+                }
+                else if (owner[p] != b) {
+                    owner[p] = locked;
+                }
+            }
+        }
+    }
+
+    std::vector<PointIndex> lockedPoints;
+    for (std::size_t i = 0; i < owner.size(); i++) {
+        if (owner[i] == locked) {
+            lockedPoints.push_back(i);
+        }
+    }
+
+    const PointIndex numLocked = lockedPoints.size();
+    auto lockedIndex = [&lockedPoints](PointIndex p) {
+        return PointIndex(std::lower_bound(lockedPoints.begin(), lockedPoints.end(), p)
+                          - lockedPoints.begin());
+    };
+
+    double ratio = double(std::max(targetSize, 0)) / double(facets.size());
+    auto simplifyBlock = [&](const BlockRange& range, SimplifiedBlock& result) {
+        std::vector<PointIndex> local;
+        local.reserve(3 * (range.end - range.begin));
+        for (std::size_t i = range.begin; i < range.end; i++) {
+            const MeshFacet& face = facets[order[i]];
+            local.insert(local.end(), face._aulPoints, face._aulPoints + 3);
+        }
+        std::sort(local.begin(), local.end());
+        local.erase(std::unique(local.begin(), local.end()), local.end());
+
+        Simplify alg;
+        alg.vertices.reserve(local.size());
+        for (std::size_t i = 0; i < local.size(); i++) {
+            Simplify::Vertex v;
+            v.tstart = 0;
+            v.tcount = 0;
+            v.border = 0;
+            v.locked = owner[local[i]] == locked ? 1 : 0;
+            v.id = static_cast<int>(i);
+            v.p = points[local[i]];
+            alg.vertices.push_back(v);
+        }
+
+        alg.triangles.reserve(range.end - range.begin);
+        for (std::size_t i = range.begin; i < range.end; i++) {
+            const MeshFacet& face = facets[order[i]];
+            Simplify::Triangle t;
+            t.deleted = 0;
+            t.dirty = 0;
+            for (double& j : t.err) {
+                j = 0.0;
+            }
+            for (int j = 0; j < 3; j++) {
+                t.v[j] = static_cast<int>(
+                    std::lower_bound(local.begin(), local.end(), face._aulPoints[j])
+                    - local.begin());
+            }
+            alg.triangles.push_back(t);
+        }
+
+        int target_count = static_cast<int>(std::lround(ratio * double(range.end - range.begin)));
+        alg.simplify_mesh(target_count, tolerance);
+
+        std::vector<PointIndex> index(alg.vertices.size());
+        for (std::size_t i = 0; i < alg.vertices.size(); i++) {
+            PointIndex p = local[alg.vertices[i].id];
+            if (owner[p] == locked) {
+                index[i] = lockedIndex(p);
+            }
+            else {
+                index[i] = numLocked + result.points.size();
+                result.points.push_back(alg.vertices[i].p);
+            }
+        }
+
+        result.facets.reserve(3 * alg.triangles.size());
+        for (const auto& triangle : alg.triangles) {
+            for (int j : triangle.v) {
+                result.facets.push_back(index[j]);
+            }
+        }
+    };
+
+    // The blocks are handed out one by one so that at most one block per thread
+    // is being simplified at the same time
+    std::vector<SimplifiedBlock> results(blocks.size());
+    std::atomic<std::size_t> nextBlock {0};
+    parallel_for(numThreads, numThreads, [&](std::size_t, std::size_t, std::size_t) {
+        for (std::size_t b = nextBlock++; b < blocks.size(); b = nextBlock++) {
+            simplifyBlock(blocks[b], results[b]);
+        }
+    });
+
+    // Stitch the blocks together
+    std::size_t numPoints = numLocked;
+    std::size_t numFacets = 0;
+    for (const auto& it : results) {
+        numPoints += it.points.size();
+        numFacets += it.facets.size() / 3;
+    }
+
+    MeshPointArray new_points;
+    new_points.reserve(numPoints);
+    for (PointIndex p : lockedPoints) {
+        new_points.push_back(points[p]);
+    }
+
+    MeshFacetArray new_facets;
+    new_facets.reserve(numFacets);
+    for (auto& it : results) {
+        PointIndex offset = new_points.size() - numLocked;
+        for (const auto& p : it.points) {
+            new_points.push_back(p);
+        }
+        for (std::size_t i = 0; i < it.facets.size(); i += 3) {
+            MeshFacet face;
+            for (int j = 0; j < 3; j++) {
+                PointIndex p = it.facets[i + j];
+                face._aulPoints[j] = p < numLocked ? p : p + offset;
+            }
+            new_facets.push_back(face);
+        }
+
+        // free the memory of the block as early as possible
+        it = SimplifiedBlock();
+    }
+
+    myKernel.Adopt(new_points, new_facets, true);
+}
+
 void MeshSimplify::simplify(float tolerance, float reduction)
 {
+    int target_count =
+        static_cast<int>(static_cast<float>(myKernel.CountFacets()) * (1.0F - reduction));
+
+    simplifyBlocks(target_count, tolerance);
     Simplify alg;
 
     const MeshPointArray& points = myKernel.GetPoints();
@@ -64,8 +328,6 @@ void MeshSimplify::simplify(float tolerance, float reduction)
         alg.triangles.push_back(t);
     }
 
-    int target_count = static_cast<int>(static_cast<float>(facets.size()) * (1.0F - reduction));
-
     // Simplification starts
     alg.simplify_mesh(target_count, tolerance);
 
@@ -99,6 +361,7 @@ void MeshSimplify::simplify(float tolerance, float reduction)
 
 void MeshSimplify::simplify(int targetSize)
 {
+    simplifyBlocks(targetSize, std::numeric_limits<float>::max());
     Simplify alg;
 
     const MeshPointArray& points = myKernel.GetPoints();
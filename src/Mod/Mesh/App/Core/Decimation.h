@@ -24,12 +24,22 @@
 #ifndef MESH_DECIMATION_H
 #define MESH_DECIMATION_H
 
+#include <cstddef>
 #include <Mod/Mesh/MeshGlobal.h>
 
 namespace MeshCore
 {
 class MeshKernel;
 
+/**
+ * The MeshSimplify class reduces the number of facets using quadric error metrics.
+ * Meshes with more facets than the block size are first split into spatial blocks
+ * that are simplified concurrently. Vertices shared by several blocks are locked,
+ * so that the simplified blocks can be stitched together again. This way only the
+ * simplification data of the blocks being processed must be kept in memory.
+ * The remaining mesh is finally simplified at once until the target is met, this pass
+ * only has to handle what the locked vertices kept the block passes from removing.
+ */
 class MeshExport MeshSimplify
 {
 public:
@@ -37,8 +47,25 @@ public:
     void simplify(float tolerance, float reduction);
     void simplify(int targetSize);
 
+    /// Sets the maximum number of facets of a block. Zero disables the block mode.
+    void setBlockSize(std::size_t size)
+    {
+        blockSize = size;
+    }
+    /// Sets the number of threads. If less than one the number of hardware threads is used.
+    void setThreads(int num)
+    {
+        threads = num;
+    }
+
+private:
+    void simplifyBlocks(int targetSize, double tolerance);
+    void simplifyBlockPass(int targetSize, double tolerance, int pass);
+
 private:
     MeshKernel& myKernel;
+    std::size_t blockSize {1000000};
+    int threads {0};
 };
 
 }  // namespace MeshCore
@@ -24,13 +24,16 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <queue>
+#include <thread>
 #endif
 
 #include <boost/math/special_functions/fpclassify.hpp>
 
 #include "Degeneration.h"
+#include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "TopoAlgorithm.h"
@@ -137,7 +140,8 @@ bool MeshEvalDuplicatePoints::Evaluate()
     }
 
     // if there are two adjacent vertices which have the same coordinates
-    std::sort(vertices.begin(), vertices.end(), Vertex_Less());
+    int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    MeshCore::parallel_sort(vertices.begin(), vertices.end(), Vertex_Less(), threads);
     return (std::adjacent_find(vertices.begin(), vertices.end(), Vertex_EqualTo())
             == vertices.end());
 }
@@ -157,7 +161,8 @@ std::vector<PointIndex> MeshEvalDuplicatePoints::GetIndices() const
     // if there are two adjacent vertices which have the same coordinates
     std::vector<PointIndex> aInds;
     Vertex_EqualTo pred;
-    std::sort(vertices.begin(), vertices.end(), Vertex_Less());
+    int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    MeshCore::parallel_sort(vertices.begin(), vertices.end(), Vertex_Less(), threads);
 
     std::vector<VertexIterator>::iterator vt = vertices.begin();
     while (vt < vertices.end()) {
@@ -473,14 +478,19 @@ bool MeshEvalInternalFacets::Evaluate()
 
 bool MeshEvalDegeneratedFacets::Evaluate()
 {
-    MeshFacetIterator it(_rclMesh);
-    for (it.Init(); it.More(); it.Next()) {
-        if (it->IsDegenerated(fEpsilon)) {
-            return false;
-        }
-    }
-
-    return true;
+    std::atomic<bool> degenerated {false};
+    int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    parallel_for(_rclMesh.CountFacets(),
+                 threads,
+                 [&](std::size_t begin, std::size_t end, std::size_t) {
+                     for (std::size_t i = begin; i < end && !degenerated; i++) {
+                         if (_rclMesh.GetFacet(FacetIndex(i)).IsDegenerated(fEpsilon)) {
+                             degenerated = true;
+                         }
+                     }
+                 });
+
+    return !degenerated;
 }
 
 unsigned long MeshEvalDegeneratedFacets::CountEdgeTooSmall(float fMinEdgeLength) const
@@ -503,12 +513,22 @@ unsigned long MeshEvalDegeneratedFacets::CountEdgeTooSmall(float fMinEdgeLength)
 
 std::vector<FacetIndex> MeshEvalDegeneratedFacets::GetIndices() const
 {
+    // the indices are collected per block and appended in the order of the blocks
+    int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::vector<std::vector<FacetIndex>> blockInds(threads);
+    parallel_for(_rclMesh.CountFacets(),
+                 threads,
+                 [&](std::size_t begin, std::size_t end, std::size_t block) {
+                     for (std::size_t i = begin; i < end; i++) {
+                         if (_rclMesh.GetFacet(FacetIndex(i)).IsDegenerated(fEpsilon)) {
+                             blockInds[block].push_back(FacetIndex(i));
+                         }
+                     }
+                 });
+
     std::vector<FacetIndex> aInds;
-    MeshFacetIterator it(_rclMesh);
-    for (it.Init(); it.More(); it.Next()) {
-        if (it->IsDegenerated(fEpsilon)) {
-            aInds.push_back(it.Position());
-        }
+    for (const auto& it : blockInds) {
+        aInds.insert(aInds.end(), it.begin(), it.end());
     }
 
     return aInds;
@@ -24,6 +24,13 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
 #include <vector>
 #endif
 
@@ -42,6 +49,118 @@
 using namespace MeshCore;
 
 
+MeshEvaluationRunner::MeshEvaluationRunner(int threads)
+    : threads(threads)
+{
+    if (this->threads < 1) {
+        this->threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+}
+
+void MeshEvaluationRunner::Add(std::function<void()> check)
+{
+    checks.push_back(std::move(check));
+}
+
+void MeshEvaluationRunner::Add(MeshEvaluation& eval, bool& result)
+{
+    checks.emplace_back([&eval, &result]() {
+        result = eval.Evaluate();
+    });
+}
+
+void MeshEvaluationRunner::Run(const char* text, bool canAbort)
+{
+    // The launcher must be created before the worker threads start so that the
+    // sequencers created by the checks themselves become nested and are ignored.
+    Base::SequencerLauncher seq(text, checks.size());
+
+    std::mutex mutex;
+    std::condition_variable finishedCheck;
+    std::size_t finished = 0;
+    std::size_t running = 0;
+    std::exception_ptr error;
+    std::atomic<std::size_t> nextCheck {0};
+    std::atomic<bool> cancel {false};
+
+    auto worker = [&]() {
+        while (!cancel) {
+            std::size_t index = nextCheck++;
+            if (index >= checks.size()) {
+                break;
+            }
+            try {
+                checks[index]();
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                cancel = true;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            finished++;
+            finishedCheck.notify_one();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        running--;
+        finishedCheck.notify_one();
+    };
+
+    std::size_t numThreads = std::min(static_cast<std::size_t>(threads), checks.size());
+    std::vector<std::thread> pool;
+    pool.reserve(numThreads);
+    running = numThreads;
+    for (std::size_t i = 0; i < numThreads; i++) {
+        pool.emplace_back(worker);
+    }
+
+    auto joinAll = [&pool]() {
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    };
+
+    try {
+        std::size_t reported = 0;
+        for (;;) {
+            std::size_t done {};
+            bool idle {};
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                finishedCheck.wait(lock, [&]() {
+                    return finished > reported || running == 0;
+                });
+                done = finished;
+                idle = running == 0;
+            }
+
+            // report the progress from the calling thread only
+            for (; reported < done; reported++) {
+                seq.next(canAbort);
+            }
+            if (idle) {
+                break;
+            }
+        }
+    }
+    catch (...) {
+        cancel = true;
+        joinAll();
+        throw;
+    }
+
+    joinAll();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// ----------------------------------------------------
+
 MeshOrientationVisitor::MeshOrientationVisitor() = default;
 
 bool MeshOrientationVisitor::Visit(const MeshFacet& rclFacet,
@@ -331,6 +450,129 @@ struct Edge_Less
     }
 };
 
+/*
+ * Edge with both point indices packed into one key, the smaller index in the upper half.
+ * The facet index and the side of the edge are packed into the second value.
+ */
+struct Edge_Key
+{
+    std::uint64_t key;
+    std::uint64_t facetSide;
+
+    bool operator<(const Edge_Key& other) const
+    {
+        return key < other.key || (key == other.key && facetSide < other.facetSide);
+    }
+};
+
+/*
+ * Sets the neighbours of the facets from index \a index on. The edges are distributed into
+ * buckets by their smaller point index with a parallel counting sort. Equal edges end up in the
+ * same bucket, so that the buckets can be sorted and linked independently. Returns false if a
+ * point index doesn't fit into 32 bits.
+ */
+static bool RebuildNeighboursPacked(MeshFacetArray& facets, FacetIndex index, std::size_t numPoints)
+{
+    const std::uint64_t maxIndex = std::numeric_limits<std::uint32_t>::max();
+    const std::size_t numFacets = facets.size() - index;
+    const std::size_t numBuckets = std::clamp<std::size_t>(numFacets / 256, 1, 4096);
+    const std::uint64_t divisor = std::max<std::uint64_t>(numPoints, 1);
+    const int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    const std::size_t numBlocks = std::min<std::size_t>(threads, numFacets);
+
+    auto edgeKey = [](PointIndex p0, PointIndex p1) {
+        return (std::uint64_t(std::min(p0, p1)) << 32) | std::uint64_t(std::max(p0, p1));
+    };
+    auto bucketOf = [numBuckets, divisor](std::uint64_t key) {
+        return std::min<std::size_t>((key >> 32) * numBuckets / divisor, numBuckets - 1);
+    };
+
+    // count the edges per block and bucket
+    std::atomic<bool> fits {true};
+    std::vector<std::vector<std::size_t>> counts(numBlocks, std::vector<std::size_t>(numBuckets));
+    MeshCore::parallel_for(numFacets,
+                           static_cast<int>(numBlocks),
+                           [&](std::size_t begin, std::size_t end, std::size_t block) {
+                               std::vector<std::size_t>& count = counts[block];
+                               for (std::size_t i = begin; i < end; i++) {
+                                   const MeshFacet& facet = facets[index + i];
+                                   for (int j = 0; j < 3; j++) {
+                                       PointIndex p0 = facet._aulPoints[j];
+                                       PointIndex p1 = facet._aulPoints[(j + 1) % 3];
+                                       if (p0 > maxIndex || p1 > maxIndex) {
+                                           fits = false;
+                                           return;
+                                       }
+                                       count[bucketOf(edgeKey(p0, p1))]++;
+                                   }
+                               }
+                           });
+    if (!fits) {
+        return false;
+    }
+
+    std::vector<std::size_t> bucketStart(numBuckets + 1);
+    std::size_t offset = 0;
+    for (std::size_t bucket = 0; bucket < numBuckets; bucket++) {
+        bucketStart[bucket] = offset;
+        for (std::size_t block = 0; block < numBlocks; block++) {
+            std::size_t count = counts[block][bucket];
+            counts[block][bucket] = offset;
+            offset += count;
+        }
+    }
+    bucketStart[numBuckets] = offset;
+
+    std::vector<Edge_Key> edges(offset);
+    MeshCore::parallel_for(numFacets,
+                           static_cast<int>(numBlocks),
+                           [&](std::size_t begin, std::size_t end, std::size_t block) {
+                               std::vector<std::size_t>& position = counts[block];
+                               for (std::size_t i = begin; i < end; i++) {
+                                   const MeshFacet& facet = facets[index + i];
+                                   for (int j = 0; j < 3; j++) {
+                                       Edge_Key edge {};
+                                       edge.key = edgeKey(facet._aulPoints[j],
+                                                          facet._aulPoints[(j + 1) % 3]);
+                                       edge.facetSide = ((index + i) << 2) | std::uint64_t(j);
+                                       edges[position[bucketOf(edge.key)]++] = edge;
+                                   }
+                               }
+                           });
+    counts.clear();
+
+    // Every side of a facet belongs to exactly one edge, so the buckets can be processed
+    // concurrently. We handle only the cases for 1 and 2, for all higher values we have a
+    // non-manifold that is ignored here
+    MeshCore::parallel_for(numBuckets,
+                           threads,
+                           [&](std::size_t begin, std::size_t end, std::size_t) {
+                               auto first = edges.begin() + bucketStart[begin];
+                               auto last = edges.begin() + bucketStart[end];
+                               std::sort(first, last);
+                               for (auto it = first; it != last;) {
+                                   auto next = it + 1;
+                                   while (next != last && next->key == it->key) {
+                                       ++next;
+                                   }
+
+                                   FacetIndex f0 = it->facetSide >> 2;
+                                   if (next - it == 2) {
+                                       FacetIndex f1 = (it + 1)->facetSide >> 2;
+                                       facets[f0]._aulNeighbours[it->facetSide & 3] = f1;
+                                       facets[f1]._aulNeighbours[(it + 1)->facetSide & 3] = f0;
+                                   }
+                                   else if (next - it == 1) {
+                                       facets[f0]._aulNeighbours[it->facetSide & 3] =
+                                           FACET_INDEX_MAX;
+                                   }
+                                   it = next;
+                               }
+                           });
+
+    return true;
+}
+
 }  // namespace MeshCore
 
 bool MeshEvalTopology::Evaluate()
@@ -597,182 +839,179 @@ bool MeshFixSingleFacet::Fixup()
 
 // ----------------------------------------------------------------
 
-bool MeshEvalSelfIntersection::Evaluate()
+namespace
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
 
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
+using FacetPair = std::pair<FacetIndex, FacetIndex>;
 
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
+bool ShareCommonVertex(const MeshFacet& rface1, const MeshFacet& rface2)
+{
+    for (PointIndex p1 : rface1._aulPoints) {
+        for (PointIndex p2 : rface2._aulPoints) {
+            if (p1 == p2) {
+                return true;
+            }
+        }
     }
 
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        // Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
+    return false;
+}
 
-        seq.next();
-        if (aulGridElements.empty()) {
-            continue;
+/**
+ * Tests the facets of each grid cell pairwise for intersections. The non-empty cells are
+ * collected in batches that are processed by several threads while the calling thread
+ * reports the progress after each batch, so that the user can cancel the check.
+ * If \a stopAtFirst is true the search stops after the first intersection.
+ * The returned pairs are sorted and unique with the lower facet index first.
+ */
+std::vector<FacetPair>
+FindSelfIntersections(const MeshKernel& mesh, bool stopAtFirst, bool canAbort)
+{
+    const MeshFacetArray& rFaces = mesh.GetFacets();
+    const int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    // Contains bounding boxes for every facet
+    std::vector<Base::BoundBox3f> boxes(rFaces.size());
+    parallel_for(rFaces.size(), threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; i++) {
+            boxes[i] = mesh.GetFacet(rFaces[i]).GetBoundBox();
         }
+    });
 
-        MeshGeomFacet facet1, facet2;
+    std::atomic<bool> stop {false};
+    std::vector<std::vector<FacetPair>> found(threads);
+    auto checkCell = [&](const std::vector<FacetIndex>& elements, std::vector<FacetPair>& pairs) {
         Base::Vector3f pt1, pt2;
-        for (auto it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
+        for (auto it = elements.begin(); it != elements.end() && !stop; ++it) {
             const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
             const MeshFacet& rface1 = rFaces[*it];
-            for (auto jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
+            MeshGeomFacet facet1 = mesh.GetFacet(rface1);
+            for (auto jt = it + 1; jt != elements.end(); ++jt) {
                 // If the facets share a common vertex we do not check for self-intersections
                 // because they could but usually do not intersect each other and the algorithm
                 // below would detect false-positives, otherwise
                 const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0]
-                    || rface1._aulPoints[0] == rface2._aulPoints[1]
-                    || rface1._aulPoints[0] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[1] == rface2._aulPoints[0]
-                    || rface1._aulPoints[1] == rface2._aulPoints[1]
-                    || rface1._aulPoints[1] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[2] == rface2._aulPoints[0]
-                    || rface1._aulPoints[2] == rface2._aulPoints[1]
-                    || rface1._aulPoints[2] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
+                if (ShareCommonVertex(rface1, rface2)) {
+                    continue;
                 }
 
                 const Base::BoundBox3f& box2 = boxes[*jt];
                 if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
+                    MeshGeomFacet facet2 = mesh.GetFacet(rface2);
                     int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
                     if (ret == 2) {
-                        // abort after the first detected self-intersection
-                        return false;
+                        pairs.emplace_back(std::min(*it, *jt), std::max(*it, *jt));
+                        if (stopAtFirst) {
+                            stop = true;
+                            return;
+                        }
                     }
                 }
             }
         }
-    }
-
-    return true;
-}
-
-void MeshEvalSelfIntersection::GetIntersections(
-    const std::vector<std::pair<FacetIndex, FacetIndex>>& indices,
-    std::vector<std::pair<Base::Vector3f, Base::Vector3f>>& intersection) const
-{
-    intersection.reserve(indices.size());
-    MeshFacetIterator cMF1(_rclMesh);
-    MeshFacetIterator cMF2(_rclMesh);
-
-    Base::Vector3f pt1, pt2;
-    std::vector<std::pair<FacetIndex, FacetIndex>>::const_iterator it;
-    for (it = indices.begin(); it != indices.end(); ++it) {
-        cMF1.Set(it->first);
-        cMF2.Set(it->second);
-
-        Base::BoundBox3f box1 = cMF1->GetBoundBox();
-        Base::BoundBox3f box2 = cMF2->GetBoundBox();
-        if (box1 && box2) {
-            int ret = cMF1->IntersectWithFacet(*cMF2, pt1, pt2);
-            if (ret == 2) {
-                intersection.emplace_back(pt1, pt2);
+    };
+
+    // The cells are handed out one by one because their sizes differ a lot
+    std::vector<std::vector<FacetIndex>> batch;
+    auto checkBatch = [&]() {
+        std::atomic<std::size_t> nextCell {0};
+        parallel_for(threads, threads, [&](std::size_t, std::size_t, std::size_t block) {
+            for (std::size_t i = nextCell++; i < batch.size() && !stop; i = nextCell++) {
+                checkCell(batch[i], found[block]);
             }
-        }
-    }
-}
-
-void MeshEvalSelfIntersection::GetIntersections(
-    std::vector<std::pair<FacetIndex, FacetIndex>>& intersection) const
-{
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
-    // intersection.clear();
+        });
+        batch.clear();
+    };
 
     // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
+    MeshFacetGrid cMeshFacetGrid(mesh);
     MeshGridIterator clGridIter(cMeshFacetGrid);
     unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
     cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
 
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
     // Calculates the intersections
+    const std::size_t maxBatchPairs = 1 << 20;
+    std::size_t batchPairs = 0;
+    std::size_t batchCells = 0;
     Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
+    for (clGridIter.Init(); clGridIter.More() && !stop; clGridIter.Next()) {
         // Get the facet indices, belonging to the current grid unit
         std::vector<FacetIndex> aulGridElements;
         clGridIter.GetElements(aulGridElements);
 
-        seq.next(true);
-        if (aulGridElements.empty()) {
-            continue;
+        batchCells++;
+        if (aulGridElements.size() > 1) {
+            batchPairs += aulGridElements.size() * (aulGridElements.size() - 1) / 2;
+            batch.push_back(std::move(aulGridElements));
         }
 
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (auto it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (auto jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
-                // If the facets share a common vertex we do not check for self-intersections
-                // because they could but usually do not intersect each other and the algorithm
-                // below would detect false-positives, otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0]
-                    || rface1._aulPoints[0] == rface2._aulPoints[1]
-                    || rface1._aulPoints[0] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[1] == rface2._aulPoints[0]
-                    || rface1._aulPoints[1] == rface2._aulPoints[1]
-                    || rface1._aulPoints[1] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[2] == rface2._aulPoints[0]
-                    || rface1._aulPoints[2] == rface2._aulPoints[1]
-                    || rface1._aulPoints[2] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        intersection.emplace_back(*it, *jt);
-                    }
-                }
+        if (batchPairs >= maxBatchPairs) {
+            checkBatch();
+            batchPairs = 0;
+            for (; batchCells > 0; batchCells--) {
+                seq.next(canAbort);
             }
         }
     }
+
+    checkBatch();
+
+    std::vector<FacetPair> intersection;
+    for (const auto& pairs : found) {
+        intersection.insert(intersection.end(), pairs.begin(), pairs.end());
+    }
+
+    // a pair of facets can be found in several grid cells
+    std::sort(intersection.begin(), intersection.end());
+    intersection.erase(std::unique(intersection.begin(), intersection.end()), intersection.end());
+    return intersection;
+}
+
+}  // namespace
+
+bool MeshEvalSelfIntersection::Evaluate()
+{
+    return FindSelfIntersections(_rclMesh, true, false).empty();
+}
+
+void MeshEvalSelfIntersection::GetIntersections(
+    const std::vector<std::pair<FacetIndex, FacetIndex>>& indices,
+    std::vector<std::pair<Base::Vector3f, Base::Vector3f>>& intersection) const
+{
+    // the lines are collected per block and appended in the order of the blocks
+    using Line = std::pair<Base::Vector3f, Base::Vector3f>;
+    const int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::vector<std::vector<Line>> lines(threads);
+    parallel_for(indices.size(),
+                 threads,
+                 [&](std::size_t begin, std::size_t end, std::size_t block) {
+                     Base::Vector3f pt1, pt2;
+                     for (std::size_t i = begin; i < end; i++) {
+                         MeshGeomFacet facet1 = _rclMesh.GetFacet(indices[i].first);
+                         MeshGeomFacet facet2 = _rclMesh.GetFacet(indices[i].second);
+
+                         Base::BoundBox3f box1 = facet1.GetBoundBox();
+                         Base::BoundBox3f box2 = facet2.GetBoundBox();
+                         if (box1 && box2) {
+                             int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
+                             if (ret == 2) {
+                                 lines[block].emplace_back(pt1, pt2);
+                             }
+                         }
+                     }
+                 });
+
+    intersection.reserve(intersection.size() + indices.size());
+    for (const auto& it : lines) {
+        intersection.insert(intersection.end(), it.begin(), it.end());
+    }
+}
+
+void MeshEvalSelfIntersection::GetIntersections(
+    std::vector<std::pair<FacetIndex, FacetIndex>>& intersection) const
+{
+    std::vector<FacetPair> pairs = FindSelfIntersections(_rclMesh, false, true);
+    intersection.insert(intersection.end(), pairs.begin(), pairs.end());
 }
 
 std::vector<FacetIndex> MeshFixSelfIntersection::GetFacets() const
@@ -968,6 +1207,14 @@ bool MeshFixNeighbourhood::Fixup()
 
 void MeshKernel::RebuildNeighbours(FacetIndex index)
 {
+    if (index >= this->_aclFacetArray.size()) {
+        return;
+    }
+    if (this->_aclPointArray.size() <= std::numeric_limits<std::uint32_t>::max()
+        && RebuildNeighboursPacked(this->_aclFacetArray, index, this->_aclPointArray.size())) {
+        return;
+    }
+
     std::vector<Edge_Index> edges;
     edges.reserve(3 * (this->_aclFacetArray.size() - index));
 
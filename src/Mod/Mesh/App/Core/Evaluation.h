@@ -24,6 +24,7 @@
 #define MESH_EVALUATION_H
 
 #include <cmath>
+#include <functional>
 #include <list>
 
 #include "MeshKernel.h"
@@ -102,6 +103,42 @@ protected:
 
 // ----------------------------------------------------
 
+/**
+ * The MeshEvaluationRunner class runs independent checks of a mesh concurrently.
+ * The checks must only read the mesh kernel. Checks that use the facet or point
+ * flags must not be added to the same runner because the flags are shared.
+ * The progress is reported by the calling thread after each finished check, where
+ * the user can also cancel the run. Cancelling does not interrupt checks that are
+ * already running but prevents pending checks from being started.
+ */
+class MeshExport MeshEvaluationRunner
+{
+public:
+    /// If \a threads is less than one the number of hardware threads is used.
+    explicit MeshEvaluationRunner(int threads = 0);
+
+    /// Adds a check.
+    void Add(std::function<void()> check);
+    /// Adds an evaluation whose result of MeshEvaluation::Evaluate() is written to \a result.
+    void Add(MeshEvaluation& eval, bool& result);
+    /// Returns the number of added checks.
+    std::size_t Count() const
+    {
+        return checks.size();
+    }
+    /**
+     * Runs all checks and waits until they have finished. If the user cancels the run
+     * Base::AbortException is thrown. An exception thrown by a check is re-thrown.
+     */
+    void Run(const char* text, bool canAbort = true);
+
+private:
+    std::vector<std::function<void()>> checks;
+    int threads;
+};
+
+// ----------------------------------------------------
+
 /**
  * This class searches for nonuniform orientation of neighboured facets.
  * @author Werner Mayer
@@ -322,6 +359,7 @@ private:
 
 /**
  * The MeshEvalSelfIntersection class checks the mesh for self intersection.
+ * The cells of a facet grid are checked by several threads.
  * @author Werner Mayer
  */
 class MeshExport MeshEvalSelfIntersection: public MeshEvaluation
@@ -335,7 +373,8 @@ public:
     /// collect all intersection lines
     void GetIntersections(const std::vector<std::pair<FacetIndex, FacetIndex>>&,
                           std::vector<std::pair<Base::Vector3f, Base::Vector3f>>&) const;
-    /// collect the index of all facets with self intersections
+    /// collect the index of all facets with self intersections, each pair is appended once
+    /// with the lower index first and the appended pairs are sorted
     void GetIntersections(std::vector<std::pair<FacetIndex, FacetIndex>>&) const;
 };
 
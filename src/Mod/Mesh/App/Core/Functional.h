@@ -25,6 +25,10 @@
 
 #include <algorithm>
 #include <future>
+#include <thread>
+#include <vector>
+
+#include <Base/Parallel.h>
 
 
 namespace MeshCore
@@ -62,6 +66,8 @@ static void parallel_sort(Iter begin, Iter end, Pred comp, int threads)
     }
 }
 
+using Base::parallel_for;
+
 }  // namespace MeshCore
 
 
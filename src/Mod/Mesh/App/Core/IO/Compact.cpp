@@ -0,0 +1,643 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+#endif
+
+#include "Core/Functional.h"
+#include "Core/MeshKernel.h"
+#include <Base/Exception.h>
+#include <Base/Stream.h>
+#include <Base/Swap.h>
+
+#include "Compact.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+// Number of points or facets per chunk
+constexpr uint32_t chunkSize = 1 << 16;
+constexpr uint32_t magicNumber = 0xA0B0C0D0;
+
+enum PointMode : uint32_t
+{
+    Lossless = 0,
+    Quantized = 1
+};
+
+enum ChunkMode : unsigned char
+{
+    Raw = 0,
+    Rans = 1
+};
+
+// Order-0 rANS with byte-wise renormalization, see "Interleaved entropy coders" by F. Giesen
+constexpr uint32_t scaleBits = 12;
+constexpr uint32_t scaleTotal = 1U << scaleBits;
+constexpr uint32_t ransLow = 1U << 23;
+
+void putVarint(std::string& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+uint64_t getVarint(const unsigned char*& it, const unsigned char* end)
+{
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (it == end) {
+            break;
+        }
+        unsigned char byte = *it++;
+        value |= uint64_t(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw Base::BadFormatError("Invalid compact mesh data");
+}
+
+uint64_t zigzag(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Maps the bits of a float to an unsigned integer with the same ordering
+uint32_t floatToOrdered(float value)
+{
+    uint32_t bits {};
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000U) != 0 ? ~bits : bits | 0x80000000U;
+}
+
+float orderedToFloat(uint32_t bits)
+{
+    bits = (bits & 0x80000000U) != 0 ? bits & 0x7fffffffU : ~bits;
+    float value {};
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+struct SymbolTable
+{
+    std::array<uint32_t, 256> freq {};
+    std::array<uint32_t, 256> start {};
+
+    void computeStart()
+    {
+        uint32_t sum = 0;
+        for (std::size_t i = 0; i < freq.size(); i++) {
+            start[i] = sum;
+            sum += freq[i];
+        }
+    }
+};
+
+// Scales the byte histogram so that the frequencies sum up to scaleTotal and every occurring
+// byte keeps a non-zero frequency
+SymbolTable buildTable(const std::string& data)
+{
+    std::array<uint64_t, 256> counts {};
+    for (char c : data) {
+        counts[static_cast<unsigned char>(c)]++;
+    }
+
+    SymbolTable table;
+    uint32_t sum = 0;
+    for (std::size_t i = 0; i < counts.size(); i++) {
+        if (counts[i] > 0) {
+            table.freq[i] = std::max<uint32_t>(1, counts[i] * scaleTotal / data.size());
+            sum += table.freq[i];
+        }
+    }
+
+    auto largest = [&table]() {
+        return std::max_element(table.freq.begin(), table.freq.end());
+    };
+    if (sum < scaleTotal) {
+        *largest() += scaleTotal - sum;
+    }
+    while (sum > scaleTotal) {
+        (*largest())--;
+        sum--;
+    }
+
+    table.computeStart();
+    return table;
+}
+
+// Entropy codes a chunk, falls back to the raw bytes if that isn't smaller
+std::string compress(const std::string& data)
+{
+    std::string out;
+    if (!data.empty()) {
+        SymbolTable table = buildTable(data);
+
+        std::string bytes;
+        bytes.reserve(data.size());
+        uint32_t state = ransLow;
+        for (std::size_t i = data.size(); i-- > 0;) {
+            auto sym = static_cast<unsigned char>(data[i]);
+            uint32_t freq = table.freq[sym];
+            uint32_t limit = ((ransLow >> scaleBits) << 8) * freq;
+            while (state >= limit) {
+                bytes.push_back(static_cast<char>(state & 0xff));
+                state >>= 8;
+            }
+            state = ((state / freq) << scaleBits) + (state % freq) + table.start[sym];
+        }
+        for (int i = 0; i < 4; i++) {
+            bytes.push_back(static_cast<char>(state & 0xff));
+            state >>= 8;
+        }
+        std::reverse(bytes.begin(), bytes.end());
+
+        out.push_back(static_cast<char>(Rans));
+        putVarint(out, data.size());
+        auto symbols = std::count_if(table.freq.begin(), table.freq.end(), [](uint32_t freq) {
+            return freq > 0;
+        });
+        out.push_back(static_cast<char>(symbols - 1));
+        for (std::size_t i = 0; i < table.freq.size(); i++) {
+            if (table.freq[i] > 0) {
+                out.push_back(static_cast<char>(i));
+                putVarint(out, table.freq[i]);
+            }
+        }
+        out.append(bytes);
+    }
+
+    if (out.empty() || out.size() > data.size() + 1) {
+        out.assign(1, static_cast<char>(Raw));
+        out.append(data);
+    }
+    return out;
+}
+
+std::string decompress(const unsigned char* it, const unsigned char* end)
+{
+    if (it == end) {
+        throw Base::BadFormatError("Invalid compact mesh data");
+    }
+    unsigned char mode = *it++;
+    if (mode == Raw) {
+        return {reinterpret_cast<const char*>(it), static_cast<std::size_t>(end - it)};
+    }
+    if (mode != Rans) {
+        throw Base::BadFormatError("Invalid compact mesh data");
+    }
+
+    uint64_t size = getVarint(it, end);
+    if (it == end) {
+        throw Base::BadFormatError("Invalid compact mesh data");
+    }
+    int symbols = *it++ + 1;
+    SymbolTable table;
+    uint32_t sum = 0;
+    for (int i = 0; i < symbols; i++) {
+        if (it == end) {
+            throw Base::BadFormatError("Invalid compact mesh data");
+        }
+        unsigned char sym = *it++;
+        uint64_t freq = getVarint(it, end);
+        if (freq == 0 || freq > scaleTotal) {
+            throw Base::BadFormatError("Invalid compact mesh data");
+        }
+        table.freq[sym] = static_cast<uint32_t>(freq);
+        sum += static_cast<uint32_t>(freq);
+    }
+    if (sum != scaleTotal || end - it < 4) {
+        throw Base::BadFormatError("Invalid compact mesh data");
+    }
+    table.computeStart();
+
+    std::array<unsigned char, scaleTotal> slots {};
+    for (std::size_t i = 0; i < table.freq.size(); i++) {
+        std::fill_n(slots.begin() + table.start[i], table.freq[i], static_cast<unsigned char>(i));
+    }
+
+    uint32_t state = 0;
+    for (int i = 0; i < 4; i++) {
+        state = (state << 8) | *it++;
+    }
+
+    std::string data(size, '\0');
+    for (auto& c : data) {
+        unsigned char sym = slots[state & (scaleTotal - 1)];
+        c = static_cast<char>(sym);
+        state = table.freq[sym] * (state >> scaleBits) + (state & (scaleTotal - 1))
+            - table.start[sym];
+        while (state < ransLow) {
+            if (it == end) {
+                throw Base::BadFormatError("Invalid compact mesh data");
+            }
+            state = (state << 8) | *it++;
+        }
+    }
+
+    return data;
+}
+
+struct Quantization
+{
+    uint32_t mode = Lossless;
+    double step = 0.0;
+    std::array<double, 3> origin {};
+};
+
+Quantization quantization(const MeshPointArray& points, float tolerance)
+{
+    Quantization quant;
+    if (tolerance <= 0.0F || points.empty()) {
+        return quant;
+    }
+
+    std::array<double, 3> minimum, maximum;
+    minimum.fill(std::numeric_limits<double>::max());
+    maximum.fill(std::numeric_limits<double>::lowest());
+    for (const auto& point : points) {
+        for (int i = 0; i < 3; i++) {
+            minimum[i] = std::min<double>(minimum[i], point[i]);
+            maximum[i] = std::max<double>(maximum[i], point[i]);
+        }
+    }
+
+    // round to a grid of twice the tolerance so that a coordinate moves by at most the tolerance
+    double step = 2.0 * double(tolerance);
+    for (int i = 0; i < 3; i++) {
+        double cells = (maximum[i] - minimum[i]) / step;
+        if (!std::isfinite(cells) || cells >= double(std::numeric_limits<int32_t>::max())) {
+            return quant;
+        }
+    }
+
+    quant.mode = Quantized;
+    quant.step = step;
+    quant.origin = minimum;
+    return quant;
+}
+
+std::string encodePoints(const MeshPointArray& points,
+                         std::size_t begin,
+                         std::size_t end,
+                         const Quantization& quant)
+{
+    std::string data;
+    data.reserve(6 * (end - begin));
+    std::array<int64_t, 3> prev {};
+    for (std::size_t index = begin; index < end; index++) {
+        const MeshPoint& point = points[index];
+        for (int i = 0; i < 3; i++) {
+            int64_t value {};
+            if (quant.mode == Quantized) {
+                value = std::llround((double(point[i]) - quant.origin[i]) / quant.step);
+            }
+            else {
+                value = floatToOrdered(point[i]);
+            }
+            putVarint(data, zigzag(value - prev[i]));
+            prev[i] = value;
+        }
+    }
+    return data;
+}
+
+void decodePoints(const std::string& data,
+                  MeshPointArray& points,
+                  std::size_t begin,
+                  std::size_t end,
+                  const Quantization& quant)
+{
+    const auto* it = reinterpret_cast<const unsigned char*>(data.data());
+    const auto* last = it + data.size();
+    std::array<int64_t, 3> prev {};
+    for (std::size_t index = begin; index < end; index++) {
+        MeshPoint& point = points[index];
+        for (int i = 0; i < 3; i++) {
+            prev[i] += unzigzag(getVarint(it, last));
+            if (quant.mode == Quantized) {
+                point[i] = static_cast<float>(quant.origin[i] + double(prev[i]) * quant.step);
+            }
+            else {
+                point[i] = orderedToFloat(static_cast<uint32_t>(prev[i]));
+            }
+        }
+    }
+}
+
+// The first corner is coded relative to the first corner of the previous facet and the other
+// corners relative to the first one
+std::string encodeFacets(const MeshFacetArray& facets, std::size_t begin, std::size_t end)
+{
+    std::string data;
+    data.reserve(4 * (end - begin));
+    PointIndex prev = 0;
+    for (std::size_t index = begin; index < end; index++) {
+        const MeshFacet& facet = facets[index];
+        PointIndex p0 = facet._aulPoints[0];
+        putVarint(data, zigzag(static_cast<int64_t>(p0 - prev)));
+        putVarint(data, zigzag(static_cast<int64_t>(facet._aulPoints[1] - p0)));
+        putVarint(data, zigzag(static_cast<int64_t>(facet._aulPoints[2] - p0)));
+        prev = p0;
+    }
+    return data;
+}
+
+void decodeFacets(const std::string& data,
+                  MeshFacetArray& facets,
+                  std::size_t begin,
+                  std::size_t end,
+                  std::size_t numPoints)
+{
+    const auto* it = reinterpret_cast<const unsigned char*>(data.data());
+    const auto* last = it + data.size();
+    PointIndex prev = 0;
+    for (std::size_t index = begin; index < end; index++) {
+        MeshFacet& facet = facets[index];
+        PointIndex p0 = prev + static_cast<PointIndex>(unzigzag(getVarint(it, last)));
+        PointIndex p1 = p0 + static_cast<PointIndex>(unzigzag(getVarint(it, last)));
+        PointIndex p2 = p0 + static_cast<PointIndex>(unzigzag(getVarint(it, last)));
+        if (p0 >= numPoints || p1 >= numPoints || p2 >= numPoints) {
+            throw Base::BadFormatError("Invalid data structure");
+        }
+        facet._aulPoints[0] = p0;
+        facet._aulPoints[1] = p1;
+        facet._aulPoints[2] = p2;
+        prev = p0;
+    }
+}
+
+// Lists the neighbours that differ from the rebuilt neighbourhood
+std::string encodeNeighbours(const MeshKernel& kernel)
+{
+    // start from open edges like the reader, non-manifold edges are not linked by the rebuild
+    MeshPointArray points(kernel.GetPoints());
+    MeshFacetArray corners;
+    corners.reserve(kernel.CountFacets());
+    for (const auto& facet : kernel.GetFacets()) {
+        corners.emplace_back(facet._aulPoints[0], facet._aulPoints[1], facet._aulPoints[2]);
+    }
+    MeshKernel rebuilt;
+    rebuilt.Adopt(points, corners, true);
+
+    const MeshFacetArray& facets = kernel.GetFacets();
+    const MeshFacetArray& canonical = rebuilt.GetFacets();
+    std::string entries;
+    uint64_t count = 0;
+    uint64_t prev = 0;
+    for (std::size_t index = 0; index < facets.size(); index++) {
+        for (int side = 0; side < 3; side++) {
+            FacetIndex neighbour = facets[index]._aulNeighbours[side];
+            if (neighbour != canonical[index]._aulNeighbours[side]) {
+                uint64_t key = 3 * uint64_t(index) + side;
+                putVarint(entries, key - prev);
+                putVarint(entries, neighbour < facets.size() ? uint64_t(neighbour) + 1 : 0);
+                prev = key;
+                count++;
+            }
+        }
+    }
+
+    std::string data;
+    putVarint(data, count);
+    data.append(entries);
+    return data;
+}
+
+void decodeNeighbours(const std::string& data, MeshFacetArray& facets)
+{
+    const auto* it = reinterpret_cast<const unsigned char*>(data.data());
+    const auto* last = it + data.size();
+    uint64_t count = getVarint(it, last);
+    uint64_t key = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        key += getVarint(it, last);
+        uint64_t neighbour = getVarint(it, last);
+        if (key / 3 >= facets.size() || neighbour > facets.size()) {
+            throw Base::BadFormatError("Invalid data structure");
+        }
+        facets[key / 3]._aulNeighbours[key % 3] =
+            neighbour > 0 ? FacetIndex(neighbour - 1) : FACET_INDEX_MAX;
+    }
+}
+
+std::size_t countChunks(std::size_t count)
+{
+    return (count + chunkSize - 1) / chunkSize;
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------------
+
+WriterCompact::WriterCompact(const MeshKernel& kernel, int threads)
+    : _kernel(kernel)
+    , _threads(threads)
+{}
+
+void WriterCompact::SetTolerance(float tol)
+{
+    _tolerance = std::max(tol, 0.0F);
+}
+
+bool WriterCompact::Save(std::ostream& out) const
+{
+    if (!out || out.bad()) {
+        return false;
+    }
+
+    const MeshPointArray& points = _kernel.GetPoints();
+    const MeshFacetArray& facets = _kernel.GetFacets();
+    if (points.size() > std::numeric_limits<uint32_t>::max()
+        || facets.size() > std::numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+
+    Quantization quant = quantization(points, _tolerance);
+    std::size_t numPointChunks = countChunks(points.size());
+    std::size_t numFacetChunks = countChunks(facets.size());
+
+    // the last chunk holds the neighbours that cannot be restored by rebuilding them
+    std::vector<std::string> chunks(numPointChunks + numFacetChunks + 1);
+    parallel_for(chunks.size(),
+                 _threads,
+                 [&](std::size_t begin, std::size_t end, std::size_t /*block*/) {
+                     for (std::size_t i = begin; i < end; i++) {
+                         std::string data;
+                         if (i < numPointChunks) {
+                             std::size_t first = i * chunkSize;
+                             std::size_t last = std::min(first + chunkSize, points.size());
+                             data = encodePoints(points, first, last, quant);
+                         }
+                         else if (i < numPointChunks + numFacetChunks) {
+                             std::size_t first = (i - numPointChunks) * chunkSize;
+                             std::size_t last = std::min(first + chunkSize, facets.size());
+                             data = encodeFacets(facets, first, last);
+                         }
+                         else {
+                             data = encodeNeighbours(_kernel);
+                         }
+                         chunks[i] = compress(data);
+                     }
+                 });
+
+    // fail before anything is written so that the caller can fall back to another format
+    for (const auto& chunk : chunks) {
+        if (chunk.size() > std::numeric_limits<uint32_t>::max()) {
+            return false;
+        }
+    }
+
+    Base::OutputStream str(out);
+    str << magicNumber << Version;
+    str << static_cast<uint32_t>(points.size()) << static_cast<uint32_t>(facets.size());
+    str << chunkSize << quant.mode << quant.step;
+    str << quant.origin[0] << quant.origin[1] << quant.origin[2];
+    for (const auto& chunk : chunks) {
+        str << static_cast<uint32_t>(chunk.size());
+    }
+    for (const auto& chunk : chunks) {
+        out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    }
+
+    return out.good();
+}
+
+// ----------------------------------------------------------------------------
+
+ReaderCompact::ReaderCompact(MeshKernel& kernel, int threads)
+    : _kernel(kernel)
+    , _threads(threads)
+{}
+
+bool ReaderCompact::Load(std::istream& in)
+{
+    if (!in || in.bad()) {
+        return false;
+    }
+
+    Base::InputStream str(in);
+    uint32_t magic {}, version {};
+    str >> magic >> version;
+    if (magic == magicNumber && version == WriterCompact::Version) {
+        LoadData(in, false);
+        return true;
+    }
+
+    Base::SwapEndian(magic);
+    Base::SwapEndian(version);
+    if (magic == magicNumber && version == WriterCompact::Version) {
+        LoadData(in, true);
+        return true;
+    }
+
+    return false;
+}
+
+void ReaderCompact::LoadData(std::istream& in, bool swap)
+{
+    Base::InputStream str(in);
+    if (swap) {
+        str.setByteOrder(Base::Stream::BigEndian);
+    }
+
+    uint32_t numPoints {}, numFacets {}, size {};
+    Quantization quant;
+    str >> numPoints >> numFacets >> size >> quant.mode >> quant.step;
+    str >> quant.origin[0] >> quant.origin[1] >> quant.origin[2];
+    if (!in || size != chunkSize || quant.mode > Quantized) {
+        throw Base::BadFormatError("Reading from stream failed");
+    }
+
+    std::size_t numPointChunks = countChunks(numPoints);
+    std::size_t numFacetChunks = countChunks(numFacets);
+    std::vector<std::size_t> offsets(numPointChunks + numFacetChunks + 2);
+    for (std::size_t i = 1; i < offsets.size(); i++) {
+        uint32_t bytes {};
+        str >> bytes;
+        offsets[i] = offsets[i - 1] + bytes;
+    }
+
+    std::vector<unsigned char> buffer(offsets.back());
+    in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    if (!in) {
+        throw Base::BadFormatError("Reading from stream failed");
+    }
+
+    MeshPointArray points(numPoints);
+    MeshFacetArray facets(numFacets);
+    std::string neighbours;
+    parallel_for(offsets.size() - 1,
+                 _threads,
+                 [&](std::size_t begin, std::size_t end, std::size_t /*block*/) {
+                     for (std::size_t i = begin; i < end; i++) {
+                         std::string data = decompress(buffer.data() + offsets[i],
+                                                       buffer.data() + offsets[i + 1]);
+                         if (i < numPointChunks) {
+                             std::size_t first = i * chunkSize;
+                             std::size_t last = std::min<std::size_t>(first + chunkSize, numPoints);
+                             decodePoints(data, points, first, last, quant);
+                         }
+                         else if (i < numPointChunks + numFacetChunks) {
+                             std::size_t first = (i - numPointChunks) * chunkSize;
+                             std::size_t last = std::min<std::size_t>(first + chunkSize, numFacets);
+                             decodeFacets(data, facets, first, last, numPoints);
+                         }
+                         else {
+                             neighbours.swap(data);
+                         }
+                     }
+                 });
+
+    // rebuild the neighbourhood and restore the recorded deviations from it
+    _kernel.Adopt(points, facets, true);
+    try {
+        decodeNeighbours(neighbours, _kernel._aclFacetArray);
+    }
+    catch (const Base::BadFormatError&) {
+        _kernel.Clear();
+        throw;
+    }
+}
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#ifndef MESH_IO_COMPACT_H
+#define MESH_IO_COMPACT_H
+
+#include <cstdint>
+#include <iosfwd>
+
+#include <Mod/Mesh/MeshGlobal.h>
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/** Writes a mesh kernel in a compact binary format.
+ * The points can be quantized to a grid that respects a declared tolerance or are stored
+ * losslessly. Points and facets are split into chunks of fixed size which are delta coded and
+ * then entropy coded with an order-0 rANS coder, so that the chunks can be encoded and decoded
+ * concurrently.
+ *
+ * The neighbourhood is not stored but rebuilt when reading. Facets whose neighbours differ from
+ * the rebuilt ones, e.g. at non-manifold edges, are recorded explicitly so that the restored
+ * topology is identical to the written one.
+ */
+class MeshExport WriterCompact
+{
+public:
+    /// The version number that follows the magic number of the kernel format
+    static const uint32_t Version = 0x020000;
+
+    /*!
+     * \brief WriterCompact
+     * If \a threads is less than one the number of hardware threads is used.
+     */
+    explicit WriterCompact(const MeshKernel& kernel, int threads = 0);
+    /*!
+     * \brief Sets the maximum deviation of a written coordinate. A value of zero
+     * (the default) stores the points losslessly.
+     */
+    void SetTolerance(float tol);
+    float GetTolerance() const
+    {
+        return _tolerance;
+    }
+    /*!
+     * \brief Writes the mesh to the stream.
+     */
+    bool Save(std::ostream& out) const;
+
+private:
+    const MeshKernel& _kernel;
+    int _threads;
+    float _tolerance {0.0F};
+};
+
+/** Reads a mesh kernel written by WriterCompact.
+ */
+class MeshExport ReaderCompact
+{
+public:
+    /*!
+     * \brief ReaderCompact
+     * If \a threads is less than one the number of hardware threads is used.
+     */
+    explicit ReaderCompact(MeshKernel& kernel, int threads = 0);
+    /*!
+     * \brief Reads the mesh from the stream.
+     * \return true on success and false if the stream doesn't contain a compact mesh
+     * \note A BadFormatError exception is thrown if the data is corrupt.
+     */
+    bool Load(std::istream& in);
+    /*!
+     * \brief Reads the data that follows the magic and version number.
+     * If \a swap is true the header was written with a different byte order.
+     */
+    void LoadData(std::istream& in, bool swap);
+
+private:
+    MeshKernel& _kernel;
+    int _threads;
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_IO_COMPACT_H
@@ -0,0 +1,620 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#endif
+
+#include <QFile>
+
+#include "Core/Builder.h"
+#include "Core/Functional.h"
+#include "Core/MeshIO.h"
+#include "Core/MeshKernel.h"
+#include <Base/FileInfo.h>
+
+#include "ReaderMapped.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+// Below this size the data is parsed by a single thread
+constexpr std::size_t minChunkSize = 1 << 20;
+
+bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+const char* skipBlanks(const char* it, const char* end)
+{
+    while (it < end && isBlank(*it)) {
+        ++it;
+    }
+    return it;
+}
+
+const char* nextLine(const char* it, const char* end)
+{
+    const char* eol = static_cast<const char*>(std::memchr(it, '\n', end - it));
+    return eol ? eol + 1 : end;
+}
+
+// Checks case-insensitively if the line starts with the keyword followed by a blank
+bool startsWith(const char* it, const char* end, const char* keyword)
+{
+    for (; *keyword; ++keyword, ++it) {
+        if (it == end || std::tolower(static_cast<unsigned char>(*it)) != *keyword) {
+            return false;
+        }
+    }
+    return it < end && isBlank(*it);
+}
+
+bool readFloat(const char*& it, const char* end, float& value)
+{
+    // the mapped data is not null-terminated, so copy the token first
+    char token[64];
+    std::size_t len = 0;
+    it = skipBlanks(it, end);
+    while (it < end && !isBlank(*it) && *it != '\n' && len < sizeof(token) - 1) {
+        token[len++] = *it++;
+    }
+    token[len] = '\0';
+
+    char* last {};
+    value = std::strtof(token, &last);
+    return len > 0 && last == token + len;
+}
+
+bool readIndex(const char*& it, const char* end, long& value)
+{
+    it = skipBlanks(it, end);
+    bool negative = false;
+    if (it < end && (*it == '-' || *it == '+')) {
+        negative = *it == '-';
+        ++it;
+    }
+    if (it == end || *it < '0' || *it > '9') {
+        return false;
+    }
+    value = 0;
+    while (it < end && *it >= '0' && *it <= '9') {
+        value = 10 * value + (*it++ - '0');
+    }
+    if (negative) {
+        value = -value;
+    }
+    // skip texture and normal indices
+    while (it < end && !isBlank(*it) && *it != '\n') {
+        ++it;
+    }
+    return true;
+}
+
+bool isEndOfLine(const char* it, const char* end)
+{
+    it = skipBlanks(it, end);
+    return it == end || *it == '\n';
+}
+
+bool isLittleEndian()
+{
+    const std::uint16_t value = 1;
+    unsigned char byte {};
+    std::memcpy(&byte, &value, 1);
+    return byte == 1;
+}
+
+int plyTypeSize(const std::string& type)
+{
+    if (type == "char" || type == "int8" || type == "uchar" || type == "uint8") {
+        return 1;
+    }
+    if (type == "short" || type == "int16" || type == "ushort" || type == "uint16") {
+        return 2;
+    }
+    if (type == "int" || type == "int32" || type == "uint" || type == "uint32" || type == "float"
+        || type == "float32") {
+        return 4;
+    }
+    if (type == "double" || type == "float64") {
+        return 8;
+    }
+    return 0;
+}
+
+template<typename T>
+T readValue(const char* data)
+{
+    T value {};
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+}  // namespace
+
+ReaderMapped::ReaderMapped(MeshKernel& kernel, int threads)
+    : _kernel(kernel)
+    , _threads(threads)
+{
+    if (_threads < 1) {
+        _threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+}
+
+bool ReaderMapped::Load(const std::string& filename)
+{
+    Base::FileInfo fi(filename);
+    QFile file(QString::fromStdString(fi.filePath()));
+    if (!file.open(QIODevice::ReadOnly) || file.size() == 0) {
+        return false;
+    }
+
+    const auto size = static_cast<std::size_t>(file.size());
+    uchar* map = file.map(0, file.size());
+    if (!map) {
+        return false;
+    }
+
+    const char* data = reinterpret_cast<const char*>(map);  // NOLINT
+    bool ok = false;
+    if (fi.hasExtension({"stl", "ast"})) {
+        ok = LoadSTL(data, size);
+    }
+    else if (fi.hasExtension("obj")) {
+        ok = LoadOBJ(data, size);
+    }
+    else if (fi.hasExtension("ply")) {
+        ok = LoadPLY(data, size);
+    }
+
+    file.unmap(map);
+    return ok;
+}
+
+std::vector<ReaderMapped::Chunk> ReaderMapped::splitLines(const char* data, std::size_t size) const
+{
+    std::size_t numChunks = std::max<std::size_t>(1, size / minChunkSize);
+    numChunks = std::min(numChunks, static_cast<std::size_t>(_threads));
+
+    std::vector<Chunk> chunks;
+    chunks.reserve(numChunks);
+    const char* end = data + size;
+    std::size_t begin = 0;
+    for (std::size_t i = 1; i <= numChunks && begin < size; i++) {
+        std::size_t pos = size;
+        if (i < numChunks) {
+            pos = std::max(begin, size / numChunks * i);
+            pos = nextLine(data + pos, end) - data;
+        }
+        chunks.push_back({begin, pos});
+        begin = pos;
+    }
+    return chunks;
+}
+
+void ReaderMapped::adoptCorners(const std::vector<Base::Vector3f>& corners)
+{
+    MeshPointArray points;
+    MeshFacetArray facets;
+    MeshPointWelder welder(_threads);
+    welder.Weld(corners, points, facets);
+
+    _kernel.Clear();
+    _kernel.Adopt(points, facets, true);
+}
+
+void ReaderMapped::adoptIndexed(MeshPointArray& points, MeshFacetArray& facets)
+{
+    _kernel.Clear();
+
+    MeshCleanup meshCleanup(points, facets);
+    meshCleanup.RemoveInvalids();
+    MeshPointFacetAdjacency meshAdj(points.size(), facets);
+    meshAdj.SetFacetNeighbourhood();
+    _kernel.Adopt(points, facets);
+}
+
+bool ReaderMapped::LoadSTL(const char* data, std::size_t size)
+{
+    // Same check as in MeshInput::LoadSTL: look for keywords after the 80 bytes of the header.
+    // Small files are left to the stream reader.
+    const std::size_t offset = 80 + sizeof(std::uint32_t);
+    if (size < offset + 100) {
+        return false;
+    }
+
+    // like strstr() the search ends at the first NUL byte
+    const char* begin = data + offset;
+    const char* end = begin + (readValue<std::uint32_t>(data + 80) > 1 ? 100 : 50);
+    std::string keys(begin, std::find(begin, end, '\0'));
+    std::transform(keys.begin(), keys.end(), keys.begin(), [](char c) {
+        return static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    });
+
+    for (const char* key : {"SOLID", "FACET", "NORMAL", "VERTEX", "ENDFACET", "ENDLOOP"}) {
+        if (keys.find(key) != std::string::npos) {
+            return LoadAsciiSTL(data, size);
+        }
+    }
+
+    return LoadBinarySTL(data, size);
+}
+
+bool ReaderMapped::LoadBinarySTL(const char* data, std::size_t size)
+{
+    const std::size_t offset = 80 + sizeof(std::uint32_t);
+    const std::size_t recordSize = 50;
+    if (size < offset) {
+        return false;
+    }
+
+    const std::size_t numFacets = readValue<std::uint32_t>(data + 80);
+    if (numFacets > (size - offset) / recordSize) {
+        return false;  // not a valid STL file
+    }
+
+    // a record consists of the normal, three points and two attribute bytes
+    std::vector<Base::Vector3f> corners(3 * numFacets);
+    parallel_for(numFacets, _threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; i++) {
+            const char* record = data + offset + i * recordSize + 3 * sizeof(float);
+            for (std::size_t j = 0; j < 3; j++) {
+                const char* pnt = record + j * 3 * sizeof(float);
+                corners[3 * i + j].Set(readValue<float>(pnt),
+                                       readValue<float>(pnt + sizeof(float)),
+                                       readValue<float>(pnt + 2 * sizeof(float)));
+            }
+        }
+    });
+
+    adoptCorners(corners);
+    return true;
+}
+
+bool ReaderMapped::LoadAsciiSTL(const char* data, std::size_t size)
+{
+    const char* const end = data + size;
+    std::vector<Chunk> chunks = splitLines(data, size);
+
+    // count the vertexes first so that each chunk can write to its final position
+    std::vector<std::size_t> offsets(chunks.size() + 1);
+    parallel_for(chunks.size(),
+                 static_cast<int>(chunks.size()),
+                 [&](std::size_t begin, std::size_t last, std::size_t) {
+                     for (std::size_t c = begin; c < last; c++) {
+                         std::size_t count = 0;
+                         const char* chunkEnd = data + chunks[c].end;
+                         for (const char* it = data + chunks[c].begin; it < chunkEnd;
+                              it = nextLine(it, end)) {
+                             if (startsWith(skipBlanks(it, chunkEnd), chunkEnd, "vertex")) {
+                                 count++;
+                             }
+                         }
+                         offsets[c + 1] = count;
+                     }
+                 });
+    for (std::size_t c = 0; c < chunks.size(); c++) {
+        offsets[c + 1] += offsets[c];
+    }
+
+    std::vector<Base::Vector3f> corners(offsets.back());
+    std::atomic<bool> valid {true};
+    parallel_for(chunks.size(),
+                 static_cast<int>(chunks.size()),
+                 [&](std::size_t begin, std::size_t last, std::size_t) {
+                     for (std::size_t c = begin; c < last; c++) {
+                         std::size_t index = offsets[c];
+                         const char* chunkEnd = data + chunks[c].end;
+                         for (const char* it = data + chunks[c].begin; it < chunkEnd;
+                              it = nextLine(it, end)) {
+                             const char* pos = skipBlanks(it, chunkEnd);
+                             if (!startsWith(pos, chunkEnd, "vertex")) {
+                                 continue;
+                             }
+                             pos += 6;
+                             Base::Vector3f& pnt = corners[index++];
+                             if (!readFloat(pos, chunkEnd, pnt.x) || !readFloat(pos, chunkEnd, pnt.y)
+                                 || !readFloat(pos, chunkEnd, pnt.z)) {
+                                 valid = false;
+                             }
+                         }
+                     }
+                 });
+
+    // let the stream reader handle malformed lines
+    if (!valid) {
+        return false;
+    }
+
+    adoptCorners(corners);
+    return true;
+}
+
+bool ReaderMapped::LoadOBJ(const char* data, std::size_t size)
+{
+    const char* const end = data + size;
+    std::vector<Chunk> chunks = splitLines(data, size);
+
+    // First pass: count points and triangles of each chunk and check for content that needs the
+    // stream reader, i.e. groups, materials, colors or polygons with more than four corners.
+    std::vector<std::size_t> pointOffsets(chunks.size() + 1);
+    std::vector<std::size_t> facetOffsets(chunks.size() + 1);
+    std::atomic<bool> supported {true};
+    parallel_for(
+        chunks.size(),
+        static_cast<int>(chunks.size()),
+        [&](std::size_t begin, std::size_t last, std::size_t) {
+            for (std::size_t c = begin; c < last; c++) {
+                std::size_t numPoints = 0;
+                std::size_t numFacets = 0;
+                const char* chunkEnd = data + chunks[c].end;
+                for (const char* it = data + chunks[c].begin; it < chunkEnd && supported;
+                     it = nextLine(it, end)) {
+                    const char* pos = skipBlanks(it, chunkEnd);
+                    if (startsWith(pos, chunkEnd, "v")) {
+                        float value {};
+                        pos += 1;
+                        bool ok = readFloat(pos, chunkEnd, value) && readFloat(pos, chunkEnd, value)
+                            && readFloat(pos, chunkEnd, value) && isEndOfLine(pos, chunkEnd);
+                        if (!ok) {
+                            supported = false;
+                        }
+                        numPoints++;
+                    }
+                    else if (startsWith(pos, chunkEnd, "f")) {
+                        long index {};
+                        int corners = 0;
+                        pos += 1;
+                        while (readIndex(pos, chunkEnd, index)) {
+                            corners++;
+                        }
+                        if ((corners != 3 && corners != 4) || !isEndOfLine(pos, chunkEnd)) {
+                            supported = false;
+                        }
+                        numFacets += corners - 2;
+                    }
+                    else if (startsWith(pos, chunkEnd, "g") || startsWith(pos, chunkEnd, "usemtl")
+                             || startsWith(pos, chunkEnd, "mtllib")) {
+                        supported = false;
+                    }
+                }
+                pointOffsets[c + 1] = numPoints;
+                facetOffsets[c + 1] = numFacets;
+            }
+        });
+
+    if (!supported) {
+        return false;
+    }
+
+    for (std::size_t c = 0; c < chunks.size(); c++) {
+        pointOffsets[c + 1] += pointOffsets[c];
+        facetOffsets[c + 1] += facetOffsets[c];
+    }
+
+    // Second pass: a negative index refers to the points read so far and is resolved with the
+    // number of points of the previous chunks
+    const std::size_t numPoints = pointOffsets.back();
+    MeshPointArray points(numPoints);
+    MeshFacetArray facets(facetOffsets.back());
+    parallel_for(
+        chunks.size(),
+        static_cast<int>(chunks.size()),
+        [&](std::size_t begin, std::size_t last, std::size_t) {
+            for (std::size_t c = begin; c < last; c++) {
+                std::size_t pointIndex = pointOffsets[c];
+                std::size_t facetIndex = facetOffsets[c];
+                const char* chunkEnd = data + chunks[c].end;
+                for (const char* it = data + chunks[c].begin; it < chunkEnd;
+                     it = nextLine(it, end)) {
+                    const char* pos = skipBlanks(it, chunkEnd);
+                    if (startsWith(pos, chunkEnd, "v")) {
+                        MeshPoint& pnt = points[pointIndex++];
+                        pos += 1;
+                        readFloat(pos, chunkEnd, pnt.x);
+                        readFloat(pos, chunkEnd, pnt.y);
+                        readFloat(pos, chunkEnd, pnt.z);
+                    }
+                    else if (startsWith(pos, chunkEnd, "f")) {
+                        PointIndex corners[4] {};
+                        int numCorners = 0;
+                        long index {};
+                        pos += 1;
+                        while (numCorners < 4 && readIndex(pos, chunkEnd, index)) {
+                            long value = index > 0 ? index - 1
+                                                   : index + static_cast<long>(pointIndex);
+                            corners[numCorners++] = value >= 0 && std::size_t(value) < numPoints
+                                ? static_cast<PointIndex>(value)
+                                : POINT_INDEX_MAX;
+                        }
+
+                        // same triangulation of quads as in ReaderOBJ
+                        facets[facetIndex++].SetVertices(corners[0], corners[1], corners[2]);
+                        if (numCorners == 4) {
+                            facets[facetIndex++].SetVertices(corners[2], corners[3], corners[0]);
+                        }
+                    }
+                }
+            }
+        });
+
+    adoptIndexed(points, facets);
+    return true;
+}
+
+bool ReaderMapped::LoadPLY(const char* data, std::size_t size)
+{
+    if (!isLittleEndian()) {
+        return false;
+    }
+
+    const char* const end = data + size;
+    if (size < 3 || std::strncmp(data, "ply", 3) != 0) {
+        return false;
+    }
+
+    const char* body = nullptr;
+    for (const char* it = data; it < end; it = nextLine(it, end)) {
+        if (std::strncmp(it, "end_header", std::min<std::size_t>(10, end - it)) == 0) {
+            body = nextLine(it, end);
+            break;
+        }
+    }
+    if (!body) {
+        return false;
+    }
+
+    // Only binary files with plain vertexes and triangles are handled here
+    std::istringstream header(std::string(data, body));
+    std::string line;
+    std::string element;
+    std::size_t numPoints = 0;
+    std::size_t numFacets = 0;
+    std::size_t pointSize = 0;
+    std::size_t coordOffset[3] = {0, 0, 0};
+    int coordSize[3] = {0, 0, 0};
+    int faceProperties = 0;
+    bool isBinary = false;
+    while (std::getline(header, line)) {
+        std::istringstream str(line);
+        std::string kw;
+        str >> kw;
+        if (kw == "format") {
+            std::string format;
+            str >> format;
+            isBinary = format == "binary_little_endian";
+        }
+        else if (kw == "element") {
+            std::size_t count {};
+            str >> element >> count;
+            if (element == "vertex" && numPoints == 0 && numFacets == 0) {
+                numPoints = count;
+            }
+            else if (element == "face" && numPoints > 0 && numFacets == 0) {
+                numFacets = count;
+            }
+            else {
+                return false;
+            }
+        }
+        else if (kw == "property") {
+            std::string type;
+            std::string name;
+            str >> type;
+            if (element == "vertex") {
+                str >> name;
+                int typeSize = plyTypeSize(type);
+                if (typeSize == 0 || name.find("red") != std::string::npos
+                    || name.find("green") != std::string::npos
+                    || name.find("blue") != std::string::npos) {
+                    return false;
+                }
+                if (name.size() == 1 && name[0] >= 'x' && name[0] <= 'z') {
+                    int axis = name[0] - 'x';
+                    if (type != "float" && type != "float32" && type != "double"
+                        && type != "float64") {
+                        return false;
+                    }
+                    coordOffset[axis] = pointSize;
+                    coordSize[axis] = typeSize;
+                }
+                pointSize += static_cast<std::size_t>(typeSize);
+            }
+            else if (element == "face" && type == "list") {
+                std::string countType;
+                std::string indexType;
+                str >> countType >> indexType;
+                if (plyTypeSize(countType) != 1 || plyTypeSize(indexType) != 4
+                    || indexType.find("float") != std::string::npos) {
+                    return false;
+                }
+                faceProperties++;
+            }
+            else {
+                return false;
+            }
+        }
+    }
+
+    const std::size_t faceSize = 1 + 3 * sizeof(std::int32_t);
+    if (!isBinary || faceProperties != 1 || coordSize[0] == 0 || coordSize[1] == 0
+        || coordSize[2] == 0) {
+        return false;
+    }
+    if (static_cast<std::size_t>(end - body) < numPoints * pointSize + numFacets * faceSize) {
+        return false;
+    }
+
+    MeshPointArray points(numPoints);
+    parallel_for(numPoints, _threads, [&](std::size_t begin, std::size_t last, std::size_t) {
+        for (std::size_t i = begin; i < last; i++) {
+            const char* record = body + i * pointSize;
+            float coord[3];
+            for (int j = 0; j < 3; j++) {
+                const char* value = record + coordOffset[j];
+                coord[j] = coordSize[j] == 4 ? readValue<float>(value)
+                                             : static_cast<float>(readValue<double>(value));
+            }
+            points[i].Set(coord[0], coord[1], coord[2]);
+        }
+    });
+
+    // polygons other than triangles need the stream reader
+    const char* faces = body + numPoints * pointSize;
+    std::atomic<bool> triangles {true};
+    MeshFacetArray facets(numFacets);
+    parallel_for(numFacets, _threads, [&](std::size_t begin, std::size_t last, std::size_t) {
+        for (std::size_t i = begin; i < last && triangles; i++) {
+            const char* record = faces + i * faceSize;
+            if (*record != 3) {
+                triangles = false;
+                break;
+            }
+            for (int j = 0; j < 3; j++) {
+                auto index = readValue<std::int32_t>(record + 1 + j * sizeof(std::int32_t));
+                facets[i]._aulPoints[j] = index >= 0 && std::size_t(index) < numPoints
+                    ? static_cast<PointIndex>(index)
+                    : POINT_INDEX_MAX;
+            }
+        }
+    });
+
+    if (!triangles) {
+        return false;
+    }
+
+    adoptIndexed(points, facets);
+    return true;
+}
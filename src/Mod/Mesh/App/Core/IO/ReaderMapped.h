@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#ifndef MESH_IO_READER_MAPPED_H
+#define MESH_IO_READER_MAPPED_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <Base/Vector3D.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/MeshGlobal.h>
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/** Loads large STL, OBJ and PLY files from a memory-mapped file.
+ * The data is split into blocks that are parsed concurrently, ASCII formats are split at line
+ * boundaries. The corners of STL files are welded with MeshPointWelder and the point and facet
+ * arrays are handed over to the kernel without an intermediate builder.
+ *
+ * Only the plain geometry is handled here. For files with groups, materials or colors the
+ * Load methods return false so that the caller can use the stream based readers instead.
+ */
+class MeshExport ReaderMapped
+{
+public:
+    /*!
+     * \brief ReaderMapped
+     * If \a threads is less than one the number of hardware threads is used.
+     */
+    explicit ReaderMapped(MeshKernel& kernel, int threads = 0);
+    /*!
+     * \brief Maps the file and loads it depending on its extension.
+     * \return true on success and false if the file cannot be mapped or has unsupported content
+     */
+    bool Load(const std::string& filename);
+    /*!
+     * \brief Loads a binary or ASCII STL file from the buffer.
+     */
+    bool LoadSTL(const char* data, std::size_t size);
+    bool LoadBinarySTL(const char* data, std::size_t size);
+    bool LoadAsciiSTL(const char* data, std::size_t size);
+    /*!
+     * \brief Loads an OBJ file with vertices and faces only from the buffer.
+     */
+    bool LoadOBJ(const char* data, std::size_t size);
+    /*!
+     * \brief Loads a binary little-endian PLY file with triangles only from the buffer.
+     */
+    bool LoadPLY(const char* data, std::size_t size);
+
+private:
+    struct Chunk
+    {
+        std::size_t begin;
+        std::size_t end;
+    };
+    std::vector<Chunk> splitLines(const char* data, std::size_t size) const;
+    void adoptCorners(const std::vector<Base::Vector3f>& corners);
+    void adoptIndexed(MeshPointArray& points, MeshFacetArray& facets);
+
+private:
+    MeshKernel& _kernel;
+    int _threads;
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_IO_READER_MAPPED_H
@@ -21,69 +21,293 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
-#ifdef _MSC_VER
-#pragma warning(disable : 4396)
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <mutex>
 #endif
 
+#include "Functional.h"
 #include "KDTree.h"
-#include <kdtree++/kdtree.hpp>
 
 
 using namespace MeshCore;
 
-struct Point3d
+namespace
 {
-    using value_type = float;
 
-    Point3d(const Base::Vector3f& f, PointIndex i)
-        : p(f)
-        , i(i)
-    {}
+// Maximum number of points in a leaf
+constexpr std::size_t leafSize = 8;
+// Below this number of points a subtree is built by the calling thread
+constexpr std::size_t minParallelSize = 1 << 16;
+// Below this number of queries a batch is answered by the calling thread
+constexpr std::size_t minBatchSize = 1024;
 
-    Point3d(const Point3d& pnt) = default;
+struct Node
+{
+    float split;
+    int axis;  // -1 for leaves
+    uint32_t begin;
+    uint32_t end;
+    uint32_t right;  // the left child directly follows its parent
+};
+
+struct Entry
+{
+    Base::Vector3f point;
+    PointIndex index;
+};
+
+std::size_t countNodes(std::size_t num)
+{
+    if (num <= leafSize) {
+        return 1;
+    }
+    std::size_t half = num / 2;
+    return 1 + countNodes(half) + countNodes(num - half);
+}
+
+// A bounded stack of subtrees to visit with the squared distance to their splitting plane
+class NodeStack
+{
+public:
+    void push(uint32_t node, float dist)
+    {
+        items[size++] = {node, dist};
+    }
+    bool pop(uint32_t& node, float& dist)
+    {
+        if (size == 0) {
+            return false;
+        }
+        --size;
+        node = items[size].first;
+        dist = items[size].second;
+        return true;
+    }
+
+private:
+    // the depth of a balanced tree over 2^32 points
+    std::array<std::pair<uint32_t, float>, 64> items {};
+    std::size_t size {0};
+};
+
+}  // namespace
 
-    Point3d(Point3d&& pnt)
-        : p(pnt.p)
-        , i(pnt.i)
-    {}
+class MeshKDTree::Private
+{
+public:
+    std::vector<Base::Vector3f> input;
 
-    ~Point3d() = default;
+    // the flattened tree, 'points' and 'indices' are sorted by the leaves
+    std::vector<Node> nodes;
+    std::vector<Base::Vector3f> points;
+    std::vector<PointIndex> indices;
 
-    inline value_type operator[](const int N) const
+    std::mutex mutex;
+    std::atomic<bool> dirty {false};
+
+    void invalidate()
     {
-        return p[N];
+        dirty = true;
     }
+    void build();
+    void buildNode(std::vector<Entry>& entries,
+                   uint32_t node,
+                   uint32_t begin,
+                   uint32_t end,
+                   int depth);
 
-    inline bool operator==(const Point3d& other) const
+    // Visits the leaves that may contain points closer than sqrt(bound()) and calls
+    // visit(point, index, squared distance) for each point inside them
+    template<class Bound, class Visit>
+    void search(const Base::Vector3f& p, Bound bound, Visit visit) const
     {
-        return (this->p) == (other.p);
+        if (nodes.empty()) {
+            return;
+        }
+
+        NodeStack stack;
+        uint32_t current = 0;
+        float plane = 0.0F;
+        stack.push(current, plane);
+        while (stack.pop(current, plane)) {
+            if (plane > bound()) {
+                continue;
+            }
+            const Node* node = &nodes[current];
+            while (node->axis >= 0) {
+                float diff = p[node->axis] - node->split;
+                uint32_t nearChild = diff < 0.0F ? current + 1 : node->right;
+                uint32_t farChild = diff < 0.0F ? node->right : current + 1;
+                stack.push(farChild, diff * diff);
+                current = nearChild;
+                node = &nodes[current];
+            }
+            for (uint32_t i = node->begin; i < node->end; i++) {
+                visit(points[i], indices[i], Base::DistanceP2(p, points[i]));
+            }
+        }
     }
 
-    inline bool operator!=(const Point3d& other) const
+    PointIndex nearest(const Base::Vector3f& p, float maxDist2, float& dist2) const
     {
-        return (this->p) != (other.p);
+        PointIndex best = POINT_INDEX_MAX;
+        dist2 = maxDist2;
+        search(
+            p,
+            [&dist2]() {
+                return dist2;
+            },
+            [&](const Base::Vector3f&, PointIndex index, float d2) {
+                // prefer the lower index for equal distances
+                if (d2 < dist2 || (d2 == dist2 && index < best)) {
+                    dist2 = d2;
+                    best = index;
+                }
+            });
+        return best;
     }
 
-    inline Point3d& operator=(const Point3d& other) = default;
+    void kNearest(const Base::Vector3f& p,
+                  std::size_t k,
+                  float maxDist2,
+                  std::vector<std::pair<float, PointIndex>>& heap) const
+    {
+        heap.clear();
+        if (k == 0) {
+            return;
+        }
+        search(
+            p,
+            [&]() {
+                return heap.size() < k ? maxDist2 : heap.front().first;
+            },
+            [&](const Base::Vector3f&, PointIndex index, float d2) {
+                if (d2 > maxDist2) {
+                    return;
+                }
+                std::pair<float, PointIndex> item(d2, index);
+                if (heap.size() < k) {
+                    heap.push_back(item);
+                    std::push_heap(heap.begin(), heap.end());
+                }
+                else if (item < heap.front()) {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = item;
+                    std::push_heap(heap.begin(), heap.end());
+                }
+            });
+        std::sort_heap(heap.begin(), heap.end());
+    }
 
-    inline Point3d& operator=(Point3d&& other)
+    template<class Func>
+    static void forEachQuery(std::size_t count, int threads, Func func)
     {
-        this->p = other.p;
-        this->i = other.i;
-        return *this;
+        parallel_for(count,
+                     count < minBatchSize ? 1 : threads,
+                     [&](std::size_t begin, std::size_t end, std::size_t /*block*/) {
+                         for (std::size_t i = begin; i < end; i++) {
+                             func(i);
+                         }
+                     });
     }
 
-    Base::Vector3f p;
-    PointIndex i;
+    const Private& tree()
+    {
+        if (dirty) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (dirty) {
+                build();
+                dirty = false;
+            }
+        }
+        return *this;
+    }
 };
 
-using MyKDTree = KDTree::KDTree<3, Point3d>;
+void MeshKDTree::Private::build()
+{
+    std::size_t num = input.size();
+    nodes.clear();
+    points.clear();
+    indices.clear();
+    if (num == 0) {
+        return;
+    }
 
-class MeshKDTree::Private
+    std::vector<Entry> entries(num);
+    for (std::size_t i = 0; i < num; i++) {
+        entries[i] = {input[i], PointIndex(i)};
+    }
+
+    nodes.resize(countNodes(num));
+    buildNode(entries, 0, 0, static_cast<uint32_t>(num), 0);
+
+    points.resize(num);
+    indices.resize(num);
+    for (std::size_t i = 0; i < num; i++) {
+        points[i] = entries[i].point;
+        indices[i] = entries[i].index;
+    }
+}
+
+void MeshKDTree::Private::buildNode(std::vector<Entry>& entries,
+                                    uint32_t node,
+                                    uint32_t begin,
+                                    uint32_t end,
+                                    int depth)
 {
-public:
-    MyKDTree kd_tree;
-};
+    Node& item = nodes[node];
+    item.begin = begin;
+    item.end = end;
+    if (end - begin <= leafSize) {
+        item.axis = -1;
+        item.split = 0.0F;
+        item.right = 0;
+        return;
+    }
+
+    // split the longest side of the bounding box at the median
+    Base::BoundBox3f box;
+    for (uint32_t i = begin; i < end; i++) {
+        box.Add(entries[i].point);
+    }
+    float lengths[3] = {box.LengthX(), box.LengthY(), box.LengthZ()};
+    int axis = static_cast<int>(std::max_element(lengths, lengths + 3) - lengths);
+
+    uint32_t mid = begin + (end - begin) / 2;
+    std::nth_element(entries.begin() + begin,
+                     entries.begin() + mid,
+                     entries.begin() + end,
+                     [axis](const Entry& e1, const Entry& e2) {
+                         return e1.point[axis] < e2.point[axis];
+                     });
+
+    item.axis = axis;
+    item.split = entries[mid].point[axis];
+    item.right = static_cast<uint32_t>(node + 1 + countNodes(mid - begin));
+    uint32_t right = item.right;
+
+    // the subtrees are independent, the upper levels are built in parallel
+    const int maxDepth = 3;
+    if (depth < maxDepth && end - begin >= minParallelSize) {
+        auto future = std::async(std::launch::async, [&, node, begin, mid, depth]() {
+            buildNode(entries, node + 1, begin, mid, depth + 1);
+        });
+        buildNode(entries, right, mid, end, depth + 1);
+        future.get();
+    }
+    else {
+        buildNode(entries, node + 1, begin, mid, depth + 1);
+        buildNode(entries, right, mid, end, depth + 1);
+    }
+}
 
 MeshKDTree::MeshKDTree()
     : d(new Private)
@@ -92,19 +316,13 @@ MeshKDTree::MeshKDTree()
 MeshKDTree::MeshKDTree(const std::vector<Base::Vector3f>& points)
     : d(new Private)
 {
-    PointIndex index = 0;
-    for (auto it : points) {
-        d->kd_tree.insert(Point3d(it, index++));
-    }
+    AddPoints(points);
 }
 
 MeshKDTree::MeshKDTree(const MeshPointArray& points)
     : d(new Private)
 {
-    PointIndex index = 0;
-    for (const auto& it : points) {
-        d->kd_tree.insert(Point3d(it, index++));
-    }
+    AddPoints(points);
 }
 
 MeshKDTree::~MeshKDTree()
@@ -114,52 +332,44 @@ MeshKDTree::~MeshKDTree()
 
 void MeshKDTree::AddPoint(const Base::Vector3f& point)
 {
-    PointIndex index = d->kd_tree.size();
-    d->kd_tree.insert(Point3d(point, index));
+    d->input.push_back(point);
+    d->invalidate();
 }
 
 void MeshKDTree::AddPoints(const std::vector<Base::Vector3f>& points)
 {
-    PointIndex index = d->kd_tree.size();
-    for (auto it : points) {
-        d->kd_tree.insert(Point3d(it, index++));
-    }
+    d->input.insert(d->input.end(), points.begin(), points.end());
+    d->invalidate();
 }
 
 void MeshKDTree::AddPoints(const MeshPointArray& points)
 {
-    PointIndex index = d->kd_tree.size();
+    d->input.reserve(d->input.size() + points.size());
     for (const auto& it : points) {
-        d->kd_tree.insert(Point3d(it, index++));
+        d->input.push_back(it);
     }
+    d->invalidate();
 }
 
 bool MeshKDTree::IsEmpty() const
 {
-    return d->kd_tree.empty();
+    return d->input.empty();
 }
 
 void MeshKDTree::Clear()
 {
-    d->kd_tree.clear();
+    d->input.clear();
+    d->invalidate();
 }
 
 void MeshKDTree::Optimize()
 {
-    d->kd_tree.optimize();
+    d->tree();
 }
 
 PointIndex MeshKDTree::FindNearest(const Base::Vector3f& p, Base::Vector3f& n, float& dist) const
 {
-    std::pair<MyKDTree::const_iterator, MyKDTree::distance_type> it =
-        d->kd_tree.find_nearest(Point3d(p, 0));
-    if (it.first == d->kd_tree.end()) {
-        return POINT_INDEX_MAX;
-    }
-    PointIndex index = it.first->i;
-    n = it.first->p;
-    dist = it.second;
-    return index;
+    return FindNearest(p, std::numeric_limits<float>::max(), n, dist);
 }
 
 PointIndex MeshKDTree::FindNearest(const Base::Vector3f& p,
@@ -167,24 +377,28 @@ PointIndex MeshKDTree::FindNearest(const Base::Vector3f& p,
                                    Base::Vector3f& n,
                                    float& dist) const
 {
-    std::pair<MyKDTree::const_iterator, MyKDTree::distance_type> it =
-        d->kd_tree.find_nearest(Point3d(p, 0), max_dist);
-    if (it.first == d->kd_tree.end()) {
+    const Private& tree = d->tree();
+    float maxDist2 = max_dist < std::sqrt(std::numeric_limits<float>::max())
+        ? max_dist * max_dist
+        : std::numeric_limits<float>::max();
+    float dist2 {};
+    PointIndex index = tree.nearest(p, maxDist2, dist2);
+    if (index == POINT_INDEX_MAX) {
         return POINT_INDEX_MAX;
     }
-    PointIndex index = it.first->i;
-    n = it.first->p;
-    dist = it.second;
+    n = tree.input[index];
+    dist = std::sqrt(dist2);
     return index;
 }
 
 PointIndex MeshKDTree::FindExact(const Base::Vector3f& p) const
 {
-    MyKDTree::const_iterator it = d->kd_tree.find_exact(Point3d(p, 0));
-    if (it == d->kd_tree.end()) {
+    const float eps = Base::Vector3f::epsilon();
+    float dist2 {};
+    PointIndex index = d->tree().nearest(p, 3.0F * eps * eps, dist2);
+    if (index == POINT_INDEX_MAX || d->input[index] != p) {
         return POINT_INDEX_MAX;
     }
-    PointIndex index = it->i;
     return index;
 }
 
@@ -192,10 +406,113 @@ void MeshKDTree::FindInRange(const Base::Vector3f& p,
                              float range,
                              std::vector<PointIndex>& indices) const
 {
-    std::vector<Point3d> v;
-    d->kd_tree.find_within_range(Point3d(p, 0), range, std::back_inserter(v));
-    indices.reserve(v.size());
-    for (const auto& it : v) {
-        indices.push_back(it.i);
+    // the cube is contained in the sphere through its corners
+    float radius2 = 3.0F * range * range;
+    d->tree().search(
+        p,
+        [radius2]() {
+            return radius2;
+        },
+        [&](const Base::Vector3f& point, PointIndex index, float) {
+            if (std::fabs(point.x - p.x) <= range && std::fabs(point.y - p.y) <= range
+                && std::fabs(point.z - p.z) <= range) {
+                indices.push_back(index);
+            }
+        });
+}
+
+void MeshKDTree::FindKNearest(const Base::Vector3f& p,
+                              std::size_t k,
+                              std::vector<PointIndex>& indices) const
+{
+    std::vector<std::pair<float, PointIndex>> heap;
+    d->tree().kNearest(p, k, std::numeric_limits<float>::max(), heap);
+    indices.clear();
+    for (const auto& it : heap) {
+        indices.push_back(it.second);
+    }
+}
+
+void MeshKDTree::FindInRadius(const Base::Vector3f& p,
+                              float radius,
+                              std::vector<PointIndex>& indices) const
+{
+    std::vector<std::pair<float, PointIndex>> found;
+    float radius2 = radius * radius;
+    d->tree().search(
+        p,
+        [radius2]() {
+            return radius2;
+        },
+        [&](const Base::Vector3f&, PointIndex index, float d2) {
+            if (d2 <= radius2) {
+                found.emplace_back(d2, index);
+            }
+        });
+    std::sort(found.begin(), found.end());
+    indices.clear();
+    for (const auto& it : found) {
+        indices.push_back(it.second);
     }
 }
+
+void MeshKDTree::FindNearest(std::span<const Base::Vector3f> points,
+                             float max_dist,
+                             std::vector<PointIndex>& indices,
+                             int threads) const
+{
+    const Private& tree = d->tree();
+    float maxDist2 = max_dist >= 0.0F ? max_dist * max_dist : std::numeric_limits<float>::max();
+    indices.resize(points.size());
+    Private::forEachQuery(points.size(), threads, [&](std::size_t i) {
+        float dist2 {};
+        indices[i] = tree.nearest(points[i], maxDist2, dist2);
+    });
+}
+
+void MeshKDTree::FindNearest(const MeshPointArray& points,
+                             float max_dist,
+                             std::vector<PointIndex>& indices,
+                             int threads) const
+{
+    const Private& tree = d->tree();
+    float maxDist2 = max_dist >= 0.0F ? max_dist * max_dist : std::numeric_limits<float>::max();
+    indices.resize(points.size());
+    Private::forEachQuery(points.size(), threads, [&](std::size_t i) {
+        float dist2 {};
+        indices[i] = tree.nearest(points[i], maxDist2, dist2);
+    });
+}
+
+void MeshKDTree::FindKNearest(std::span<const Base::Vector3f> points,
+                              std::size_t k,
+                              std::vector<PointIndex>& indices,
+                              int threads) const
+{
+    const Private& tree = d->tree();
+    indices.assign(points.size() * k, POINT_INDEX_MAX);
+    parallel_for(points.size(),
+                 points.size() < minBatchSize ? 1 : threads,
+                 [&](std::size_t begin, std::size_t end, std::size_t /*block*/) {
+                     std::vector<std::pair<float, PointIndex>> heap;
+                     heap.reserve(k);
+                     for (std::size_t i = begin; i < end; i++) {
+                         tree.kNearest(points[i], k, std::numeric_limits<float>::max(), heap);
+                         for (std::size_t j = 0; j < heap.size(); j++) {
+                             indices[i * k + j] = heap[j].second;
+                         }
+                     }
+                 });
+}
+
+void MeshKDTree::FindInRadius(std::span<const Base::Vector3f> points,
+                              float radius,
+                              std::vector<std::vector<PointIndex>>& indices,
+                              int threads) const
+{
+    d->tree();
+    indices.resize(points.size());
+    Private::forEachQuery(points.size(), threads, [&](std::size_t i) {
+        FindInRadius(points[i], radius, indices[i]);
+    });
+}
@@ -24,11 +24,21 @@
 #ifndef MESH_KDTREE_H
 #define MESH_KDTREE_H
 
+#include <span>
+
 #include "Elements.h"
 
 namespace MeshCore
 {
 
+/**
+ * The MeshKDTree class answers nearest neighbour queries for a set of points.
+ * The tree is stored as a flat array of nodes over the spatially sorted points. It is built
+ * concurrently on the first query after points have been added or when calling Optimize().
+ * Once built, the tree can be queried from several threads and the batch methods distribute
+ * the query points over \a threads threads, if less than one the number of hardware threads
+ * is used.
+ */
 class MeshExport MeshKDTree
 {
 public:
@@ -49,7 +59,37 @@ public:
     PointIndex
     FindNearest(const Base::Vector3f& p, float max_dist, Base::Vector3f& n, float&) const;
     PointIndex FindExact(const Base::Vector3f& p) const;
-    void FindInRange(const Base::Vector3f&, float, std::vector<PointIndex>&) const;
+    /// Finds the points inside the axis-aligned cube around \a p with half side length \a range
+    void FindInRange(const Base::Vector3f& p, float range, std::vector<PointIndex>&) const;
+    /// Finds the \a k nearest points sorted by increasing distance
+    void FindKNearest(const Base::Vector3f& p, std::size_t k, std::vector<PointIndex>&) const;
+    /// Finds the points with a distance of at most \a radius sorted by increasing distance
+    void FindInRadius(const Base::Vector3f& p, float radius, std::vector<PointIndex>&) const;
+
+    /** @name Batch queries */
+    //@{
+    /// For each point the index of the nearest point not farther than \a max_dist or
+    /// POINT_INDEX_MAX, a negative \a max_dist means no limit
+    void FindNearest(std::span<const Base::Vector3f> points,
+                     float max_dist,
+                     std::vector<PointIndex>& indices,
+                     int threads = 0) const;
+    void FindNearest(const MeshPointArray& points,
+                     float max_dist,
+                     std::vector<PointIndex>& indices,
+                     int threads = 0) const;
+    /// For each point the \a k nearest points, \a indices holds k entries per point that are
+    /// filled up with POINT_INDEX_MAX if the tree has less than k points
+    void FindKNearest(std::span<const Base::Vector3f> points,
+                      std::size_t k,
+                      std::vector<PointIndex>& indices,
+                      int threads = 0) const;
+    /// For each point the points with a distance of at most \a radius
+    void FindInRadius(std::span<const Base::Vector3f> points,
+                      float radius,
+                      std::vector<std::vector<PointIndex>>& indices,
+                      int threads = 0) const;
+    //@}
 
     MeshKDTree(const MeshKDTree&) = delete;
     MeshKDTree(MeshKDTree&&) = delete;
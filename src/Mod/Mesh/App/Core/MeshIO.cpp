@@ -37,6 +37,7 @@
 #include <boost/regex.hpp>
 
 #include "IO/Reader3MF.h"
+#include "IO/ReaderMapped.h"
 #include "IO/ReaderOBJ.h"
 #include "IO/ReaderPLY.h"
 #include "IO/Writer3MF.h"
@@ -231,6 +232,15 @@ bool MeshInput::LoadAny(const char* FileName)
         throw Base::FileException("No permission on the file", FileName);
     }
 
+    // Plain geometry is parsed in parallel from the memory-mapped file. Files with groups,
+    // materials or colors are handled by the stream based readers below.
+    if (fi.hasExtension({"stl", "ast", "obj", "ply"})) {
+        ReaderMapped reader(_rclMesh);
+        if (reader.Load(FileName)) {
+            return true;
+        }
+    }
+
     Base::ifstream str(fi, std::ios::in | std::ios::binary);
 
     if (fi.hasExtension("bms")) {
@@ -38,6 +38,7 @@
 #include "Algorithm.h"
 #include "Builder.h"
 #include "Evaluation.h"
+#include "IO/Compact.h"
 #include "Iterator.h"
 #include "MeshIO.h"
 #include "MeshKernel.h"
@@ -934,6 +935,16 @@ void MeshKernel::Read(std::istream& rclIn)
     Base::SwapEndian(swap_version);
     uint32_t open_edge = 0xffffffff;  // value to mark an open edge
 
+    // the compact format is read by its own reader
+    if (magic == 0xA0B0C0D0 && version == WriterCompact::Version) {
+        ReaderCompact(*this).LoadData(rclIn, false);
+        return;
+    }
+    if (swap_magic == 0xA0B0C0D0 && swap_version == WriterCompact::Version) {
+        ReaderCompact(*this).LoadData(rclIn, true);
+        return;
+    }
+
     // is it the new or old format?
     bool new_format = false;
     if (magic == 0xA0B0C0D0 && version == 0x010000) {
@@ -1261,22 +1272,23 @@ MeshPointIterator MeshKernel::PointIterator() const
 
 void MeshKernel::GetEdges(std::vector<MeshGeomEdge>& edges) const
 {
-    std::set<MeshBuilder::Edge> tmp;
+    // maps the sorted point indices of an edge to the neighbour of the first facet using it
+    std::map<std::pair<PointIndex, PointIndex>, FacetIndex> tmp;
 
     for (const auto& it : _aclFacetArray) {
         for (int i = 0; i < 3; i++) {
-            tmp.insert(MeshBuilder::Edge(it._aulPoints[i],
-                                         it._aulPoints[(i + 1) % 3],
-                                         it._aulNeighbours[i]));
+            PointIndex p1 = it._aulPoints[i];
+            PointIndex p2 = it._aulPoints[(i + 1) % 3];
+            tmp.emplace(std::minmax(p1, p2), it._aulNeighbours[i]);
         }
     }
 
     edges.reserve(tmp.size());
     for (const auto& it2 : tmp) {
         MeshGeomEdge edge;
-        edge._aclPoints[0] = this->_aclPointArray[it2.pt1];
-        edge._aclPoints[1] = this->_aclPointArray[it2.pt2];
-        edge._bBorder = it2.facetIdx == FACET_INDEX_MAX;
+        edge._aclPoints[0] = this->_aclPointArray[it2.first.first];
+        edge._aclPoints[1] = this->_aclPointArray[it2.first.second];
+        edge._bBorder = it2.second == FACET_INDEX_MAX;
 
         edges.push_back(edge);
     }
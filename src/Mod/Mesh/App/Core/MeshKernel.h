@@ -496,6 +496,7 @@ private:
     friend class MeshFixDuplicatePoints;
     friend class MeshBuilder;
     friend class MeshTrimming;
+    friend class ReaderCompact;
 };
 
 inline MeshPoint MeshKernel::GetPoint(PointIndex ulIndex) const
@@ -22,6 +22,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
 #include <cmath>
 #endif
 
@@ -29,6 +30,7 @@
 
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
 #include "Smoothing.h"
@@ -49,219 +51,192 @@ void AbstractSmoothing::initialize(Component comp, Continuity cont)
     this->continuity = cont;
 }
 
-PlaneFitSmoothing::PlaneFitSmoothing(MeshKernel& m)
-    : AbstractSmoothing(m)
-{}
-
-void PlaneFitSmoothing::Smooth(unsigned int iterations)
+void AbstractSmoothing::ReadPoints(Coordinates& coords) const
 {
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
+    const MeshPointArray& points = kernel.GetPoints();
+    std::size_t count = points.size();
+    coords.x.resize(count);
+    coords.y.resize(count);
+    coords.z.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        coords.x[i] = points[i].x;
+        coords.y[i] = points[i].y;
+        coords.z[i] = points[i].z;
+    }
+}
 
-    MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
+void AbstractSmoothing::WritePoints(const Coordinates& coords)
+{
+    std::size_t count = coords.x.size();
+    for (std::size_t i = 0; i < count; i++) {
+        kernel.SetPoint(i, coords.x[i], coords.y[i], coords.z[i]);
+    }
+}
 
-    for (unsigned int i = 0; i < iterations; i++) {
-        Base::Vector3f N, L;
-        for (v_it.Begin(); v_it.More(); v_it.Next()) {
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3) {
-                continue;
-            }
+namespace
+{
+/**
+ * Calls \a func for each of the points \a indices, or for all \a count points if \a indices
+ * is null. The points are distributed over several threads unless there are only a few.
+ */
+template<class Func>
+void forEachPoint(std::size_t count, const std::vector<PointIndex>* indices, Func func)
+{
+    const std::size_t minPointsPerThread = 4096;
+    std::size_t size = indices ? indices->size() : count;
+    int threads = size < 2 * minPointsPerThread ? 1 : 0;
+    parallel_for(size, threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; i++) {
+            func(indices ? (*indices)[i] : PointIndex(i));
+        }
+    });
+}
+}  // namespace
 
-            std::set<PointIndex>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
-            }
+PlaneFitSmoothing::PlaneFitSmoothing(MeshKernel& m)
+    : AbstractSmoothing(m)
+{}
 
-            float scale = 1.0F / (static_cast<float>(cv.size()) + 1.0F);
-            center.Scale(scale, scale, scale);
+void PlaneFitSmoothing::Fit(const MeshPointAdjacency& adjacency,
+                            const std::vector<PointIndex>* indices,
+                            const Coordinates& src,
+                            Coordinates& dst) const
+{
+    forEachPoint(adjacency.CountPoints(), indices, [&](PointIndex pos) {
+        std::size_t count = adjacency.CountNeighbours(pos);
+        if (count < 3) {
+            return;
+        }
 
-            // get the mean plane of the current vertex with the surrounding vertices
-            pf.Fit();
-            N = pf.GetNormal();
-            N.Normalize();
+        Base::Vector3f point(src.x[pos], src.y[pos], src.z[pos]);
+        Base::Vector3f center = point;
+        MeshCore::PlaneFit pf;
+        pf.AddPoint(point);
+        for (const PointIndex* it = adjacency.Begin(pos); it != adjacency.End(pos); ++it) {
+            Base::Vector3f neighbour(src.x[*it], src.y[*it], src.z[*it]);
+            pf.AddPoint(neighbour);
+            center += neighbour;
+        }
 
-            // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
-            if (N * L < 0.0F) {
-                N.Scale(-1.0, -1.0, -1.0);
-            }
+        float scale = 1.0F / (static_cast<float>(count) + 1.0F);
+        center.Scale(scale, scale, scale);
 
-            // maximum value to move is distance to mean plane
-            float d = std::min<float>(std::fabs(this->maximum), fabs(N * L));
-            N.Scale(d, d, d);
+        // get the mean plane of the current vertex with the surrounding vertices
+        pf.Fit();
+        Base::Vector3f N = pf.GetNormal();
+        N.Normalize();
 
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
+        // look in which direction we should move the vertex
+        Base::Vector3f L = point - center;
+        if (N * L < 0.0F) {
+            N.Scale(-1.0, -1.0, -1.0);
         }
 
-        // assign values without affecting iterators
-        PointIndex count = kernel.CountPoints();
-        for (PointIndex idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
-        }
-    }
+        // maximum value to move is distance to mean plane
+        float d = std::min<float>(std::fabs(this->maximum), std::fabs(N * L));
+        N.Scale(d, d, d);
+
+        dst.x[pos] = point.x - N.x;
+        dst.y[pos] = point.y - N.y;
+        dst.z[pos] = point.z - N.z;
+    });
 }
 
-void PlaneFitSmoothing::SmoothPoints(unsigned int iterations,
-                                     const std::vector<PointIndex>& point_indices)
+void PlaneFitSmoothing::Apply(unsigned int iterations, const std::vector<PointIndex>* indices)
 {
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
+    MeshCore::MeshPointAdjacency adjacency(kernel);
 
-    MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
+    // the points that are not moved keep their position in both buffers
+    Coordinates src, dst;
+    ReadPoints(src);
+    dst = src;
 
     for (unsigned int i = 0; i < iterations; i++) {
-        Base::Vector3f N, L;
-        for (PointIndex it : point_indices) {
-            v_it.Set(it);
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3) {
-                continue;
-            }
-
-            std::set<PointIndex>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
-            }
-
-            float scale = 1.0F / (static_cast<float>(cv.size()) + 1.0F);
-            center.Scale(scale, scale, scale);
-
-            // get the mean plane of the current vertex with the surrounding vertices
-            pf.Fit();
-            N = pf.GetNormal();
-            N.Normalize();
-
-            // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
-            if (N * L < 0.0F) {
-                N.Scale(-1.0, -1.0, -1.0);
-            }
+        Fit(adjacency, indices, src, dst);
+        std::swap(src, dst);
+    }
 
-            // maximum value to move is distance to mean plane
-            float d = std::min<float>(std::fabs(this->maximum), fabs(N * L));
-            N.Scale(d, d, d);
+    WritePoints(src);
+}
 
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
-        }
+void PlaneFitSmoothing::Smooth(unsigned int iterations)
+{
+    Apply(iterations, nullptr);
+}
 
-        // assign values without affecting iterators
-        PointIndex count = kernel.CountPoints();
-        for (PointIndex idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
-        }
-    }
+void PlaneFitSmoothing::SmoothPoints(unsigned int iterations,
+                                     const std::vector<PointIndex>& point_indices)
+{
+    Apply(iterations, &point_indices);
 }
 
 LaplaceSmoothing::LaplaceSmoothing(MeshKernel& m)
     : AbstractSmoothing(m)
 {}
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it,
-                                double stepsize)
+void LaplaceSmoothing::Umbrella(const MeshPointAdjacency& adjacency,
+                                const std::vector<PointIndex>* indices,
+                                double stepsize,
+                                const Coordinates& src,
+                                Coordinates& dst) const
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_it, v_beg = points.begin(), v_end = points.end();
-
-    PointIndex pos = 0;
-    for (v_it = points.begin(); v_it != v_end; ++v_it, ++pos) {
-        const std::set<PointIndex>& cv = vv_it[pos];
-        if (cv.size() < 3) {
-            continue;
+    forEachPoint(adjacency.CountPoints(), indices, [&](PointIndex pos) {
+        std::size_t n_count = adjacency.CountNeighbours(pos);
+        if (n_count < 3) {
+            return;
         }
-        if (cv.size() != vf_it[pos].size()) {
+        if (n_count != adjacency.CountFacets(pos)) {
             // do nothing for border points
-            continue;
+            return;
         }
 
-        size_t n_count = cv.size();
-        double w {};
-        w = 1.0 / double(n_count);
-
+        double w = 1.0 / double(n_count);
+        double px = src.x[pos];
+        double py = src.y[pos];
+        double pz = src.z[pos];
         double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - v_it->x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - v_it->y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - v_it->z);
+        for (const PointIndex* it = adjacency.Begin(pos); it != adjacency.End(pos); ++it) {
+            delx += static_cast<double>(src.x[*it]) - px;
+            dely += static_cast<double>(src.y[*it]) - py;
+            delz += static_cast<double>(src.z[*it]) - pz;
         }
 
-        float x = static_cast<float>(static_cast<double>(v_it->x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>(v_it->y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>(v_it->z) + stepsize * delz);
-        kernel.SetPoint(pos, x, y, z);
-    }
+        dst.x[pos] = static_cast<float>(px + stepsize * w * delx);
+        dst.y[pos] = static_cast<float>(py + stepsize * w * dely);
+        dst.z[pos] = static_cast<float>(pz + stepsize * w * delz);
+    });
 }
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it,
-                                double stepsize,
-                                const std::vector<PointIndex>& point_indices)
+void LaplaceSmoothing::Apply(unsigned int iterations,
+                             const std::vector<PointIndex>* indices,
+                             const std::vector<double>& steps)
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_beg = points.begin();
-
-    for (PointIndex it : point_indices) {
-        const std::set<PointIndex>& cv = vv_it[it];
-        if (cv.size() < 3) {
-            continue;
-        }
-        if (cv.size() != vf_it[it].size()) {
-            // do nothing for border points
-            continue;
-        }
+    MeshCore::MeshPointAdjacency adjacency(kernel);
 
-        size_t n_count = cv.size();
-        double w {};
-        w = 1.0 / double(n_count);
+    // the points that are not moved keep their position in both buffers
+    Coordinates src, dst;
+    ReadPoints(src);
+    dst = src;
 
-        double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - (v_beg[it]).x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - (v_beg[it]).y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - (v_beg[it]).z);
+    for (unsigned int i = 0; i < iterations; i++) {
+        for (double step : steps) {
+            Umbrella(adjacency, indices, step, src, dst);
+            std::swap(src, dst);
         }
-
-        float x = static_cast<float>(static_cast<double>((v_beg[it]).x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>((v_beg[it]).y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>((v_beg[it]).z) + stepsize * delz);
-        kernel.SetPoint(it, x, y, z);
     }
+
+    WritePoints(src);
 }
 
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
-    }
+    Apply(iterations, nullptr, {lambda});
 }
 
 void LaplaceSmoothing::SmoothPoints(unsigned int iterations,
                                     const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
-    }
+    Apply(iterations, &point_indices, {lambda});
 }
 
 TaubinSmoothing::TaubinSmoothing(MeshKernel& m)
@@ -270,29 +245,17 @@ TaubinSmoothing::TaubinSmoothing(MeshKernel& m)
 
 void TaubinSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations + 1) / 2;  // two steps per iteration
-    for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, GetLambda());
-        Umbrella(vv_it, vf_it, -(GetLambda() + micro));
-    }
+    Apply(iterations, nullptr, {GetLambda(), -(GetLambda() + micro)});
 }
 
 void TaubinSmoothing::SmoothPoints(unsigned int iterations,
                                    const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations + 1) / 2;  // two steps per iteration
-    for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, GetLambda(), point_indices);
-        Umbrella(vv_it, vf_it, -(GetLambda() + micro), point_indices);
-    }
+    Apply(iterations, &point_indices, {GetLambda(), -(GetLambda() + micro)});
 }
 
 namespace
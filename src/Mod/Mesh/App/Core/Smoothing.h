@@ -32,7 +32,7 @@
 namespace MeshCore
 {
 class MeshKernel;
-class MeshRefPointToPoints;
+class MeshPointAdjacency;
 class MeshRefPointToFacets;
 class MeshRefFacetToFacets;
 
@@ -67,6 +67,21 @@ public:
     virtual void Smooth(unsigned int) = 0;
     virtual void SmoothPoints(unsigned int, const std::vector<PointIndex>&) = 0;
 
+protected:
+    /**
+     * The point coordinates as separate arrays. The smoothing kernels read the positions of
+     * one iteration from one buffer and write the new positions into another one, so all
+     * points can be moved concurrently.
+     */
+    struct Coordinates
+    {
+        std::vector<float> x, y, z;
+    };
+    /// Copies the points of the mesh into \a coords
+    void ReadPoints(Coordinates& coords) const;
+    /// Copies \a coords back to the points of the mesh
+    void WritePoints(const Coordinates& coords);
+
 protected:
     // NOLINTBEGIN
     MeshKernel& kernel;
@@ -87,6 +102,13 @@ public:
     void Smooth(unsigned int) override;
     void SmoothPoints(unsigned int, const std::vector<PointIndex>&) override;
 
+private:
+    void Apply(unsigned int, const std::vector<PointIndex>*);
+    void Fit(const MeshPointAdjacency&,
+             const std::vector<PointIndex>*,
+             const Coordinates&,
+             Coordinates&) const;
+
 private:
     float maximum {std::numeric_limits<float>::max()};
 };
@@ -107,11 +129,23 @@ public:
     }
 
 protected:
-    void Umbrella(const MeshRefPointToPoints&, const MeshRefPointToFacets&, double);
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&,
-                  double,
-                  const std::vector<PointIndex>&);
+    /**
+     * Moves the points \a indices, or all points if \a indices is null, by \a stepsize
+     * towards the centre of their neighbours. The positions are read from \a src and the
+     * new positions are written to \a dst. Border points are not moved.
+     */
+    void Umbrella(const MeshPointAdjacency&,
+                  const std::vector<PointIndex>* indices,
+                  double stepsize,
+                  const Coordinates& src,
+                  Coordinates& dst) const;
+    /**
+     * Runs \a iterations iterations on the points \a indices, or on all points if
+     * \a indices is null. Each iteration does one umbrella step for every entry of \a steps.
+     */
+    void Apply(unsigned int iterations,
+               const std::vector<PointIndex>* indices,
+               const std::vector<double>& steps);
 
 private:
     double lambda {0.6307};
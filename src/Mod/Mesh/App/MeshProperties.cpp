@@ -22,6 +22,8 @@
 
 #include "PreCompiled.h"
 
+#include <App/Application.h>
+#include <Base/Console.h>
 #include <Base/Converter.h>
 #include <Base/Exception.h>
 #include <Base/Reader.h>
@@ -29,6 +31,7 @@
 #include <Base/VectorPy.h>
 #include <Base/Writer.h>
 
+#include "Core/IO/Compact.h"
 #include "Core/Iterator.h"
 #include "Core/MeshKernel.h"
 #include "Core/MeshIO.h"
@@ -921,6 +924,21 @@ void PropertyMeshKernel::Restore(Base::XMLReader& reader)
 
 void PropertyMeshKernel::SaveDocFile(Base::Writer& writer) const
 {
+    // Older versions cannot read the compact format, so it must be enabled explicitly.
+    // A tolerance of zero keeps the points unchanged.
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Mesh");
+    if (hGrp->GetBool("CompactStorage", false)) {
+        MeshCore::WriterCompact compact(_meshObject->getKernel());
+        compact.SetTolerance(static_cast<float>(hGrp->GetFloat("CompactStorageTolerance", 0.0)));
+        if (compact.Save(writer.Stream())) {
+            return;
+        }
+
+        // the mesh is too big for the compact format, nothing has been written yet
+        Base::Console().warning("Cannot save mesh in compact format, using the default format\n");
+    }
+
     _meshObject->save(writer.Stream());
 }
 
@@ -93,8 +93,8 @@ void MeshTexture::apply(const Mesh::MeshObject& mesh,
 
         if (binding == MeshCore::MeshIO::PER_VERTEX) {
             diffuseColor.reserve(points.size());
-            for (size_t index = 0; index < points.size(); index++) {
-                PointIndex pos = findIndex(points[index], max_dist);
+            std::vector<PointIndex> found = findIndices(points, max_dist);
+            for (PointIndex pos : found) {
                 if (pos < countPointsRefMesh) {
                     diffuseColor.push_back(textureColor[pos]);
                 }
@@ -112,8 +112,8 @@ void MeshTexture::apply(const Mesh::MeshObject& mesh,
             // the values of the map give the point indices of the original mesh
             std::vector<PointIndex> pointMap;
             pointMap.reserve(points.size());
-            for (size_t index = 0; index < points.size(); index++) {
-                PointIndex pos = findIndex(points[index], max_dist);
+            std::vector<PointIndex> found = findIndices(points, max_dist);
+            for (PointIndex pos : found) {
                 if (pos < countPointsRefMesh) {
                     pointMap.push_back(pos);
                 }
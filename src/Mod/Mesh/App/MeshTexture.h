@@ -83,15 +83,21 @@ private:
                const Base::Color& defaultColor,
                float max_dist,
                MeshCore::Material& material);
-    PointIndex findIndex(const Base::Vector3f& p, float max_dist) const
+    std::vector<PointIndex> findIndices(const MeshCore::MeshPointArray& points,
+                                        float max_dist) const
     {
+        std::vector<PointIndex> indices;
         if (max_dist < 0.0F) {
-            return kdTree->FindExact(p);
+            // a negative distance looks for matches with the tolerant comparison of the points
+            indices.reserve(points.size());
+            for (const auto& p : points) {
+                indices.push_back(kdTree->FindExact(p));
+            }
         }
-
-        Base::Vector3f n;
-        float dist {};
-        return kdTree->FindNearest(p, max_dist, n, dist);
+        else {
+            kdTree->FindNearest(points, max_dist, indices);
+        }
+        return indices;
     }
 
 private:
@@ -93,6 +93,130 @@ public:
     float epsilonDegenerated {0.0F};
 };
 
+/**
+ * Holds the results of the checks of a mesh. The check methods only read the mesh and,
+ * except of checkOrientation(), can be run concurrently.
+ */
+struct DlgEvaluateMeshImp::Analysis
+{
+    enum IndexCheck
+    {
+        ValidIndices,
+        InvalidFacetIndices,
+        InvalidPointIndices,
+        MultiplePointIndices,
+        InvalidNeighbourIndices
+    };
+
+    explicit Analysis(const MeshKernel& mesh)
+        : mesh(mesh)
+    {}
+
+    void checkOrientation()
+    {
+        // uses the facet flags
+        MeshEvalOrientation eval(mesh);
+        orientation = eval.GetIndices();
+    }
+    void checkDuplicatedFaces()
+    {
+        MeshEvalDuplicateFacets eval(mesh);
+        duplicatedFaces = eval.GetIndices();
+    }
+    void checkDuplicatedPoints()
+    {
+        MeshEvalDuplicatePoints eval(mesh);
+        if (!eval.Evaluate()) {
+            duplicatedPoints = eval.GetIndices();
+        }
+    }
+    void checkNonmanifolds(bool checkPoints)
+    {
+        MeshEvalTopology f_eval(mesh);
+        manifoldEdges = f_eval.Evaluate();
+        countManifolds = f_eval.CountManifolds();
+        nonmanifoldEdges = f_eval.GetIndices();
+
+        if (checkPoints) {
+            MeshEvalPointManifolds p_eval(mesh);
+            manifoldPoints = p_eval.Evaluate();
+            if (!manifoldPoints) {
+                nonmanifoldPoints = p_eval.GetIndices();
+            }
+        }
+    }
+    void checkDegenerations(float epsilon)
+    {
+        MeshEvalDegeneratedFacets eval(mesh, epsilon);
+        degenerations = eval.GetIndices();
+    }
+    void checkIndices()
+    {
+        MeshEvalRangeFacet rf(mesh);
+        MeshEvalRangePoint rp(mesh);
+        MeshEvalCorruptedFacets cf(mesh);
+        MeshEvalNeighbourhood nb(mesh);
+
+        if (!rf.Evaluate()) {
+            invalidIndices = InvalidFacetIndices;
+            indices = rf.GetIndices();
+        }
+        else if (!rp.Evaluate()) {
+            invalidIndices = InvalidPointIndices;
+        }
+        else if (!cf.Evaluate()) {
+            invalidIndices = MultiplePointIndices;
+            indices = cf.GetIndices();
+        }
+        else if (!nb.Evaluate()) {
+            invalidIndices = InvalidNeighbourIndices;
+            indices = nb.GetIndices();
+        }
+    }
+    void checkSelfIntersections()
+    {
+        MeshEvalSelfIntersection eval(mesh);
+        eval.GetIntersections(selfIntersections);
+    }
+    void checkFolds()
+    {
+        MeshEvalFoldsOnSurface s_eval(mesh);
+        MeshEvalFoldsOnBoundary b_eval(mesh);
+        MeshEvalFoldOversOnSurface f_eval(mesh);
+        bool ok1 = s_eval.Evaluate();
+        bool ok2 = b_eval.Evaluate();
+        bool ok3 = f_eval.Evaluate();
+
+        if (!ok1 || !ok2 || !ok3) {
+            std::vector<Mesh::FacetIndex> inds = f_eval.GetIndices();
+            std::vector<Mesh::FacetIndex> inds1 = s_eval.GetIndices();
+            std::vector<Mesh::FacetIndex> inds2 = b_eval.GetIndices();
+            inds.insert(inds.end(), inds1.begin(), inds1.end());
+            inds.insert(inds.end(), inds2.begin(), inds2.end());
+
+            // remove duplicates
+            std::sort(inds.begin(), inds.end());
+            inds.erase(std::unique(inds.begin(), inds.end()), inds.end());
+            folds.swap(inds);
+        }
+    }
+
+    const MeshKernel& mesh;
+    std::vector<Mesh::FacetIndex> orientation;
+    std::vector<Mesh::FacetIndex> duplicatedFaces;
+    std::vector<Mesh::PointIndex> duplicatedPoints;
+    std::vector<std::pair<Mesh::FacetIndex, Mesh::FacetIndex>> nonmanifoldEdges;
+    std::vector<Mesh::PointIndex> nonmanifoldPoints;
+    unsigned long countManifolds {0};
+    bool manifoldEdges {true};
+    bool manifoldPoints {true};
+    std::vector<Mesh::FacetIndex> degenerations;
+    IndexCheck invalidIndices {ValidIndices};
+    std::vector<Mesh::ElementIndex> indices;
+    std::vector<std::pair<Mesh::FacetIndex, Mesh::FacetIndex>> selfIntersections;
+    std::vector<Mesh::FacetIndex> folds;
+};
+
 /* TRANSLATOR MeshGui::DlgEvaluateMeshImp */
 
 /**
@@ -516,29 +640,33 @@ void DlgEvaluateMeshImp::onAnalyzeOrientationButtonClicked()
         qApp->processEvents();
         qApp->setOverrideCursor(Qt::WaitCursor);
 
-        const MeshKernel& rMesh = d->meshFeature->Mesh.getValue().getKernel();
-        MeshEvalOrientation eval(rMesh);
-        std::vector<MeshCore::FacetIndex> inds = eval.GetIndices();
-
-        if (inds.empty()) {
-            d->ui.checkOrientationButton->setText(tr("No flipped normals"));
-            d->ui.checkOrientationButton->setChecked(false);
-            d->ui.repairOrientationButton->setEnabled(false);
-            removeViewProvider("MeshGui::ViewProviderMeshOrientation");
-        }
-        else {
-            d->ui.checkOrientationButton->setText(tr("%1 flipped normals").arg(inds.size()));
-            d->ui.checkOrientationButton->setChecked(true);
-            d->ui.repairOrientationButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
-            addViewProvider("MeshGui::ViewProviderMeshOrientation", eval.GetIndices());
-        }
+        Analysis analysis(d->meshFeature->Mesh.getValue().getKernel());
+        analysis.checkOrientation();
+        showOrientation(analysis);
 
         qApp->restoreOverrideCursor();
         d->ui.analyzeOrientationButton->setEnabled(true);
     }
 }
 
+void DlgEvaluateMeshImp::showOrientation(const Analysis& analysis)
+{
+    const std::vector<MeshCore::FacetIndex>& inds = analysis.orientation;
+    if (inds.empty()) {
+        d->ui.checkOrientationButton->setText(tr("No flipped normals"));
+        d->ui.checkOrientationButton->setChecked(false);
+        d->ui.repairOrientationButton->setEnabled(false);
+        removeViewProvider("MeshGui::ViewProviderMeshOrientation");
+    }
+    else {
+        d->ui.checkOrientationButton->setText(tr("%1 flipped normals").arg(inds.size()));
+        d->ui.checkOrientationButton->setChecked(true);
+        d->ui.repairOrientationButton->setEnabled(true);
+        d->ui.repairAllTogether->setEnabled(true);
+        addViewProvider("MeshGui::ViewProviderMeshOrientation", inds);
+    }
+}
+
 void DlgEvaluateMeshImp::onRepairOrientationButtonClicked()
 {
     if (d->meshFeature) {
@@ -598,55 +726,52 @@ void DlgEvaluateMeshImp::onAnalyzeNonmanifoldsButtonClicked()
         qApp->processEvents();
         qApp->setOverrideCursor(Qt::WaitCursor);
 
-        const MeshKernel& rMesh = d->meshFeature->Mesh.getValue().getKernel();
-        MeshEvalTopology f_eval(rMesh);
-        bool ok1 = f_eval.Evaluate();
-        bool ok2 = true;
-        std::vector<Mesh::PointIndex> point_indices;
-
-        if (d->checkNonManfoldPoints) {
-            MeshEvalPointManifolds p_eval(rMesh);
-            ok2 = p_eval.Evaluate();
-            if (!ok2) {
-                point_indices = p_eval.GetIndices();
-            }
-        }
+        Analysis analysis(d->meshFeature->Mesh.getValue().getKernel());
+        analysis.checkNonmanifolds(d->checkNonManfoldPoints);
+        showNonmanifolds(analysis);
 
-        if (ok1 && ok2) {
-            d->ui.checkNonmanifoldsButton->setText(tr("No non-manifolds"));
-            d->ui.checkNonmanifoldsButton->setChecked(false);
-            d->ui.repairNonmanifoldsButton->setEnabled(false);
-            removeViewProvider("MeshGui::ViewProviderMeshNonManifolds");
-            removeViewProvider("MeshGui::ViewProviderMeshNonManifoldPoints");
-        }
-        else {
-            d->ui.checkNonmanifoldsButton->setText(
-                tr("%1 non-manifolds").arg(f_eval.CountManifolds() + point_indices.size()));
-            d->ui.checkNonmanifoldsButton->setChecked(true);
-            d->ui.repairNonmanifoldsButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
-
-            if (!ok1) {
-                const std::vector<std::pair<Mesh::FacetIndex, Mesh::FacetIndex>>& inds =
-                    f_eval.GetIndices();
-                std::vector<Mesh::FacetIndex> indices;
-                indices.reserve(2 * inds.size());
-                std::vector<std::pair<Mesh::FacetIndex, Mesh::FacetIndex>>::const_iterator it;
-                for (it = inds.begin(); it != inds.end(); ++it) {
-                    indices.push_back(it->first);
-                    indices.push_back(it->second);
-                }
+        qApp->restoreOverrideCursor();
+        d->ui.analyzeNonmanifoldsButton->setEnabled(true);
+    }
+}
 
-                addViewProvider("MeshGui::ViewProviderMeshNonManifolds", indices);
-            }
+void DlgEvaluateMeshImp::showNonmanifolds(const Analysis& analysis)
+{
+    bool ok1 = analysis.manifoldEdges;
+    bool ok2 = analysis.manifoldPoints;
+    const std::vector<Mesh::PointIndex>& point_indices = analysis.nonmanifoldPoints;
 
-            if (!ok2) {
-                addViewProvider("MeshGui::ViewProviderMeshNonManifoldPoints", point_indices);
+    if (ok1 && ok2) {
+        d->ui.checkNonmanifoldsButton->setText(tr("No non-manifolds"));
+        d->ui.checkNonmanifoldsButton->setChecked(false);
+        d->ui.repairNonmanifoldsButton->setEnabled(false);
+        removeViewProvider("MeshGui::ViewProviderMeshNonManifolds");
+        removeViewProvider("MeshGui::ViewProviderMeshNonManifoldPoints");
+    }
+    else {
+        d->ui.checkNonmanifoldsButton->setText(
+            tr("%1 non-manifolds").arg(analysis.countManifolds + point_indices.size()));
+        d->ui.checkNonmanifoldsButton->setChecked(true);
+        d->ui.repairNonmanifoldsButton->setEnabled(true);
+        d->ui.repairAllTogether->setEnabled(true);
+
+        if (!ok1) {
+            const std::vector<std::pair<Mesh::FacetIndex, Mesh::FacetIndex>>& inds =
+                analysis.nonmanifoldEdges;
+            std::vector<Mesh::FacetIndex> indices;
+            indices.reserve(2 * inds.size());
+            std::vector<std::pair<Mesh::FacetIndex, Mesh::FacetIndex>>::const_iterator it;
+            for (it = inds.begin(); it != inds.end(); ++it) {
+                indices.push_back(it->first);
+                indices.push_back(it->second);
             }
+
+            addViewProvider("MeshGui::ViewProviderMeshNonManifolds", indices);
         }
 
-        qApp->restoreOverrideCursor();
-        d->ui.analyzeNonmanifoldsButton->setEnabled(true);
+        if (!ok2) {
+            addViewProvider("MeshGui::ViewProviderMeshNonManifoldPoints", point_indices);
+        }
     }
 }
 
@@ -708,49 +833,44 @@ void DlgEvaluateMeshImp::onAnalyzeIndicesButtonClicked()
         qApp->processEvents();
         qApp->setOverrideCursor(Qt::WaitCursor);
 
-        const MeshKernel& rMesh = d->meshFeature->Mesh.getValue().getKernel();
-        MeshEvalRangeFacet rf(rMesh);
-        MeshEvalRangePoint rp(rMesh);
-        MeshEvalCorruptedFacets cf(rMesh);
-        MeshEvalNeighbourhood nb(rMesh);
+        Analysis analysis(d->meshFeature->Mesh.getValue().getKernel());
+        analysis.checkIndices();
+        showIndices(analysis);
 
-        if (!rf.Evaluate()) {
+        qApp->restoreOverrideCursor();
+        d->ui.analyzeIndicesButton->setEnabled(true);
+    }
+}
+
+void DlgEvaluateMeshImp::showIndices(const Analysis& analysis)
+{
+    switch (analysis.invalidIndices) {
+        case Analysis::InvalidFacetIndices:
             d->ui.checkIndicesButton->setText(tr("Invalid face indices"));
-            d->ui.checkIndicesButton->setChecked(true);
-            d->ui.repairIndicesButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
-            addViewProvider("MeshGui::ViewProviderMeshIndices", rf.GetIndices());
-        }
-        else if (!rp.Evaluate()) {
+            break;
+        case Analysis::InvalidPointIndices:
             d->ui.checkIndicesButton->setText(tr("Invalid point indices"));
-            d->ui.checkIndicesButton->setChecked(true);
-            d->ui.repairIndicesButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
-            // addViewProvider("MeshGui::ViewProviderMeshIndices", rp.GetIndices());
-        }
-        else if (!cf.Evaluate()) {
+            break;
+        case Analysis::MultiplePointIndices:
             d->ui.checkIndicesButton->setText(tr("Multiple point indices"));
-            d->ui.checkIndicesButton->setChecked(true);
-            d->ui.repairIndicesButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
-            addViewProvider("MeshGui::ViewProviderMeshIndices", cf.GetIndices());
-        }
-        else if (!nb.Evaluate()) {
+            break;
+        case Analysis::InvalidNeighbourIndices:
             d->ui.checkIndicesButton->setText(tr("Invalid neighbour indices"));
-            d->ui.checkIndicesButton->setChecked(true);
-            d->ui.repairIndicesButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
-            addViewProvider("MeshGui::ViewProviderMeshIndices", nb.GetIndices());
-        }
-        else {
+            break;
+        case Analysis::ValidIndices:
             d->ui.checkIndicesButton->setText(tr("No invalid indices"));
             d->ui.checkIndicesButton->setChecked(false);
             d->ui.repairIndicesButton->setEnabled(false);
             removeViewProvider("MeshGui::ViewProviderMeshIndices");
-        }
+            return;
+    }
 
-        qApp->restoreOverrideCursor();
-        d->ui.analyzeIndicesButton->setEnabled(true);
+    d->ui.checkIndicesButton->setChecked(true);
+    d->ui.repairIndicesButton->setEnabled(true);
+    d->ui.repairAllTogether->setEnabled(true);
+    // the invalid point indices are not shown
+    if (analysis.invalidIndices != Analysis::InvalidPointIndices) {
+        addViewProvider("MeshGui::ViewProviderMeshIndices", analysis.indices);
     }
 }
 
@@ -800,29 +920,33 @@ void DlgEvaluateMeshImp::onAnalyzeDegeneratedButtonClicked()
         qApp->processEvents();
         qApp->setOverrideCursor(Qt::WaitCursor);
 
-        const MeshKernel& rMesh = d->meshFeature->Mesh.getValue().getKernel();
-        MeshEvalDegeneratedFacets eval(rMesh, d->epsilonDegenerated);
-        std::vector<Mesh::FacetIndex> degen = eval.GetIndices();
-
-        if (degen.empty()) {
-            d->ui.checkDegenerationButton->setText(tr("No degenerations"));
-            d->ui.checkDegenerationButton->setChecked(false);
-            d->ui.repairDegeneratedButton->setEnabled(false);
-            removeViewProvider("MeshGui::ViewProviderMeshDegenerations");
-        }
-        else {
-            d->ui.checkDegenerationButton->setText(tr("%1 degenerated faces").arg(degen.size()));
-            d->ui.checkDegenerationButton->setChecked(true);
-            d->ui.repairDegeneratedButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
-            addViewProvider("MeshGui::ViewProviderMeshDegenerations", degen);
-        }
+        Analysis analysis(d->meshFeature->Mesh.getValue().getKernel());
+        analysis.checkDegenerations(d->epsilonDegenerated);
+        showDegenerations(analysis);
 
         qApp->restoreOverrideCursor();
         d->ui.analyzeDegeneratedButton->setEnabled(true);
     }
 }
 
+void DlgEvaluateMeshImp::showDegenerations(const Analysis& analysis)
+{
+    const std::vector<Mesh::FacetIndex>& degen = analysis.degenerations;
+    if (degen.empty()) {
+        d->ui.checkDegenerationButton->setText(tr("No degenerations"));
+        d->ui.checkDegenerationButton->setChecked(false);
+        d->ui.repairDegeneratedButton->setEnabled(false);
+        removeViewProvider("MeshGui::ViewProviderMeshDegenerations");
+    }
+    else {
+        d->ui.checkDegenerationButton->setText(tr("%1 degenerated faces").arg(degen.size()));
+        d->ui.checkDegenerationButton->setChecked(true);
+        d->ui.repairDegeneratedButton->setEnabled(true);
+        d->ui.repairAllTogether->setEnabled(true);
+        addViewProvider("MeshGui::ViewProviderMeshDegenerations", degen);
+    }
+}
+
 void DlgEvaluateMeshImp::onRepairDegeneratedButtonClicked()
 {
     if (d->meshFeature) {
@@ -870,30 +994,34 @@ void DlgEvaluateMeshImp::onAnalyzeDuplicatedFacesButtonClicked()
         qApp->processEvents();
         qApp->setOverrideCursor(Qt::WaitCursor);
 
-        const MeshKernel& rMesh = d->meshFeature->Mesh.getValue().getKernel();
-        MeshEvalDuplicateFacets eval(rMesh);
-        std::vector<Mesh::FacetIndex> dupl = eval.GetIndices();
-
-        if (dupl.empty()) {
-            d->ui.checkDuplicatedFacesButton->setText(tr("No duplicated faces"));
-            d->ui.checkDuplicatedFacesButton->setChecked(false);
-            d->ui.repairDuplicatedFacesButton->setEnabled(false);
-            removeViewProvider("MeshGui::ViewProviderMeshDuplicatedFaces");
-        }
-        else {
-            d->ui.checkDuplicatedFacesButton->setText(tr("%1 duplicated faces").arg(dupl.size()));
-            d->ui.checkDuplicatedFacesButton->setChecked(true);
-            d->ui.repairDuplicatedFacesButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
-
-            addViewProvider("MeshGui::ViewProviderMeshDuplicatedFaces", dupl);
-        }
+        Analysis analysis(d->meshFeature->Mesh.getValue().getKernel());
+        analysis.checkDuplicatedFaces();
+        showDuplicatedFaces(analysis);
 
         qApp->restoreOverrideCursor();
         d->ui.analyzeDuplicatedFacesButton->setEnabled(true);
     }
 }
 
+void DlgEvaluateMeshImp::showDuplicatedFaces(const Analysis& analysis)
+{
+    const std::vector<Mesh::FacetIndex>& dupl = analysis.duplicatedFaces;
+    if (dupl.empty()) {
+        d->ui.checkDuplicatedFacesButton->setText(tr("No duplicated faces"));
+        d->ui.checkDuplicatedFacesButton->setChecked(false);
+        d->ui.repairDuplicatedFacesButton->setEnabled(false);
+        removeViewProvider("MeshGui::ViewProviderMeshDuplicatedFaces");
+    }
+    else {
+        d->ui.checkDuplicatedFacesButton->setText(tr("%1 duplicated faces").arg(dupl.size()));
+        d->ui.checkDuplicatedFacesButton->setChecked(true);
+        d->ui.repairDuplicatedFacesButton->setEnabled(true);
+        d->ui.repairAllTogether->setEnabled(true);
+
+        addViewProvider("MeshGui::ViewProviderMeshDuplicatedFaces", dupl);
+    }
+}
+
 void DlgEvaluateMeshImp::onRepairDuplicatedFacesButtonClicked()
 {
     if (d->meshFeature) {
@@ -941,28 +1069,32 @@ void DlgEvaluateMeshImp::onAnalyzeDuplicatedPointsButtonClicked()
         qApp->processEvents();
         qApp->setOverrideCursor(Qt::WaitCursor);
 
-        const MeshKernel& rMesh = d->meshFeature->Mesh.getValue().getKernel();
-        MeshEvalDuplicatePoints eval(rMesh);
-
-        if (eval.Evaluate()) {
-            d->ui.checkDuplicatedPointsButton->setText(tr("No duplicated points"));
-            d->ui.checkDuplicatedPointsButton->setChecked(false);
-            d->ui.repairDuplicatedPointsButton->setEnabled(false);
-            removeViewProvider("MeshGui::ViewProviderMeshDuplicatedPoints");
-        }
-        else {
-            d->ui.checkDuplicatedPointsButton->setText(tr("Duplicated points"));
-            d->ui.checkDuplicatedPointsButton->setChecked(true);
-            d->ui.repairDuplicatedPointsButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
-            addViewProvider("MeshGui::ViewProviderMeshDuplicatedPoints", eval.GetIndices());
-        }
+        Analysis analysis(d->meshFeature->Mesh.getValue().getKernel());
+        analysis.checkDuplicatedPoints();
+        showDuplicatedPoints(analysis);
 
         qApp->restoreOverrideCursor();
         d->ui.analyzeDuplicatedPointsButton->setEnabled(true);
     }
 }
 
+void DlgEvaluateMeshImp::showDuplicatedPoints(const Analysis& analysis)
+{
+    if (analysis.duplicatedPoints.empty()) {
+        d->ui.checkDuplicatedPointsButton->setText(tr("No duplicated points"));
+        d->ui.checkDuplicatedPointsButton->setChecked(false);
+        d->ui.repairDuplicatedPointsButton->setEnabled(false);
+        removeViewProvider("MeshGui::ViewProviderMeshDuplicatedPoints");
+    }
+    else {
+        d->ui.checkDuplicatedPointsButton->setText(tr("Duplicated points"));
+        d->ui.checkDuplicatedPointsButton->setChecked(true);
+        d->ui.repairDuplicatedPointsButton->setEnabled(true);
+        d->ui.repairAllTogether->setEnabled(true);
+        addViewProvider("MeshGui::ViewProviderMeshDuplicatedPoints", analysis.duplicatedPoints);
+    }
+}
+
 void DlgEvaluateMeshImp::onRepairDuplicatedPointsButtonClicked()
 {
     if (d->meshFeature) {
@@ -1010,42 +1142,46 @@ void DlgEvaluateMeshImp::onAnalyzeSelfIntersectionButtonClicked()
         qApp->processEvents();
         qApp->setOverrideCursor(Qt::WaitCursor);
 
-        const MeshKernel& rMesh = d->meshFeature->Mesh.getValue().getKernel();
-        MeshEvalSelfIntersection eval(rMesh);
-        std::vector<std::pair<Mesh::FacetIndex, Mesh::FacetIndex>> intersection;
+        Analysis analysis(d->meshFeature->Mesh.getValue().getKernel());
         try {
-            eval.GetIntersections(intersection);
+            analysis.checkSelfIntersections();
         }
         catch (const Base::AbortException&) {
             Base::Console().message("The self-intersection analysis was aborted by the user\n");
         }
+        showSelfIntersections(analysis);
 
-        if (intersection.empty()) {
-            d->ui.checkSelfIntersectionButton->setText(tr("No self-intersections"));
-            d->ui.checkSelfIntersectionButton->setChecked(false);
-            d->ui.repairSelfIntersectionButton->setEnabled(false);
-            removeViewProvider("MeshGui::ViewProviderMeshSelfIntersections");
-        }
-        else {
-            d->ui.checkSelfIntersectionButton->setText(tr("Self-intersections"));
-            d->ui.checkSelfIntersectionButton->setChecked(true);
-            d->ui.repairSelfIntersectionButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
+        qApp->restoreOverrideCursor();
+        d->ui.analyzeSelfIntersectionButton->setEnabled(true);
+    }
+}
 
-            std::vector<Mesh::FacetIndex> indices;
-            indices.reserve(2 * intersection.size());
-            std::vector<std::pair<Mesh::FacetIndex, Mesh::FacetIndex>>::iterator it;
-            for (it = intersection.begin(); it != intersection.end(); ++it) {
-                indices.push_back(it->first);
-                indices.push_back(it->second);
-            }
+void DlgEvaluateMeshImp::showSelfIntersections(const Analysis& analysis)
+{
+    const std::vector<std::pair<Mesh::FacetIndex, Mesh::FacetIndex>>& intersection =
+        analysis.selfIntersections;
+    if (intersection.empty()) {
+        d->ui.checkSelfIntersectionButton->setText(tr("No self-intersections"));
+        d->ui.checkSelfIntersectionButton->setChecked(false);
+        d->ui.repairSelfIntersectionButton->setEnabled(false);
+        removeViewProvider("MeshGui::ViewProviderMeshSelfIntersections");
+    }
+    else {
+        d->ui.checkSelfIntersectionButton->setText(tr("Self-intersections"));
+        d->ui.checkSelfIntersectionButton->setChecked(true);
+        d->ui.repairSelfIntersectionButton->setEnabled(true);
+        d->ui.repairAllTogether->setEnabled(true);
 
-            addViewProvider("MeshGui::ViewProviderMeshSelfIntersections", indices);
-            d->self_intersections.swap(indices);
+        std::vector<Mesh::FacetIndex> indices;
+        indices.reserve(2 * intersection.size());
+        std::vector<std::pair<Mesh::FacetIndex, Mesh::FacetIndex>>::const_iterator it;
+        for (it = intersection.begin(); it != intersection.end(); ++it) {
+            indices.push_back(it->first);
+            indices.push_back(it->second);
         }
 
-        qApp->restoreOverrideCursor();
-        d->ui.analyzeSelfIntersectionButton->setEnabled(true);
+        addViewProvider("MeshGui::ViewProviderMeshSelfIntersections", indices);
+        d->self_intersections.swap(indices);
     }
 }
 
@@ -1088,43 +1224,33 @@ void DlgEvaluateMeshImp::onAnalyzeFoldsButtonClicked()
         qApp->processEvents();
         qApp->setOverrideCursor(Qt::WaitCursor);
 
-        const MeshKernel& rMesh = d->meshFeature->Mesh.getValue().getKernel();
-        MeshEvalFoldsOnSurface s_eval(rMesh);
-        MeshEvalFoldsOnBoundary b_eval(rMesh);
-        MeshEvalFoldOversOnSurface f_eval(rMesh);
-        bool ok1 = s_eval.Evaluate();
-        bool ok2 = b_eval.Evaluate();
-        bool ok3 = f_eval.Evaluate();
-
-        if (ok1 && ok2 && ok3) {
-            d->ui.checkFoldsButton->setText(tr("No folds on surface"));
-            d->ui.checkFoldsButton->setChecked(false);
-            d->ui.repairFoldsButton->setEnabled(false);
-            removeViewProvider("MeshGui::ViewProviderMeshFolds");
-        }
-        else {
-            std::vector<Mesh::FacetIndex> inds = f_eval.GetIndices();
-            std::vector<Mesh::FacetIndex> inds1 = s_eval.GetIndices();
-            std::vector<Mesh::FacetIndex> inds2 = b_eval.GetIndices();
-            inds.insert(inds.end(), inds1.begin(), inds1.end());
-            inds.insert(inds.end(), inds2.begin(), inds2.end());
-
-            // remove duplicates
-            std::sort(inds.begin(), inds.end());
-            inds.erase(std::unique(inds.begin(), inds.end()), inds.end());
-
-            d->ui.checkFoldsButton->setText(tr("%1 folds on surface").arg(inds.size()));
-            d->ui.checkFoldsButton->setChecked(true);
-            d->ui.repairFoldsButton->setEnabled(true);
-            d->ui.repairAllTogether->setEnabled(true);
-            addViewProvider("MeshGui::ViewProviderMeshFolds", inds);
-        }
+        Analysis analysis(d->meshFeature->Mesh.getValue().getKernel());
+        analysis.checkFolds();
+        showFolds(analysis);
 
         qApp->restoreOverrideCursor();
         d->ui.analyzeFoldsButton->setEnabled(true);
     }
 }
 
+void DlgEvaluateMeshImp::showFolds(const Analysis& analysis)
+{
+    const std::vector<Mesh::FacetIndex>& inds = analysis.folds;
+    if (inds.empty()) {
+        d->ui.checkFoldsButton->setText(tr("No folds on surface"));
+        d->ui.checkFoldsButton->setChecked(false);
+        d->ui.repairFoldsButton->setEnabled(false);
+        removeViewProvider("MeshGui::ViewProviderMeshFolds");
+    }
+    else {
+        d->ui.checkFoldsButton->setText(tr("%1 folds on surface").arg(inds.size()));
+        d->ui.checkFoldsButton->setChecked(true);
+        d->ui.repairFoldsButton->setEnabled(true);
+        d->ui.repairAllTogether->setEnabled(true);
+        addViewProvider("MeshGui::ViewProviderMeshFolds", inds);
+    }
+}
+
 void DlgEvaluateMeshImp::onRepairFoldsButtonClicked()
 {
     if (d->meshFeature) {
@@ -1156,15 +1282,61 @@ void DlgEvaluateMeshImp::onRepairFoldsButtonClicked()
 
 void DlgEvaluateMeshImp::onAnalyzeAllTogetherClicked()
 {
-    onAnalyzeOrientationButtonClicked();
-    onAnalyzeDuplicatedFacesButtonClicked();
-    onAnalyzeDuplicatedPointsButtonClicked();
-    onAnalyzeNonmanifoldsButtonClicked();
-    onAnalyzeDegeneratedButtonClicked();
-    onAnalyzeIndicesButtonClicked();
-    onAnalyzeSelfIntersectionButtonClicked();
-    if (d->enableFoldsCheck) {
-        onAnalyzeFoldsButtonClicked();
+    if (d->meshFeature) {
+        d->ui.analyzeAllTogether->setEnabled(false);
+        qApp->processEvents();
+        qApp->setOverrideCursor(Qt::WaitCursor);
+
+        // The orientation check uses the facet flags and thus runs on its own while
+        // the other checks only read the mesh and run concurrently
+        Analysis analysis(d->meshFeature->Mesh.getValue().getKernel());
+        analysis.checkOrientation();
+
+        MeshCore::MeshEvaluationRunner runner;
+        runner.Add([&analysis]() {
+            analysis.checkDuplicatedFaces();
+        });
+        runner.Add([&analysis]() {
+            analysis.checkDuplicatedPoints();
+        });
+        runner.Add([&analysis, checkPoints = d->checkNonManfoldPoints]() {
+            analysis.checkNonmanifolds(checkPoints);
+        });
+        runner.Add([&analysis, epsilon = d->epsilonDegenerated]() {
+            analysis.checkDegenerations(epsilon);
+        });
+        runner.Add([&analysis]() {
+            analysis.checkIndices();
+        });
+        runner.Add([&analysis]() {
+            analysis.checkSelfIntersections();
+        });
+        if (d->enableFoldsCheck) {
+            runner.Add([&analysis]() {
+                analysis.checkFolds();
+            });
+        }
+
+        try {
+            runner.Run("Analyzing mesh...");
+
+            showOrientation(analysis);
+            showDuplicatedFaces(analysis);
+            showDuplicatedPoints(analysis);
+            showNonmanifolds(analysis);
+            showDegenerations(analysis);
+            showIndices(analysis);
+            showSelfIntersections(analysis);
+            if (d->enableFoldsCheck) {
+                showFolds(analysis);
+            }
+        }
+        catch (const Base::AbortException&) {
+            Base::Console().message("The mesh analysis was aborted by the user\n");
+        }
+
+        qApp->restoreOverrideCursor();
+        d->ui.analyzeAllTogether->setEnabled(true);
     }
 }
 
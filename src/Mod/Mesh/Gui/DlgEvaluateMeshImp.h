@@ -128,6 +128,16 @@ private:
     void onMeshNameButtonActivated(int);
     void onButtonBoxClicked(QAbstractButton*);
 
+    struct Analysis;
+    void showOrientation(const Analysis&);
+    void showDuplicatedFaces(const Analysis&);
+    void showDuplicatedPoints(const Analysis&);
+    void showNonmanifolds(const Analysis&);
+    void showDegenerations(const Analysis&);
+    void showIndices(const Analysis&);
+    void showSelfIntersections(const Analysis&);
+    void showFolds(const Analysis&);
+
 protected:
     void refreshList();
     void showInformation();
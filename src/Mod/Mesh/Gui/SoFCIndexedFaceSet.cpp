@@ -30,6 +30,8 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <limits>
 #ifdef FC_OS_MACOSX
 #include <OpenGL/gl.h>
@@ -49,9 +51,12 @@
 #include <Inventor/elements/SoGLCoordinateElement.h>
 #include <Inventor/elements/SoGLLazyElement.h>
 #include <Inventor/elements/SoMaterialBindingElement.h>
+#include <Inventor/elements/SoModelMatrixElement.h>
 #include <Inventor/elements/SoNormalBindingElement.h>
 #include <Inventor/elements/SoProjectionMatrixElement.h>
+#include <Inventor/elements/SoViewVolumeElement.h>
 #include <Inventor/elements/SoViewingMatrixElement.h>
+#include <Inventor/elements/SoViewportRegionElement.h>
 #include <Inventor/errors/SoDebugError.h>
 #include <Inventor/nodes/SoCoordinate3.h>
 #endif
@@ -70,6 +75,13 @@ using namespace MeshGui;
 
 #if defined RENDER_GL_VAO
 
+/**
+ * The triangles are sorted along a Morton curve and split into spatial clusters of a fixed
+ * size. Each cluster stores its bounding box and the index ranges of its full and its
+ * simplified triangles. When rendering, clusters outside the view volume are skipped and
+ * clusters whose triangles become smaller than a pixel on the screen are drawn simplified.
+ * Adjacent ranges are merged so that a fully visible mesh is still drawn with a single call.
+ */
 class MeshRenderer::Private
 {
 public:
@@ -91,9 +103,48 @@ public:
     bool needUpdate(SoGLRenderAction*);
 
 private:
-    void renderGLArray(SoGLRenderAction*, GLenum);
+    struct Range
+    {
+        int32_t offset;
+        int32_t count;
+    };
+    struct Cluster
+    {
+        SbBox3f box;
+        Range full;
+        Range coarse;
+    };
+
+    void buildClusters(const std::vector<float>& vertex, std::vector<int32_t>& index);
+    std::vector<Range> visibleRanges(SoGLRenderAction*) const;
+    void renderGLArray(SoGLRenderAction*, GLenum, const std::vector<Range>&);
+
+    std::vector<Cluster> clusters;
+    int32_t numIndices {0};
+    int stride {6};
 };
 
+namespace
+{
+// Number of triangles per cluster
+constexpr std::size_t clusterSize = 4096;
+// Number of cells along the longest side of a cluster used to simplify it
+constexpr int clusterResolution = 16;
+// A cluster is simplified if a triangle covers less than this number of pixels
+constexpr float minPixelsPerTriangle = 1.0F;
+
+// Spreads the lower ten bits so that two zero bits follow each of them
+uint32_t spreadBits(float cell)
+{
+    auto value = static_cast<uint32_t>(std::clamp(cell, 0.0F, 1023.0F));
+    value = (value | (value << 16)) & 0x030000FF;
+    value = (value | (value << 8)) & 0x0300F00F;
+    value = (value | (value << 4)) & 0x030C30C3;
+    value = (value | (value << 2)) & 0x09249249;
+    return value;
+}
+}  // namespace
+
 MeshRenderer::Private::Private()
     : vertices(GL_ARRAY_BUFFER)
     , indices(GL_ELEMENT_ARRAY_BUFFER)
@@ -136,13 +187,159 @@ void MeshRenderer::Private::generateGLArrays(SoGLRenderAction* action,
     vertices.allocate(vertex.data(), vertex.size() * sizeof(float));
     vertices.release();
 
+    // the position follows the color and normal
+    stride = matbind != SoMaterialBindingElement::OVERALL ? 10 : 6;
+    buildClusters(vertex, index);
+
     indices.bind();
     indices.allocate(index.data(), index.size() * sizeof(int32_t));
     indices.release();
     this->matbinding = matbind;
 }
 
-void MeshRenderer::Private::renderGLArray(SoGLRenderAction* action, GLenum mode)
+void MeshRenderer::Private::buildClusters(const std::vector<float>& vertex,
+                                          std::vector<int32_t>& index)
+{
+    clusters.clear();
+    numIndices = static_cast<int32_t>(index.size());
+    std::size_t numTria = index.size() / 3;
+    auto point = [&vertex, this](int32_t idx) {
+        const float* ptr = &vertex[std::size_t(idx) * stride + stride - 3];
+        return SbVec3f(ptr[0], ptr[1], ptr[2]);
+    };
+
+    // sort the triangles along a Morton curve of their centers
+    const float tiny = std::numeric_limits<float>::min();
+    SbBox3f bbox;
+    for (int32_t idx : index) {
+        bbox.extendBy(point(idx));
+    }
+    if (bbox.isEmpty()) {
+        return;
+    }
+
+    SbVec3f bmin = bbox.getMin();
+    SbVec3f size = bbox.getMax() - bmin;
+    float scale = 1023.0F / std::max({size[0], size[1], size[2], tiny});
+    std::vector<std::pair<uint32_t, uint32_t>> order(numTria);
+    for (std::size_t i = 0; i < numTria; i++) {
+        SbVec3f center = (point(index[3 * i]) + point(index[3 * i + 1]) + point(index[3 * i + 2]))
+            / 3.0F;
+        SbVec3f cell = (center - bmin) * scale;
+        uint32_t code =
+            spreadBits(cell[0]) | (spreadBits(cell[1]) << 1) | (spreadBits(cell[2]) << 2);
+        order[i] = std::make_pair(code, uint32_t(i));
+    }
+    std::sort(order.begin(), order.end());
+
+    std::vector<int32_t> sorted(index.size());
+    for (std::size_t i = 0; i < numTria; i++) {
+        std::copy_n(&index[3 * order[i].second], 3, &sorted[3 * i]);
+    }
+
+    // The simplified triangles are appended after all full triangles. The corners are snapped
+    // to the first vertex found in their cell of a coarse grid over the cluster and
+    // degenerated or duplicated triangles are removed.
+    const int cells = clusterResolution + 1;
+    std::vector<int32_t> grid(cells * cells * cells, -1);
+    std::vector<int32_t> coarse;
+    std::vector<std::array<int32_t, 3>> triangles;
+    for (std::size_t first = 0; first < numTria; first += clusterSize) {
+        std::size_t last = std::min(first + clusterSize, numTria);
+        Cluster cluster;
+        for (std::size_t i = 3 * first; i < 3 * last; i++) {
+            cluster.box.extendBy(point(sorted[i]));
+        }
+        cluster.full.offset = static_cast<int32_t>(3 * first);
+        cluster.full.count = static_cast<int32_t>(3 * (last - first));
+
+        SbVec3f cmin = cluster.box.getMin();
+        SbVec3f csize = cluster.box.getMax() - cmin;
+        float cscale = float(clusterResolution) / std::max({csize[0], csize[1], csize[2], tiny});
+        auto snap = [&](int32_t idx) {
+            SbVec3f cell = (point(idx) - cmin) * cscale;
+            auto coord = [&cell](int i) {
+                return std::clamp(int(cell[i]), 0, clusterResolution);
+            };
+            int key = (coord(0) * cells + coord(1)) * cells + coord(2);
+            if (grid[key] < 0) {
+                grid[key] = idx;
+            }
+            return grid[key];
+        };
+
+        triangles.clear();
+        for (std::size_t i = 3 * first; i < 3 * last; i += 3) {
+            std::array<int32_t, 3> tria {snap(sorted[i]), snap(sorted[i + 1]), snap(sorted[i + 2])};
+            if (tria[0] != tria[1] && tria[1] != tria[2] && tria[2] != tria[0]) {
+                // keep the orientation when making the first index the smallest
+                std::rotate(tria.begin(), std::min_element(tria.begin(), tria.end()), tria.end());
+                triangles.push_back(tria);
+            }
+        }
+        std::sort(triangles.begin(), triangles.end());
+        triangles.erase(std::unique(triangles.begin(), triangles.end()), triangles.end());
+
+        if (3 * triangles.size() < std::size_t(cluster.full.count)) {
+            cluster.coarse.offset = static_cast<int32_t>(index.size() + coarse.size());
+            cluster.coarse.count = static_cast<int32_t>(3 * triangles.size());
+            for (const auto& tria : triangles) {
+                coarse.insert(coarse.end(), tria.begin(), tria.end());
+            }
+        }
+        else {
+            cluster.coarse = cluster.full;
+        }
+
+        std::fill(grid.begin(), grid.end(), -1);
+        clusters.push_back(cluster);
+    }
+
+    sorted.insert(sorted.end(), coarse.begin(), coarse.end());
+    index.swap(sorted);
+}
+
+std::vector<MeshRenderer::Private::Range>
+MeshRenderer::Private::visibleRanges(SoGLRenderAction* action) const
+{
+    SoState* state = action->getState();
+    const SbViewVolume& vv = SoViewVolumeElement::get(state);
+    const SbMatrix& mat = SoModelMatrixElement::get(state);
+    SbVec2s size = SoViewportRegionElement::get(state).getViewportSizePixels();
+    float pixels = float(std::max(size[0], size[1]));
+
+    std::vector<Range> ranges;
+    for (const auto& cluster : clusters) {
+        SbBox3f box = cluster.box;
+        box.transform(mat);
+        if (!vv.intersect(box)) {
+            continue;
+        }
+
+        // compare the projected size of the cluster with the number of its triangles
+        float diameter = (box.getMax() - box.getMin()).length();
+        float scale = vv.getWorldToScreenScale(box.getCenter(), 1.0F);
+        float extent = scale > 0.0F ? pixels * diameter / scale : pixels;
+        bool simplify = extent * extent < minPixelsPerTriangle * float(cluster.full.count / 3);
+        const Range& range = simplify ? cluster.coarse : cluster.full;
+        if (!ranges.empty() && ranges.back().offset + ranges.back().count == range.offset) {
+            ranges.back().count += range.count;
+        }
+        else {
+            ranges.push_back(range);
+        }
+    }
+
+    // the drawn subset depends on the camera
+    if (clusters.size() > 1) {
+        SoGLCacheContextElement::shouldAutoCache(state, SoGLCacheContextElement::DONT_AUTO_CACHE);
+    }
+    return ranges;
+}
+
+void MeshRenderer::Private::renderGLArray(SoGLRenderAction* action,
+                                          GLenum mode,
+                                          const std::vector<Range>& ranges)
 {
     if (!initialized) {
         SoDebugError::postWarning("MeshRenderer", "not initialized");
@@ -166,7 +363,13 @@ void MeshRenderer::Private::renderGLArray(SoGLRenderAction* action, GLenum mode)
         glInterleavedArrays(GL_N3F_V3F, 0, nullptr);
     }
 
-    glDrawElements(mode, indices.size() / sizeof(uint32_t), GL_UNSIGNED_INT, nullptr);
+    for (const auto& range : ranges) {
+        glDrawElements(
+            mode,
+            range.count,
+            GL_UNSIGNED_INT,
+            reinterpret_cast<const GLvoid*>(std::uintptr_t(range.offset) * sizeof(uint32_t)));
+    }
 
     vertices.release();
     indices.release();
@@ -178,18 +381,20 @@ void MeshRenderer::Private::renderGLArray(SoGLRenderAction* action, GLenum mode)
 
 void MeshRenderer::Private::renderFacesGLArray(SoGLRenderAction* action)
 {
-    renderGLArray(action, GL_TRIANGLES);
+    renderGLArray(action, GL_TRIANGLES, visibleRanges(action));
 }
 
 void MeshRenderer::Private::renderCoordsGLArray(SoGLRenderAction* action)
 {
-    renderGLArray(action, GL_POINTS);
+    renderGLArray(action, GL_POINTS, {Range {0, numIndices}});
 }
 
 void MeshRenderer::Private::update()
 {
     vertices.destroy();
     indices.destroy();
+    clusters.clear();
+    numIndices = 0;
 }
 
 bool MeshRenderer::Private::needUpdate(SoGLRenderAction* action)
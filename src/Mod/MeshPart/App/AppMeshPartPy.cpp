@@ -76,8 +76,11 @@ public:
             "Multiple signatures are available:\n"
             "\n"
             "projectShapeOnMesh(Shape, Mesh, float) -> list of polygons\n"
-            "projectShapeOnMesh(Shape, Mesh, Vector) -> list of polygons\n"
-            "projectShapeOnMesh(list of polygons, Mesh, Vector) -> list of polygons\n"
+            "projectShapeOnMesh(Shape, Mesh, Vector, [Threads=0]) -> list of polygons\n"
+            "projectShapeOnMesh(list of polygons, Mesh, Vector, [Threads=0]) -> list of polygons\n"
+            "\n"
+            "The projection along a direction runs in parallel with the given number of\n"
+            "threads. If Threads is 0 all hardware threads are used.\n"
         );
         add_varargs_method("projectPointsOnMesh",&Module::projectPointsOnMesh,
             "Projects points onto a mesh with a given direction\n"
@@ -100,7 +103,8 @@ public:
             "                         AngularDeflection=0.5,\n"
             "                         Relative=False,"
             "                         Segments=False,\n"
-            "                         GroupColors=[])\n"
+            "                         GroupColors=[],\n"
+            "                         Parallel=False)\n"
             "    meshFromShape(Shape, MaxLength)\n"
             "    meshFromShape(Shape, MaxArea)\n"
             "    meshFromShape(Shape, LocalLength)\n"
@@ -126,6 +130,7 @@ public:
             "    AngularDeflection (optional, float)\n"
             "    Segments (optional, boolean)\n"
             "    GroupColors (optional, list of (Red, Green, Blue) tuples)\n"
+            "    Parallel (optional, boolean) - mesh the faces in parallel\n"
             "    MaxLength (required, float)\n"
             "    MaxArea (required, float)\n"
             "    LocalLength (required, float)\n"
@@ -279,14 +284,16 @@ private:
             return list;
         }
 
-        static const std::array<const char *, 4> kwds_dir {"Shape", "Mesh", "Direction", nullptr};
+        static const std::array<const char *, 5> kwds_dir {"Shape", "Mesh", "Direction", "Threads", nullptr};
         PyErr_Clear();
         PyObject *v;
+        int threads = 0;
         if (Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(),
-                                                "O!O!O!", kwds_dir,
+                                                "O!O!O!|i", kwds_dir,
                                                 &Part::TopoShapePy::Type, &s,
                                                 &Mesh::MeshPy::Type, &m,
-                                                &Base::VectorPy::Type, &v)) {
+                                                &Base::VectorPy::Type, &v,
+                                                &threads)) {
             TopoDS_Shape shape = static_cast<Part::TopoShapePy*>(s)->getTopoShapePtr()->getShape();
             const Mesh::MeshObject* mesh = static_cast<Mesh::MeshPy*>(m)->getMeshObjectPtr();
             Base::Vector3d* vec = static_cast<Base::VectorPy*>(v)->getVectorPtr();
@@ -297,7 +304,10 @@ private:
 
             MeshProjection proj(kernel);
             std::vector<MeshProjection::PolyLine> polylines;
-            proj.projectParallelToMesh(shape, dir, polylines);
+            {
+                Base::PyGILStateRelease releaser{};
+                proj.projectParallelToMesh(shape, dir, polylines, threads);
+            }
             Py::List list;
             for (const auto& it : polylines) {
                 Py::List poly;
@@ -311,14 +321,15 @@ private:
             return list;
         }
 
-        static const std::array<const char *, 4> kwds_poly {"Polygons", "Mesh", "Direction", nullptr};
+        static const std::array<const char *, 5> kwds_poly {"Polygons", "Mesh", "Direction", "Threads", nullptr};
         PyErr_Clear();
         PyObject *seq;
         if (Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(),
-                                                "OO!O!", kwds_poly,
+                                                "OO!O!|i", kwds_poly,
                                                 &seq,
                                                 &Mesh::MeshPy::Type, &m,
-                                                &Base::VectorPy::Type, &v)) {
+                                                &Base::VectorPy::Type, &v,
+                                                &threads)) {
             std::vector<MeshProjection::PolyLine> polylinesIn;
             Py::Sequence edges(seq);
             polylinesIn.reserve(edges.size());
@@ -346,7 +357,10 @@ private:
 
             MeshProjection proj(kernel);
             std::vector<MeshProjection::PolyLine> polylines;
-            proj.projectParallelToMesh(polylinesIn, dir, polylines);
+            {
+                Base::PyGILStateRelease releaser{};
+                proj.projectParallelToMesh(polylinesIn, dir, polylines, threads);
+            }
 
             Py::List list;
             for (const auto& it : polylines) {
@@ -363,8 +377,8 @@ private:
 
         throw Py::TypeError("Expected arguments are:\n"
                             "Shape, Mesh, float or\n"
-                            "Shape, Mesh, Vector or\n"
-                            "Polygons, Mesh, Vector\n");
+                            "Shape, Mesh, Vector, [int] or\n"
+                            "Polygons, Mesh, Vector, [int]\n");
     }
     Py::Object projectPointsOnMesh(const Py::Tuple& args)
     {
@@ -482,18 +496,21 @@ private:
             return Py::asObject(new Mesh::MeshPy(mesh));
         };
 
-        static const std::array<const char *, 7> kwds_lindeflection{"Shape", "LinearDeflection", "AngularDeflection",
-                                                                    "Relative", "Segments", "GroupColors", nullptr};
+        static const std::array<const char *, 8> kwds_lindeflection{"Shape", "LinearDeflection", "AngularDeflection",
+                                                                    "Relative", "Segments", "GroupColors",
+                                                                    "Parallel", nullptr};
         PyErr_Clear();
         double lindeflection=0;
         double angdeflection=0.5;
         PyObject* relative = Py_False;
         PyObject* segment = Py_False;
         PyObject* groupColors = nullptr;
-        if (Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!d|dO!O!O", kwds_lindeflection,
+        PyObject* parallel = Py_False;
+        if (Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!d|dO!O!OO!", kwds_lindeflection,
                                                 &(Part::TopoShapePy::Type), &shape, &lindeflection,
                                                 &angdeflection, &(PyBool_Type), &relative,
-                                                &(PyBool_Type), &segment, &groupColors)) {
+                                                &(PyBool_Type), &segment, &groupColors,
+                                                &(PyBool_Type), &parallel)) {
             MeshPart::Mesher mesher(static_cast<Part::TopoShapePy*>(shape)->getTopoShapePtr()->getShape());
             mesher.setMethod(MeshPart::Mesher::Standard);
             mesher.setDeflection(lindeflection);
@@ -501,6 +518,7 @@ private:
             mesher.setRegular(true);
             mesher.setRelative(Base::asBoolean(relative));
             mesher.setSegments(Base::asBoolean(segment));
+            mesher.setParallel(Base::asBoolean(parallel));
             if (groupColors) {
                 Py::Sequence list(groupColors);
                 std::vector<uint32_t> colors;
@@ -22,7 +22,9 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
 #include <limits>
+#include <memory>
 #ifdef FC_OS_LINUX
 #include <unistd.h>
 #endif
@@ -51,6 +53,8 @@
 #include <Base/Stream.h>
 
 #include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
+#include <Mod/Mesh/App/Core/Functional.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
@@ -743,114 +747,242 @@ void MeshProjection::projectOnMesh(const std::vector<Base::Vector3f>& pointsIn,
 
 void MeshProjection::projectParallelToMesh(const TopoDS_Shape& aShape,
                                            const Base::Vector3f& dir,
-                                           std::vector<PolyLine>& rPolyLines) const
+                                           std::vector<PolyLine>& rPolyLines,
+                                           int threads) const
 {
-    // calculate the average edge length and create a grid
-    MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f * fAvgLen);
-    TopExp_Explorer Ex;
+    std::vector<PolyLine> polylines;
+    for (TopExp_Explorer Ex(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
+        const TopoDS_Edge& aEdge = TopoDS::Edge(Ex.Current());
+        PolyLine polyline;
+        discretize(aEdge, polyline.points, 5);
+        polylines.push_back(std::move(polyline));
+    }
 
-    int iCnt = 0;
-    for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
-        iCnt++;
+    projectParallelToMesh(polylines, dir, rPolyLines, threads);
+}
+
+void MeshProjection::projectParallelToMesh(const std::vector<PolyLine>& aEdges,
+                                           const Base::Vector3f& dir,
+                                           std::vector<PolyLine>& rPolyLines,
+                                           int threads) const
+{
+    // cast the rays of all points in one batch
+    std::vector<Base::Vector3f> points;
+    std::vector<std::size_t> pointOffsets {0};
+    pointOffsets.reserve(aEdges.size() + 1);
+    for (const auto& it : aEdges) {
+        points.insert(points.end(), it.points.begin(), it.points.end());
+        pointOffsets.push_back(points.size());
     }
 
-    Base::SequencerLauncher seq("Project curve on mesh", iCnt);
+    MeshCore::MeshFacetBVH bvh(_rcMesh);
+    std::vector<Base::Vector3f> hits;
+    std::vector<MeshCore::FacetIndex> facets;
+    bvh.NearestFacetsOnRays(points,
+                            std::vector<Base::Vector3f>(points.size(), dir),
+                            hits,
+                            facets,
+                            threads);
+
+    // like the line intersection of the grid search, a point behind the mesh is projected
+    // against the direction
+    std::vector<std::size_t> misses;
+    for (std::size_t i = 0; i < facets.size(); i++) {
+        if (facets[i] == MeshCore::FACET_INDEX_MAX) {
+            misses.push_back(i);
+        }
+    }
+    if (!misses.empty()) {
+        std::vector<Base::Vector3f> missPoints;
+        missPoints.reserve(misses.size());
+        for (std::size_t index : misses) {
+            missPoints.push_back(points[index]);
+        }
+        std::vector<Base::Vector3f> missHits;
+        std::vector<MeshCore::FacetIndex> missFacets;
+        bvh.NearestFacetsOnRays(missPoints,
+                                std::vector<Base::Vector3f>(misses.size(), -dir),
+                                missHits,
+                                missFacets,
+                                threads);
+        for (std::size_t i = 0; i < misses.size(); i++) {
+            hits[misses[i]] = missHits[i];
+            facets[misses[i]] = missFacets[i];
+        }
+    }
 
-    for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
-        const TopoDS_Edge& aEdge = TopoDS::Edge(Ex.Current());
-        std::vector<Base::Vector3f> points;
-        discretize(aEdge, points, 5);
-
-        using HitPoint = std::pair<Base::Vector3f, MeshCore::FacetIndex>;
-        std::vector<HitPoint> hitPoints;
-        using HitPoints = std::pair<HitPoint, HitPoint>;
-        std::vector<HitPoints> hitPointPairs;
-        for (auto it : points) {
-            Base::Vector3f result;
-            MeshCore::FacetIndex index;
-            if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
-                hitPoints.emplace_back(result, index);
-
-                if (hitPoints.size() > 1) {
-                    HitPoint p1 = hitPoints[hitPoints.size() - 2];
-                    HitPoint p2 = hitPoints[hitPoints.size() - 1];
-                    hitPointPairs.emplace_back(p1, p2);
+    // consecutive hits of a polyline make up the segments to walk over the mesh
+    std::vector<std::pair<std::size_t, std::size_t>> segments;
+    std::vector<std::size_t> segmentOffsets {0};
+    segmentOffsets.reserve(aEdges.size() + 1);
+    for (std::size_t i = 0; i < aEdges.size(); i++) {
+        std::size_t prev = std::numeric_limits<std::size_t>::max();
+        for (std::size_t j = pointOffsets[i]; j < pointOffsets[i + 1]; j++) {
+            if (facets[j] != MeshCore::FACET_INDEX_MAX) {
+                if (prev != std::numeric_limits<std::size_t>::max()) {
+                    segments.emplace_back(prev, j);
                 }
+                prev = j;
             }
         }
+        segmentOffsets.push_back(segments.size());
+    }
 
-        MeshCore::MeshProjection meshProjection(_rcMesh);
-        PolyLine polyline;
-        for (auto it : hitPointPairs) {
-            points.clear();
-            if (meshProjection.projectLineOnMesh(cGrid,
-                                                 it.first.first,
-                                                 it.first.second,
-                                                 it.second.first,
-                                                 it.second.second,
-                                                 dir,
-                                                 points)) {
-                polyline.points.insert(polyline.points.end(), points.begin(), points.end());
+    std::vector<std::vector<Base::Vector3f>> paths(segments.size());
+    std::vector<char> walked(segments.size(), 0);
+    auto walk = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            auto [first, second] = segments[i];
+            const Base::Vector3f& p1 = hits[first];
+            const Base::Vector3f& p2 = hits[second];
+            std::vector<Base::Vector3f>& path = paths[i];
+            if (walkFacetPath(p1, facets[first], p2, facets[second], dir, path)) {
+                walked[i] = 1;
+                continue;
+            }
+
+            // try the other way round, e.g. if the start point lies on a vertex
+            path.clear();
+            if (walkFacetPath(p2, facets[second], p1, facets[first], dir, path)) {
+                std::reverse(path.begin(), path.end());
+                walked[i] = 1;
             }
         }
-        rPolyLines.push_back(polyline);
+    };
+
+    // a walk fails at borders or non-manifolds, search these sections with the grid instead
+    std::unique_ptr<MeshFacetGrid> cGrid;
+    MeshCore::MeshProjection meshProjection(_rcMesh);
+    auto search = [&](std::size_t i) {
+        if (!cGrid) {
+            MeshAlgorithm clAlg(_rcMesh);
+            float fAvgLen = clAlg.GetAverageEdgeLength();
+            cGrid = std::make_unique<MeshFacetGrid>(_rcMesh, 5.0f * fAvgLen);
+        }
+        auto [first, second] = segments[i];
+        paths[i].clear();
+        if (!meshProjection.projectLineOnMesh(*cGrid,
+                                              hits[first],
+                                              facets[first],
+                                              hits[second],
+                                              facets[second],
+                                              dir,
+                                              paths[i])) {
+            paths[i].clear();
+        }
+    };
+
+    // the segments are walked in batches so that the progress is shown and the user can abort
+    Base::SequencerLauncher seq("Project curve on mesh", segments.size());
+    const std::size_t batchSize = 1024;
+    for (std::size_t start = 0; start < segments.size(); start += batchSize) {
+        std::size_t count = std::min(batchSize, segments.size() - start);
+        MeshCore::parallel_for(count,
+                               threads,
+                               [&](std::size_t begin, std::size_t end, std::size_t /*block*/) {
+                                   walk(start + begin, start + end);
+                               });
+        for (std::size_t i = start; i < start + count; i++) {
+            if (!walked[i]) {
+                search(i);
+            }
+            seq.next(true);
+        }
+    }
 
-        seq.next();
+    rPolyLines.reserve(rPolyLines.size() + aEdges.size());
+    for (std::size_t i = 0; i < aEdges.size(); i++) {
+        PolyLine polyline;
+        for (std::size_t j = segmentOffsets[i]; j < segmentOffsets[i + 1]; j++) {
+            polyline.points.insert(polyline.points.end(), paths[j].begin(), paths[j].end());
+        }
+        rPolyLines.push_back(std::move(polyline));
     }
 }
 
-void MeshProjection::projectParallelToMesh(const std::vector<PolyLine>& aEdges,
-                                           const Base::Vector3f& dir,
-                                           std::vector<PolyLine>& rPolyLines) const
+bool MeshProjection::walkFacetPath(const Base::Vector3f& p1,
+                                   MeshCore::FacetIndex f1,
+                                   const Base::Vector3f& p2,
+                                   MeshCore::FacetIndex f2,
+                                   const Base::Vector3f& dir,
+                                   std::vector<Base::Vector3f>& polyline) const
 {
-    // calculate the average edge length and create a grid
-    MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f * fAvgLen);
-
-    Base::SequencerLauncher seq("Project curve on mesh", aEdges.size());
+    polyline.push_back(p1);
+    if (f1 == f2) {
+        polyline.push_back(p2);
+        return true;
+    }
 
-    for (const auto& it : aEdges) {
-        std::vector<Base::Vector3f> points = it.points;
-
-        using HitPoint = std::pair<Base::Vector3f, MeshCore::FacetIndex>;
-        std::vector<HitPoint> hitPoints;
-        using HitPoints = std::pair<HitPoint, HitPoint>;
-        std::vector<HitPoints> hitPointPairs;
-        for (auto it : points) {
-            Base::Vector3f result;
-            MeshCore::FacetIndex index;
-            if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
-                hitPoints.emplace_back(result, index);
-
-                if (hitPoints.size() > 1) {
-                    HitPoint p1 = hitPoints[hitPoints.size() - 2];
-                    HitPoint p2 = hitPoints[hitPoints.size() - 1];
-                    hitPointPairs.emplace_back(p1, p2);
-                }
+    Base::Vector3f line = p2 - p1;
+    Base::Vector3f normal = dir % line;
+    if (normal.Sqr() == 0.0F) {
+        return false;
+    }
+    normal.Normalize();
+
+    const MeshCore::MeshFacetArray& rFacets = _rcMesh.GetFacets();
+    const MeshCore::MeshPointArray& rPoints = _rcMesh.GetPoints();
+
+    // A point on the plane counts as lying on the positive side. As a point always gets the
+    // same distance every facet is cut at either none or two of its edges.
+    auto distance = [&](MeshCore::PointIndex index) {
+        return normal * (rPoints[index] - p1);
+    };
+    auto cutEdge = [&](MeshCore::PointIndex p, MeshCore::PointIndex q, Base::Vector3f& cut) {
+        float dp = distance(p);
+        float dq = distance(q);
+        if ((dp >= 0.0F) == (dq >= 0.0F)) {
+            return false;
+        }
+        cut = rPoints[p] + (rPoints[q] - rPoints[p]) * (dp / (dp - dq));
+        return true;
+    };
+
+    MeshCore::FacetIndex facet = f1;
+    unsigned short entry = std::numeric_limits<unsigned short>::max();
+    for (std::size_t step = 0; step < rFacets.size(); step++) {
+        const MeshFacet& rFacet = rFacets[facet];
+        unsigned short exit = std::numeric_limits<unsigned short>::max();
+        Base::Vector3f exitPoint;
+        float ahead = -std::numeric_limits<float>::max();
+        for (unsigned short i = 0; i < 3; i++) {
+            Base::Vector3f cut;
+            if (i == entry
+                || !cutEdge(rFacet._aulPoints[i], rFacet._aulPoints[(i + 1) % 3], cut)) {
+                continue;
+            }
+            // in the start facet leave towards the end point
+            if (facet == f1 && (cut - p1) * line <= ahead) {
+                continue;
             }
+            ahead = (cut - p1) * line;
+            exit = i;
+            exitPoint = cut;
         }
 
-        MeshCore::MeshProjection meshProjection(_rcMesh);
-        PolyLine polyline;
-        for (auto it : hitPointPairs) {
-            points.clear();
-            if (meshProjection.projectLineOnMesh(cGrid,
-                                                 it.first.first,
-                                                 it.first.second,
-                                                 it.second.first,
-                                                 it.second.second,
-                                                 dir,
-                                                 points)) {
-                polyline.points.insert(polyline.points.end(), points.begin(), points.end());
-            }
+        // the section may leave the start facet only backwards if the point lies on its border
+        if (exit == std::numeric_limits<unsigned short>::max() || (facet == f1 && ahead <= 0.0F)) {
+            return false;
         }
-        rPolyLines.push_back(polyline);
 
-        seq.next();
+        polyline.push_back(exitPoint);
+        MeshCore::FacetIndex next = rFacet._aulNeighbours[exit];
+        if (next == MeshCore::FACET_INDEX_MAX || next == f1) {
+            return false;
+        }
+
+        entry = rFacets[next].Side(facet);
+        if (entry == std::numeric_limits<unsigned short>::max()) {
+            return false;
+        }
+        facet = next;
+        if (facet == f2) {
+            polyline.push_back(p2);
+            return true;
+        }
     }
+
+    return false;
 }
 
 void MeshProjection::projectEdgeToEdge(const TopoDS_Edge& aEdge,
@@ -230,16 +230,22 @@ public:
                        std::vector<Base::Vector3f>& pointsOut) const;
     /**
      * Project all edges of the shape onto the mesh using parallel projection.
+     * The edges are sampled and then projected like polylines.
      */
     void projectParallelToMesh(const TopoDS_Shape& aShape,
                                const Base::Vector3f& dir,
-                               std::vector<PolyLine>& rPolyLines) const;
+                               std::vector<PolyLine>& rPolyLines,
+                               int threads = 0) const;
     /**
      * Project all polylines onto the mesh using parallel projection.
+     * The rays of all points are cast in one batch against a bounding volume hierarchy and the
+     * path between two consecutive hits is walked over the neighbouring facets. Both steps run
+     * with \a threads threads, or the number of hardware threads if \a threads is less than one.
      */
     void projectParallelToMesh(const std::vector<PolyLine>& aEdges,
                                const Base::Vector3f& dir,
-                               std::vector<PolyLine>& rPolyLines) const;
+                               std::vector<PolyLine>& rPolyLines,
+                               int threads = 0) const;
     /**
      * Cuts the mesh at the curve defined by \a aShape. This method call @ref projectToMesh() to get
      * the split the facet at the found points. @see projectToMesh() for more details.
@@ -255,6 +261,17 @@ protected:
                           const Edge&,
                           const Base::Vector3f& dir,
                           Base::Vector3f& res) const;
+    /**
+     * Cuts the mesh with the plane through \a p1 and \a p2 that is parallel to \a dir and
+     * follows the section from facet \a f1 over the facet neighbours until facet \a f2 is
+     * reached. Returns false if the walk hits a border or runs into a loop.
+     */
+    bool walkFacetPath(const Base::Vector3f& p1,
+                       MeshCore::FacetIndex f1,
+                       const Base::Vector3f& p2,
+                       MeshCore::FacetIndex f2,
+                       const Base::Vector3f& dir,
+                       std::vector<Base::Vector3f>& polyline) const;
 
 private:
     const MeshKernel& _rcMesh;
@@ -23,15 +23,25 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <algorithm>
+#include <array>
+#include <numeric>
 
 #include <BRepMesh_IncrementalMesh.hxx>
 #include <BRepTools.hxx>
+#include <BRep_Tool.hxx>
+#include <Poly_PolygonOnTriangulation.hxx>
+#include <Poly_Triangulation.hxx>
 #include <Standard_Version.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
 #include <TopoDS_Shape.hxx>
 #endif
 
 #include <Base/Console.h>
 #include <Base/Tools.h>
+#include <Mod/Mesh/App/Core/Functional.h>
 #include <Mod/Mesh/App/Mesh.h>
 #include <Mod/Part/App/BRepMesh.h>
 #include <Mod/Part/App/TopoShape.h>
@@ -163,15 +173,8 @@ public:
         // mesh segments
         std::vector<std::vector<MeshCore::FacetIndex>> meshSegments;
 
-        std::map<uint32_t, std::vector<std::size_t>> colorMap;
-        for (std::size_t i = 0; i < colors.size(); i++) {
-            colorMap[colors[i]].push_back(i);
-        }
-
-        bool createSegm = (colors.size() == domains.size());
-
         // add a segment for the face
-        if (createSegm || this->segments) {
+        if (needSegments(domains.size())) {
             auto segments = mesh.createSegments();
             meshSegments.reserve(segments.size());
             std::transform(segments.cbegin(),
@@ -184,6 +187,269 @@ public:
                            });
         }
 
+        return createObject(kernel, meshSegments, domains.size());
+    }
+
+    /*!
+     * Assembles the mesh kernel directly from the face triangulations of a shape that has been
+     * meshed with BRepMesh_IncrementalMesh. The nodes on the edges and vertices are numbered
+     * only once because adjacent faces share the edge discretisation, so that the result is
+     * watertight without merging any vertices. The faces are processed in parallel.
+     * Returns null if a face triangulation lacks the polygon of one of its edges.
+     */
+    Mesh::MeshObject* createParallel(const TopoDS_Shape& shape) const
+    {
+        using MeshCore::PointIndex;
+
+        struct FaceData
+        {
+            Handle(Poly_Triangulation) triangulation;
+            gp_Trsf transform;
+            bool reversed {false};
+            // (node, point index) pairs of the nodes on the face boundary
+            std::vector<std::pair<int, PointIndex>> boundary;
+            // point index of each node, 1-based as in Poly_Triangulation
+            std::vector<PointIndex> nodes;
+            std::size_t numPoints {0};
+            std::size_t numFacets {0};
+            std::size_t pointOffset {0};
+            std::size_t facetOffset {0};
+        };
+
+        TopTools_IndexedMapOfShape vertexMap;
+        TopTools_IndexedMapOfShape edgeMap;
+        TopExp::MapShapes(shape, TopAbs_VERTEX, vertexMap);
+        TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
+        std::vector<PointIndex> vertexPoints(vertexMap.Extent(), MeshCore::POINT_INDEX_MAX);
+        std::vector<std::vector<PointIndex>> edgePoints(edgeMap.Extent());
+        std::vector<int> edgeNodes(edgeMap.Extent(), 0);
+
+        // The points on edges and vertices come first. This pass only touches the boundary
+        // nodes and is done sequentially.
+        MeshCore::MeshPointArray verts;
+        std::vector<FaceData> faceData;
+        for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+            const TopoDS_Face& face = TopoDS::Face(xp.Current());
+            FaceData& data = faceData.emplace_back();
+
+            // for a face without triangulation an empty segment is kept like in getDomains()
+            TopLoc_Location loc;
+            data.triangulation = BRep_Tool::Triangulation(face, loc);
+            if (data.triangulation.IsNull()) {
+                continue;
+            }
+            data.transform = loc.Transformation();
+            data.reversed = (face.Orientation() != TopAbs_FORWARD);
+
+            auto addPoint = [&verts, &data](int node) {
+                gp_Pnt p = getNode(data.triangulation, node).Transformed(data.transform);
+                verts.emplace_back(float(p.X()), float(p.Y()), float(p.Z()));
+                return PointIndex(verts.size() - 1);
+            };
+            auto addVertex = [&](const TopoDS_Vertex& vertex, int node) {
+                PointIndex& index = vertexPoints[vertexMap.FindIndex(vertex) - 1];
+                if (index == MeshCore::POINT_INDEX_MAX) {
+                    index = addPoint(node);
+                }
+                return index;
+            };
+
+            for (TopExp_Explorer xe(face, TopAbs_EDGE); xe.More(); xe.Next()) {
+                const TopoDS_Edge& edge = TopoDS::Edge(xe.Current());
+                Handle(Poly_PolygonOnTriangulation) poly =
+                    BRep_Tool::PolygonOnTriangulation(edge, data.triangulation, loc);
+                TopoDS_Vertex first, last;
+                TopExp::Vertices(edge, first, last);
+                if (poly.IsNull() || first.IsNull() || last.IsNull()) {
+                    return nullptr;
+                }
+
+                // The polygon nodes follow the edge parameter regardless of the face, so the
+                // n-th node of an edge gets the same point in all faces
+                const TColStd_Array1OfInteger& indices = poly->Nodes();
+                int count = indices.Length();
+                int lower = indices.Lower();
+                if (BRep_Tool::Degenerated(edge)) {
+                    for (int i = 0; i < count; i++) {
+                        int node = indices(lower + i);
+                        data.boundary.emplace_back(node, addVertex(first, node));
+                    }
+                    continue;
+                }
+
+                int edgeIndex = edgeMap.FindIndex(edge) - 1;
+                std::vector<PointIndex>& points = edgePoints[edgeIndex];
+                if (edgeNodes[edgeIndex] == 0) {
+                    edgeNodes[edgeIndex] = count;
+                    for (int i = 1; i < count - 1; i++) {
+                        points.push_back(addPoint(indices(lower + i)));
+                    }
+                }
+                else if (edgeNodes[edgeIndex] != count) {
+                    return nullptr;
+                }
+
+                data.boundary.emplace_back(indices(lower), addVertex(first, indices(lower)));
+                for (int i = 1; i < count - 1; i++) {
+                    data.boundary.emplace_back(indices(lower + i), points[i - 1]);
+                }
+                int back = indices(lower + count - 1);
+                data.boundary.emplace_back(back, addVertex(last, back));
+            }
+        }
+
+        // count the interior points and the valid triangles of each face
+        MeshCore::parallel_for(
+            faceData.size(),
+            0,
+            [&faceData](std::size_t begin, std::size_t end, std::size_t /*block*/) {
+                for (std::size_t i = begin; i < end; i++) {
+                    FaceData& data = faceData[i];
+                    if (data.triangulation.IsNull()) {
+                        continue;
+                    }
+
+                    int numNodes = data.triangulation->NbNodes();
+                    data.nodes.assign(numNodes + 1, MeshCore::POINT_INDEX_MAX);
+                    for (const auto& [node, index] : data.boundary) {
+                        data.nodes[node] = index;
+                    }
+
+                    std::vector<bool> interior(numNodes + 1, false);
+                    int numTriangles = data.triangulation->NbTriangles();
+                    for (int j = 1; j <= numTriangles; j++) {
+                        std::array<int, 3> tria = getTriangle(data.triangulation, j);
+                        for (int node : tria) {
+                            if (data.nodes[node] == MeshCore::POINT_INDEX_MAX
+                                && !interior[node]) {
+                                interior[node] = true;
+                                data.numPoints++;
+                            }
+                        }
+                        if (isValid(data.nodes, tria)) {
+                            data.numFacets++;
+                        }
+                    }
+                }
+            });
+
+        std::size_t numPoints = verts.size();
+        std::size_t numFacets = 0;
+        for (auto& data : faceData) {
+            data.pointOffset = numPoints;
+            data.facetOffset = numFacets;
+            numPoints += data.numPoints;
+            numFacets += data.numFacets;
+        }
+
+        MeshCore::MeshFacetArray faces;
+        verts.resize(numPoints);
+        faces.resize(numFacets);
+
+        // number the interior points in the order of the triangles and copy the facets
+        MeshCore::parallel_for(
+            faceData.size(),
+            0,
+            [&faceData, &verts, &faces](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t i = begin; i < end; i++) {
+                    FaceData& data = faceData[i];
+                    if (data.triangulation.IsNull()) {
+                        continue;
+                    }
+
+                    std::size_t point = data.pointOffset;
+                    std::size_t facet = data.facetOffset;
+                    int numTriangles = data.triangulation->NbTriangles();
+                    for (int j = 1; j <= numTriangles; j++) {
+                        std::array<int, 3> tria = getTriangle(data.triangulation, j);
+                        if (data.reversed) {
+                            std::swap(tria[0], tria[1]);
+                        }
+                        for (int node : tria) {
+                            if (data.nodes[node] == MeshCore::POINT_INDEX_MAX) {
+                                gp_Pnt p = getNode(data.triangulation, node)
+                                               .Transformed(data.transform);
+                                verts[point].Set(float(p.X()), float(p.Y()), float(p.Z()));
+                                data.nodes[node] = point++;
+                            }
+                        }
+                        if (isValid(data.nodes, tria)) {
+                            faces[facet++] = MeshCore::MeshFacet(data.nodes[tria[0]],
+                                                                 data.nodes[tria[1]],
+                                                                 data.nodes[tria[2]]);
+                        }
+                    }
+
+                    data.nodes.clear();
+                    data.nodes.shrink_to_fit();
+                }
+            });
+
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(verts, faces, true);
+
+        std::vector<std::vector<MeshCore::FacetIndex>> meshSegments;
+        if (needSegments(faceData.size())) {
+            meshSegments.reserve(faceData.size());
+            for (const auto& data : faceData) {
+                auto& segm = meshSegments.emplace_back(data.numFacets);
+                std::iota(segm.begin(), segm.end(), data.facetOffset);
+            }
+        }
+
+        return createObject(kernel, meshSegments, faceData.size());
+    }
+
+private:
+    bool needSegments(std::size_t numDomains) const
+    {
+        return this->segments || colors.size() == numDomains;
+    }
+
+    static gp_Pnt getNode(const Handle(Poly_Triangulation)& triangulation, int index)
+    {
+#if OCC_VERSION_HEX < 0x070600
+        return triangulation->Nodes()(index);
+#else
+        return triangulation->Node(index);
+#endif
+    }
+
+    static std::array<int, 3> getTriangle(const Handle(Poly_Triangulation)& triangulation,
+                                          int index)
+    {
+        std::array<int, 3> tria {};
+#if OCC_VERSION_HEX < 0x070600
+        triangulation->Triangles()(index).Get(tria[0], tria[1], tria[2]);
+#else
+        triangulation->Triangle(index).Get(tria[0], tria[1], tria[2]);
+#endif
+        return tria;
+    }
+
+    // a triangle whose corners fall onto the same point, e.g. at a degenerated edge, is skipped
+    static bool isValid(const std::vector<MeshCore::PointIndex>& nodes,
+                        const std::array<int, 3>& tria)
+    {
+        auto samePoint = [&nodes](int n1, int n2) {
+            return n1 == n2 || (nodes[n1] != MeshCore::POINT_INDEX_MAX && nodes[n1] == nodes[n2]);
+        };
+        return !samePoint(tria[0], tria[1]) && !samePoint(tria[1], tria[2])
+            && !samePoint(tria[2], tria[0]);
+    }
+
+    Mesh::MeshObject*
+    createObject(MeshCore::MeshKernel& kernel,
+                 const std::vector<std::vector<MeshCore::FacetIndex>>& meshSegments,
+                 std::size_t numDomains) const
+    {
+        std::map<uint32_t, std::vector<std::size_t>> colorMap;
+        for (std::size_t i = 0; i < colors.size(); i++) {
+            colorMap[colors[i]].push_back(i);
+        }
+
+        bool createSegm = (colors.size() == numDomains);
+
         Mesh::MeshObject* meshdata = new Mesh::MeshObject();
         meshdata->swap(kernel);
         if (createSegm) {
@@ -225,13 +491,19 @@ Mesh::MeshObject* Mesher::createStandard() const
 {
     if (!shape.IsNull()) {
         BRepTools::Clean(shape);
-        BRepMesh_IncrementalMesh aMesh(shape, deflection, relative, angularDeflection);
+        BRepMesh_IncrementalMesh aMesh(shape, deflection, relative, angularDeflection, parallel);
+    }
+
+    BrepMesh brepmesh(this->segments, this->colors);
+    if (parallel) {
+        if (Mesh::MeshObject* meshdata = brepmesh.createParallel(shape)) {
+            return meshdata;
+        }
     }
 
     std::vector<Part::TopoShape::Domain> domains;
     Part::TopoShape(shape).getDomains(domains);
 
-    BrepMesh brepmesh(this->segments, this->colors);
     return brepmesh.create(domains);
 }
 
@@ -440,15 +712,19 @@ Mesh::MeshObject* Mesher::createFrom(SMESH_Mesh* mesh) const
     verts.reserve(mesh->NbNodes());
     faces.reserve(mesh->NbFaces());
 
+    // node ids are dense after Compute(), so a plain array replaces a search tree
     int index = 0;
-    std::map<const SMDS_MeshNode*, int> mapNodeIndex;
+    std::vector<int> nodeIndex(mesh->GetMeshDS()->MaxNodeID() + 1, -1);
     for (; aNodeIter->more();) {
         const SMDS_MeshNode* aNode = aNodeIter->next();
         MeshCore::MeshPoint p;
         p.Set((float)aNode->X(), (float)aNode->Y(), (float)aNode->Z());
         verts.push_back(p);
-        mapNodeIndex[aNode] = index++;
+        nodeIndex[aNode->GetID()] = index++;
     }
+    auto mapNodeIndex = [&nodeIndex](const SMDS_MeshNode* node) {
+        return nodeIndex[node->GetID()];
+    };
 
     for (; aFaceIter->more();) {
         const SMDS_MeshFace* aFace = aFaceIter->next();
@@ -456,7 +732,7 @@ Mesh::MeshObject* Mesher::createFrom(SMESH_Mesh* mesh) const
             MeshCore::MeshFacet f;
             for (int i = 0; i < 3; i++) {
                 const SMDS_MeshNode* node = aFace->GetNode(i);
-                f._aulPoints[i] = mapNodeIndex[node];
+                f._aulPoints[i] = mapNodeIndex(node);
             }
             faces.push_back(f);
         }
@@ -467,13 +743,13 @@ Mesh::MeshObject* Mesher::createFrom(SMESH_Mesh* mesh) const
             const SMDS_MeshNode* node2 = aFace->GetNode(2);
             const SMDS_MeshNode* node3 = aFace->GetNode(3);
 
-            f1._aulPoints[0] = mapNodeIndex[node0];
-            f1._aulPoints[1] = mapNodeIndex[node1];
-            f1._aulPoints[2] = mapNodeIndex[node2];
+            f1._aulPoints[0] = mapNodeIndex(node0);
+            f1._aulPoints[1] = mapNodeIndex(node1);
+            f1._aulPoints[2] = mapNodeIndex(node2);
 
-            f2._aulPoints[0] = mapNodeIndex[node0];
-            f2._aulPoints[1] = mapNodeIndex[node2];
-            f2._aulPoints[2] = mapNodeIndex[node3];
+            f2._aulPoints[0] = mapNodeIndex(node0);
+            f2._aulPoints[1] = mapNodeIndex(node2);
+            f2._aulPoints[2] = mapNodeIndex(node3);
 
             faces.push_back(f1);
             faces.push_back(f2);
@@ -487,21 +763,21 @@ Mesh::MeshObject* Mesher::createFrom(SMESH_Mesh* mesh) const
             const SMDS_MeshNode* node4 = aFace->GetNode(4);
             const SMDS_MeshNode* node5 = aFace->GetNode(5);
 
-            f1._aulPoints[0] = mapNodeIndex[node0];
-            f1._aulPoints[1] = mapNodeIndex[node3];
-            f1._aulPoints[2] = mapNodeIndex[node5];
+            f1._aulPoints[0] = mapNodeIndex(node0);
+            f1._aulPoints[1] = mapNodeIndex(node3);
+            f1._aulPoints[2] = mapNodeIndex(node5);
 
-            f2._aulPoints[0] = mapNodeIndex[node1];
-            f2._aulPoints[1] = mapNodeIndex[node4];
-            f2._aulPoints[2] = mapNodeIndex[node3];
+            f2._aulPoints[0] = mapNodeIndex(node1);
+            f2._aulPoints[1] = mapNodeIndex(node4);
+            f2._aulPoints[2] = mapNodeIndex(node3);
 
-            f3._aulPoints[0] = mapNodeIndex[node2];
-            f3._aulPoints[1] = mapNodeIndex[node5];
-            f3._aulPoints[2] = mapNodeIndex[node4];
+            f3._aulPoints[0] = mapNodeIndex(node2);
+            f3._aulPoints[1] = mapNodeIndex(node5);
+            f3._aulPoints[2] = mapNodeIndex(node4);
 
-            f4._aulPoints[0] = mapNodeIndex[node3];
-            f4._aulPoints[1] = mapNodeIndex[node4];
-            f4._aulPoints[2] = mapNodeIndex[node5];
+            f4._aulPoints[0] = mapNodeIndex(node3);
+            f4._aulPoints[1] = mapNodeIndex(node4);
+            f4._aulPoints[2] = mapNodeIndex(node5);
 
             faces.push_back(f1);
             faces.push_back(f2);
@@ -519,21 +795,21 @@ Mesh::MeshObject* Mesher::createFrom(SMESH_Mesh* mesh) const
             const SMDS_MeshNode* node6 = aFace->GetNode(6);
             const SMDS_MeshNode* node7 = aFace->GetNode(7);
 
-            f1._aulPoints[0] = mapNodeIndex[node0];
-            f1._aulPoints[1] = mapNodeIndex[node4];
-            f1._aulPoints[2] = mapNodeIndex[node7];
+            f1._aulPoints[0] = mapNodeIndex(node0);
+            f1._aulPoints[1] = mapNodeIndex(node4);
+            f1._aulPoints[2] = mapNodeIndex(node7);
 
-            f2._aulPoints[0] = mapNodeIndex[node1];
-            f2._aulPoints[1] = mapNodeIndex[node5];
-            f2._aulPoints[2] = mapNodeIndex[node4];
+            f2._aulPoints[0] = mapNodeIndex(node1);
+            f2._aulPoints[1] = mapNodeIndex(node5);
+            f2._aulPoints[2] = mapNodeIndex(node4);
 
-            f3._aulPoints[0] = mapNodeIndex[node2];
-            f3._aulPoints[1] = mapNodeIndex[node6];
-            f3._aulPoints[2] = mapNodeIndex[node5];
+            f3._aulPoints[0] = mapNodeIndex(node2);
+            f3._aulPoints[1] = mapNodeIndex(node6);
+            f3._aulPoints[2] = mapNodeIndex(node5);
 
-            f4._aulPoints[0] = mapNodeIndex[node3];
-            f4._aulPoints[1] = mapNodeIndex[node7];
-            f4._aulPoints[2] = mapNodeIndex[node6];
+            f4._aulPoints[0] = mapNodeIndex(node3);
+            f4._aulPoints[1] = mapNodeIndex(node7);
+            f4._aulPoints[2] = mapNodeIndex(node6);
 
             // Two solutions are possible:
             // <4,6,7>, <4,5,6> or <4,5,7>, <5,6,7>
@@ -544,22 +820,22 @@ Mesh::MeshObject* Mesher::createFrom(SMESH_Mesh* mesh) const
             double dist46 = Base::DistanceP2(v4, v6);
             double dist57 = Base::DistanceP2(v5, v7);
             if (dist46 > dist57) {
-                f5._aulPoints[0] = mapNodeIndex[node4];
-                f5._aulPoints[1] = mapNodeIndex[node6];
-                f5._aulPoints[2] = mapNodeIndex[node7];
+                f5._aulPoints[0] = mapNodeIndex(node4);
+                f5._aulPoints[1] = mapNodeIndex(node6);
+                f5._aulPoints[2] = mapNodeIndex(node7);
 
-                f6._aulPoints[0] = mapNodeIndex[node4];
-                f6._aulPoints[1] = mapNodeIndex[node5];
-                f6._aulPoints[2] = mapNodeIndex[node6];
+                f6._aulPoints[0] = mapNodeIndex(node4);
+                f6._aulPoints[1] = mapNodeIndex(node5);
+                f6._aulPoints[2] = mapNodeIndex(node6);
             }
             else {
-                f5._aulPoints[0] = mapNodeIndex[node4];
-                f5._aulPoints[1] = mapNodeIndex[node5];
-                f5._aulPoints[2] = mapNodeIndex[node7];
+                f5._aulPoints[0] = mapNodeIndex(node4);
+                f5._aulPoints[1] = mapNodeIndex(node5);
+                f5._aulPoints[2] = mapNodeIndex(node7);
 
-                f6._aulPoints[0] = mapNodeIndex[node5];
-                f6._aulPoints[1] = mapNodeIndex[node6];
-                f6._aulPoints[2] = mapNodeIndex[node7];
+                f6._aulPoints[0] = mapNodeIndex(node5);
+                f6._aulPoints[1] = mapNodeIndex(node6);
+                f6._aulPoints[2] = mapNodeIndex(node7);
             }
 
             faces.push_back(f1);
@@ -143,6 +143,15 @@ public:
     {
         return segments;
     }
+    /// Triangulate the faces in parallel and assemble the mesh without merging vertices
+    void setParallel(bool s)
+    {
+        parallel = s;
+    }
+    bool isParallel() const
+    {
+        return parallel;
+    }
     void setColors(const std::vector<uint32_t>& c)
     {
         colors = c;
@@ -229,6 +238,7 @@ private:
     bool relative {false};
     bool regular {false};
     bool segments {false};
+    bool parallel {false};
 #if defined(HAVE_NETGEN)
     int fineness {5};
     double growthRate {0};
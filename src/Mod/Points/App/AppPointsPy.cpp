@@ -22,6 +22,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <array>
 #include <memory>
 #endif
 
@@ -30,9 +31,11 @@
 #include <App/DocumentObject.h>
 #include <App/DocumentObjectPy.h>
 #include <App/Property.h>
+#include <Base/BoundBoxPy.h>
 #include <Base/Console.h>
 #include <Base/FileInfo.h>
 #include <Base/Interpreter.h>
+#include <Base/PyWrapParseTupleAndKeywords.h>
 
 #include "Points.h"
 #include "PointsAlgos.h"
@@ -49,8 +52,20 @@ public:
     Module()
         : Py::ExtensionModule<Module>("Points")
     {
-        add_varargs_method("open", &Module::open);
-        add_varargs_method("insert", &Module::importer);
+        add_keyword_method("open",
+                           &Module::open,
+                           "open(string, [pointBudget=0, voxelSize=0, minDistance=0, crop=None])\n"
+                           "Load a point cloud into a new document. The optional keywords filter\n"
+                           "the points while the file is read: crop only keeps the points inside\n"
+                           "the bounding box, minDistance skips points too close to the previous\n"
+                           "one, voxelSize keeps one point per voxel and pointBudget thins out the\n"
+                           "points until at most this number is left.");
+        add_keyword_method("insert",
+                           &Module::importer,
+                           "insert(string, string, [pointBudget=0, voxelSize=0, minDistance=0,\n"
+                           "crop=None])\n"
+                           "Load a point cloud into the given document. See open() for the\n"
+                           "keywords.");
         add_varargs_method("export", &Module::exporter);
         add_varargs_method("show",
                            &Module::show,
@@ -73,10 +88,53 @@ private:
 
         return std::make_tuple(useColor, checkState, minDistance);
     }
-    Py::Object open(const Py::Tuple& args)
+    static void setReadFilter(Reader& reader,
+                              Py_ssize_t pointBudget,
+                              double voxelSize,
+                              double minDistance,
+                              PyObject* crop)
+    {
+        if (pointBudget < 0) {
+            throw Py::ValueError("pointBudget must not be negative");
+        }
+
+        ReadFilter filter = reader.getFilter();
+        filter.pointBudget = static_cast<std::size_t>(pointBudget);
+        filter.voxelSize = voxelSize;
+        // keep the preference of the E57 reader unless overridden
+        if (minDistance > 0.0) {
+            filter.minDistance = minDistance;
+        }
+        if (crop) {
+            filter.cropBox = *static_cast<Base::BoundBoxPy*>(crop)->getBoundBoxPtr();
+        }
+        reader.setFilter(filter);
+    }
+
+    Py::Object open(const Py::Tuple& args, const Py::Dict& keywds)
     {
         char* Name {};
-        if (!PyArg_ParseTuple(args.ptr(), "et", "utf-8", &Name)) {
+        Py_ssize_t pointBudget {0};
+        double voxelSize {0.0};
+        double minDistance {0.0};
+        PyObject* crop {nullptr};
+        static const std::array<const char*, 6> kwList {"filename",
+                                                        "pointBudget",
+                                                        "voxelSize",
+                                                        "minDistance",
+                                                        "crop",
+                                                        nullptr};
+        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(),
+                                                 keywds.ptr(),
+                                                 "et|nddO!",
+                                                 kwList,
+                                                 "utf-8",
+                                                 &Name,
+                                                 &pointBudget,
+                                                 &voxelSize,
+                                                 &minDistance,
+                                                 &Base::BoundBoxPy::Type,
+                                                 &crop)) {
             throw Py::Exception();
         }
         std::string EncodedName = std::string(Name);
@@ -111,6 +169,7 @@ private:
                 throw Py::RuntimeError("Unsupported file extension");
             }
 
+            setReadFilter(*reader, pointBudget, voxelSize, minDistance, crop);
             reader->read(EncodedName);
 
             App::Document* pcDoc = App::GetApplication().newDocument();
@@ -194,11 +253,33 @@ private:
         return Py::None();
     }
 
-    Py::Object importer(const Py::Tuple& args)
+    Py::Object importer(const Py::Tuple& args, const Py::Dict& keywds)
     {
         char* Name {};
         const char* DocName {};
-        if (!PyArg_ParseTuple(args.ptr(), "ets", "utf-8", &Name, &DocName)) {
+        Py_ssize_t pointBudget {0};
+        double voxelSize {0.0};
+        double minDistance {0.0};
+        PyObject* crop {nullptr};
+        static const std::array<const char*, 7> kwList {"filename",
+                                                        "docname",
+                                                        "pointBudget",
+                                                        "voxelSize",
+                                                        "minDistance",
+                                                        "crop",
+                                                        nullptr};
+        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(),
+                                                 keywds.ptr(),
+                                                 "ets|nddO!",
+                                                 kwList,
+                                                 "utf-8",
+                                                 &Name,
+                                                 &DocName,
+                                                 &pointBudget,
+                                                 &voxelSize,
+                                                 &minDistance,
+                                                 &Base::BoundBoxPy::Type,
+                                                 &crop)) {
             throw Py::Exception();
         }
         std::string EncodedName = std::string(Name);
@@ -233,6 +314,7 @@ private:
                 throw Py::RuntimeError("Unsupported file extension");
             }
 
+            setReadFilter(*reader, pointBudget, voxelSize, minDistance, crop);
             reader->read(EncodedName);
 
             App::Document* pcDoc = App::GetApplication().getDocument(DocName);
@@ -0,0 +1,596 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+#endif
+
+#include <Base/Parallel.h>
+
+#include "PointCloud.h"
+
+
+using namespace Points;
+
+PointCloud::PointCloud(int attributes)
+    : attributes(attributes)
+{}
+
+PointCloud::PointCloud(const PointCloud& cloud)
+    : numPoints(cloud.numPoints)
+    , attributes(cloud.attributes)
+{
+    copyBlocks(positions, cloud.positions);
+    copyBlocks(normals, cloud.normals);
+    copyBlocks(intensities, cloud.intensities);
+    copyBlocks(colors, cloud.colors);
+}
+
+PointCloud::PointCloud(PointCloud&& cloud) noexcept
+    : numPoints(cloud.numPoints)
+    , attributes(cloud.attributes)
+    , positions(std::move(cloud.positions))
+    , normals(std::move(cloud.normals))
+    , intensities(std::move(cloud.intensities))
+    , colors(std::move(cloud.colors))
+{
+    cloud.clear();
+}
+
+PointCloud::~PointCloud() = default;
+
+PointCloud& PointCloud::operator=(const PointCloud& cloud)
+{
+    if (this != &cloud) {
+        numPoints = cloud.numPoints;
+        attributes = cloud.attributes;
+        copyBlocks(positions, cloud.positions);
+        copyBlocks(normals, cloud.normals);
+        copyBlocks(intensities, cloud.intensities);
+        copyBlocks(colors, cloud.colors);
+    }
+    return *this;
+}
+
+PointCloud& PointCloud::operator=(PointCloud&& cloud) noexcept
+{
+    if (this != &cloud) {
+        numPoints = cloud.numPoints;
+        attributes = cloud.attributes;
+        positions = std::move(cloud.positions);
+        normals = std::move(cloud.normals);
+        intensities = std::move(cloud.intensities);
+        colors = std::move(cloud.colors);
+        cloud.clear();
+    }
+    return *this;
+}
+
+template<class Block>
+void PointCloud::copyBlocks(std::vector<std::unique_ptr<Block>>& dst,
+                            const std::vector<std::unique_ptr<Block>>& src)
+{
+    dst.clear();
+    dst.reserve(src.size());
+    for (const auto& it : src) {
+        dst.push_back(std::make_unique<Block>(*it));
+    }
+}
+
+void PointCloud::reserve(size_type num)
+{
+    size_type blocks = (num + BlockSize - 1) / BlockSize;
+    positions.reserve(blocks);
+    if (hasAttribute(Normals)) {
+        normals.reserve(blocks);
+    }
+    if (hasAttribute(Intensities)) {
+        intensities.reserve(blocks);
+    }
+    if (hasAttribute(Colors)) {
+        colors.reserve(blocks);
+    }
+}
+
+void PointCloud::addBlock()
+{
+    // make_unique value-initializes the blocks, so unused entries are always zero
+    positions.push_back(std::make_unique<Position>());
+    if (hasAttribute(Normals)) {
+        normals.push_back(std::make_unique<Position>());
+    }
+    if (hasAttribute(Intensities)) {
+        intensities.push_back(std::make_unique<FloatBlock>());
+    }
+    if (hasAttribute(Colors)) {
+        colors.push_back(std::make_unique<ColorBlock>());
+    }
+}
+
+void PointCloud::resize(size_type num)
+{
+    size_type blocks = (num + BlockSize - 1) / BlockSize;
+    if (num < numPoints) {
+        positions.resize(blocks);
+        normals.resize(hasAttribute(Normals) ? blocks : 0);
+        intensities.resize(hasAttribute(Intensities) ? blocks : 0);
+        colors.resize(hasAttribute(Colors) ? blocks : 0);
+
+        // clear the entries behind the new end to keep them zero
+        size_type first = num % BlockSize;
+        if (blocks > 0 && first > 0) {
+            size_type last = std::min(BlockSize, numPoints - (blocks - 1) * BlockSize);
+            size_type count = last - first;
+            Position& pos = *positions.back();
+            std::fill_n(pos.x.data + first, count, 0.0F);
+            std::fill_n(pos.y.data + first, count, 0.0F);
+            std::fill_n(pos.z.data + first, count, 0.0F);
+            if (hasAttribute(Normals)) {
+                Position& nor = *normals.back();
+                std::fill_n(nor.x.data + first, count, 0.0F);
+                std::fill_n(nor.y.data + first, count, 0.0F);
+                std::fill_n(nor.z.data + first, count, 0.0F);
+            }
+            if (hasAttribute(Intensities)) {
+                std::fill_n(intensities.back()->data + first, count, 0.0F);
+            }
+            if (hasAttribute(Colors)) {
+                std::fill_n(colors.back()->data + first, count, uint32_t(0));
+            }
+        }
+    }
+    else {
+        reserve(num);
+        while (positions.size() < blocks) {
+            addBlock();
+        }
+    }
+
+    numPoints = num;
+}
+
+void PointCloud::clear()
+{
+    positions.clear();
+    normals.clear();
+    intensities.clear();
+    colors.clear();
+    numPoints = 0;
+}
+
+void PointCloud::addAttributes(int attr)
+{
+    attr &= ~attributes;
+    size_type blocks = positions.size();
+    if (attr & Normals) {
+        normals.reserve(blocks);
+        for (size_type i = 0; i < blocks; i++) {
+            normals.push_back(std::make_unique<Position>());
+        }
+    }
+    if (attr & Intensities) {
+        intensities.reserve(blocks);
+        for (size_type i = 0; i < blocks; i++) {
+            intensities.push_back(std::make_unique<FloatBlock>());
+        }
+    }
+    if (attr & Colors) {
+        colors.reserve(blocks);
+        for (size_type i = 0; i < blocks; i++) {
+            colors.push_back(std::make_unique<ColorBlock>());
+        }
+    }
+    attributes |= attr;
+}
+
+void PointCloud::removeAttributes(int attr)
+{
+    if (attr & Normals) {
+        normals.clear();
+    }
+    if (attr & Intensities) {
+        intensities.clear();
+    }
+    if (attr & Colors) {
+        colors.clear();
+    }
+    attributes &= ~attr;
+}
+
+void PointCloud::push_back(const Base::Vector3f& pnt)
+{
+    if (numPoints == positions.size() * BlockSize) {
+        addBlock();
+    }
+    setPoint(numPoints++, pnt);
+}
+
+void PointCloud::keep(const std::vector<size_type>& indices)
+{
+    // the indices are ascending, so an entry is never overwritten before it is moved
+    for (size_type i = 0; i < indices.size(); i++) {
+        size_type index = indices[i];
+        setPoint(i, getPoint(index));
+        if (hasAttribute(Normals)) {
+            setNormal(i, getNormal(index));
+        }
+        if (hasAttribute(Intensities)) {
+            setIntensity(i, getIntensity(index));
+        }
+        if (hasAttribute(Colors)) {
+            colors[i / BlockSize]->data[i % BlockSize] =
+                colors[index / BlockSize]->data[index % BlockSize];
+        }
+    }
+    resize(indices.size());
+}
+
+Base::Vector3f PointCloud::getPoint(size_type index) const
+{
+    const Position& pos = *positions[index / BlockSize];
+    size_type i = index % BlockSize;
+    return Base::Vector3f(pos.x.data[i], pos.y.data[i], pos.z.data[i]);
+}
+
+void PointCloud::setPoint(size_type index, const Base::Vector3f& pnt)
+{
+    Position& pos = *positions[index / BlockSize];
+    size_type i = index % BlockSize;
+    pos.x.data[i] = pnt.x;
+    pos.y.data[i] = pnt.y;
+    pos.z.data[i] = pnt.z;
+}
+
+Base::Vector3f PointCloud::getNormal(size_type index) const
+{
+    const Position& nor = *normals[index / BlockSize];
+    size_type i = index % BlockSize;
+    return Base::Vector3f(nor.x.data[i], nor.y.data[i], nor.z.data[i]);
+}
+
+void PointCloud::setNormal(size_type index, const Base::Vector3f& normal)
+{
+    Position& nor = *normals[index / BlockSize];
+    size_type i = index % BlockSize;
+    nor.x.data[i] = normal.x;
+    nor.y.data[i] = normal.y;
+    nor.z.data[i] = normal.z;
+}
+
+float PointCloud::getIntensity(size_type index) const
+{
+    return intensities[index / BlockSize]->data[index % BlockSize];
+}
+
+void PointCloud::setIntensity(size_type index, float value)
+{
+    intensities[index / BlockSize]->data[index % BlockSize] = value;
+}
+
+Base::Color PointCloud::getColor(size_type index) const
+{
+    Base::Color color;
+    color.setPackedValue(colors[index / BlockSize]->data[index % BlockSize]);
+    return color;
+}
+
+void PointCloud::setColor(size_type index, const Base::Color& color)
+{
+    colors[index / BlockSize]->data[index % BlockSize] = color.getPackedValue();
+}
+
+PointCloud::BlockView PointCloud::block(size_type index) const
+{
+    BlockView view;
+    size_type count = std::min(BlockSize, numPoints - index * BlockSize);
+    const Position& pos = *positions[index];
+    view.x = std::span<const float>(pos.x.data, count);
+    view.y = std::span<const float>(pos.y.data, count);
+    view.z = std::span<const float>(pos.z.data, count);
+    if (hasAttribute(Normals)) {
+        const Position& nor = *normals[index];
+        view.nx = std::span<const float>(nor.x.data, count);
+        view.ny = std::span<const float>(nor.y.data, count);
+        view.nz = std::span<const float>(nor.z.data, count);
+    }
+    if (hasAttribute(Intensities)) {
+        view.intensity = std::span<const float>(intensities[index]->data, count);
+    }
+    if (hasAttribute(Colors)) {
+        view.color = std::span<const uint32_t>(colors[index]->data, count);
+    }
+    return view;
+}
+
+void PointCloud::setPoints(const std::vector<Base::Vector3f>& pts, int threads)
+{
+    resize(pts.size());
+    Base::parallel_for(countBlocks(), threads, [&](size_type begin, size_type end, size_type) {
+        for (size_type b = begin; b < end; b++) {
+            Position& pos = *positions[b];
+            size_type offset = b * BlockSize;
+            size_type count = std::min(BlockSize, numPoints - offset);
+            for (size_type i = 0; i < count; i++) {
+                const Base::Vector3f& pnt = pts[offset + i];
+                pos.x.data[i] = pnt.x;
+                pos.y.data[i] = pnt.y;
+                pos.z.data[i] = pnt.z;
+            }
+        }
+    });
+}
+
+std::vector<Base::Vector3f> PointCloud::getPoints(int threads) const
+{
+    std::vector<Base::Vector3f> pts(numPoints);
+    Base::parallel_for(countBlocks(), threads, [&](size_type begin, size_type end, size_type) {
+        for (size_type b = begin; b < end; b++) {
+            const Position& pos = *positions[b];
+            size_type offset = b * BlockSize;
+            size_type count = std::min(BlockSize, numPoints - offset);
+            for (size_type i = 0; i < count; i++) {
+                pts[offset + i].Set(pos.x.data[i], pos.y.data[i], pos.z.data[i]);
+            }
+        }
+    });
+    return pts;
+}
+
+void PointCloud::setNormals(const std::vector<Base::Vector3f>& values)
+{
+    addAttributes(Normals);
+    size_type count = std::min(values.size(), numPoints);
+    for (size_type i = 0; i < count; i++) {
+        setNormal(i, values[i]);
+    }
+}
+
+std::vector<Base::Vector3f> PointCloud::getNormals() const
+{
+    std::vector<Base::Vector3f> values;
+    if (hasAttribute(Normals)) {
+        values.reserve(numPoints);
+        for (size_type i = 0; i < numPoints; i++) {
+            values.push_back(getNormal(i));
+        }
+    }
+    return values;
+}
+
+void PointCloud::setIntensities(const std::vector<float>& values)
+{
+    addAttributes(Intensities);
+    size_type count = std::min(values.size(), numPoints);
+    for (size_type i = 0; i < count; i++) {
+        setIntensity(i, values[i]);
+    }
+}
+
+std::vector<float> PointCloud::getIntensities() const
+{
+    std::vector<float> values;
+    if (hasAttribute(Intensities)) {
+        values.reserve(numPoints);
+        for (size_type i = 0; i < numPoints; i++) {
+            values.push_back(getIntensity(i));
+        }
+    }
+    return values;
+}
+
+void PointCloud::setColors(const std::vector<Base::Color>& values)
+{
+    addAttributes(Colors);
+    size_type count = std::min(values.size(), numPoints);
+    for (size_type i = 0; i < count; i++) {
+        setColor(i, values[i]);
+    }
+}
+
+std::vector<Base::Color> PointCloud::getColors() const
+{
+    std::vector<Base::Color> values;
+    if (hasAttribute(Colors)) {
+        values.reserve(numPoints);
+        for (size_type i = 0; i < numPoints; i++) {
+            values.push_back(getColor(i));
+        }
+    }
+    return values;
+}
+
+void PointCloud::takeData(std::vector<Base::Vector3f>& pts,
+                          std::vector<Base::Vector3f>& nor,
+                          std::vector<float>& intensity,
+                          std::vector<Base::Color>& col)
+{
+    pts.clear();
+    nor.clear();
+    intensity.clear();
+    col.clear();
+
+    // reserving does not touch the memory, it is only used block by block
+    pts.reserve(numPoints);
+    if (hasAttribute(Normals)) {
+        nor.reserve(numPoints);
+    }
+    if (hasAttribute(Intensities)) {
+        intensity.reserve(numPoints);
+    }
+    if (hasAttribute(Colors)) {
+        col.reserve(numPoints);
+    }
+
+    for (size_type b = 0; b < countBlocks(); b++) {
+        size_type count = std::min(BlockSize, numPoints - b * BlockSize);
+        const Position& pos = *positions[b];
+        for (size_type i = 0; i < count; i++) {
+            pts.emplace_back(pos.x.data[i], pos.y.data[i], pos.z.data[i]);
+        }
+        positions[b].reset();
+
+        if (hasAttribute(Normals)) {
+            const Position& dir = *normals[b];
+            for (size_type i = 0; i < count; i++) {
+                nor.emplace_back(dir.x.data[i], dir.y.data[i], dir.z.data[i]);
+            }
+            normals[b].reset();
+        }
+        if (hasAttribute(Intensities)) {
+            intensity.insert(intensity.end(),
+                             intensities[b]->data,
+                             intensities[b]->data + count);
+            intensities[b].reset();
+        }
+        if (hasAttribute(Colors)) {
+            for (size_type i = 0; i < count; i++) {
+                Base::Color color;
+                color.setPackedValue(colors[b]->data[i]);
+                col.push_back(color);
+            }
+            colors[b].reset();
+        }
+    }
+
+    clear();
+}
+
+namespace
+{
+// Computes (x, y, z) = M * (x, y, z) for count points. The loop only accesses the three
+// separate arrays, so it is vectorized by the compiler.
+void transformBlock(float* x, float* y, float* z, std::size_t count, const float (&m)[3][4])
+{
+    for (std::size_t i = 0; i < count; i++) {
+        float px = x[i];
+        float py = y[i];
+        float pz = z[i];
+        x[i] = m[0][0] * px + m[0][1] * py + m[0][2] * pz + m[0][3];
+        y[i] = m[1][0] * px + m[1][1] * py + m[1][2] * pz + m[1][3];
+        z[i] = m[2][0] * px + m[2][1] * py + m[2][2] * pz + m[2][3];
+    }
+}
+
+// Accumulates the range of count values into lanes of independent minima and maxima. A NaN
+// fails both comparisons and is skipped.
+constexpr std::size_t Lanes = 8;
+void rangeOfBlock(const float* v, std::size_t count, float (&lo)[Lanes], float (&hi)[Lanes])
+{
+    std::size_t i = 0;
+    for (; i + Lanes <= count; i += Lanes) {
+        for (std::size_t k = 0; k < Lanes; k++) {
+            float value = v[i + k];
+            lo[k] = value < lo[k] ? value : lo[k];
+            hi[k] = value > hi[k] ? value : hi[k];
+        }
+    }
+    for (std::size_t k = 0; i < count; i++, k++) {
+        float value = v[i];
+        lo[k] = value < lo[k] ? value : lo[k];
+        hi[k] = value > hi[k] ? value : hi[k];
+    }
+}
+}  // namespace
+
+void PointCloud::transformGeometry(const Base::Matrix4D& mat, int threads)
+{
+    float m[3][4];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 4; j++) {
+            m[i][j] = static_cast<float>(mat[i][j]);
+        }
+    }
+
+    // A normal vector is only a direction with unit length, so we only need to rotate it
+    // (no translations or scaling)
+    float r[3][4] {};
+    if (hasAttribute(Normals)) {
+        for (int i = 0; i < 3; i++) {
+            double s = std::sqrt(mat[i][0] * mat[i][0] + mat[i][1] * mat[i][1]
+                                 + mat[i][2] * mat[i][2]);
+            for (int j = 0; j < 3; j++) {
+                r[i][j] = static_cast<float>(mat[i][j] / s);
+            }
+        }
+    }
+
+    Base::parallel_for(countBlocks(), threads, [&](size_type begin, size_type end, size_type) {
+        for (size_type b = begin; b < end; b++) {
+            size_type count = std::min(BlockSize, numPoints - b * BlockSize);
+            Position& pos = *positions[b];
+            transformBlock(pos.x.data, pos.y.data, pos.z.data, count, m);
+            if (hasAttribute(Normals)) {
+                Position& nor = *normals[b];
+                transformBlock(nor.x.data, nor.y.data, nor.z.data, count, r);
+            }
+        }
+    });
+}
+
+Base::BoundBox3f PointCloud::getBoundBox(int threads) const
+{
+    struct Range
+    {
+        float lo[3][Lanes];
+        float hi[3][Lanes];
+    };
+
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    Range init;
+    std::fill_n(&init.lo[0][0], 3 * Lanes, inf);
+    std::fill_n(&init.hi[0][0], 3 * Lanes, -inf);
+
+    if (threads < 1) {
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    std::vector<Range> ranges(threads, init);
+    Base::parallel_for(countBlocks(), threads, [&](size_type begin, size_type end, size_type blk) {
+        Range& range = ranges[blk];
+        for (size_type b = begin; b < end; b++) {
+            size_type count = std::min(BlockSize, numPoints - b * BlockSize);
+            const Position& pos = *positions[b];
+            rangeOfBlock(pos.x.data, count, range.lo[0], range.hi[0]);
+            rangeOfBlock(pos.y.data, count, range.lo[1], range.hi[1]);
+            rangeOfBlock(pos.z.data, count, range.lo[2], range.hi[2]);
+        }
+    });
+
+    float lo[3] = {inf, inf, inf};
+    float hi[3] = {-inf, -inf, -inf};
+    for (const auto& range : ranges) {
+        for (int c = 0; c < 3; c++) {
+            lo[c] = std::min(lo[c], *std::min_element(range.lo[c], range.lo[c] + Lanes));
+            hi[c] = std::max(hi[c], *std::max_element(range.hi[c], range.hi[c] + Lanes));
+        }
+    }
+
+    Base::BoundBox3f box;
+    if (lo[0] <= hi[0] && lo[1] <= hi[1] && lo[2] <= hi[2]) {
+        box = Base::BoundBox3f(lo[0], lo[1], lo[2], hi[0], hi[1], hi[2]);
+    }
+    return box;
+}
@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef POINTS_POINTCLOUD_H
+#define POINTS_POINTCLOUD_H
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/Color.h>
+#include <Base/Matrix.h>
+#include <Base/Vector3D.h>
+
+#include <Mod/Points/PointsGlobal.h>
+
+
+namespace Points
+{
+
+/**
+ * Point cloud with optional per-point normals, intensities and colors, stored as a structure of
+ * arrays in blocks of BlockSize points.
+ *
+ * Every coordinate and attribute of a block lives in its own aligned array, so the transform and
+ * bounding box kernels run over contiguous floats that the compiler can vectorize, and blocks are
+ * processed in parallel. Blocks never move once they are allocated: the views returned by block()
+ * stay valid while points are appended and can be handed to consumers without copying.
+ */
+class PointsExport PointCloud
+{
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type BlockSize = 4096;
+    static constexpr size_type Alignment = 64;
+
+    enum Attribute : int
+    {
+        None = 0,
+        Normals = 1,
+        Intensities = 2,
+        Colors = 4
+    };
+
+    /// Read-only view of the data of a block.
+    struct BlockView
+    {
+        std::span<const float> x, y, z;
+        /// empty if the cloud has no normals
+        std::span<const float> nx, ny, nz;
+        /// empty if the cloud has no intensities
+        std::span<const float> intensity;
+        /// packed RGBA values, empty if the cloud has no colors
+        std::span<const uint32_t> color;
+    };
+
+    explicit PointCloud(int attributes = None);
+    PointCloud(const PointCloud&);
+    PointCloud(PointCloud&&) noexcept;
+    ~PointCloud();
+
+    PointCloud& operator=(const PointCloud&);
+    PointCloud& operator=(PointCloud&&) noexcept;
+
+    /** @name Size */
+    //@{
+    size_type size() const
+    {
+        return numPoints;
+    }
+    bool empty() const
+    {
+        return numPoints == 0;
+    }
+    size_type countBlocks() const
+    {
+        return positions.size();
+    }
+    void reserve(size_type num);
+    /// New points and their attributes are zero-initialized.
+    void resize(size_type num);
+    void clear();
+    //@}
+
+    /** @name Attributes */
+    //@{
+    int getAttributes() const
+    {
+        return attributes;
+    }
+    bool hasAttribute(Attribute attr) const
+    {
+        return (attributes & attr) != 0;
+    }
+    /// Adds the storage for \a attr, the values of existing points are zero.
+    void addAttributes(int attr);
+    void removeAttributes(int attr);
+    //@}
+
+    /** @name Element access */
+    //@{
+    /// Appends a point, its attributes are zero.
+    void push_back(const Base::Vector3f& pnt);
+    /// Keeps only the points at the ascending \a indices together with their attributes.
+    void keep(const std::vector<size_type>& indices);
+    Base::Vector3f getPoint(size_type index) const;
+    void setPoint(size_type index, const Base::Vector3f& pnt);
+    Base::Vector3f getNormal(size_type index) const;
+    void setNormal(size_type index, const Base::Vector3f& normal);
+    float getIntensity(size_type index) const;
+    void setIntensity(size_type index, float value);
+    Base::Color getColor(size_type index) const;
+    void setColor(size_type index, const Base::Color& color);
+
+    /// Returns a view of the points [i * BlockSize, min(size(), (i + 1) * BlockSize)).
+    BlockView block(size_type index) const;
+    //@}
+
+    /** @name Conversion from and to the array based storage */
+    //@{
+    void setPoints(const std::vector<Base::Vector3f>& pts, int threads = 0);
+    std::vector<Base::Vector3f> getPoints(int threads = 0) const;
+    void setNormals(const std::vector<Base::Vector3f>& normals);
+    std::vector<Base::Vector3f> getNormals() const;
+    void setIntensities(const std::vector<float>& values);
+    std::vector<float> getIntensities() const;
+    void setColors(const std::vector<Base::Color>& colors);
+    std::vector<Base::Color> getColors() const;
+    /**
+     * Moves the points and the attributes the cloud has into the arrays and leaves the cloud
+     * empty. Each block is freed as soon as it is copied, so the data is never held twice.
+     */
+    void takeData(std::vector<Base::Vector3f>& pts,
+                  std::vector<Base::Vector3f>& nor,
+                  std::vector<float>& intensity,
+                  std::vector<Base::Color>& col);
+    //@}
+
+    /** @name Kernels */
+    //@{
+    /**
+     * Transforms the points with \a mat. Normals are only rotated, like the normal property
+     * of a points feature does it.
+     */
+    void transformGeometry(const Base::Matrix4D& mat, int threads = 0);
+    /// Bounding box of the points, invalid points with NaN coordinates are ignored.
+    Base::BoundBox3f getBoundBox(int threads = 0) const;
+    //@}
+
+private:
+    struct alignas(Alignment) FloatBlock
+    {
+        float data[BlockSize];
+    };
+    struct alignas(Alignment) ColorBlock
+    {
+        uint32_t data[BlockSize];
+    };
+    struct Position
+    {
+        FloatBlock x, y, z;
+    };
+
+    void addBlock();
+    template<class Block>
+    static void copyBlocks(std::vector<std::unique_ptr<Block>>& dst,
+                           const std::vector<std::unique_ptr<Block>>& src);
+
+    size_type numPoints {0};
+    int attributes {None};
+    std::vector<std::unique_ptr<Position>> positions;
+    std::vector<std::unique_ptr<Position>> normals;
+    std::vector<std::unique_ptr<FloatBlock>> intensities;
+    std::vector<std::unique_ptr<ColorBlock>> colors;
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_POINTCLOUD_H
@@ -0,0 +1,251 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <queue>
+#include <unordered_set>
+#endif
+
+#include <Base/Parallel.h>
+
+#include "PointOctree.h"
+
+
+using namespace Points;
+
+namespace
+{
+// limits the depth for clouds with many coincident points
+constexpr int MaxLevel = 20;
+
+struct BuildNode
+{
+    Base::BoundBox3f box;
+    float spacing {0.0F};
+    int level {0};
+    std::vector<uint32_t> points;
+    std::array<std::unique_ptr<BuildNode>, 8> children;
+};
+
+int octant(const Base::Vector3f& pnt, const Base::Vector3f& center)
+{
+    return (pnt.x >= center.x ? 1 : 0) | (pnt.y >= center.y ? 2 : 0) | (pnt.z >= center.z ? 4 : 0);
+}
+
+Base::BoundBox3f octantBox(const Base::BoundBox3f& box, int index)
+{
+    Base::Vector3f center = box.GetCenter();
+    Base::BoundBox3f child = box;
+    ((index & 1) ? child.MinX : child.MaxX) = center.x;
+    ((index & 2) ? child.MinY : child.MaxY) = center.y;
+    ((index & 4) ? child.MinZ : child.MaxZ) = center.z;
+    return child;
+}
+
+void subdivide(BuildNode& node,
+               const std::vector<Base::Vector3f>& points,
+               std::vector<uint32_t>& indices)
+{
+    constexpr int res = PointOctree::Resolution;
+    float length = node.box.LengthX();
+    node.spacing = length / float(res);
+    if (indices.size() <= PointOctree::MaxLeafPoints || node.level >= MaxLevel) {
+        node.points = std::move(indices);
+        return;
+    }
+
+    // keep the first point of each cell of the grid and pass the others to the children
+    std::unordered_set<uint32_t> cells;
+    cells.reserve(std::min<std::size_t>(indices.size(), std::size_t(res) * res * res));
+    std::array<std::vector<uint32_t>, 8> octants;
+    Base::Vector3f center = node.box.GetCenter();
+    float scale = float(res) / length;
+    auto toCell = [scale](float value, float min) {
+        return static_cast<uint32_t>(std::clamp(int((value - min) * scale), 0, res - 1));
+    };
+
+    for (uint32_t index : indices) {
+        const Base::Vector3f& pnt = points[index];
+        uint32_t cell = (toCell(pnt.x, node.box.MinX) * res + toCell(pnt.y, node.box.MinY)) * res
+            + toCell(pnt.z, node.box.MinZ);
+        if (cells.insert(cell).second) {
+            node.points.push_back(index);
+        }
+        else {
+            octants[octant(pnt, center)].push_back(index);
+        }
+    }
+
+    indices.clear();
+    indices.shrink_to_fit();
+
+    for (int i = 0; i < 8; i++) {
+        if (!octants[i].empty()) {
+            node.children[i] = std::make_unique<BuildNode>();
+            node.children[i]->box = octantBox(node.box, i);
+            node.children[i]->level = node.level + 1;
+        }
+    }
+
+    // the octants of the root are independent of each other
+    int threads = node.level == 0 ? 0 : 1;
+    Base::parallel_for(8, threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; i++) {
+            if (node.children[i]) {
+                subdivide(*node.children[i], points, octants[i]);
+            }
+        }
+    });
+}
+}  // namespace
+
+void PointOctree::build(const std::vector<Base::Vector3f>& points)
+{
+    clear();
+
+    std::vector<uint32_t> indices;
+    indices.reserve(points.size());
+    Base::BoundBox3f box;
+    for (std::size_t i = 0; i < points.size(); i++) {
+        const Base::Vector3f& pnt = points[i];
+        if (!std::isnan(pnt.x) && !std::isnan(pnt.y) && !std::isnan(pnt.z)) {
+            indices.push_back(static_cast<uint32_t>(i));
+            box.Add(pnt);
+        }
+    }
+
+    if (indices.empty()) {
+        return;
+    }
+
+    // make the root a cube that is slightly larger than the points
+    float length = std::max({box.LengthX(), box.LengthY(), box.LengthZ()});
+    float half = length > 0.0F ? 0.5F * length * 1.001F : 1.0F;
+    Base::Vector3f center = box.GetCenter();
+
+    BuildNode root;
+    root.box = Base::BoundBox3f(center.x - half,
+                                center.y - half,
+                                center.z - half,
+                                center.x + half,
+                                center.y + half,
+                                center.z + half);
+    subdivide(root, points, indices);
+
+    // flatten the tree breadth-first
+    order.reserve(points.size());
+    std::vector<const BuildNode*> queue {&root};
+    nodes.emplace_back();
+    for (std::size_t i = 0; i < queue.size(); i++) {
+        const BuildNode* build = queue[i];
+        Node& node = nodes[i];
+        node.box = build->box;
+        node.spacing = build->spacing;
+        node.level = build->level;
+        node.begin = static_cast<uint32_t>(order.size());
+        node.count = static_cast<uint32_t>(build->points.size());
+        node.firstChild = static_cast<uint32_t>(nodes.size());
+        order.insert(order.end(), build->points.begin(), build->points.end());
+
+        uint32_t numChildren = 0;
+        for (const auto& child : build->children) {
+            if (child) {
+                queue.push_back(child.get());
+                numChildren++;
+            }
+        }
+
+        // may reallocate, so don't use 'node' afterwards
+        nodes[i].numChildren = numChildren;
+        nodes.resize(nodes.size() + numChildren);
+    }
+}
+
+void PointOctree::clear()
+{
+    nodes.clear();
+    order.clear();
+}
+
+bool PointOctree::empty() const
+{
+    return nodes.empty();
+}
+
+const std::vector<PointOctree::Node>& PointOctree::getNodes() const
+{
+    return nodes;
+}
+
+const std::vector<uint32_t>& PointOctree::getOrder() const
+{
+    return order;
+}
+
+std::vector<uint32_t>
+PointOctree::selectNodes(const std::function<float(const Node&)>& pixelSpacing,
+                         std::size_t pointBudget,
+                         float minPixels) const
+{
+    std::vector<uint32_t> selection;
+    if (nodes.empty()) {
+        return selection;
+    }
+
+    // the nodes with the coarsest points on the screen are refined first
+    using Entry = std::pair<float, uint32_t>;
+    std::priority_queue<Entry> queue;
+    auto visit = [&](uint32_t index) {
+        float size = pixelSpacing(nodes[index]);
+        if (size >= 0.0F) {
+            queue.emplace(size, index);
+        }
+    };
+
+    visit(0);
+    std::size_t numPoints = 0;
+    while (!queue.empty()) {
+        auto [size, index] = queue.top();
+        queue.pop();
+
+        const Node& node = nodes[index];
+        if (!selection.empty() && numPoints + node.count > pointBudget) {
+            break;
+        }
+
+        selection.push_back(index);
+        numPoints += node.count;
+        if (size > minPixels) {
+            for (uint32_t i = 0; i < node.numChildren; i++) {
+                visit(node.firstChild + i);
+            }
+        }
+    }
+
+    return selection;
+}
@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef POINTS_POINTOCTREE_H
+#define POINTS_POINTOCTREE_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/Vector3D.h>
+
+#include <Mod/Points/PointsGlobal.h>
+
+
+namespace Points
+{
+
+/**
+ * Level of detail hierarchy of a point cloud.
+ *
+ * Every node of the octree keeps a subsample of the points that fall into its cube: at most one
+ * point per cell of a grid with Resolution cells along each axis. The points that were not
+ * taken are passed on to the children, so a node together with all its ancestors is a
+ * progressively refined sample of the cloud. The tree does not copy any point, it only stores a
+ * permutation of the point indices in which the points of each node are contiguous.
+ *
+ * The nodes are stored breadth-first, so coarse levels come first and the children of a node
+ * are adjacent.
+ */
+class PointsExport PointOctree
+{
+public:
+    /// Number of grid cells along an axis of a node.
+    static constexpr int Resolution = 128;
+    /// Nodes with at most this number of points are not split any further.
+    static constexpr std::size_t MaxLeafPoints = 16384;
+
+    struct Node
+    {
+        /// the cube of the node
+        Base::BoundBox3f box;
+        /// minimum distance of the points of the node
+        float spacing {0.0F};
+        int level {0};
+        /// range of the node in the permutation
+        uint32_t begin {0};
+        uint32_t count {0};
+        /// range of the children in the node list
+        uint32_t firstChild {0};
+        uint32_t numChildren {0};
+    };
+
+    /// Builds the hierarchy of \a points. Points with NaN coordinates are left out.
+    void build(const std::vector<Base::Vector3f>& points);
+    void clear();
+    bool empty() const;
+
+    const std::vector<Node>& getNodes() const;
+    /// Point indices ordered by nodes.
+    const std::vector<uint32_t>& getOrder() const;
+
+    /**
+     * Selects the nodes to render.
+     *
+     * \a pixelSpacing returns the spacing of a node as seen on the screen in pixels, or a
+     * negative value if the node is not visible. Nodes are refined in the order of decreasing
+     * pixel spacing until their points are denser than \a minPixels or the number of selected
+     * points would exceed \a pointBudget.
+     */
+    std::vector<uint32_t> selectNodes(const std::function<float(const Node&)>& pixelSpacing,
+                                      std::size_t pointBudget,
+                                      float minPixels = 1.0F) const;
+
+private:
+    std::vector<Node> nodes;
+    std::vector<uint32_t> order;
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_POINTOCTREE_H
@@ -22,13 +22,13 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
-#include <QtConcurrentMap>
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <cmath>
 #include <iostream>
 #endif
 
 #include <Base/Matrix.h>
+#include <Base/Parallel.h>
 #include <Base/Stream.h>
 #include <Base/Writer.h>
 
@@ -36,10 +36,6 @@
 #include "PointsAlgos.h"
 
 
-#ifdef _MSC_VER
-#include <ppl.h>
-#endif
-
 using namespace Points;
 using namespace std;
 
@@ -81,48 +77,51 @@ Data::Segment* PointKernel::getSubElement(const char* /*Type*/, unsigned long /*
     return nullptr;
 }
 
+namespace
+{
+// Transforming a point takes a few nanoseconds while starting a thread takes some ten
+// microseconds, so below this number of points a single thread is faster
+constexpr std::size_t MinPointsForThreads = 8192;
+
+int countThreads(std::size_t numPoints)
+{
+    return numPoints < MinPointsForThreads ? 1 : 0;
+}
+}  // namespace
+
 void PointKernel::transformGeometry(const Base::Matrix4D& rclMat)
 {
+    // Each thread transforms a contiguous range of points
     std::vector<value_type>& kernel = getBasicPoints();
-#ifdef _MSC_VER
-    // Win32-only at the moment since ppl.h is a Microsoft library. Points is not using Qt so we
-    // cannot use QtConcurrent We could also rewrite Points to leverage SIMD instructions Other
-    // option: openMP. But with VC2013 results in high CPU usage even after computation (busy-waits
-    // for >100ms)
-    Concurrency::parallel_for_each(kernel.begin(), kernel.end(), [rclMat](value_type& value) {
-        value = rclMat * value;
-    });
-#else
-    QtConcurrent::blockingMap(kernel, [rclMat](value_type& value) {
-        rclMat.multVec(value, value);
-    });
-#endif
+    Base::parallel_for(kernel.size(),
+                       countThreads(kernel.size()),
+                       [&kernel, &rclMat](std::size_t begin, std::size_t end, std::size_t) {
+                           for (std::size_t i = begin; i < end; i++) {
+                               rclMat.multVec(kernel[i], kernel[i]);
+                           }
+                       });
 }
 
 Base::BoundBox3d PointKernel::getBoundBox() const
 {
-    Base::BoundBox3d bnd;
+    // Thread-local bounding boxes of contiguous ranges
+    std::vector<Base::BoundBox3d> boxes(std::max(1U, std::thread::hardware_concurrency()));
+    Base::parallel_for(_Points.size(),
+                       countThreads(_Points.size()),
+                       [this, &boxes](std::size_t begin, std::size_t end, std::size_t block) {
+                           Base::BoundBox3d& bnd = boxes[block];
+                           for (std::size_t i = begin; i < end; i++) {
+                               const value_type& value = _Points[i];
+                               Base::Vector3d vertd(value.x, value.y, value.z);
+                               bnd.Add(_Mtrx * vertd);
+                           }
+                       });
 
-#ifdef _MSC_VER
-    // Thread-local bounding boxes
-    Concurrency::combinable<Base::BoundBox3d> bbs;
-    // Cannot use a const_point_iterator here as it is *not* a proper iterator (fails the for_each
-    // template)
-    Concurrency::parallel_for_each(_Points.begin(),
-                                   _Points.end(),
-                                   [this, &bbs](const value_type& value) {
-                                       Base::Vector3d vertd(value.x, value.y, value.z);
-                                       bbs.local().Add(this->_Mtrx * vertd);
-                                   });
     // Combine each thread-local bounding box in the final bounding box
-    bbs.combine_each([&bnd](const Base::BoundBox3d& lbb) {
-        bnd.Add(lbb);
-    });
-#else
-    for (const auto& it : *this) {
+    Base::BoundBox3d bnd;
+    for (const auto& it : boxes) {
         bnd.Add(it);
     }
-#endif
     return bnd;
 }
 
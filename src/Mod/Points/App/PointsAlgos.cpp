@@ -25,6 +25,11 @@
 #ifdef FC_OS_LINUX
 #include <unistd.h>
 #endif
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <sstream>
 
@@ -38,6 +43,7 @@
 #include <Base/Converter.h>
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
+#include <Base/Parallel.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
 
@@ -47,6 +53,20 @@
 
 using namespace Points;
 
+namespace
+{
+// number of rows that are decoded and filtered at once
+constexpr std::size_t ChunkSize = 65536;
+// A row is parsed in well below a microsecond, so fewer rows than this are parsed faster
+// by a single thread than by starting the others
+constexpr std::size_t MinRowsForThreads = 1024;
+
+int countThreads(std::size_t rows)
+{
+    return rows < MinRowsForThreads ? 1 : 0;
+}
+}  // namespace
+
 void PointsAlgos::Load(PointKernel& points, const char* FileName)
 {
     Base::FileInfo File(FileName);
@@ -124,6 +144,119 @@ void PointsAlgos::LoadAscii(PointKernel& points, const char* FileName)
 
 // ----------------------------------------------------------------------------
 
+namespace Points
+{
+/** Set of the voxels of a regular grid that contain a point, stored as open addressing hash
+ * table of the voxel coordinates.
+ */
+class VoxelGrid
+{
+public:
+    explicit VoxelGrid(double size)
+        : size(size)
+    {
+        keys.resize(1024, emptyKey());
+    }
+
+    double getSize() const
+    {
+        return size;
+    }
+
+    /// Adds the voxel of \a pnt and returns true if it was empty.
+    bool insert(const Base::Vector3d& pnt)
+    {
+        if (2 * (count + 1) > keys.size()) {
+            rehash(2 * keys.size());
+        }
+        return insertKey(makeKey(pnt));
+    }
+
+private:
+    struct Key
+    {
+        int32_t x, y, z;
+        bool operator==(const Key&) const = default;
+    };
+
+    static Key emptyKey()
+    {
+        constexpr int32_t none = std::numeric_limits<int32_t>::min();
+        return {none, none, none};
+    }
+
+    int32_t toCoord(double value) const
+    {
+        // the minimum is reserved for empty slots
+        const double lower = std::numeric_limits<int32_t>::min() + 1.0;
+        const double upper = std::numeric_limits<int32_t>::max();
+        return static_cast<int32_t>(std::clamp(std::floor(value / size), lower, upper));
+    }
+
+    Key makeKey(const Base::Vector3d& pnt) const
+    {
+        return {toCoord(pnt.x), toCoord(pnt.y), toCoord(pnt.z)};
+    }
+
+    static std::size_t hash(const Key& key)
+    {
+        uint64_t hash = static_cast<uint32_t>(key.x) * 0x9E3779B97F4A7C15ULL;
+        hash ^= static_cast<uint32_t>(key.y) * 0xC2B2AE3D27D4EB4FULL;
+        hash ^= static_cast<uint32_t>(key.z) * 0x165667B19E3779F9ULL;
+        hash ^= hash >> 32;
+        return static_cast<std::size_t>(hash);
+    }
+
+    bool insertKey(const Key& key)
+    {
+        std::size_t mask = keys.size() - 1;
+        for (std::size_t i = hash(key) & mask;; i = (i + 1) & mask) {
+            if (keys[i] == key) {
+                return false;
+            }
+            if (keys[i] == emptyKey()) {
+                keys[i] = key;
+                count++;
+                return true;
+            }
+        }
+    }
+
+    void rehash(std::size_t num)
+    {
+        std::vector<Key> old(num, emptyKey());
+        old.swap(keys);
+        count = 0;
+        for (const auto& key : old) {
+            if (!(key == emptyKey())) {
+                insertKey(key);
+            }
+        }
+    }
+
+    double size;
+    std::size_t count {0};
+    std::vector<Key> keys;
+};
+}  // namespace Points
+
+// ----------------------------------------------------------------------------
+
+bool ReadFilter::isActive() const
+{
+    return cropBox.IsValid() || minDistance > 0.0 || voxelSize > 0.0 || pointBudget > 0;
+}
+
+// ----------------------------------------------------------------------------
+
+void Reader::Chunk::clear()
+{
+    points.clear();
+    normals.clear();
+    intensity.clear();
+    colors.clear();
+}
+
 Reader::Reader() = default;
 
 Reader::~Reader() = default;
@@ -190,15 +323,161 @@ int Reader::getHeight() const
     return height;
 }
 
+void Reader::setFilter(const ReadFilter& flt)
+{
+    filter = flt;
+}
+
+const ReadFilter& Reader::getFilter() const
+{
+    return filter;
+}
+
+void Reader::beginRead(std::size_t numPoints)
+{
+    points.clear();
+    clear();
+    cloud.clear();
+    cloud.removeAttributes(PointCloud::Normals | PointCloud::Intensities | PointCloud::Colors);
+    hasLastPoint = false;
+
+    grid.reset();
+    if (filter.voxelSize > 0.0) {
+        grid = std::make_unique<VoxelGrid>(filter.voxelSize);
+    }
+
+    if (filter.pointBudget > 0) {
+        numPoints = std::min(numPoints, filter.pointBudget + 1);
+    }
+    if (!filter.isActive() || filter.pointBudget > 0) {
+        cloud.reserve(numPoints);
+    }
+}
+
+void Reader::addChunk(const Chunk& chunk)
+{
+    std::size_t numPoints = chunk.points.size();
+    if (numPoints == 0) {
+        return;
+    }
+
+    bool hasNormal = chunk.normals.size() == numPoints;
+    bool hasIntensity = chunk.intensity.size() == numPoints;
+    bool hasColor = chunk.colors.size() == numPoints;
+    cloud.addAttributes((hasNormal ? PointCloud::Normals : PointCloud::None)
+                        | (hasIntensity ? PointCloud::Intensities : PointCloud::None)
+                        | (hasColor ? PointCloud::Colors : PointCloud::None));
+
+    bool useCrop = filter.cropBox.IsValid();
+    bool useDistance = filter.minDistance > 0.0;
+
+    for (std::size_t i = 0; i < numPoints; i++) {
+        const Base::Vector3d& pnt = chunk.points[i];
+        if (useCrop && !filter.cropBox.IsInBox(pnt)) {
+            continue;
+        }
+        if (useDistance && hasLastPoint && Base::Distance(lastPoint, pnt) < filter.minDistance) {
+            continue;
+        }
+        if (grid && !grid->insert(pnt)) {
+            continue;
+        }
+
+        std::size_t index = cloud.size();
+        cloud.push_back(Base::convertTo<Base::Vector3f>(pnt));
+        lastPoint = pnt;
+        hasLastPoint = true;
+        if (hasNormal) {
+            cloud.setNormal(index, chunk.normals[i]);
+        }
+        if (hasIntensity) {
+            cloud.setIntensity(index, chunk.intensity[i]);
+        }
+        if (hasColor) {
+            cloud.setColor(index, chunk.colors[i]);
+        }
+
+        if (filter.pointBudget > 0 && cloud.size() > filter.pointBudget) {
+            reduce();
+        }
+    }
+}
+
+void Reader::endRead()
+{
+    grid.reset();
+
+    std::vector<PointKernel::value_type> pts;
+    cloud.takeData(pts, normals, intensity, colors);
+    points.swap(pts);
+
+    if (filter.isActive()) {
+        // a filtered cloud has lost its structure
+        width = static_cast<int>(points.size());
+        height = 1;
+    }
+}
+
+void Reader::reduce()
+{
+    // Thin out the points with a growing voxel size. Aim a quarter below the budget so that the
+    // next few points don't trigger another reduction at once.
+    std::size_t target = filter.pointBudget - filter.pointBudget / 4;
+
+    double size = 0.0;
+    if (grid) {
+        size = grid->getSize();
+    }
+    else {
+        // start with a voxel size that gives about the budget for a surface
+        Base::BoundBox3f box = cloud.getBoundBox();
+        double length = std::max({box.LengthX(), box.LengthY(), box.LengthZ()});
+        size = length > 0.0 ? length / std::sqrt(static_cast<double>(filter.pointBudget)) : 1.0;
+    }
+
+    std::vector<std::size_t> indices;
+    do {
+        size *= 1.25;
+        grid = std::make_unique<VoxelGrid>(size);
+        indices.clear();
+        for (std::size_t i = 0; i < cloud.size(); i++) {
+            if (grid->insert(Base::convertTo<Base::Vector3d>(cloud.getPoint(i)))) {
+                indices.push_back(i);
+            }
+        }
+    } while (indices.size() > target);
+
+    cloud.keep(indices);
+}
+
 // ----------------------------------------------------------------------------
 
 AscReader::AscReader() = default;
 
 void AscReader::read(const std::string& filename)
 {
-    points.load(filename.c_str());
-    this->height = 1;
-    this->width = points.size();
+    if (!getFilter().isActive()) {
+        points.load(filename.c_str());
+        this->height = 1;
+        this->width = points.size();
+        return;
+    }
+
+    PointKernel kernel;
+    kernel.load(filename.c_str());
+    beginRead(kernel.size());
+
+    Chunk chunk;
+    for (std::size_t i = 0; i < kernel.size(); i += ChunkSize) {
+        chunk.clear();
+        std::size_t end = std::min(kernel.size(), i + ChunkSize);
+        for (std::size_t j = i; j < end; j++) {
+            chunk.points.push_back(kernel.getPoint(int(j)));
+        }
+        addChunk(chunk);
+    }
+
+    endRead();
 }
 
 // ----------------------------------------------------------------------------
@@ -212,6 +491,7 @@ public:
     virtual ~Converter() = default;
     virtual std::string toString(double) const = 0;
     virtual double toDouble(Base::InputStream&) const = 0;
+    virtual double fromBytes(const char*, bool swapByteOrder) const = 0;
     virtual int getSizeOf() const = 0;
 
     Converter(const Converter&) = delete;
@@ -238,6 +518,17 @@ public:
         str >> c;
         return static_cast<double>(c);
     }
+    double fromBytes(const char* data, bool swapByteOrder) const override
+    {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, data, sizeof(T));
+        if (swapByteOrder) {
+            std::reverse(bytes, bytes + sizeof(T));
+        }
+        T c;
+        std::memcpy(&c, bytes, sizeof(T));
+        return static_cast<double>(c);
+    }
     int getSizeOf() const override
     {
         return sizeof(T);
@@ -543,12 +834,123 @@ lzfDecompress(const void* const in_data, unsigned int in_len, void* out_data, un
 }  // namespace Points
 // NOLINTEND
 
+namespace
+{
+bool isBigEndianHost()
+{
+    return std::endian::native == std::endian::big;
+}
+
+/// Parses the whitespace separated values of \a lines into the rows of \a data.
+void parseLines(const std::vector<std::string>& lines, Eigen::MatrixXd& data)
+{
+    data.setZero(Eigen::Index(lines.size()), data.cols());
+    Eigen::Index numFields = data.cols();
+    auto parse = [&lines, &data, numFields](std::size_t begin, std::size_t end, std::size_t) {
+        std::vector<std::string> list;
+        for (std::size_t row = begin; row < end; row++) {
+            // since the file is loaded in binary mode we may get the CR at the end
+            std::string line = boost::trim_copy(lines[row]);
+            boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
+
+            Eigen::Index size = Eigen::Index(list.size());
+            for (Eigen::Index col = 0; col < size && col < numFields; col++) {
+                data(Eigen::Index(row), col) = boost::lexical_cast<double>(list[col]);
+            }
+        }
+    };
+
+    Base::parallel_for(lines.size(), countThreads(lines.size()), parse);
+}
+
+/// Decodes the binary rows of \a buffer, each of \a rowSize bytes, into the rows of \a data.
+void decodeRows(const std::vector<char>& buffer,
+                std::size_t rowSize,
+                const std::vector<ConverterPtr>& converters,
+                bool swapByteOrder,
+                Eigen::MatrixXd& data)
+{
+    std::size_t numRows = buffer.size() / rowSize;
+    data.resize(Eigen::Index(numRows), Eigen::Index(converters.size()));
+    auto decode = [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t row = begin; row < end; row++) {
+            const char* ptr = buffer.data() + row * rowSize;
+            for (std::size_t col = 0; col < converters.size(); col++) {
+                data(Eigen::Index(row), Eigen::Index(col)) =
+                    converters[col]->fromBytes(ptr, swapByteOrder);
+                ptr += converters[col]->getSizeOf();
+            }
+        }
+    };
+
+    Base::parallel_for(numRows, countThreads(numRows), decode);
+}
+
+/// Reads the non-empty lines of \a inp in chunks, skipping the first \a offset lines.
+void readLines(std::istream& inp,
+               std::size_t offset,
+               std::size_t numPoints,
+               Eigen::Index numFields,
+               const std::function<void(const Eigen::MatrixXd&)>& process)
+{
+    std::string line;
+    std::size_t row = 0;
+    std::vector<std::string> lines;
+    Eigen::MatrixXd data(0, numFields);
+    while (row < numPoints && std::getline(inp, line)) {
+        if (line.empty()) {
+            continue;
+        }
+
+        if (offset > 0) {
+            offset--;
+            continue;
+        }
+
+        lines.push_back(line);
+        ++row;
+
+        if (lines.size() == ChunkSize || row == numPoints) {
+            parseLines(lines, data);
+            process(data);
+            lines.clear();
+        }
+    }
+
+    if (!lines.empty()) {
+        parseLines(lines, data);
+        process(data);
+    }
+}
+
+/// Reads \a numPoints rows of \a rowSize bytes from \a inp in chunks.
+void readRows(std::istream& inp,
+              std::size_t numPoints,
+              std::size_t rowSize,
+              const std::vector<ConverterPtr>& converters,
+              bool swapByteOrder,
+              const std::function<void(const Eigen::MatrixXd&)>& process)
+{
+    std::vector<char> buffer;
+    Eigen::MatrixXd data;
+    for (std::size_t row = 0; row < numPoints; row += ChunkSize) {
+        std::size_t numRows = std::min(ChunkSize, numPoints - row);
+        buffer.resize(numRows * rowSize);
+        inp.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (inp.gcount() != static_cast<std::streamsize>(buffer.size())) {
+            throw Base::BadFormatError("Unexpected end of file");
+        }
+
+        decodeRows(buffer, rowSize, converters, swapByteOrder, data);
+        process(data);
+    }
+}
+}  // namespace
+
 PlyReader::PlyReader() = default;
 
 void PlyReader::read(const std::string& filename)
 {
-    clear();
-
     Base::FileInfo fi(filename);
     Base::ifstream inp(fi, std::ios::in | std::ios::binary);
 
@@ -557,21 +959,7 @@ void PlyReader::read(const std::string& filename)
     std::vector<std::string> types;
     std::vector<int> sizes;
     std::size_t offset = 0;
-    Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, offset, fields, types, sizes));
-
-    this->width = numPoints;
-    this->height = 1;
-
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, offset, data);
-    }
-    else if (format == "binary_little_endian") {
-        readBinary(false, inp, offset, types, sizes, data);
-    }
-    else if (format == "binary_big_endian") {
-        readBinary(true, inp, offset, types, sizes, data);
-    }
+    std::size_t numPoints = readHeader(inp, format, offset, fields, types, sizes);
 
     std::vector<std::string>::iterator it;
     Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
@@ -665,56 +1053,78 @@ void PlyReader::read(const std::string& filename)
     bool hasIntensity = (greyvalue != max_size);
     bool hasColor = (red != max_size && green != max_size && blue != max_size);
 
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
+    // transfer the data of each chunk
+    Chunk chunk;
+    auto process = [&](const Eigen::MatrixXd& data) {
+        if (!hasData) {
+            return;
         }
-    }
 
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+        chunk.clear();
+        Eigen::Index numRows = data.rows();
+        chunk.points.reserve(numRows);
+        for (Eigen::Index i = 0; i < numRows; i++) {
+            chunk.points.emplace_back(data(i, x), data(i, y), data(i, z));
         }
-    }
 
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(static_cast<float>(data(i, greyvalue)));
+        if (hasNormal) {
+            chunk.normals.reserve(numRows);
+            for (Eigen::Index i = 0; i < numRows; i++) {
+                chunk.normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+            }
         }
-    }
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        float a = 1.0;
-        if (types[red] == "uchar") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
-                }
-                colors.emplace_back(static_cast<float>(r) / 255.0F,
-                                    static_cast<float>(g) / 255.0F,
-                                    static_cast<float>(b) / 255.0F,
-                                    static_cast<float>(a) / 255.0F);
+        if (hasIntensity) {
+            chunk.intensity.reserve(numRows);
+            for (Eigen::Index i = 0; i < numRows; i++) {
+                chunk.intensity.push_back(static_cast<float>(data(i, greyvalue)));
             }
         }
-        else if (types[red] == "float") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
+
+        if (hasColor) {
+            chunk.colors.reserve(numRows);
+            float a = 1.0;
+            if (types[red] == "uchar") {
+                for (Eigen::Index i = 0; i < numRows; i++) {
+                    float r = static_cast<float>(data(i, red));
+                    float g = static_cast<float>(data(i, green));
+                    float b = static_cast<float>(data(i, blue));
+                    if (alpha != max_size) {
+                        a = static_cast<float>(data(i, alpha));
+                    }
+                    chunk.colors.emplace_back(r / 255.0F, g / 255.0F, b / 255.0F, a / 255.0F);
+                }
+            }
+            else if (types[red] == "float") {
+                for (Eigen::Index i = 0; i < numRows; i++) {
+                    float r = static_cast<float>(data(i, red));
+                    float g = static_cast<float>(data(i, green));
+                    float b = static_cast<float>(data(i, blue));
+                    if (alpha != max_size) {
+                        a = static_cast<float>(data(i, alpha));
+                    }
+                    chunk.colors.emplace_back(r, g, b, a);
                 }
-                colors.emplace_back(r, g, b, a);
             }
         }
+
+        addChunk(chunk);
+    };
+
+    this->width = int(numPoints);
+    this->height = 1;
+
+    beginRead(numPoints);
+    if (format == "ascii") {
+        readAscii(inp, offset, numPoints, Eigen::Index(fields.size()), process);
+    }
+    else if (format == "binary_little_endian") {
+        readBinary(isBigEndianHost(), inp, offset, numPoints, types, sizes, process);
+    }
+    else if (format == "binary_big_endian") {
+        readBinary(!isBigEndianHost(), inp, offset, numPoints, types, sizes, process);
     }
+    endRead();
 }
 
 std::size_t PlyReader::readHeader(std::istream& in,
@@ -887,48 +1297,24 @@ std::size_t PlyReader::readHeader(std::istream& in,
     return numPoints;
 }
 
-void PlyReader::readAscii(std::istream& inp, std::size_t offset, Eigen::MatrixXd& data)
+void PlyReader::readAscii(std::istream& inp,
+                          std::size_t offset,
+                          std::size_t numPoints,
+                          Eigen::Index numFields,
+                          const std::function<void(const Eigen::MatrixXd&)>& process)
 {
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = Eigen::Index(data.rows());
-    Eigen::Index numFields = Eigen::Index(data.cols());
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        if (offset > 0) {
-            offset--;
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
+    readLines(inp, offset, numPoints, numFields, process);
 }
 
 void PlyReader::readBinary(bool swapByteOrder,
                            std::istream& inp,
                            std::size_t offset,
+                           std::size_t numPoints,
                            const std::vector<std::string>& types,
                            const std::vector<int>& sizes,
-                           Eigen::MatrixXd& data)
+                           const std::function<void(const Eigen::MatrixXd&)>& process)
 {
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
+    Eigen::Index numFields = Eigen::Index(types.size());
 
     int neededSize = 0;
     ConverterPtr convert_float32(new ConverterT<float>);
@@ -1007,14 +1393,7 @@ void PlyReader::readBinary(bool swapByteOrder,
         }
     }
 
-    Base::InputStream str(inp);
-    str.setByteOrder(swapByteOrder ? Base::Stream::BigEndian : Base::Stream::LittleEndian);
-    for (Eigen::Index i = 0; i < numPoints; i++) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            double value = converters[j]->toDouble(str);
-            data(i, j) = value;
-        }
-    }
+    readRows(inp, numPoints, std::size_t(neededSize), converters, swapByteOrder, process);
 }
 
 // ----------------------------------------------------------------------------
@@ -1023,7 +1402,6 @@ PcdReader::PcdReader() = default;
 
 void PcdReader::read(const std::string& filename)
 {
-    clear();
     this->width = 0;
     this->height = 1;
 
@@ -1034,34 +1412,7 @@ void PcdReader::read(const std::string& filename)
     std::vector<std::string> fields;
     std::vector<std::string> types;
     std::vector<int> sizes;
-    Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, fields, types, sizes));
-
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, data);
-    }
-    else if (format == "binary") {
-        readBinary(false, inp, types, sizes, data);
-    }
-    else if (format == "binary_compressed") {
-        unsigned int c {};
-        unsigned int u {};
-        Base::InputStream str(inp);
-        str >> c >> u;
-
-        std::vector<char> compressed(c);
-        inp.read(compressed.data(), c);
-        std::vector<char> uncompressed(u);
-        if (lzfDecompress(compressed.data(), c, uncompressed.data(), u) == u) {
-            DataStreambuf ibuf(uncompressed);
-            std::istream istr(nullptr);
-            istr.rdbuf(&ibuf);
-            readBinary(true, istr, types, sizes, data);
-        }
-        else {
-            throw Base::BadFormatError("Failed to decompress binary data");
-        }
-    }
+    std::size_t numPoints = readHeader(inp, format, fields, types, sizes);
 
     std::vector<std::string>::iterator it;
     Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
@@ -1140,50 +1491,90 @@ void PcdReader::read(const std::string& filename)
     bool hasIntensity = (greyvalue != max_size);
     bool hasColor = (rgba != max_size);
 
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
+    // transfer the data of each chunk
+    Chunk chunk;
+    auto process = [&](const Eigen::MatrixXd& data) {
+        if (!hasData) {
+            return;
         }
-    }
 
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+        chunk.clear();
+        Eigen::Index numRows = data.rows();
+        chunk.points.reserve(numRows);
+        for (Eigen::Index i = 0; i < numRows; i++) {
+            chunk.points.emplace_back(data(i, x), data(i, y), data(i, z));
         }
-    }
 
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(data(i, greyvalue));
+        if (hasNormal) {
+            chunk.normals.reserve(numRows);
+            for (Eigen::Index i = 0; i < numRows; i++) {
+                chunk.normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+            }
         }
-    }
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        if (types[rgba] == "U") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                uint32_t packed = static_cast<uint32_t>(data(i, rgba));
-                Base::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
+        if (hasIntensity) {
+            chunk.intensity.reserve(numRows);
+            for (Eigen::Index i = 0; i < numRows; i++) {
+                chunk.intensity.push_back(static_cast<float>(data(i, greyvalue)));
             }
         }
-        else if (types[rgba] == "F") {
-            static_assert(sizeof(float) == sizeof(uint32_t),
-                          "float and uint32_t have different sizes");
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float f = static_cast<float>(data(i, rgba));
-                uint32_t packed {};
-                std::memcpy(&packed, &f, sizeof(packed));
-                Base::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
+
+        if (hasColor) {
+            chunk.colors.reserve(numRows);
+            if (types[rgba] == "U") {
+                for (Eigen::Index i = 0; i < numRows; i++) {
+                    uint32_t packed = static_cast<uint32_t>(data(i, rgba));
+                    Base::Color col;
+                    col.setPackedARGB(packed);
+                    chunk.colors.emplace_back(col);
+                }
+            }
+            else if (types[rgba] == "F") {
+                static_assert(sizeof(float) == sizeof(uint32_t),
+                              "float and uint32_t have different sizes");
+                for (Eigen::Index i = 0; i < numRows; i++) {
+                    float f = static_cast<float>(data(i, rgba));
+                    uint32_t packed {};
+                    std::memcpy(&packed, &f, sizeof(packed));
+                    Base::Color col;
+                    col.setPackedARGB(packed);
+                    chunk.colors.emplace_back(col);
+                }
             }
         }
+
+        addChunk(chunk);
+    };
+
+    beginRead(numPoints);
+    if (format == "ascii") {
+        readAscii(inp, numPoints, Eigen::Index(fields.size()), process);
+    }
+    else if (format == "binary") {
+        readBinary(false, inp, numPoints, types, sizes, process);
+    }
+    else if (format == "binary_compressed") {
+        unsigned int c {};
+        unsigned int u {};
+        Base::InputStream str(inp);
+        str >> c >> u;
+
+        std::vector<char> compressed(c);
+        inp.read(compressed.data(), c);
+        std::vector<char> uncompressed(u);
+        if (lzfDecompress(compressed.data(), c, uncompressed.data(), u) == u) {
+            compressed.clear();
+            compressed.shrink_to_fit();
+            DataStreambuf ibuf(uncompressed);
+            std::istream istr(nullptr);
+            istr.rdbuf(&ibuf);
+            readBinary(true, istr, numPoints, types, sizes, process);
+        }
+        else {
+            throw Base::BadFormatError("Failed to decompress binary data");
+        }
     }
+    endRead();
 }
 
 std::size_t PcdReader::readHeader(std::istream& in,
@@ -1257,42 +1648,22 @@ std::size_t PcdReader::readHeader(std::istream& in,
     return points;
 }
 
-void PcdReader::readAscii(std::istream& inp, Eigen::MatrixXd& data)
+void PcdReader::readAscii(std::istream& inp,
+                          std::size_t numPoints,
+                          Eigen::Index numFields,
+                          const std::function<void(const Eigen::MatrixXd&)>& process)
 {
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
+    readLines(inp, 0, numPoints, numFields, process);
 }
 
 void PcdReader::readBinary(bool transpose,
                            std::istream& inp,
+                           std::size_t numPoints,
                            const std::vector<std::string>& types,
                            const std::vector<int>& sizes,
-                           Eigen::MatrixXd& data)
+                           const std::function<void(const Eigen::MatrixXd&)>& process)
 {
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
+    Eigen::Index numFields = Eigen::Index(types.size());
 
     int neededSize = 0;
     ConverterPtr convert_float32(new ConverterT<float>);
@@ -1371,22 +1742,43 @@ void PcdReader::readBinary(bool transpose,
         }
     }
 
-    Base::InputStream str(inp);
-    if (transpose) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
+    // the data is stored in the byte order of the writing host which is assumed to be little endian
+    bool swapByteOrder = isBigEndianHost();
+    auto rowSize = static_cast<std::size_t>(neededSize);
+    if (!transpose) {
+        readRows(inp, numPoints, rowSize, converters, swapByteOrder, process);
+        return;
+    }
+
+    // the fields are stored one after another, so gather the slices of each chunk
+    std::vector<char> column;
+    std::vector<char> buffer;
+    Eigen::MatrixXd data;
+    for (std::size_t row = 0; row < numPoints; row += ChunkSize) {
+        std::size_t numRows = std::min(ChunkSize, numPoints - row);
+        buffer.resize(numRows * rowSize);
+
+        std::size_t fieldOffset = 0;
+        for (const auto& it : converters) {
+            std::size_t size = it->getSizeOf();
+            auto pos = ulCurr + static_cast<std::streamoff>(numPoints * fieldOffset + row * size);
+            column.resize(numRows * size);
+            inp.seekg(pos, std::ios::beg);
+            inp.read(column.data(), static_cast<std::streamsize>(column.size()));
+            if (inp.gcount() != static_cast<std::streamsize>(column.size())) {
+                throw Base::BadFormatError("Unexpected end of file");
             }
-        }
-    }
-    else {
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            for (Eigen::Index j = 0; j < numFields; j++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
+
+            for (std::size_t i = 0; i < numRows; i++) {
+                std::memcpy(buffer.data() + i * rowSize + fieldOffset,
+                            column.data() + i * size,
+                            size);
             }
+            fieldOffset += size;
         }
+
+        decodeRows(buffer, rowSize, converters, swapByteOrder, data);
+        process(data);
     }
 }
 
@@ -1397,44 +1789,26 @@ namespace
 class E57ReaderImp
 {
 public:
-    E57ReaderImp(const std::string& filename, bool color, bool state, double distance)
+    using ProcessChunk = std::function<void(const Reader::Chunk&)>;
+
+    E57ReaderImp(const std::string& filename, bool color, bool state)
         : imfi(filename, "r")
         , useColor {color}
         , checkState {state}
-        , minDistance {distance}
     {}
 
-    void read()
+    /// Passes the points of each block that is read from the file to \a process.
+    void read(const ProcessChunk& process)
     {
         e57::StructureNode root = imfi.root();
         if (root.isDefined("data3D")) {
             e57::VectorNode data3D(root.get("data3D"));
-            readData3D(data3D);
+            readData3D(data3D, process);
         }
     }
 
-    std::vector<Base::Color> getColors() const
-    {
-        return colors;
-    }
-
-    std::vector<float> getItensity() const
-    {
-        return intensity;
-    }
-
-    const PointKernel& getPoints() const
-    {
-        return points;
-    }
-
-    const std::vector<Base::Vector3f>& getNormals() const
-    {
-        return normals;
-    }
-
 private:
-    void readData3D(const e57::VectorNode& data3D)
+    void readData3D(const e57::VectorNode& data3D, const ProcessChunk& process)
     {
         for (int child = 0; child < data3D.childCount(); ++child) {
             e57::StructureNode scan_data(data3D.get(child));
@@ -1444,7 +1818,7 @@ private:
             e57::CompressedVectorNode cvn(scan_data.get("points"));
             e57::StructureNode prototype(cvn.prototype());
             Proto proto = readProto(prototype);
-            processProto(cvn, proto, hasPlacement, plm);
+            processProto(cvn, proto, hasPlacement, plm, process);
         }
     }
 
@@ -1630,52 +2004,38 @@ private:
     void processProto(e57::CompressedVectorNode& cvn,
                       const Proto& proto,
                       bool hasPlacement,
-                      const Base::Placement& plm)
+                      const Base::Placement& plm,
+                      const ProcessChunk& process)
     {
         if (proto.cnt_xyz != 3) {
             throw Base::BadFormatError("Missing channels xyz");
         }
         unsigned count;
-        unsigned cnt_pts = 0;
-        Base::Vector3d pt, last;
         e57::CompressedVectorReader cvr(cvn.reader(proto.sdb));
         bool hasColor = (proto.cnt_rgb == 3) && useColor;
         bool hasItensity = proto.inty;
         bool hasNormal = (proto.cnt_nor == 3);
         bool hasState = proto.inv_state && checkState;
-        bool filter = false;
 
         while ((count = cvr.read())) {
+            chunk.clear();
             for (size_t i = 0; i < count; ++i) {
-                filter = false;
-                if (hasState) {
-                    if (proto.state[i] != 0) {
-                        filter = true;
-                    }
+                if (hasState && proto.state[i] != 0) {
+                    continue;
                 }
 
-                pt = getCoord(proto, i, hasPlacement, plm);
-
-                if ((!filter) && (cnt_pts > 0)) {
-                    if (Base::Distance(last, pt) < minDistance) {
-                        filter = true;
-                    }
+                chunk.points.push_back(getCoord(proto, i, hasPlacement, plm));
+                if (hasColor) {
+                    chunk.colors.push_back(getColor(proto, i));
                 }
-                if (!filter) {
-                    cnt_pts++;
-                    points.push_back(pt);
-                    last = pt;
-                    if (hasColor) {
-                        colors.push_back(getColor(proto, i));
-                    }
-                    if (hasItensity) {
-                        intensity.push_back(proto.intensity[i]);
-                    }
-                    if (hasNormal) {
-                        normals.push_back(getNormal(proto, i, hasPlacement, plm.getRotation()));
-                    }
+                if (hasItensity) {
+                    chunk.intensity.push_back(static_cast<float>(proto.intensity[i]));
+                }
+                if (hasNormal) {
+                    chunk.normals.push_back(getNormal(proto, i, hasPlacement, plm.getRotation()));
                 }
             }
+            process(chunk);
         }
     }
 
@@ -1767,31 +2127,30 @@ private:
     e57::ImageFile imfi;
     bool useColor;
     bool checkState;
-    double minDistance;
-    const size_t buf_size = 1024;
-    std::vector<Base::Color> colors;
-    std::vector<float> intensity;
-    PointKernel points;
-    std::vector<Base::Vector3f> normals;
+    const size_t buf_size = 65536;
+    Reader::Chunk chunk;
 };
 }  // namespace
 
 E57Reader::E57Reader(bool Color, bool State, double Distance)
     : useColor {Color}
     , checkState {State}
-    , minDistance {Distance}
-{}
+{
+    ReadFilter filter;
+    filter.minDistance = Distance;
+    setFilter(filter);
+}
 
 void E57Reader::read(const std::string& filename)
 {
     try {
-        E57ReaderImp reader(filename, useColor, checkState, minDistance);
-        reader.read();
-        points = reader.getPoints();
-        normals = reader.getNormals();
-        colors = reader.getColors();
-        intensity = reader.getItensity();
-        width = points.size();
+        E57ReaderImp reader(filename, useColor, checkState);
+        beginRead(0);
+        reader.read([this](const Chunk& chunk) {
+            addChunk(chunk);
+        });
+        endRead();
+        width = static_cast<int>(points.size());
         height = 1;
     }
     catch (const Base::BadFormatError&) {
@@ -23,8 +23,11 @@
 #ifndef _PointsAlgos_h_
 #define _PointsAlgos_h_
 
+#include <functional>
+#include <memory>
 #include <Eigen/Core>
 
+#include "PointCloud.h"
 #include "Points.h"
 #include "Properties.h"
 
@@ -45,13 +48,47 @@ public:
     static void LoadAscii(PointKernel&, const char* FileName);
 };
 
+/** Filters that are applied while a point cloud is read. The points are decoded and filtered
+ * in chunks, so points that are dropped are never held in memory as a whole.
+ */
+struct PointsExport ReadFilter
+{
+    /// Only keep the points inside the box, ignored if the box is invalid.
+    Base::BoundBox3d cropBox;
+    /// Skip points closer than this to the previously kept point, ignored if not positive.
+    double minDistance {0.0};
+    /// Keep only the first point of each voxel of this size, ignored if not positive.
+    double voxelSize {0.0};
+    /// Maximum number of points to keep, 0 means no limit. If the limit is exceeded the kept
+    /// points are thinned out with a voxel grid whose size grows until the points fit.
+    std::size_t pointBudget {0};
+
+    bool isActive() const;
+};
+
+class VoxelGrid;
+
 class PointsExport Reader
 {
 public:
+    /// Decoded points of a file with their optional attributes.
+    struct Chunk
+    {
+        std::vector<Base::Vector3d> points;
+        std::vector<Base::Vector3f> normals;
+        std::vector<float> intensity;
+        std::vector<Base::Color> colors;
+
+        void clear();
+    };
+
     Reader();
     virtual ~Reader();
     virtual void read(const std::string& filename) = 0;
 
+    void setFilter(const ReadFilter&);
+    const ReadFilter& getFilter() const;
+
     void clear();
     const PointKernel& getPoints() const;
     bool hasProperties() const;
@@ -70,6 +107,17 @@ public:
     Reader& operator=(const Reader&) = delete;
     Reader& operator=(Reader&&) = delete;
 
+protected:
+    /// Must be called before the first chunk of a file is added.
+    void beginRead(std::size_t numPoints);
+    /// Appends the points of \a chunk that pass the filter.
+    void addChunk(const Chunk& chunk);
+    /// Must be called after the last chunk of a file is added.
+    void endRead();
+
+private:
+    void reduce();
+
 protected:
     // NOLINTBEGIN
     PointKernel points;
@@ -79,6 +127,15 @@ protected:
     int width {0};
     int height {1};
     // NOLINTEND
+
+private:
+    ReadFilter filter;
+    /// Points and attributes while a file is read, the chunked storage grows without moving
+    /// the data already read.
+    PointCloud cloud;
+    std::unique_ptr<VoxelGrid> grid;
+    Base::Vector3d lastPoint;
+    bool hasLastPoint {false};
 };
 
 class PointsExport AscReader: public Reader
@@ -101,13 +158,18 @@ private:
                            std::vector<std::string>& fields,
                            std::vector<std::string>& types,
                            std::vector<int>& sizes);
-    void readAscii(std::istream&, std::size_t offset, Eigen::MatrixXd& data);
+    void readAscii(std::istream&,
+                   std::size_t offset,
+                   std::size_t numPoints,
+                   Eigen::Index numFields,
+                   const std::function<void(const Eigen::MatrixXd&)>& process);
     void readBinary(bool swapByteOrder,
                     std::istream&,
                     std::size_t offset,
+                    std::size_t numPoints,
                     const std::vector<std::string>& types,
                     const std::vector<int>& sizes,
-                    Eigen::MatrixXd& data);
+                    const std::function<void(const Eigen::MatrixXd&)>& process);
 };
 
 class PointsExport PcdReader: public Reader
@@ -122,12 +184,16 @@ private:
                            std::vector<std::string>& fields,
                            std::vector<std::string>& types,
                            std::vector<int>& sizes);
-    void readAscii(std::istream&, Eigen::MatrixXd& data);
+    void readAscii(std::istream&,
+                   std::size_t numPoints,
+                   Eigen::Index numFields,
+                   const std::function<void(const Eigen::MatrixXd&)>& process);
     void readBinary(bool transpose,
                     std::istream&,
+                    std::size_t numPoints,
                     const std::vector<std::string>& types,
                     const std::vector<int>& sizes,
-                    Eigen::MatrixXd& data);
+                    const std::function<void(const Eigen::MatrixXd&)>& process);
 };
 
 class PointsExport E57Reader: public Reader
@@ -138,7 +204,6 @@ public:
 
 protected:
     bool useColor, checkState;
-    double minDistance;
 };
 
 class PointsExport Writer
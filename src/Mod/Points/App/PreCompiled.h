@@ -39,11 +39,16 @@
 
 // STL
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <queue>
 #include <set>
 #include <sstream>
+#include <unordered_set>
 #include <vector>
 
 // boost
@@ -29,6 +29,7 @@
 #include <Gui/Language/Translator.h>
 #include <Mod/Points/App/PropertyPointKernel.h>
 
+#include "SoFCIndexedPointSet.h"
 #include "ViewProvider.h"
 #include "Workbench.h"
 
@@ -88,6 +89,7 @@ PyMOD_INIT_FUNC(PointsGui)
     CreatePointsCommands();
 
     // clang-format off
+    PointsGui::SoFCIndexedPointSet      ::initClass();
     PointsGui::ViewProviderPoints       ::init();
     PointsGui::ViewProviderScattered    ::init();
     PointsGui::ViewProviderStructured   ::init();
@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <limits>
+
+#include <Inventor/SbBox3f.h>
+#include <Inventor/SbViewVolume.h>
+#include <Inventor/SbViewportRegion.h>
+#include <Inventor/actions/SoGLRenderAction.h>
+#include <Inventor/elements/SoCacheElement.h>
+#include <Inventor/elements/SoModelMatrixElement.h>
+#include <Inventor/elements/SoViewVolumeElement.h>
+#include <Inventor/elements/SoViewportRegionElement.h>
+#include <Inventor/misc/SoState.h>
+#include <Inventor/sensors/SoOneShotSensor.h>
+#endif
+
+#include <Mod/Points/App/PointOctree.h>
+
+#include "SoFCIndexedPointSet.h"
+
+
+using namespace PointsGui;
+
+SO_NODE_SOURCE(SoFCIndexedPointSet)
+
+void SoFCIndexedPointSet::initClass()
+{
+    SO_NODE_INIT_CLASS(SoFCIndexedPointSet, SoIndexedPointSet, "IndexedPointSet");
+}
+
+SoFCIndexedPointSet::SoFCIndexedPointSet()
+{
+    SO_NODE_CONSTRUCTOR(SoFCIndexedPointSet);
+
+    SO_NODE_ADD_FIELD(pointBudget, (5000000));
+
+    updateSensor.setFunction(&SoFCIndexedPointSet::updateCB);
+    updateSensor.setData(this);
+}
+
+SoFCIndexedPointSet::~SoFCIndexedPointSet()
+{
+    updateSensor.unschedule();
+}
+
+void SoFCIndexedPointSet::setOctree(const std::shared_ptr<const Points::PointOctree>& tree)
+{
+    octree = tree;
+    selection.clear();
+    pending.clear();
+    updateSensor.unschedule();
+
+    // until the first rendering only the coarsest level is used
+    std::vector<uint32_t> nodes;
+    if (octree && !octree->empty()) {
+        nodes.push_back(0);
+    }
+    setIndices(std::move(nodes));
+}
+
+void SoFCIndexedPointSet::GLRender(SoGLRenderAction* action)
+{
+    if (octree && !octree->empty()) {
+        SoState* state = action->getState();
+        // the rendered points depend on the camera
+        SoCacheElement::invalidate(state);
+        updateIndices(state);
+    }
+
+    inherited::GLRender(action);
+}
+
+void SoFCIndexedPointSet::computeBBox(SoAction* action, SbBox3f& box, SbVec3f& center)
+{
+    if (!octree || octree->empty()) {
+        inherited::computeBBox(action, box, center);
+        return;
+    }
+
+    // use the whole cloud so that the clipping planes don't change with the level of detail
+    const Base::BoundBox3f& bbox = octree->getNodes().front().box;
+    box.setBounds(bbox.MinX, bbox.MinY, bbox.MinZ, bbox.MaxX, bbox.MaxY, bbox.MaxZ);
+    center = box.getCenter();
+}
+
+void SoFCIndexedPointSet::updateIndices(SoState* state)
+{
+    const SbViewVolume& vv = SoViewVolumeElement::get(state);
+    const SbMatrix& mat = SoModelMatrixElement::get(state);
+    SbVec2s size = SoViewportRegionElement::get(state).getViewportSizePixels();
+    float height = std::max(1.0F, static_cast<float>(size[1]));
+    SbVec3f eye = vv.getProjectionPoint();
+
+    auto pixelSpacing = [&](const Points::PointOctree::Node& node) {
+        SbBox3f box(node.box.MinX,
+                    node.box.MinY,
+                    node.box.MinZ,
+                    node.box.MaxX,
+                    node.box.MaxY,
+                    node.box.MaxZ);
+        box.transform(mat);
+        if (!vv.intersect(box)) {
+            return -1.0F;
+        }
+        if (vv.getProjectionType() == SbViewVolume::PERSPECTIVE && box.intersect(eye)) {
+            return std::numeric_limits<float>::max();
+        }
+
+        // size of the viewport height in world units at the node
+        float scale = vv.getWorldToScreenScale(box.getCenter(), 1.0F);
+        if (scale <= 0.0F) {
+            return std::numeric_limits<float>::max();
+        }
+        return node.spacing / scale * height;
+    };
+
+    auto budget = static_cast<std::size_t>(std::max(pointBudget.getValue(), 1));
+    std::vector<uint32_t> nodes = octree->selectNodes(pixelSpacing, budget);
+    if (nodes == selection) {
+        pending.clear();
+        updateSensor.unschedule();
+    }
+    else if (nodes != pending || !updateSensor.isScheduled()) {
+        // changing coordIndex notifies the scene graph, which must not happen while rendering
+        pending = std::move(nodes);
+        updateSensor.schedule();
+    }
+}
+
+void SoFCIndexedPointSet::updateCB(void* data, SoSensor*)
+{
+    auto self = static_cast<SoFCIndexedPointSet*>(data);
+    if (self->octree) {
+        self->setIndices(std::move(self->pending));
+        self->pending.clear();
+    }
+}
+
+void SoFCIndexedPointSet::setIndices(std::vector<uint32_t>&& nodes)
+{
+    selection = std::move(nodes);
+
+    std::size_t count = 0;
+    for (uint32_t index : selection) {
+        count += octree->getNodes()[index].count;
+    }
+
+    coordIndex.setNum(static_cast<int>(count));
+    if (count > 0) {
+        const std::vector<uint32_t>& order = octree->getOrder();
+        int32_t* indices = coordIndex.startEditing();
+        for (uint32_t index : selection) {
+            const Points::PointOctree::Node& node = octree->getNodes()[index];
+            indices = std::transform(order.begin() + node.begin,
+                                     order.begin() + node.begin + node.count,
+                                     indices,
+                                     [](uint32_t value) {
+                                         return static_cast<int32_t>(value);
+                                     });
+        }
+        coordIndex.finishEditing();
+    }
+}
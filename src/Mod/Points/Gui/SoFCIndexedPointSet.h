@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef POINTSGUI_SOFCINDEXEDPOINTSET_H
+#define POINTSGUI_SOFCINDEXEDPOINTSET_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <Inventor/fields/SoSFInt32.h>
+#include <Inventor/nodes/SoIndexedPointSet.h>
+#include <Inventor/sensors/SoOneShotSensor.h>
+#include <Mod/Points/PointsGlobal.h>
+
+
+class SoState;
+
+namespace Points
+{
+class PointOctree;
+}
+
+namespace PointsGui
+{
+
+/**
+ * Point set for clouds with more points than can be rendered interactively.
+ *
+ * While rendering the nodes of the octree are selected by their spacing on the screen. When the
+ * selection changes, coordIndex is set to the points of these nodes by a sensor after the
+ * traversal, so the next frame draws them. So at most pointBudget points are drawn, and detail is
+ * spent where the camera is close. Picking uses the points that were rendered last.
+ */
+// NOLINTBEGIN
+class PointsGuiExport SoFCIndexedPointSet: public SoIndexedPointSet
+{
+    using inherited = SoIndexedPointSet;
+
+    SO_NODE_HEADER(SoFCIndexedPointSet);
+
+public:
+    static void initClass();
+    SoFCIndexedPointSet();
+
+    /// Maximum number of points that are rendered.
+    SoSFInt32 pointBudget;
+
+    /// Sets the octree of the points of the current coordinates.
+    void setOctree(const std::shared_ptr<const Points::PointOctree>& tree);
+
+protected:
+    ~SoFCIndexedPointSet() override;
+    void GLRender(SoGLRenderAction* action) override;
+    void computeBBox(SoAction* action, SbBox3f& box, SbVec3f& center) override;
+
+private:
+    void updateIndices(SoState* state);
+    void setIndices(std::vector<uint32_t>&& nodes);
+    static void updateCB(void* data, SoSensor* sensor);
+
+private:
+    std::shared_ptr<const Points::PointOctree> octree;
+    std::vector<uint32_t> selection;
+    std::vector<uint32_t> pending;
+    SoOneShotSensor updateSensor;
+};
+// NOLINTEND
+
+}  // namespace PointsGui
+
+
+#endif  // POINTSGUI_SOFCINDEXEDPOINTSET_H
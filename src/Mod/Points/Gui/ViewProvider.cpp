@@ -24,6 +24,7 @@
 #ifndef _PreComp_
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <limits>
+#include <memory>
 
 #include <Inventor/errors/SoDebugError.h>
 #include <Inventor/events/SoMouseButtonEvent.h>
@@ -37,21 +38,36 @@
 #include <Inventor/nodes/SoPointSet.h>
 #endif
 
+#include <App/Application.h>
 #include <App/Document.h>
 #include <Base/Vector3D.h>
 #include <Gui/Application.h>
 #include <Gui/Document.h>
 #include <Gui/Selection/SoFCSelection.h>
 #include <Gui/View3DInventorViewer.h>
+#include <Mod/Points/App/PointOctree.h>
 #include <Mod/Points/App/PointsFeature.h>
 #include <Mod/Points/App/Properties.h>
 
+#include "SoFCIndexedPointSet.h"
 #include "ViewProvider.h"
 
 
 using namespace PointsGui;
 using namespace Points;
 
+namespace
+{
+// clouds with more points are rendered with a level of detail
+std::size_t getPointBudget()
+{
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Points/View");
+    long budget = hGrp->GetInt("PointBudget", 5000000);
+    return static_cast<std::size_t>(std::max(budget, 1L));
+}
+}  // namespace
+
 
 PROPERTY_SOURCE_ABSTRACT(PointsGui::ViewProviderPoints, Gui::ViewProviderGeometryObject)
 
@@ -370,11 +386,14 @@ ViewProviderScattered::ViewProviderScattered()
 {
     pcPoints = new SoPointSet();
     pcPoints->ref();
+    pcLodPoints = new SoFCIndexedPointSet();
+    pcLodPoints->ref();
 }
 
 ViewProviderScattered::~ViewProviderScattered()
 {
     pcPoints->unref();
+    pcLodPoints->unref();
 }
 
 void ViewProviderScattered::attach(App::DocumentObject* pcObj)
@@ -427,8 +446,22 @@ void ViewProviderScattered::updateData(const App::Property* prop)
 {
     ViewProviderPoints::updateData(prop);
     if (prop->is<Points::PropertyPointKernel>()) {
-        ViewProviderPointsBuilder builder;
-        builder.createPoints(prop, pcPointsCoord, pcPoints);
+        // the coordinates are updated on every change of the kernel, so they can share it
+        ViewProviderPointsBuilder builder(true);
+        std::size_t budget = getPointBudget();
+        const Points::PointKernel& kernel =
+            static_cast<const Points::PropertyPointKernel*>(prop)->getValue();
+        if (kernel.size() > budget) {
+            pcLodPoints->pointBudget = static_cast<int>(
+                std::min<std::size_t>(budget, std::numeric_limits<int>::max()));
+            builder.createPoints(prop, pcPointsCoord, pcLodPoints);
+            setPointSet(pcLodPoints);
+        }
+        else {
+            builder.createPoints(prop, pcPointsCoord, pcPoints);
+            pcLodPoints->setOctree(nullptr);
+            setPointSet(pcPoints);
+        }
 
         // The number of points might have changed, so force also a resize of the Inventor internals
         setActiveMode();
@@ -444,6 +477,15 @@ void ViewProviderScattered::updateData(const App::Property* prop)
     }
 }
 
+void ViewProviderScattered::setPointSet(SoNode* node)
+{
+    SoNode* other = node == pcPoints ? static_cast<SoNode*>(pcLodPoints) : pcPoints;
+    int index = pcHighlight->findChild(other);
+    if (index >= 0) {
+        pcHighlight->replaceChild(index, node);
+    }
+}
+
 void ViewProviderScattered::cut(const std::vector<SbVec2f>& picked,
                                 Gui::View3DInventorViewer& Viewer)
 {
@@ -599,7 +641,7 @@ void ViewProviderStructured::updateData(const App::Property* prop)
 {
     ViewProviderPoints::updateData(prop);
     if (prop->is<Points::PropertyPointKernel>()) {
-        ViewProviderPointsBuilder builder;
+        ViewProviderPointsBuilder builder(true);
         builder.createPoints(prop, pcPointsCoord, pcPoints);
 
         // The number of points might have changed, so force also a resize of the Inventor internals
@@ -701,6 +743,28 @@ void ViewProviderPointsBuilder::buildNodes(const App::Property* prop,
     }
 }
 
+void ViewProviderPointsBuilder::setCoordinates(const Points::PointKernel& cPts,
+                                               SoCoordinate3* coords) const
+{
+    // The kernel stores the points contiguously as float triples, so the field can use them as
+    // they are. Otherwise the whole block is copied at once instead of point by point.
+    static_assert(sizeof(Points::PointKernel::value_type) == 3 * sizeof(float));
+    const std::vector<Points::PointKernel::value_type>& kernel = cPts.getBasicPoints();
+    if (kernel.empty()) {
+        coords->point.setNum(0);
+    }
+    else if (shareKernel) {
+        coords->point.setValuesPointer(static_cast<int>(kernel.size()),
+                                       reinterpret_cast<const float*>(kernel.data()));
+    }
+    else {
+        coords->point.setNum(static_cast<int>(kernel.size()));
+        coords->point.setValues(0,
+                                static_cast<int>(kernel.size()),
+                                reinterpret_cast<const float(*)[3]>(kernel.data()));
+    }
+}
+
 void ViewProviderPointsBuilder::createPoints(const App::Property* prop,
                                              SoCoordinate3* coords,
                                              SoPointSet* points) const
@@ -709,20 +773,9 @@ void ViewProviderPointsBuilder::createPoints(const App::Property* prop,
         static_cast<const Points::PropertyPointKernel*>(prop);
     const Points::PointKernel& cPts = prop_points->getValue();
 
-    coords->point.setNum(cPts.size());
-    SbVec3f* vec = coords->point.startEditing();
-
     // get all points
-    std::size_t idx = 0;
-    const std::vector<Points::PointKernel::value_type>& kernel = cPts.getBasicPoints();
-    for (std::vector<Points::PointKernel::value_type>::const_iterator it = kernel.begin();
-         it != kernel.end();
-         ++it, idx++) {
-        vec[idx].setValue(it->x, it->y, it->z);
-    }
-
+    setCoordinates(cPts, coords);
     points->numPoints = cPts.size();
-    coords->point.finishEditing();
 }
 
 void ViewProviderPointsBuilder::createPoints(const App::Property* prop,
@@ -733,10 +786,9 @@ void ViewProviderPointsBuilder::createPoints(const App::Property* prop,
         static_cast<const Points::PropertyPointKernel*>(prop);
     const Points::PointKernel& cPts = prop_points->getValue();
 
-    coords->point.setNum(cPts.size());
-    SbVec3f* vec = coords->point.startEditing();
-
     // get all points
+    setCoordinates(cPts, coords);
+
     std::size_t idx = 0;
     std::vector<int32_t> indices;
     indices.reserve(cPts.size());
@@ -744,14 +796,12 @@ void ViewProviderPointsBuilder::createPoints(const App::Property* prop,
     for (std::vector<Points::PointKernel::value_type>::const_iterator it = kernel.begin();
          it != kernel.end();
          ++it, idx++) {
-        vec[idx].setValue(it->x, it->y, it->z);
         // valid point?
         if (!(boost::math::isnan(it->x) || boost::math::isnan(it->y)
               || boost::math::isnan(it->z))) {
             indices.push_back(idx);
         }
     }
-    coords->point.finishEditing();
 
     // get all point indices
     idx = 0;
@@ -762,3 +812,20 @@ void ViewProviderPointsBuilder::createPoints(const App::Property* prop,
     }
     points->coordIndex.finishEditing();
 }
+
+void ViewProviderPointsBuilder::createPoints(const App::Property* prop,
+                                             SoCoordinate3* coords,
+                                             SoFCIndexedPointSet* points) const
+{
+    const Points::PropertyPointKernel* prop_points =
+        static_cast<const Points::PropertyPointKernel*>(prop);
+    const Points::PointKernel& cPts = prop_points->getValue();
+
+    // get all points
+    setCoordinates(cPts, coords);
+
+    // the octree only refers to the points by index
+    auto octree = std::make_shared<Points::PointOctree>();
+    octree->build(cPts.getBasicPoints());
+    points->setOctree(octree);
+}
@@ -60,14 +60,27 @@ class Feature;
 namespace PointsGui
 {
 
+class SoFCIndexedPointSet;
+
 class ViewProviderPointsBuilder: public Gui::ViewProviderBuilder
 {
 public:
     ViewProviderPointsBuilder() = default;
+    /// If \a share is true the coordinates refer to the memory of the point kernel instead of
+    /// a copy of it. The caller must then rebuild the nodes whenever the kernel changes.
+    explicit ViewProviderPointsBuilder(bool share)
+        : shareKernel(share)
+    {}
     ~ViewProviderPointsBuilder() override = default;
     void buildNodes(const App::Property*, std::vector<SoNode*>&) const override;
     void createPoints(const App::Property*, SoCoordinate3*, SoPointSet*) const;
     void createPoints(const App::Property*, SoCoordinate3*, SoIndexedPointSet*) const;
+    void createPoints(const App::Property*, SoCoordinate3*, SoFCIndexedPointSet*) const;
+
+private:
+    void setCoordinates(const Points::PointKernel&, SoCoordinate3*) const;
+
+    bool shareKernel {false};
 };
 
 /**
@@ -141,8 +154,13 @@ public:
 protected:
     void cut(const std::vector<SbVec2f>& picked, Gui::View3DInventorViewer& Viewer) override;
 
+private:
+    void setPointSet(SoNode* node);
+
 protected:
     SoPointSet* pcPoints;
+    /// used instead of pcPoints if the cloud exceeds the point budget
+    SoFCIndexedPointSet* pcLodPoints;
 };
 
 /**
@@ -143,19 +143,17 @@ public:
             "f.ViewObject.DisplayMode=1\n"
         );
 #endif
-#if defined(HAVE_PCL_SEGMENTATION)
         add_keyword_method("regionGrowingSegmentation",&Module::regionGrowingSegmentation,
             "regionGrowingSegmentation()."
         );
+#if defined(HAVE_PCL_SEGMENTATION)
         add_keyword_method("featureSegmentation",&Module::featureSegmentation,
             "featureSegmentation()."
         );
 #endif
-#if defined(HAVE_PCL_SAMPLE_CONSENSUS)
         add_keyword_method("sampleConsensus",&Module::sampleConsensus,
             "sampleConsensus()."
         );
-#endif
         initialize("This module is the ReverseEngineering module."); // register with Python
     }
 
@@ -822,7 +820,6 @@ Mesh.show(m)
         return list;
     }
 #endif
-#if defined(HAVE_PCL_SEGMENTATION)
     Py::Object regionGrowingSegmentation(const Py::Tuple& args, const Py::Dict& kwds)
     {
         PyObject *pts;
@@ -864,6 +861,7 @@ Mesh.show(m)
 
         return lists;
     }
+#if defined(HAVE_PCL_SEGMENTATION)
     Py::Object featureSegmentation(const Py::Tuple& args, const Py::Dict& kwds)
     {
         PyObject *pts;
@@ -892,7 +890,6 @@ Mesh.show(m)
         return lists;
     }
 #endif
-#if defined(HAVE_PCL_SAMPLE_CONSENSUS)
 /*
 import ReverseEngineering as reen
 import Points
@@ -929,10 +926,13 @@ Points.show(np)
         PyObject *pts;
         PyObject *vec = nullptr;
         const char* sacModelType = nullptr;
+        double distance = 0.01;
 
-        static const std::array<const char*,4> kwds_sample {"SacModel", "Points", "Normals", NULL};
-        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "sO!|O", kwds_sample,
-                                        &sacModelType, &(Points::PointsPy::Type), &pts, &vec))
+        static const std::array<const char*,5> kwds_sample {"SacModel", "Points", "Normals",
+                                                            "Distance", NULL};
+        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "sO!|Od", kwds_sample,
+                                        &sacModelType, &(Points::PointsPy::Type), &pts, &vec,
+                                        &distance))
             throw Py::Exception();
 
         Points::PointKernel* points = static_cast<Points::PointsPy*>(pts)->getPointKernelPtr();
@@ -958,6 +958,7 @@ Points.show(np)
 
         std::vector<float> parameters;
         SampleConsensus sample(sacModel, *points, normals);
+        sample.setDistanceThreshold(distance);
         std::vector<int> model;
         double probability = sample.perform(parameters, model);
 
@@ -974,7 +975,6 @@ Points.show(np)
 
         return dict;
     }
-#endif
 };
 
 PyObject* initModule()
@@ -22,25 +22,24 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
-#include <QFuture>
-#include <QFutureWatcher>
-#include <QtConcurrentMap>
+#include <algorithm>
+#include <thread>
 
 #include <Geom_BSplineSurface.hxx>
 #include <Precision.hxx>
-#include <math_Gauss.hxx>
-#include <math_Householder.hxx>
 #endif
 
+#include <Eigen/SparseCholesky>
+
 #include <Base/Sequencer.h>
 #include <Base/Tools.h>
 #include <Mod/Mesh/App/Core/Approximation.h>
+#include <Mod/Mesh/App/Core/Functional.h>
 
 #include "ApproxSurface.h"
 
 
 using namespace Reen;
-namespace sp = std::placeholders;
 
 // SplineBasisfunction
 
@@ -878,6 +877,8 @@ BSplineParameterCorrection::BSplineParameterCorrection(unsigned usUOrder,
     Init();
 }
 
+BSplineParameterCorrection::~BSplineParameterCorrection() = default;
+
 void BSplineParameterCorrection::Init()
 {
     // Initializations
@@ -963,15 +964,11 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
     int i = 0;
     double fMaxDiff = 0.0, fMaxScalar = 1.0;
     double fWeight = _fSmoothInfluence;
+    int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
 
-    Base::SequencerLauncher seq("Calc surface...",
-                                static_cast<size_t>(iIter)
-                                    * static_cast<size_t>(_pvcPoints->Length()));
+    Base::SequencerLauncher seq("Calc surface...", static_cast<size_t>(iIter));
 
     do {
-        fMaxScalar = 1.0;
-        fMaxDiff = 0.0;
-
         Handle(Geom_BSplineSurface) pclBSplineSurf = new Geom_BSplineSurface(_vCtrlPntsOfSurf,
                                                                              _vUKnots,
                                                                              _vVKnots,
@@ -980,51 +977,64 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
                                                                              _usUOrder - 1,
                                                                              _usVOrder - 1);
 
-        for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
-            double fDeltaU, fDeltaV, fU, fV;
-            const gp_Pnt& pnt = (*_pvcPoints)(ii);
-            gp_Vec P(pnt.X(), pnt.Y(), pnt.Z());
-            gp_Pnt PntX;
-            gp_Vec Xu, Xv, Xuv, Xuu, Xvv;
-            // Calculate the first two derivatives and point at (u,v)
-            gp_Pnt2d& uvValue = (*_pvcUVParam)(ii);
-            pclBSplineSurf->D2(uvValue.X(), uvValue.Y(), PntX, Xu, Xv, Xuu, Xvv, Xuv);
-            gp_Vec X(PntX.X(), PntX.Y(), PntX.Z());
-            gp_Vec ErrorVec = X - P;
-
-            // Calculate Xu x Xv the normal in X(u,v)
-            gp_Dir clNormal = Xu ^ Xv;
-
-            // Check, if X = P
-            if (!(X.IsEqual(P, 0.001, 0.001))) {
-                ErrorVec.Normalize();
-                if (fabs(clNormal * ErrorVec) < fMaxScalar) {
-                    fMaxScalar = fabs(clNormal * ErrorVec);
+        // Each point is corrected independently starting from its current (u,v) values
+        std::vector<double> maxDiffs(static_cast<std::size_t>(threads), 0.0);
+        std::vector<double> maxScalars(static_cast<std::size_t>(threads), 1.0);
+        auto correct = [&](std::size_t begin, std::size_t end, std::size_t block) {
+            double& fBlockDiff = maxDiffs[block];
+            double& fBlockScalar = maxScalars[block];
+            for (std::size_t index = begin; index < end; index++) {
+                int ii = _pvcPoints->Lower() + static_cast<int>(index);
+                double fDeltaU, fDeltaV, fU, fV;
+                const gp_Pnt& pnt = (*_pvcPoints)(ii);
+                gp_Vec P(pnt.X(), pnt.Y(), pnt.Z());
+                gp_Pnt PntX;
+                gp_Vec Xu, Xv, Xuv, Xuu, Xvv;
+                // Calculate the first two derivatives and point at (u,v)
+                gp_Pnt2d& uvValue = (*_pvcUVParam)(ii);
+                pclBSplineSurf->D2(uvValue.X(), uvValue.Y(), PntX, Xu, Xv, Xuu, Xvv, Xuv);
+                gp_Vec X(PntX.X(), PntX.Y(), PntX.Z());
+                gp_Vec ErrorVec = X - P;
+
+                // Calculate Xu x Xv the normal in X(u,v)
+                gp_Dir clNormal = Xu ^ Xv;
+
+                // Check, if X = P
+                if (!(X.IsEqual(P, 0.001, 0.001))) {
+                    ErrorVec.Normalize();
+                    if (fabs(clNormal * ErrorVec) < fBlockScalar) {
+                        fBlockScalar = fabs(clNormal * ErrorVec);
+                    }
                 }
-            }
 
-            fDeltaU = ((P - X) * Xu) / ((P - X) * Xuu - Xu * Xu);
-            if (fabs(fDeltaU) < Precision::Confusion()) {
-                fDeltaU = 0.0;
-            }
-            fDeltaV = ((P - X) * Xv) / ((P - X) * Xvv - Xv * Xv);
-            if (fabs(fDeltaV) < Precision::Confusion()) {
-                fDeltaV = 0.0;
-            }
+                fDeltaU = ((P - X) * Xu) / ((P - X) * Xuu - Xu * Xu);
+                if (fabs(fDeltaU) < Precision::Confusion()) {
+                    fDeltaU = 0.0;
+                }
+                fDeltaV = ((P - X) * Xv) / ((P - X) * Xvv - Xv * Xv);
+                if (fabs(fDeltaV) < Precision::Confusion()) {
+                    fDeltaV = 0.0;
+                }
 
-            // Replace old u/v values with new ones
-            fU = uvValue.X() - fDeltaU;
-            fV = uvValue.Y() - fDeltaV;
-            if (fU <= 1.0 && fU >= 0.0 && fV <= 1.0 && fV >= 0.0) {
-                uvValue.SetX(fU);
-                uvValue.SetY(fV);
-                fMaxDiff = std::max<double>(fabs(fDeltaU), fMaxDiff);
-                fMaxDiff = std::max<double>(fabs(fDeltaV), fMaxDiff);
+                // Replace old u/v values with new ones
+                fU = uvValue.X() - fDeltaU;
+                fV = uvValue.Y() - fDeltaV;
+                if (fU <= 1.0 && fU >= 0.0 && fV <= 1.0 && fV >= 0.0) {
+                    uvValue.SetX(fU);
+                    uvValue.SetY(fV);
+                    fBlockDiff = std::max<double>(fabs(fDeltaU), fBlockDiff);
+                    fBlockDiff = std::max<double>(fabs(fDeltaV), fBlockDiff);
+                }
             }
+        };
+        MeshCore::parallel_for(static_cast<std::size_t>(_pvcPoints->Length()), threads, correct);
 
-            seq.next();
-        }
+        fMaxDiff = *std::max_element(maxDiffs.begin(), maxDiffs.end());
+        fMaxScalar = *std::min_element(maxScalars.begin(), maxScalars.end());
+        seq.next();
 
+        // The normal equations keep the analysis of their sparsity pattern so that only the
+        // numeric factorization is redone
         if (_bSmoothing) {
             fWeight *= 0.5f;
             SolveWithSmoothing(fWeight);
@@ -1037,235 +1047,242 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
     } while (i < iIter && fMaxDiff > Precision::Confusion() && fMaxScalar < 0.99);
 }
 
-bool BSplineParameterCorrection::SolveWithoutSmoothing()
+namespace Reen
 {
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim = _usUCtrlpoints * _usVCtrlpoints;
-    math_Matrix M(0, ulSize - 1, 0, ulDim - 1);
-    math_Matrix Xx(0, ulDim - 1, 0, 0);
-    math_Matrix Xy(0, ulDim - 1, 0, 0);
-    math_Matrix Xz(0, ulDim - 1, 0, 0);
-    math_Vector bx(0, ulSize - 1);
-    math_Vector by(0, ulSize - 1);
-    math_Vector bz(0, ulSize - 1);
-
-    // Determining the coefficient matrix of the overdetermined LGS
-    for (unsigned i = 0; i < ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        unsigned ulIdx = 0;
-
-        // Pre-calculation of the values of the base functions
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j, fU);
-        }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k, fV);
-        }
-
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = 0.0;
-                    ulIdx++;
+/**
+ * Normal equations of the least-squares fit of a B-spline surface. Because of the local support
+ * of the basis functions a pole only couples with the poles whose indices differ by less than
+ * the order in both directions. So, each row of the lower triangle of the system matrix is
+ * stored as a small stencil that the points are accumulated into in parallel. The sparsity
+ * pattern only depends on the number of poles and the orders and thus its analysis for the
+ * sparse Cholesky factorization is kept for all further solves.
+ */
+class SparseNormalEquations
+{
+public:
+    SparseNormalEquations(int uPoles, int vPoles, int uOrder, int vOrder)
+        : uPoles(uPoles)
+        , vPoles(vPoles)
+        , uOrder(uOrder)
+        , vOrder(vOrder)
+        , stencilSize(uOrder * (2 * vOrder - 1))
+    {
+        std::size_t dim = static_cast<std::size_t>(uPoles) * static_cast<std::size_t>(vPoles);
+        std::vector<Eigen::Triplet<double>> triplets;
+        triplets.reserve(dim * static_cast<std::size_t>(stencilSize));
+        forEachEntry([&triplets](int row, int col, std::size_t) {
+            triplets.emplace_back(row, col, 0.0);
+        });
+
+        matrix.resize(static_cast<Eigen::Index>(dim), static_cast<Eigen::Index>(dim));
+        matrix.setFromTriplets(triplets.begin(), triplets.end());
+        matrix.makeCompressed();
+
+        positions.assign(dim * static_cast<std::size_t>(stencilSize), -1);
+        const double* values = matrix.valuePtr();
+        forEachEntry([&](int row, int col, std::size_t entry) {
+            positions[entry] = static_cast<int>(&matrix.coeffRef(row, col) - values);
+        });
+    }
+
+    /// Accumulates the products of the basis functions of all points
+    void assemble(const TColgp_Array1OfPnt& points,
+                  const TColgp_Array1OfPnt2d& params,
+                  BSplineBasis& uSpline,
+                  BSplineBasis& vSpline)
+    {
+        std::size_t dim = static_cast<std::size_t>(uPoles) * static_cast<std::size_t>(vPoles);
+        std::size_t entries = dim * static_cast<std::size_t>(stencilSize);
+        std::size_t numPoints = static_cast<std::size_t>(points.Length());
+        int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        std::vector<std::vector<double>> localStencils(static_cast<std::size_t>(threads));
+        std::vector<std::vector<Base::Vector3d>> localRhs(static_cast<std::size_t>(threads));
+
+        MeshCore::parallel_for(
+            numPoints,
+            threads,
+            [&](std::size_t begin, std::size_t end, std::size_t block) {
+                std::vector<double>& stencil = localStencils[block];
+                std::vector<Base::Vector3d>& rhs = localRhs[block];
+                stencil.assign(entries, 0.0);
+                rhs.assign(dim, Base::Vector3d());
+
+                TColStd_Array1OfReal uValues(0, uOrder - 1);
+                TColStd_Array1OfReal vValues(0, vOrder - 1);
+                std::vector<double> weights(static_cast<std::size_t>(uOrder * vOrder));
+                for (std::size_t index = begin; index < end; index++) {
+                    int ii = points.Lower() + static_cast<int>(index);
+                    const gp_Pnt2d& uv = params(ii);
+                    double fU = uv.X();
+                    double fV = uv.Y();
+                    // all basis functions vanish outside the domain
+                    if (fU < 0.0 || fU > 1.0 || fV < 0.0 || fV > 1.0) {
+                        continue;
+                    }
+
+                    int uFirst = uSpline.FindSpan(fU) - uOrder + 1;
+                    int vFirst = vSpline.FindSpan(fV) - vOrder + 1;
+                    uSpline.AllBasisFunctions(fU, uValues);
+                    vSpline.AllBasisFunctions(fV, vValues);
+                    for (int a = 0; a < uOrder; a++) {
+                        for (int b = 0; b < vOrder; b++) {
+                            weights[a * vOrder + b] = uValues(a) * vValues(b);
+                        }
+                    }
+
+                    const gp_Pnt& pnt = points(ii);
+                    Base::Vector3d pos(pnt.X(), pnt.Y(), pnt.Z());
+                    for (int a1 = 0; a1 < uOrder; a1++) {
+                        for (int b1 = 0; b1 < vOrder; b1++) {
+                            double w1 = weights[a1 * vOrder + b1];
+                            int row = (uFirst + a1) * vPoles + vFirst + b1;
+                            rhs[row] += w1 * pos;
+
+                            double* rowStencil = &stencil[static_cast<std::size_t>(row)
+                                                          * static_cast<std::size_t>(stencilSize)];
+                            for (int a2 = 0; a2 <= a1; a2++) {
+                                int b2End = a2 == a1 ? b1 + 1 : vOrder;
+                                for (int b2 = 0; b2 < b2End; b2++) {
+                                    rowStencil[slot(a1 - a2, b1 - b2)] +=
+                                        w1 * weights[a2 * vOrder + b2];
+                                }
+                            }
+                        }
+                    }
+                }
+            });
+
+        // sum up the contributions of the threads row by row
+        stencils.assign(entries, 0.0);
+        rhs.assign(dim, Base::Vector3d());
+        MeshCore::parallel_for(dim, threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+            std::size_t size = static_cast<std::size_t>(stencilSize);
+            for (const auto& local : localStencils) {
+                if (local.empty()) {
+                    continue;
+                }
+                for (std::size_t entry = begin * size; entry < end * size; entry++) {
+                    stencils[entry] += local[entry];
                 }
             }
-            else {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = valueU * basisV[k];
-                    ulIdx++;
+            for (const auto& local : localRhs) {
+                if (local.empty()) {
+                    continue;
+                }
+                for (std::size_t row = begin; row < end; row++) {
+                    rhs[row] += local[row];
                 }
             }
-        }
+        });
     }
 
-    // Determine the right side
-    for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X();
-        by(ii) = pnt.Y();
-        bz(ii) = pnt.Z();
-    }
-
-    // Solve the over-determined LGS with Householder-Transformation
-    math_Householder hhX(M, bx);
-    math_Householder hhY(M, by);
-    math_Householder hhZ(M, bz);
-
-    if (!(hhX.IsDone() && hhY.IsDone() && hhZ.IsDone())) {
-        // LGS could not be solved
-        return false;
-    }
-    Xx = hhX.AllValues();
-    Xy = hhY.AllValues();
-    Xz = hhZ.AllValues();
+    /// Solves the normal equations including the optional smoothing terms
+    bool solve(const math_Matrix* smoothing, double weight, TColgp_Array2OfPnt& poles)
+    {
+        double* values = matrix.valuePtr();
+        forEachEntry([&](int row, int col, std::size_t entry) {
+            double value = stencils[entry];
+            if (smoothing) {
+                value += weight * (*smoothing)(row, col);
+            }
+            values[positions[entry]] = value;
+        });
 
-    unsigned ulIdx = 0;
-    for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            _vCtrlPntsOfSurf(j, k) = gp_Pnt(Xx(ulIdx, 0), Xy(ulIdx, 0), Xz(ulIdx, 0));
-            ulIdx++;
+        if (!analyzed) {
+            solver.analyzePattern(matrix);
+            analyzed = true;
         }
-    }
-
-    return true;
-}
-
-namespace Reen
-{
-class ScalarProduct
-{
-public:
-    explicit ScalarProduct(const math_Matrix& mat)
-        : mat(mat)
-    {}
-    std::vector<double> multiply(int col) const
-    {
-        math_Vector vec = mat.Col(col);
-        std::vector<double> out(mat.ColNumber());
-        for (int n = mat.LowerCol(); n <= mat.UpperCol(); n++) {
-            out[n] = vec * mat.Col(n);
+        solver.factorize(matrix);
+        if (solver.info() != Eigen::Success) {
+            return false;
         }
-        return out;
-    }
 
-private:
-    const math_Matrix& mat;
-};
-}  // namespace Reen
-
-bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
-{
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim = _usUCtrlpoints * _usVCtrlpoints;
-    math_Matrix M(0, ulSize - 1, 0, ulDim - 1);
-    math_Vector Xx(0, ulDim - 1);
-    math_Vector Xy(0, ulDim - 1);
-    math_Vector Xz(0, ulDim - 1);
-    math_Vector bx(0, ulSize - 1);
-    math_Vector by(0, ulSize - 1);
-    math_Vector bz(0, ulSize - 1);
-    math_Vector Mbx(0, ulDim - 1);
-    math_Vector Mby(0, ulDim - 1);
-    math_Vector Mbz(0, ulDim - 1);
-
-    // Determining the coefficient matrix of the overdetermined LGS
-    for (unsigned i = 0; i < ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        int ulIdx = 0;
-
-        // Pre-calculation of the values of the basis functions
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j, fU);
+        Eigen::MatrixXd b(matrix.rows(), 3);
+        for (Eigen::Index row = 0; row < b.rows(); row++) {
+            const Base::Vector3d& value = rhs[static_cast<std::size_t>(row)];
+            b.row(row) << value.x, value.y, value.z;
         }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k, fV);
+        Eigen::MatrixXd x = solver.solve(b);
+        if (solver.info() != Eigen::Success || !x.allFinite()) {
+            return false;
         }
 
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = 0.0;
-                    ulIdx++;
-                }
-            }
-            else {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = valueU * basisV[k];
-                    ulIdx++;
-                }
+        Eigen::Index index = 0;
+        for (int j = 0; j < uPoles; j++) {
+            for (int k = 0; k < vPoles; k++) {
+                poles(j, k) = gp_Pnt(x(index, 0), x(index, 1), x(index, 2));
+                index++;
             }
         }
-    }
 
-    // The product of its transform and itself results in the quadratic
-    // system matrix (slowly)
-#if 0
-    math_Matrix MTM = M.TMultiply(M);
-#elif 0
-    math_Matrix MTM(0, ulDim - 1, 0, ulDim - 1);
-    for (unsigned m = 0; m < ulDim; m++) {
-        math_Vector Mm = M.Col(m);
-        for (unsigned n = m; n < ulDim; n++) {
-            MTM(m, n) = MTM(n, m) = Mm * M.Col(n);
-        }
-    }
-#else  // multi-threaded
-    std::vector<int> columns(ulDim);
-    std::generate(columns.begin(), columns.end(), Base::iotaGen<int>(0));
-    ScalarProduct scalar(M);
-    // NOLINTBEGIN
-    QFuture<std::vector<double>> future =
-        QtConcurrent::mapped(columns, std::bind(&ScalarProduct::multiply, &scalar, sp::_1));
-    // NOLINTEND
-    QFutureWatcher<std::vector<double>> watcher;
-    watcher.setFuture(future);
-    watcher.waitForFinished();
-
-    math_Matrix MTM(0, ulDim - 1, 0, ulDim - 1);
-    int rowIndex = 0;
-    for (const auto& it : future) {
-        int colIndex = 0;
-        for (std::vector<double>::const_iterator jt = it.begin(); jt != it.end();
-             ++jt, colIndex++) {
-            MTM(rowIndex, colIndex) = *jt;
-        }
-        rowIndex++;
+        return true;
     }
-#endif
 
-    // Determine the right side
-    for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X();
-        by(ii) = pnt.Y();
-        bz(ii) = pnt.Z();
-    }
-    for (unsigned i = 0; i < ulDim; i++) {
-        math_Vector Mi = M.Col(i);
-        Mbx(i) = Mi * bx;
-        Mby(i) = Mi * by;
-        Mbz(i) = Mi * bz;
+private:
+    /// Stencil entry of the pole that is du rows and dv columns before the current pole
+    int slot(int du, int dv) const
+    {
+        return du * (2 * vOrder - 1) + dv + vOrder - 1;
     }
 
-    // Solve the LGS with the LU decomposition
-    math_Gauss mgGaussX(MTM + fWeight * _clSmoothMatrix);
-    math_Gauss mgGaussY(MTM + fWeight * _clSmoothMatrix);
-    math_Gauss mgGaussZ(MTM + fWeight * _clSmoothMatrix);
-
-    mgGaussX.Solve(Mbx, Xx);
-    if (!mgGaussX.IsDone()) {
-        return false;
+    /// Calls func for all structural non-zeros of the lower triangle
+    template<typename Func>
+    void forEachEntry(Func&& func) const
+    {
+        for (int j = 0; j < uPoles; j++) {
+            for (int k = 0; k < vPoles; k++) {
+                int row = j * vPoles + k;
+                std::size_t base =
+                    static_cast<std::size_t>(row) * static_cast<std::size_t>(stencilSize);
+                for (int du = 0; du < uOrder && du <= j; du++) {
+                    for (int dv = du == 0 ? 0 : 1 - vOrder; dv < vOrder; dv++) {
+                        int l = k - dv;
+                        if (l >= 0 && l < vPoles) {
+                            int col = (j - du) * vPoles + l;
+                            func(row, col, base + static_cast<std::size_t>(slot(du, dv)));
+                        }
+                    }
+                }
+            }
+        }
     }
 
-    mgGaussY.Solve(Mby, Xy);
-    if (!mgGaussY.IsDone()) {
-        return false;
-    }
+    int uPoles;
+    int vPoles;
+    int uOrder;
+    int vOrder;
+    int stencilSize;
+    std::vector<double> stencils;
+    std::vector<Base::Vector3d> rhs;
+    std::vector<int> positions;
+    Eigen::SparseMatrix<double> matrix;
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver;
+    bool analyzed {false};
+};
+}  // namespace Reen
 
-    mgGaussZ.Solve(Mbz, Xz);
-    if (!mgGaussZ.IsDone()) {
-        return false;
-    }
+bool BSplineParameterCorrection::SolveWithoutSmoothing()
+{
+    return SolveNormalEquations(nullptr, 0.0);
+}
 
-    unsigned ulIdx = 0;
-    for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            _vCtrlPntsOfSurf(j, k) = gp_Pnt(Xx(ulIdx), Xy(ulIdx), Xz(ulIdx));
-            ulIdx++;
-        }
+bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
+{
+    return SolveNormalEquations(&_clSmoothMatrix, fWeight);
+}
+
+bool BSplineParameterCorrection::SolveNormalEquations(const math_Matrix* pclSmooth, double fWeight)
+{
+    if (!_pclNormalEquations) {
+        _pclNormalEquations = std::make_unique<SparseNormalEquations>(
+            static_cast<int>(_usUCtrlpoints),
+            static_cast<int>(_usVCtrlpoints),
+            static_cast<int>(_usUOrder),
+            static_cast<int>(_usVOrder));
     }
 
-    return true;
+    _pclNormalEquations->assemble(*_pvcPoints, *_pvcUVParam, _clUSpline, _clVSpline);
+    return _pclNormalEquations->solve(pclSmooth, fWeight, _vCtrlPntsOfSurf);
 }
 
 void BSplineParameterCorrection::CalcSmoothingTerms(bool bRecalc,
@@ -1287,6 +1304,16 @@ void BSplineParameterCorrection::CalcSmoothingTerms(bool bRecalc,
     _clSmoothMatrix = fFirst * _clFirstMatrix + fSecond * _clSecondMatrix + fThird * _clThirdMatrix;
 }
 
+bool BSplineParameterCorrection::SupportsOverlap(unsigned i,
+                                                 unsigned k,
+                                                 unsigned j,
+                                                 unsigned l) const
+{
+    unsigned du = i > k ? i - k : k - i;
+    unsigned dv = j > l ? j - l : l - j;
+    return du < _usUOrder && dv < _usVOrder;
+}
+
 void BSplineParameterCorrection::CalcFirstSmoothMatrix(Base::SequencerLauncher& seq)
 {
     unsigned m = 0;
@@ -1296,6 +1323,12 @@ void BSplineParameterCorrection::CalcFirstSmoothMatrix(Base::SequencerLauncher&
 
             for (unsigned i = 0; i < _usUCtrlpoints; i++) {
                 for (unsigned j = 0; j < _usVCtrlpoints; j++) {
+                    if (!SupportsOverlap(i, k, j, l)) {
+                        _clFirstMatrix(m, n) = 0.0;
+                        seq.next();
+                        n++;
+                        continue;
+                    }
                     _clFirstMatrix(m, n) = _clUSpline.GetIntegralOfProductOfBSplines(i, k, 1, 1)
                             * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 0, 0)
                         + _clUSpline.GetIntegralOfProductOfBSplines(i, k, 0, 0)
@@ -1318,6 +1351,12 @@ void BSplineParameterCorrection::CalcSecondSmoothMatrix(Base::SequencerLauncher&
 
             for (unsigned i = 0; i < _usUCtrlpoints; i++) {
                 for (unsigned j = 0; j < _usVCtrlpoints; j++) {
+                    if (!SupportsOverlap(i, k, j, l)) {
+                        _clSecondMatrix(m, n) = 0.0;
+                        seq.next();
+                        n++;
+                        continue;
+                    }
                     _clSecondMatrix(m, n) = _clUSpline.GetIntegralOfProductOfBSplines(i, k, 2, 2)
                             * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 0, 0)
                         + 2 * _clUSpline.GetIntegralOfProductOfBSplines(i, k, 1, 1)
@@ -1342,6 +1381,12 @@ void BSplineParameterCorrection::CalcThirdSmoothMatrix(Base::SequencerLauncher&
 
             for (unsigned i = 0; i < _usUCtrlpoints; i++) {
                 for (unsigned j = 0; j < _usVCtrlpoints; j++) {
+                    if (!SupportsOverlap(i, k, j, l)) {
+                        _clThirdMatrix(m, n) = 0.0;
+                        seq.next();
+                        n++;
+                        continue;
+                    }
                     _clThirdMatrix(m, n) = _clUSpline.GetIntegralOfProductOfBSplines(i, k, 3, 3)
                             * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 0, 0)
                         + _clUSpline.GetIntegralOfProductOfBSplines(i, k, 3, 1)
@@ -23,6 +23,8 @@
 #ifndef REEN_APPROXSURFACE_H
 #define REEN_APPROXSURFACE_H
 
+#include <memory>
+
 #include <Geom_BSplineSurface.hxx>
 #include <TColStd_Array1OfInteger.hxx>
 #include <TColStd_Array1OfReal.hxx>
@@ -372,12 +374,16 @@ protected:
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
+class SparseNormalEquations;
+
 /**
  * This class calculates a B-spline area on any point cloud (AKA scattered data).
  * The surface is generated iteratively with the help of a parameter correction.
  * See Hoschek/Lasser 2nd ed. (1992).
  * The approximation is expanded to include smoothing terms so that smooth surfaces
  * can be generated.
+ * The control points are computed from sparse normal equations that are assembled in
+ * parallel over the points and solved with a sparse Cholesky factorization.
  */
 
 class ReenExport BSplineParameterCorrection: public ParameterCorrection
@@ -390,7 +396,7 @@ public:
         unsigned usUCtrlpoints = 6,   // Qty. of the control points in u-direction
         unsigned usVCtrlpoints = 6);  // Qty. of the control points in v-direction
 
-    ~BSplineParameterCorrection() override = default;
+    ~BSplineParameterCorrection() override;
 
 protected:
     /**
@@ -404,16 +410,22 @@ protected:
     void DoParameterCorrection(int iIter) override;
 
     /**
-     * Solve an overdetermined LGS with the help of the Householder-Tansformation
+     * Solve the overdetermined LGS in the least-squares sense
      */
     bool SolveWithoutSmoothing() override;
 
     /**
-     * Solve a regular system of equations by LU decomposition. Depending on the weighting,
+     * Solve the overdetermined LGS in the least-squares sense. Depending on the weighting,
      * smoothing terms are included
      */
     bool SolveWithSmoothing(double fWeight) override;
 
+    /**
+     * Assembles and solves the normal equations with the weighted smoothing terms if
+     * @a pclSmooth is not null
+     */
+    bool SolveNormalEquations(const math_Matrix* pclSmooth, double fWeight);
+
 public:
     /**
      * Setting the knot vector
@@ -490,6 +502,12 @@ protected:
      */
     virtual void CalcThirdSmoothMatrix(Base::SequencerLauncher&);
 
+    /**
+     * Checks whether the supports of the basis functions of the poles (i,j) and (k,l) overlap.
+     * Otherwise the integrals of the smoothing terms vanish.
+     */
+    bool SupportsOverlap(unsigned i, unsigned k, unsigned j, unsigned l) const;
+
 protected:
     BSplineBasis _clUSpline;      //! B-spline basic function in the u-direction
     BSplineBasis _clVSpline;      //! B-spline basic function in the v-direction
@@ -497,6 +515,7 @@ protected:
     math_Matrix _clFirstMatrix;   //! Matrix of the 1st smoothing functionals
     math_Matrix _clSecondMatrix;  //! Matrix of the 2nd smoothing functionals
     math_Matrix _clThirdMatrix;   //! Matrix of the 3rd smoothing functionals
+    std::unique_ptr<SparseNormalEquations> _pclNormalEquations;  //! Sparse normal equations
 };
 
 }  // namespace Reen
@@ -41,7 +41,9 @@
 #ifdef _PreComp_
 
 // standard
+#include <algorithm>
 #include <map>
+#include <thread>
 
 // boost
 #include <boost/math/special_functions/fpclassify.hpp>
@@ -50,13 +52,6 @@
 #include <Geom_BSplineSurface.hxx>
 #include <Precision.hxx>
 #include <TColgp_Array1OfPnt.hxx>
-#include <math_Gauss.hxx>
-#include <math_Householder.hxx>
-
-// Qt
-#include <QFuture>
-#include <QFutureWatcher>
-#include <QtConcurrentMap>
 
 #endif  // _PreComp_
 #endif
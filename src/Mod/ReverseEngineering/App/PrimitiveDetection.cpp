@@ -0,0 +1,620 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <numbers>
+#include <numeric>
+#include <random>
+#include <thread>
+#endif
+
+#include <Eigen/Eigenvalues>
+
+#include <Base/Exception.h>
+#include <Mod/Mesh/App/Core/Approximation.h>
+#include <Mod/Mesh/App/Core/CylinderFit.h>
+#include <Mod/Mesh/App/Core/Functional.h>
+#include <Mod/Mesh/App/Core/KDTree.h>
+#include <Mod/Mesh/App/Core/SphereFit.h>
+
+#include "PrimitiveDetection.h"
+
+
+using namespace Reen;
+
+// ----------------------------------------------------------------------------
+
+void NeighbourGraph::build(const std::vector<Base::Vector3f>& points, int k, int threads)
+{
+    offsets.clear();
+    indices.clear();
+    offsets.reserve(points.size() + 1);
+    offsets.push_back(0);
+    if (points.empty() || k < 1) {
+        offsets.resize(points.size() + 1, 0);
+        return;
+    }
+
+    // the search also returns the point itself
+    std::size_t rowSize = static_cast<std::size_t>(k) + 1;
+    std::vector<MeshCore::PointIndex> found;
+    MeshCore::MeshKDTree tree(points);
+    tree.FindKNearest(std::span<const Base::Vector3f>(points), rowSize, found, threads);
+
+    indices.reserve(points.size() * static_cast<std::size_t>(k));
+    for (std::size_t i = 0; i < points.size(); i++) {
+        std::size_t count = 0;
+        for (std::size_t j = i * rowSize; j < (i + 1) * rowSize; j++) {
+            MeshCore::PointIndex index = found[j];
+            if (index != MeshCore::POINT_INDEX_MAX && index != i
+                && count < static_cast<std::size_t>(k)) {
+                indices.push_back(static_cast<std::uint32_t>(index));
+                count++;
+            }
+        }
+        offsets.push_back(indices.size());
+    }
+}
+
+std::size_t NeighbourGraph::size() const
+{
+    return offsets.empty() ? 0 : offsets.size() - 1;
+}
+
+std::span<const std::uint32_t> NeighbourGraph::neighbours(std::size_t index) const
+{
+    return {indices.data() + offsets[index], offsets[index + 1] - offsets[index]};
+}
+
+void NeighbourGraph::estimateNormals(const std::vector<Base::Vector3f>& points,
+                                     std::vector<Base::Vector3f>& normals,
+                                     std::vector<float>& curvatures,
+                                     int threads) const
+{
+    if (points.size() != size()) {
+        throw Base::RuntimeError("Number of points does not match with the neighbour graph");
+    }
+
+    normals.assign(points.size(), Base::Vector3f());
+    curvatures.assign(points.size(), 1.0F);
+    auto estimate = [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; i++) {
+            std::span<const std::uint32_t> ring = neighbours(i);
+            if (ring.size() < 2) {
+                continue;
+            }
+
+            Eigen::Vector3d mean = Eigen::Vector3d::Zero();
+            auto toEigen = [&points](std::size_t index) {
+                const Base::Vector3f& p = points[index];
+                return Eigen::Vector3d(p.x, p.y, p.z);
+            };
+            mean += toEigen(i);
+            for (std::uint32_t index : ring) {
+                mean += toEigen(index);
+            }
+            mean /= static_cast<double>(ring.size() + 1);
+
+            Eigen::Vector3d diff = toEigen(i) - mean;
+            Eigen::Matrix3d covariance = diff * diff.transpose();
+            for (std::uint32_t index : ring) {
+                diff = toEigen(index) - mean;
+                covariance += diff * diff.transpose();
+            }
+
+            Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(covariance);
+            const Eigen::Vector3d& values = solver.eigenvalues();
+            Eigen::Vector3d normal = solver.eigenvectors().col(0);
+            double sum = values.sum();
+
+            Base::Vector3f n(float(normal.x()), float(normal.y()), float(normal.z()));
+            if (n * points[i] > 0.0F) {
+                n = -n;
+            }
+            normals[i] = n;
+            curvatures[i] = sum > 0.0 ? float(std::max(values[0], 0.0) / sum) : 0.0F;
+        }
+    };
+    MeshCore::parallel_for(points.size(), threads, estimate);
+}
+
+// ----------------------------------------------------------------------------
+
+RegionGrower::RegionGrower(const Parameters& params)
+    : params(params)
+{}
+
+std::list<std::vector<int>> RegionGrower::perform(const NeighbourGraph& graph,
+                                                  const std::vector<Base::Vector3f>& normals,
+                                                  const std::vector<float>& curvatures) const
+{
+    std::size_t numPoints = graph.size();
+    if (normals.size() != numPoints || curvatures.size() != numPoints) {
+        throw Base::RuntimeError("Number of points does not match with number of normals");
+    }
+
+    // seeds are processed in the order of increasing curvature
+    std::vector<std::uint32_t> order(numPoints);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&curvatures](std::uint32_t a, std::uint32_t b) {
+        return curvatures[a] < curvatures[b];
+    });
+
+    float minCosine = std::cos(params.smoothness);
+    std::vector<bool> assigned(numPoints, false);
+    std::vector<std::uint32_t> seeds;
+    std::list<std::vector<int>> clusters;
+    for (std::uint32_t start : order) {
+        if (assigned[start]) {
+            continue;
+        }
+
+        std::vector<int> region;
+        region.push_back(static_cast<int>(start));
+        assigned[start] = true;
+        seeds.clear();
+        seeds.push_back(start);
+        for (std::size_t head = 0; head < seeds.size(); head++) {
+            std::uint32_t current = seeds[head];
+            const Base::Vector3f& normal = normals[current];
+            for (std::uint32_t index : graph.neighbours(current)) {
+                if (assigned[index] || std::fabs(normal * normals[index]) < minCosine) {
+                    continue;
+                }
+
+                assigned[index] = true;
+                region.push_back(static_cast<int>(index));
+                if (curvatures[index] < params.curvature) {
+                    seeds.push_back(index);
+                }
+            }
+        }
+
+        if (region.size() >= params.minClusterSize && region.size() <= params.maxClusterSize) {
+            std::sort(region.begin(), region.end());
+            clusters.push_back(std::move(region));
+        }
+    }
+
+    return clusters;
+}
+
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+using Primitive = PrimitiveDetector::Primitive;
+
+/// Primitive defined by a point (plane base, sphere center, point on axis, apex), a
+/// direction (plane normal or axis) and a value (radius or opening angle)
+struct Model
+{
+    Base::Vector3f base;
+    Base::Vector3f axis;
+    float value {};
+};
+
+std::size_t sampleSize(Primitive type)
+{
+    switch (type) {
+        case Primitive::Plane:
+            return 3;
+        case Primitive::Sphere:
+            return 4;
+        case Primitive::Cylinder:
+            return 2;
+        case Primitive::Cone:
+            return 3;
+    }
+    return 0;
+}
+
+class ModelEstimator
+{
+public:
+    ModelEstimator(Primitive type,
+                   const PrimitiveDetector::Parameters& params,
+                   const std::vector<Base::Vector3f>& points,
+                   const std::vector<Base::Vector3f>& normals)
+        : type(type)
+        , distance(params.distance)
+        , minCosine(std::cos(params.normalAngle))
+        , points(points)
+        , normals(normals)
+    {}
+
+    bool compute(const std::array<std::size_t, 4>& sample, Model& model) const
+    {
+        switch (type) {
+            case Primitive::Plane:
+                return computePlane(sample, model);
+            case Primitive::Sphere:
+                return computeSphere(sample, model);
+            case Primitive::Cylinder:
+                return computeCylinder(sample, model);
+            case Primitive::Cone:
+                return computeCone(sample, model);
+        }
+        return false;
+    }
+
+    bool isInlier(const Model& model, std::size_t index) const
+    {
+        const Base::Vector3f& p = points[index];
+        switch (type) {
+            case Primitive::Plane:
+                return std::fabs((p - model.base) * model.axis) <= distance;
+            case Primitive::Sphere:
+                return std::fabs(Base::Distance(p, model.base) - model.value) <= distance;
+            case Primitive::Cylinder: {
+                Base::Vector3f v = p - model.base;
+                Base::Vector3f radial = v - model.axis * (v * model.axis);
+                float length = radial.Length();
+                if (std::fabs(length - model.value) > distance || length <= 0.0F) {
+                    return false;
+                }
+                return std::fabs(normals[index] * radial) >= minCosine * length;
+            }
+            case Primitive::Cone: {
+                Base::Vector3f v = p - model.base;
+                float height = v * model.axis;
+                Base::Vector3f radial = v - model.axis * height;
+                float length = radial.Length();
+                float cosAngle = std::cos(model.value);
+                float sinAngle = std::sin(model.value);
+                float dist = height * cosAngle + length * sinAngle < 0.0F
+                    ? v.Length()
+                    : std::fabs(length * cosAngle - height * sinAngle);
+                if (dist > distance || length <= 0.0F) {
+                    return false;
+                }
+                Base::Vector3f normal = radial * (cosAngle / length) - model.axis * sinAngle;
+                return std::fabs(normals[index] * normal) >= minCosine;
+            }
+        }
+        return false;
+    }
+
+    std::vector<int> inliers(const Model& model) const
+    {
+        std::vector<int> result;
+        for (std::size_t i = 0; i < points.size(); i++) {
+            if (isInlier(model, i)) {
+                result.push_back(static_cast<int>(i));
+            }
+        }
+        return result;
+    }
+
+private:
+    bool computePlane(const std::array<std::size_t, 4>& sample, Model& model) const
+    {
+        const Base::Vector3f& p1 = points[sample[0]];
+        Base::Vector3f normal = (points[sample[1]] - p1) % (points[sample[2]] - p1);
+        if (normal.Length() <= std::numeric_limits<float>::epsilon()) {
+            return false;
+        }
+        model.base = p1;
+        model.axis = normal.Normalize();
+        return true;
+    }
+
+    bool computeSphere(const std::array<std::size_t, 4>& sample, Model& model) const
+    {
+        // 2 * (pi - p0) * c = pi^2 - p0^2
+        Base::Vector3d p0 = Base::toVector<double>(points[sample[0]]);
+        Eigen::Matrix3d a;
+        Eigen::Vector3d b;
+        for (int i = 0; i < 3; i++) {
+            Base::Vector3d pi = Base::toVector<double>(points[sample[i + 1]]);
+            Base::Vector3d d = pi - p0;
+            a.row(i) << 2.0 * d.x, 2.0 * d.y, 2.0 * d.z;
+            b[i] = pi.Sqr() - p0.Sqr();
+        }
+        if (std::fabs(a.determinant()) <= 1e-12) {
+            return false;
+        }
+        Eigen::Vector3d center = a.partialPivLu().solve(b);
+        model.base.Set(float(center.x()), float(center.y()), float(center.z()));
+        model.value = Base::Distance(model.base, points[sample[0]]);
+        return true;
+    }
+
+    bool computeCylinder(const std::array<std::size_t, 4>& sample, Model& model) const
+    {
+        // the lines through the points along their normals intersect the axis
+        const Base::Vector3f& p1 = points[sample[0]];
+        const Base::Vector3f& p2 = points[sample[1]];
+        const Base::Vector3f& n1 = normals[sample[0]];
+        const Base::Vector3f& n2 = normals[sample[1]];
+        Base::Vector3f axis = n1 % n2;
+        if (axis.Length() <= 1e-4F) {
+            return false;
+        }
+
+        Base::Vector3f w = p1 - p2;
+        float a = n1 * n1;
+        float b = n1 * n2;
+        float c = n2 * n2;
+        float d = n1 * w;
+        float e = n2 * w;
+        float denom = a * c - b * b;
+        if (denom <= std::numeric_limits<float>::epsilon()) {
+            return false;
+        }
+
+        model.axis = axis.Normalize();
+        model.base = p1 + n1 * ((b * e - c * d) / denom);
+        Base::Vector3f v = p1 - model.base;
+        model.value = (v - model.axis * (v * model.axis)).Length();
+        return model.value > 0.0F;
+    }
+
+    bool computeCone(const std::array<std::size_t, 4>& sample, Model& model) const
+    {
+        // the apex is the intersection of the three tangent planes
+        Eigen::Matrix3d a;
+        Eigen::Vector3d b;
+        for (int i = 0; i < 3; i++) {
+            const Base::Vector3f& p = points[sample[i]];
+            const Base::Vector3f& n = normals[sample[i]];
+            a.row(i) << n.x, n.y, n.z;
+            b[i] = double(n * p);
+        }
+        if (std::fabs(a.determinant()) <= 1e-8) {
+            return false;
+        }
+        Eigen::Vector3d apex = a.partialPivLu().solve(b);
+        model.base.Set(float(apex.x()), float(apex.y()), float(apex.z()));
+
+        std::array<Base::Vector3f, 3> dirs;
+        for (std::size_t i = 0; i < 3; i++) {
+            dirs[i] = points[sample[i]] - model.base;
+            if (dirs[i].Length() <= std::numeric_limits<float>::epsilon()) {
+                return false;
+            }
+            dirs[i].Normalize();
+        }
+
+        Base::Vector3f axis = (dirs[1] - dirs[0]) % (dirs[2] - dirs[0]);
+        if (axis.Length() <= std::numeric_limits<float>::epsilon()) {
+            return false;
+        }
+        axis.Normalize();
+        if (axis * dirs[0] < 0.0F) {
+            axis = -axis;
+        }
+
+        float angle = 0.0F;
+        for (const auto& dir : dirs) {
+            angle += std::acos(std::clamp(dir * axis, -1.0F, 1.0F));
+        }
+        model.axis = axis;
+        model.value = angle / 3.0F;
+        return model.value > 0.0F && model.value < std::numbers::pi_v<float> / 2.0F;
+    }
+
+    Primitive type;
+    float distance;
+    float minCosine;
+    const std::vector<Base::Vector3f>& points;
+    const std::vector<Base::Vector3f>& normals;
+};
+
+/// Refines the model by a least-squares fit of its inliers
+bool refineModel(Primitive type, const std::vector<Base::Vector3f>& points, Model& model)
+{
+    switch (type) {
+        case Primitive::Plane: {
+            MeshCore::PlaneFit fit;
+            fit.AddPoints(points);
+            if (fit.Fit() >= std::numeric_limits<float>::max()) {
+                return false;
+            }
+            Base::Vector3f normal = fit.GetNormal();
+            model.base = fit.GetBase();
+            model.axis = normal * model.axis < 0.0F ? -normal : normal;
+            return true;
+        }
+        case Primitive::Sphere: {
+            MeshCoreFit::SphereFit fit;
+            fit.AddPoints(points);
+            fit.SetApproximations(model.value, Base::toVector<double>(model.base));
+            if (fit.Fit() >= std::numeric_limits<float>::max()) {
+                return false;
+            }
+            model.base = Base::toVector<float>(fit.GetCenter());
+            model.value = float(fit.GetRadius());
+            return true;
+        }
+        case Primitive::Cylinder: {
+            MeshCoreFit::CylinderFit fit;
+            fit.AddPoints(points);
+            fit.SetApproximations(model.value,
+                                  Base::toVector<double>(model.base),
+                                  Base::toVector<double>(model.axis));
+            if (fit.Fit() >= std::numeric_limits<float>::max()) {
+                return false;
+            }
+            Base::Vector3f axis = Base::toVector<float>(fit.GetAxis());
+            model.base = Base::toVector<float>(fit.GetBase());
+            model.axis = axis * model.axis < 0.0F ? -axis : axis;
+            model.value = float(fit.GetRadius());
+            return true;
+        }
+        case Primitive::Cone:
+            // there is no least-squares cone fit
+            return false;
+    }
+    return false;
+}
+
+}  // namespace
+
+PrimitiveDetector::PrimitiveDetector(Primitive type, const Parameters& params)
+    : type(type)
+    , params(params)
+{}
+
+bool PrimitiveDetector::needsNormals(Primitive type)
+{
+    return type == Primitive::Cylinder || type == Primitive::Cone;
+}
+
+bool PrimitiveDetector::perform(const std::vector<Base::Vector3f>& points,
+                                const std::vector<Base::Vector3f>& normals,
+                                std::vector<float>& parameters,
+                                std::vector<int>& inliers,
+                                double* probability) const
+{
+    if (needsNormals(type) && normals.size() != points.size()) {
+        throw Base::RuntimeError("Number of points does not match with number of normals");
+    }
+
+    std::size_t numPoints = points.size();
+    std::size_t numSamples = sampleSize(type);
+    if (numPoints < numSamples) {
+        return false;
+    }
+
+    // a hypothesis is scored in a random order of the points so that the number of inliers
+    // found so far is a fair estimate for the final count
+    std::vector<std::uint32_t> order(numPoints);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(static_cast<unsigned>(numPoints)));
+
+    ModelEstimator estimator(type, params, points, normals);
+    std::atomic<std::size_t> bestCount {0};
+    std::atomic<std::size_t> iterations {0};
+    std::atomic<std::size_t> maxIterations {params.maxIterations};
+    std::atomic<std::size_t> samples {0};
+    std::mutex mutex;
+    Model bestModel;
+
+    auto requiredIterations = [&](std::size_t count) {
+        double ratio = std::pow(double(count) / double(numPoints), double(numSamples));
+        double failure = std::log(1.0 - ratio);
+        if (failure >= 0.0 || ratio >= 1.0) {
+            return std::size_t(1);
+        }
+        double value = std::ceil(std::log(1.0 - params.probability) / failure);
+        return value < double(params.maxIterations) ? std::size_t(value) : params.maxIterations;
+    };
+
+    int threads = params.threads;
+    if (threads < 1) {
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    auto search = [&](std::size_t, std::size_t, std::size_t block) {
+        std::mt19937 rng(static_cast<unsigned>(block + 1));
+        std::uniform_int_distribution<std::size_t> random(0, numPoints - 1);
+        std::array<std::size_t, 4> sample {};
+        Model model;
+        while (iterations.fetch_add(1) < maxIterations.load()) {
+            samples++;
+            for (std::size_t i = 0; i < numSamples; i++) {
+                do {
+                    sample[i] = random(rng);
+                } while (std::find(sample.begin(), sample.begin() + i, sample[i])
+                         != sample.begin() + i);
+            }
+            if (!estimator.compute(sample, model)) {
+                continue;
+            }
+
+            // stop scoring as soon as the hypothesis cannot beat the best one
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < numPoints; i++) {
+                if (estimator.isInlier(model, order[i])) {
+                    count++;
+                }
+                else if (count + numPoints - i - 1
+                         <= bestCount.load(std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+
+            if (count > bestCount.load()) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (count > bestCount.load()) {
+                    bestCount = count;
+                    bestModel = model;
+                    maxIterations = requiredIterations(count);
+                }
+            }
+        }
+    };
+    MeshCore::parallel_for(std::size_t(threads), threads, search);
+
+    if (bestCount.load() < numSamples) {
+        return false;
+    }
+
+    inliers = estimator.inliers(bestModel);
+    std::vector<Base::Vector3f> inlierPoints;
+    inlierPoints.reserve(inliers.size());
+    for (int index : inliers) {
+        inlierPoints.push_back(points[index]);
+    }
+
+    Model refined = bestModel;
+    if (refineModel(type, inlierPoints, refined)) {
+        std::vector<int> refinedInliers = estimator.inliers(refined);
+        if (refinedInliers.size() >= inliers.size()) {
+            inliers.swap(refinedInliers);
+            bestModel = refined;
+        }
+    }
+
+    if (probability) {
+        double ratio = std::pow(double(inliers.size()) / double(numPoints), double(numSamples));
+        *probability = 1.0 - std::pow(1.0 - std::min(ratio, 1.0), double(samples.load()));
+    }
+
+    const Base::Vector3f& base = bestModel.base;
+    const Base::Vector3f& axis = bestModel.axis;
+    parameters.clear();
+    switch (type) {
+        case Primitive::Plane:
+            parameters = {axis.x, axis.y, axis.z, -(axis * base)};
+            break;
+        case Primitive::Sphere:
+            parameters = {base.x, base.y, base.z, bestModel.value};
+            break;
+        case Primitive::Cylinder:
+        case Primitive::Cone:
+            parameters = {base.x, base.y, base.z, axis.x, axis.y, axis.z, bestModel.value};
+            break;
+    }
+
+    return true;
+}
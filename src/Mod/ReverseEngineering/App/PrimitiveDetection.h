@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef REEN_PRIMITIVEDETECTION_H
+#define REEN_PRIMITIVEDETECTION_H
+
+#include <cstdint>
+#include <list>
+#include <span>
+#include <vector>
+
+#include <Base/Vector3D.h>
+#include <Mod/ReverseEngineering/ReverseEngineeringGlobal.h>
+
+
+namespace Reen
+{
+
+/**
+ * The NeighbourGraph class holds the k nearest neighbours of every point of a point cloud
+ * in compressed sparse row layout: the neighbours of point i, sorted by increasing distance
+ * and without the point itself, are stored in one contiguous block.
+ */
+class ReenExport NeighbourGraph
+{
+public:
+    /// Computes the \a k nearest neighbours of all \a points with a parallel k-NN search
+    void build(const std::vector<Base::Vector3f>& points, int k, int threads = 0);
+    std::size_t size() const;
+    std::span<const std::uint32_t> neighbours(std::size_t index) const;
+    /** Estimates the normals by a principal component analysis of each point and its
+     * neighbours. The normals are oriented towards the origin and \a curvatures is set to
+     * the surface variation, i.e. the smallest eigenvalue divided by the sum of eigenvalues.
+     */
+    void estimateNormals(const std::vector<Base::Vector3f>& points,
+                         std::vector<Base::Vector3f>& normals,
+                         std::vector<float>& curvatures,
+                         int threads = 0) const;
+
+private:
+    std::vector<std::size_t> offsets;
+    std::vector<std::uint32_t> indices;
+};
+
+/**
+ * The RegionGrower class segments a point cloud into smooth regions. Starting with the
+ * point of lowest curvature a region is grown over the neighbour graph as long as the
+ * normals of adjacent points deviate less than the smoothness threshold. Only neighbours
+ * with a curvature below the curvature threshold are used as new seeds.
+ */
+class ReenExport RegionGrower
+{
+public:
+    struct Parameters
+    {
+        std::size_t minClusterSize = 50;
+        std::size_t maxClusterSize = 1000000;
+        /// Maximum angle in radians between the normals of adjacent points
+        float smoothness = 0.05236F;
+        float curvature = 1.0F;
+    };
+
+    explicit RegionGrower(const Parameters& params);
+    std::list<std::vector<int>> perform(const NeighbourGraph& graph,
+                                        const std::vector<Base::Vector3f>& normals,
+                                        const std::vector<float>& curvatures) const;
+
+private:
+    Parameters params;
+};
+
+/**
+ * The PrimitiveDetector class finds the geometric primitive with most inliers in a point
+ * cloud with the RANSAC method. The hypotheses are drawn and scored on several threads and
+ * the scoring of a hypothesis stops as soon as it cannot beat the best one any more. The
+ * best hypothesis is then refined with a least-squares fit of its inliers.
+ *
+ * The parameters of the primitives are:
+ * \li Plane: normal and distance to the origin (n·p + d = 0)
+ * \li Sphere: center and radius
+ * \li Cylinder: point on axis, axis direction and radius
+ * \li Cone: apex, axis direction and opening angle in radians
+ */
+class ReenExport PrimitiveDetector
+{
+public:
+    enum class Primitive
+    {
+        Plane,
+        Sphere,
+        Cylinder,
+        Cone
+    };
+
+    struct Parameters
+    {
+        /// Maximum distance of an inlier to the primitive
+        float distance = 0.01F;
+        /// Maximum angle in radians between the normal of an inlier and the primitive
+        float normalAngle = 0.5236F;
+        double probability = 0.99;
+        std::size_t maxIterations = 10000;
+        int threads = 0;
+    };
+
+    PrimitiveDetector(Primitive type, const Parameters& params);
+    /// Returns true if the primitive needs the point normals
+    static bool needsNormals(Primitive type);
+    /** Detects the primitive in \a points. The \a normals are only used for the cylinder
+     * and cone and must then have the same size as \a points. If \a probability is given it
+     * is set to the probability that one of the drawn samples consisted of inliers only,
+     * estimated from the final inlier ratio and the number of iterations done.
+     */
+    bool perform(const std::vector<Base::Vector3f>& points,
+                 const std::vector<Base::Vector3f>& normals,
+                 std::vector<float>& parameters,
+                 std::vector<int>& inliers,
+                 double* probability = nullptr) const;
+
+private:
+    Primitive type;
+    Parameters params;
+};
+
+}  // namespace Reen
+
+#endif  // REEN_PRIMITIVEDETECTION_H
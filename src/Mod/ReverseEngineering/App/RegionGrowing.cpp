@@ -25,9 +25,11 @@
 #include <boost/math/special_functions/fpclassify.hpp>
 #endif
 
+#include <Base/Exception.h>
 #include <Base/Tools.h>
 #include <Mod/Points/App/Points.h>
 
+#include "PrimitiveDetection.h"
 #include "RegionGrowing.h"
 
 
@@ -42,17 +44,20 @@
 #include <pcl/search/search.h>
 #include <pcl/segmentation/region_growing.h>
 
-using namespace std;
-using namespace Reen;
 using pcl::PointCloud;
 using pcl::PointNormal;
 using pcl::PointXYZ;
+#endif  // HAVE_PCL_SEGMENTATION
+
+using namespace std;
+using namespace Reen;
 
 RegionGrowing::RegionGrowing(const Points::PointKernel& pts, std::list<std::vector<int>>& clusters)
     : myPoints(pts)
     , myClusters(clusters)
 {}
 
+#if defined(HAVE_PCL_SEGMENTATION)
 void RegionGrowing::perform(int ksearch)
 {
     pcl::PointCloud<pcl::PointXYZ>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZ>);
@@ -156,4 +161,97 @@ void RegionGrowing::perform(const std::vector<Base::Vector3f>& myNormals)
     }
 }
 
+#else  // HAVE_PCL_SEGMENTATION
+
+namespace
+{
+// Same settings as used with PCL
+RegionGrower::Parameters regionGrowingParameters()
+{
+    RegionGrower::Parameters params;
+    params.minClusterSize = 50;
+    params.maxClusterSize = 1000000;
+    params.smoothness = float(Base::toRadians(3.0));
+    params.curvature = 1.0F;
+    return params;
+}
+
+constexpr int numberOfNeighbours = 30;
+
+void mapClusters(std::list<std::vector<int>>& clusters, const std::vector<int>& mapping)
+{
+    for (auto& cluster : clusters) {
+        for (int& index : cluster) {
+            index = mapping[index];
+        }
+    }
+}
+}  // namespace
+
+void RegionGrowing::perform(int ksearch)
+{
+    std::vector<Base::Vector3f> points;
+    std::vector<int> mapping;
+    points.reserve(myPoints.size());
+    mapping.reserve(myPoints.size());
+    const std::vector<Base::Vector3f>& basicPoints = myPoints.getBasicPoints();
+    for (std::size_t index = 0; index < basicPoints.size(); index++) {
+        const Base::Vector3f& p = basicPoints[index];
+        if (!boost::math::isnan(p.x) && !boost::math::isnan(p.y) && !boost::math::isnan(p.z)) {
+            points.push_back(p);
+            mapping.push_back(static_cast<int>(index));
+        }
+    }
+
+    // normal estimation
+    NeighbourGraph graph;
+    graph.build(points, ksearch);
+    std::vector<Base::Vector3f> normals;
+    std::vector<float> curvatures;
+    graph.estimateNormals(points, normals, curvatures);
+    if (ksearch != numberOfNeighbours) {
+        graph.build(points, numberOfNeighbours);
+    }
+
+    RegionGrower grower(regionGrowingParameters());
+    std::list<std::vector<int>> clusters = grower.perform(graph, normals, curvatures);
+    mapClusters(clusters, mapping);
+    myClusters.splice(myClusters.end(), clusters);
+}
+
+void RegionGrowing::perform(const std::vector<Base::Vector3f>& myNormals)
+{
+    if (myPoints.size() != myNormals.size()) {
+        throw Base::RuntimeError("Number of points does not match with number of normals");
+    }
+
+    std::vector<Base::Vector3f> points;
+    std::vector<Base::Vector3f> normals;
+    std::vector<int> mapping;
+    points.reserve(myPoints.size());
+    normals.reserve(myNormals.size());
+    mapping.reserve(myPoints.size());
+
+    std::size_t num_points = myPoints.size();
+    const std::vector<Base::Vector3f>& basicPoints = myPoints.getBasicPoints();
+    for (std::size_t index = 0; index < num_points; index++) {
+        const Base::Vector3f& p = basicPoints[index];
+        if (!boost::math::isnan(p.x) && !boost::math::isnan(p.y) && !boost::math::isnan(p.z)) {
+            points.push_back(p);
+            normals.push_back(myNormals[index]);
+            mapping.push_back(static_cast<int>(index));
+        }
+    }
+
+    NeighbourGraph graph;
+    graph.build(points, numberOfNeighbours);
+
+    // without curvature information every point can be a seed
+    std::vector<float> curvatures(points.size(), 0.0F);
+    RegionGrower grower(regionGrowingParameters());
+    std::list<std::vector<int>> clusters = grower.perform(graph, normals, curvatures);
+    mapClusters(clusters, mapping);
+    myClusters.splice(myClusters.end(), clusters);
+}
+
 #endif  // HAVE_PCL_SEGMENTATION
@@ -28,6 +28,7 @@
 #include <Base/Exception.h>
 #include <Mod/Points/App/Points.h>
 
+#include "PrimitiveDetection.h"
 #include "SampleConsensus.h"
 
 
@@ -40,11 +41,13 @@
 #include <pcl/sample_consensus/sac_model_plane.h>
 #include <pcl/sample_consensus/sac_model_sphere.h>
 
-using namespace std;
-using namespace Reen;
 using pcl::PointCloud;
 using pcl::PointNormal;
 using pcl::PointXYZ;
+#endif  // HAVE_PCL_SAMPLE_CONSENSUS
+
+using namespace std;
+using namespace Reen;
 
 SampleConsensus::SampleConsensus(SacModel sac,
                                  const Points::PointKernel& pts,
@@ -54,6 +57,7 @@ SampleConsensus::SampleConsensus(SacModel sac,
     , myNormals(nor)
 {}
 
+#if defined(HAVE_PCL_SAMPLE_CONSENSUS)
 double SampleConsensus::perform(std::vector<float>& parameters, std::vector<int>& model)
 {
     pcl::PointCloud<pcl::PointXYZ>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZ>);
@@ -127,7 +131,7 @@ double SampleConsensus::perform(std::vector<float>& parameters, std::vector<int>
     }
 
     pcl::RandomSampleConsensus<pcl::PointXYZ> ransac(model_p);
-    ransac.setDistanceThreshold(.01);
+    ransac.setDistanceThreshold(myDistance);
     ransac.computeModel();
     ransac.getInliers(model);
     // ransac.getModel (model);
@@ -140,4 +144,77 @@ double SampleConsensus::perform(std::vector<float>& parameters, std::vector<int>
     return ransac.getProbability();
 }
 
+#else  // HAVE_PCL_SAMPLE_CONSENSUS
+
+double SampleConsensus::perform(std::vector<float>& parameters, std::vector<int>& model)
+{
+    PrimitiveDetector::Primitive primitive {};
+    switch (mySac) {
+        case SACMODEL_PLANE:
+            primitive = PrimitiveDetector::Primitive::Plane;
+            break;
+        case SACMODEL_SPHERE:
+            primitive = PrimitiveDetector::Primitive::Sphere;
+            break;
+        case SACMODEL_CONE:
+            primitive = PrimitiveDetector::Primitive::Cone;
+            break;
+        case SACMODEL_CYLINDER:
+            primitive = PrimitiveDetector::Primitive::Cylinder;
+            break;
+        default:
+            throw Base::RuntimeError("Unsupported SAC model");
+    }
+
+    // the given normals are only used if there is one for each point
+    bool needsNormals = PrimitiveDetector::needsNormals(primitive);
+    bool hasNormals = needsNormals && myNormals.size() == myPoints.size();
+
+    std::vector<Base::Vector3f> points;
+    std::vector<Base::Vector3f> normals;
+    std::vector<int> mapping;
+    points.reserve(myPoints.size());
+    mapping.reserve(myPoints.size());
+    const std::vector<Base::Vector3f>& basicPoints = myPoints.getBasicPoints();
+    for (std::size_t index = 0; index < basicPoints.size(); index++) {
+        const Base::Vector3f& p = basicPoints[index];
+        if (boost::math::isnan(p.x) || boost::math::isnan(p.y) || boost::math::isnan(p.z)) {
+            continue;
+        }
+        if (hasNormals) {
+            const Base::Vector3d& n = myNormals[index];
+            if (boost::math::isnan(n.x) || boost::math::isnan(n.y) || boost::math::isnan(n.z)) {
+                continue;
+            }
+            normals.push_back(Base::toVector<float>(n));
+        }
+        points.push_back(p);
+        mapping.push_back(static_cast<int>(index));
+    }
+
+    if (needsNormals && !hasNormals) {
+        int ksearch = 10;
+        NeighbourGraph graph;
+        graph.build(points, ksearch);
+        std::vector<float> curvatures;
+        graph.estimateNormals(points, normals, curvatures);
+    }
+
+    PrimitiveDetector::Parameters params;
+    params.distance = static_cast<float>(myDistance);
+    PrimitiveDetector detector(primitive, params);
+    std::vector<int> inliers;
+    double probability = 0.0;
+    if (!detector.perform(points, normals, parameters, inliers, &probability)) {
+        return 0.0;
+    }
+
+    model.reserve(model.size() + inliers.size());
+    for (int index : inliers) {
+        model.push_back(mapping[index]);
+    }
+
+    return probability;
+}
+
 #endif  // HAVE_PCL_SAMPLE_CONSENSUS
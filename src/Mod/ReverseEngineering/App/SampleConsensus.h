@@ -51,12 +51,24 @@ public:
         SACMODEL_TORUS,
     };
     SampleConsensus(SacModel sac, const Points::PointKernel&, const std::vector<Base::Vector3d>&);
+    /** \brief Set the maximum distance of an inlier to the model.
+     * \param[in] distance the distance threshold, 0.01 by default
+     */
+    void setDistanceThreshold(double distance)
+    {
+        myDistance = distance;
+    }
+    /** \brief Fits the model and returns the probability that it was found.
+     * \param[out] parameters the coefficients of the model
+     * \param[out] model the indices of the inliers
+     */
     double perform(std::vector<float>& parameters, std::vector<int>& model);
 
 private:
     SacModel mySac;
     const Points::PointKernel& myPoints;
     const std::vector<Base::Vector3d>& myNormals;
+    double myDistance {0.01};
 };
 
 }  // namespace Reen
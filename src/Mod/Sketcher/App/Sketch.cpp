@@ -70,6 +70,7 @@ TYPESYSTEM_SOURCE(Sketcher::Sketch, Base::Persistence)
 Sketch::Sketch()
     : SolveTime(0)
     , RecalculateInitialSolutionWhileMovingPoint(false)
+    , DragSolveTimeBudget(0)
     , resolveAfterGeometryUpdated(false)
     , GCSsys()
     , ConstraintsCounter(0)
@@ -4605,6 +4606,11 @@ int Sketch::internalSolve(std::string& solvername, int level)
     if (isInitMove) {
         solvername = "DogLeg";  // DogLeg is used for dragging (same as before)
         ret = GCSsys.solve(isFine, GCS::DogLeg);
+        if (ret != GCS::Success && GCSsys.isSolveInterrupted()) {
+            // interactive drag out of time: show the best iterate so far, the solve on
+            // release will converge
+            ret = GCS::Success;
+        }
     }
     else {
         switch (defaultSolver) {
@@ -4999,6 +5005,12 @@ int Sketch::initMove(int geoId, PointPos pos, bool fine)
 void Sketch::resetInitMove()
 {
     isInitMove = false;
+    GCSsys.setDragging(false);
+}
+
+void Sketch::setInteractiveMove(bool interactive)
+{
+    GCSsys.setDragging(interactive && isInitMove, DragSolveTimeBudget);
 }
 
 int Sketch::initBSplinePieceMove(int geoId,
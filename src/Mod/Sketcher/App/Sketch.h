@@ -176,6 +176,12 @@ public:
      */
     void resetInitMove();
 
+    /** Switches the initialized move to interactive solving: each solve warm starts from
+     * the previous one, only the components holding the dragged geometry are solved and
+     * the solve is bounded by the drag solve time budget. It is reset by resetInitMove().
+     */
+    void setInteractiveMove(bool interactive);
+
     /** Limits a b-spline drag to the segment around `firstPoint`.
      */
     int limitBSplineMove(int geoId, PointPos pos, const Base::Vector3d& firstPoint);
@@ -205,6 +211,20 @@ public:
         RecalculateInitialSolutionWhileMovingPoint = recalculateInitialSolutionWhileMovingPoint;
     }
 
+    /**
+     * Returns the time (in milliseconds) a solve of an interactive move may take before the best
+     * iterate found so far is used. A value <= 0 means unbounded.
+     */
+    double getDragSolveTimeBudget() const
+    {
+        return DragSolveTimeBudget;
+    }
+
+    void setDragSolveTimeBudget(double dragSolveTimeBudget)
+    {
+        DragSolveTimeBudget = dragSolveTimeBudget;
+    }
+
     /// add dedicated geometry
     //@{
     /// add a point
@@ -528,6 +548,7 @@ public:
 private:
     float SolveTime;
     bool RecalculateInitialSolutionWhileMovingPoint;
+    double DragSolveTimeBudget;
 
     // regulates a second solve for cases where there result of having update the geometry (e.g. via
     // OCCT) needs to be taken into account by the solver (for example to provide the right value of
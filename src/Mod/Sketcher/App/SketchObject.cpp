@@ -24,7 +24,9 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <functional>
 #include <limits>
 #include <vector>
 
@@ -37,6 +39,7 @@
 #include <BRepMesh_IncrementalMesh.hxx>
 #include <BRepOffsetAPI_NormalProjection.hxx>
 #include <BRepTools_WireExplorer.hxx>
+#include <Precision.hxx>
 #include <BRep_Tool.hxx>
 #include <ElCLib.hxx>
 #include <GCPnts_AbscissaPoint.hxx>
@@ -47,6 +50,9 @@
 #include <GeomConvert_BSplineCurveKnotSplitting.hxx>
 #include <GeomLProp_CLProps.hxx>
 #include <Geom_BSplineCurve.hxx>
+#include <Geom_BSplineSurface.hxx>
+#include <Geom_BezierCurve.hxx>
+#include <Geom_BezierSurface.hxx>
 #include <Geom_Circle.hxx>
 #include <Geom_Ellipse.hxx>
 #include <Geom_Hyperbola.hxx>
@@ -65,10 +71,15 @@
 #include <TopoDS_Shape.hxx>
 #include <gp_Ax3.hxx>
 #include <gp_Circ.hxx>
+#include <gp_Cone.hxx>
+#include <gp_Cylinder.hxx>
 #include <gp_Elips.hxx>
 #include <gp_Hypr.hxx>
+#include <gp_Lin.hxx>
 #include <gp_Parab.hxx>
 #include <gp_Pln.hxx>
+#include <gp_Sphere.hxx>
+#include <gp_Torus.hxx>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/predicate.hpp>
@@ -1406,6 +1417,10 @@ int SketchObject::moveGeometries(const std::vector<GeoElementId>& geoEltIds, con
     if (lastHasConflict)// conflicting constraints
         return -1;
 
+    // a preceding temporary (interactive) move may have left the solver in drag mode, the
+    // final move is always a full solve
+    solvedSketch.setInteractiveMove(false);
+
     // move the point and solve
     lastSolverStatus = solvedSketch.moveGeometries(geoEltIds, toPoint, relative);
 
@@ -8689,6 +8704,199 @@ void processFace (const Rotation& invRot,
     }
 }
 
+// Exact description of the geometry of a shape, used to tell whether an external reference
+// still has the same geometry. Rebuilding the reference (App::Plane, datums) or recomputing its
+// owner creates a new TShape, so its identity cannot be used for this. Curves and surfaces are
+// described by their definition, only those without an analytic or pole representation (offset
+// curves and surfaces, swept surfaces) are sampled.
+std::vector<double> describeGeometry(const TopoDS_Shape& shape)
+{
+    std::vector<double> values {static_cast<double>(shape.ShapeType())};
+    auto addXYZ = [&values](const gp_XYZ& xyz) {
+        values.insert(values.end(), {xyz.X(), xyz.Y(), xyz.Z()});
+    };
+    auto addAxes = [&addXYZ](const gp_Pnt& location, const gp_Dir& main, const gp_Dir& xdir) {
+        addXYZ(location.XYZ());
+        addXYZ(main.XYZ());
+        addXYZ(xdir.XYZ());
+    };
+    auto addAx2 = [&addAxes](const gp_Ax2& ax) {
+        addAxes(ax.Location(), ax.Direction(), ax.XDirection());
+    };
+    auto addAx3 = [&addAxes](const gp_Ax3& ax) {
+        addAxes(ax.Location(), ax.Direction(), ax.XDirection());
+    };
+    auto samples = [](double first, double last, int count) {
+        // infinite curves and surfaces are sampled around their origin
+        if (Precision::IsInfinite(first) || Precision::IsInfinite(last)) {
+            first = 0.0;
+            last = 1.0;
+        }
+        std::vector<double> params;
+        for (int i = 0; i < count; i++) {
+            params.push_back(first + (last - first) * i / (count - 1));
+        }
+        return params;
+    };
+
+    for (TopExp_Explorer xp(shape, TopAbs_VERTEX); xp.More(); xp.Next()) {
+        addXYZ(BRep_Tool::Pnt(TopoDS::Vertex(xp.Current())).XYZ());
+    }
+    for (TopExp_Explorer xp(shape, TopAbs_EDGE); xp.More(); xp.Next()) {
+        const TopoDS_Edge& edge = TopoDS::Edge(xp.Current());
+        if (BRep_Tool::Degenerated(edge)) {
+            continue;
+        }
+        BRepAdaptor_Curve curve(edge);
+        values.insert(values.end(),
+                      {static_cast<double>(curve.GetType()),
+                       curve.FirstParameter(),
+                       curve.LastParameter()});
+        switch (curve.GetType()) {
+            case GeomAbs_Line: {
+                gp_Lin line = curve.Line();
+                addXYZ(line.Location().XYZ());
+                addXYZ(line.Direction().XYZ());
+                break;
+            }
+            case GeomAbs_Circle: {
+                gp_Circ circle = curve.Circle();
+                addAx2(circle.Position());
+                values.push_back(circle.Radius());
+                break;
+            }
+            case GeomAbs_Ellipse: {
+                gp_Elips ellipse = curve.Ellipse();
+                addAx2(ellipse.Position());
+                values.insert(values.end(), {ellipse.MajorRadius(), ellipse.MinorRadius()});
+                break;
+            }
+            case GeomAbs_Hyperbola: {
+                gp_Hypr hyperbola = curve.Hyperbola();
+                addAx2(hyperbola.Position());
+                values.insert(values.end(), {hyperbola.MajorRadius(), hyperbola.MinorRadius()});
+                break;
+            }
+            case GeomAbs_Parabola: {
+                gp_Parab parabola = curve.Parabola();
+                addAx2(parabola.Position());
+                values.push_back(parabola.Focal());
+                break;
+            }
+            case GeomAbs_BezierCurve: {
+                Handle(Geom_BezierCurve) bezier = curve.Bezier();
+                for (int i = 1; i <= bezier->NbPoles(); i++) {
+                    addXYZ(bezier->Pole(i).XYZ());
+                    values.push_back(bezier->Weight(i));
+                }
+                break;
+            }
+            case GeomAbs_BSplineCurve: {
+                Handle(Geom_BSplineCurve) spline = curve.BSpline();
+                values.insert(values.end(),
+                              {static_cast<double>(spline->Degree()),
+                               static_cast<double>(spline->IsPeriodic())});
+                for (int i = 1; i <= spline->NbPoles(); i++) {
+                    addXYZ(spline->Pole(i).XYZ());
+                    values.push_back(spline->Weight(i));
+                }
+                for (int i = 1; i <= spline->NbKnots(); i++) {
+                    values.push_back(spline->Knot(i));
+                    values.push_back(spline->Multiplicity(i));
+                }
+                break;
+            }
+            default:
+                for (double u : samples(curve.FirstParameter(), curve.LastParameter(), 17)) {
+                    addXYZ(curve.Value(u).XYZ());
+                }
+                break;
+        }
+    }
+    for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+        BRepAdaptor_Surface surface(TopoDS::Face(xp.Current()));
+        values.insert(values.end(),
+                      {static_cast<double>(surface.GetType()),
+                       surface.FirstUParameter(),
+                       surface.LastUParameter(),
+                       surface.FirstVParameter(),
+                       surface.LastVParameter()});
+        switch (surface.GetType()) {
+            case GeomAbs_Plane:
+                addAx3(surface.Plane().Position());
+                break;
+            case GeomAbs_Cylinder: {
+                gp_Cylinder cylinder = surface.Cylinder();
+                addAx3(cylinder.Position());
+                values.push_back(cylinder.Radius());
+                break;
+            }
+            case GeomAbs_Cone: {
+                gp_Cone cone = surface.Cone();
+                addAx3(cone.Position());
+                values.insert(values.end(), {cone.RefRadius(), cone.SemiAngle()});
+                break;
+            }
+            case GeomAbs_Sphere: {
+                gp_Sphere sphere = surface.Sphere();
+                addAx3(sphere.Position());
+                values.push_back(sphere.Radius());
+                break;
+            }
+            case GeomAbs_Torus: {
+                gp_Torus torus = surface.Torus();
+                addAx3(torus.Position());
+                values.insert(values.end(), {torus.MajorRadius(), torus.MinorRadius()});
+                break;
+            }
+            case GeomAbs_BezierSurface: {
+                Handle(Geom_BezierSurface) bezier = surface.Bezier();
+                for (int i = 1; i <= bezier->NbUPoles(); i++) {
+                    for (int j = 1; j <= bezier->NbVPoles(); j++) {
+                        addXYZ(bezier->Pole(i, j).XYZ());
+                        values.push_back(bezier->Weight(i, j));
+                    }
+                }
+                break;
+            }
+            case GeomAbs_BSplineSurface: {
+                Handle(Geom_BSplineSurface) spline = surface.BSpline();
+                values.insert(values.end(),
+                              {static_cast<double>(spline->UDegree()),
+                               static_cast<double>(spline->VDegree()),
+                               static_cast<double>(spline->IsUPeriodic()),
+                               static_cast<double>(spline->IsVPeriodic())});
+                for (int i = 1; i <= spline->NbUPoles(); i++) {
+                    for (int j = 1; j <= spline->NbVPoles(); j++) {
+                        addXYZ(spline->Pole(i, j).XYZ());
+                        values.push_back(spline->Weight(i, j));
+                    }
+                }
+                for (int i = 1; i <= spline->NbUKnots(); i++) {
+                    values.push_back(spline->UKnot(i));
+                    values.push_back(spline->UMultiplicity(i));
+                }
+                for (int i = 1; i <= spline->NbVKnots(); i++) {
+                    values.push_back(spline->VKnot(i));
+                    values.push_back(spline->VMultiplicity(i));
+                }
+                break;
+            }
+            default: {
+                auto us = samples(surface.FirstUParameter(), surface.LastUParameter(), 9);
+                auto vs = samples(surface.FirstVParameter(), surface.LastVParameter(), 9);
+                for (double u : us) {
+                    for (double v : vs) {
+                        addXYZ(surface.Value(u, v).XYZ());
+                    }
+                }
+                break;
+            }
+        }
+    }
+    return values;
+}
+
 }
 
 void SketchObject::rebuildExternalGeometry(std::optional<ExternalToAdd> extToAdd)
@@ -8879,7 +9087,24 @@ void SketchObject::rebuildExternalGeometry(std::optional<ExternalToAdd> extToAdd
                     "Datum feature type is not yet supported as external geometry for a sketch");
             }
 
-            if (projection) {
+            // Projecting with OCC is costly, reuse the previous result if neither the geometry
+            // of the referenced sub-shape nor the sketch plane changed.
+            std::vector<double> geometry = describeGeometry(refSubShape);
+            auto cached = externalProjectionCache.find(key);
+            bool isCached = !beingCreated && cached != externalProjectionCache.end()
+                && cached->second.isUpToDate(geometry,
+                                             Plm,
+                                             Types[i],
+                                             ArcFitTolerance.getValue());
+
+            if (isCached) {
+                for (const auto& geo : cached->second.geos) {
+                    geos.emplace_back(geo->clone());
+                }
+                ++externalProjectionCacheHits;
+            }
+
+            if (projection && !isCached) {
                 switch (refSubShape.ShapeType()) {
                 case TopAbs_FACE: {
                     processFace(invRot, invPlm, mov, sketchPlane, gPlane, sketchAx3, aProjFace, geos, refSubShape);
@@ -8905,7 +9130,7 @@ void SketchObject::rebuildExternalGeometry(std::optional<ExternalToAdd> extToAdd
             }
             int projSize = geos.size();
 
-            if (intersection) {
+            if (intersection && !isCached) {
                 FCBRepAlgoAPI_Section maker(refSubShape, sketchPlane);
                 maker.Approximation(Standard_True);
                 if (!maker.IsDone())
@@ -8949,6 +9174,18 @@ void SketchObject::rebuildExternalGeometry(std::optional<ExternalToAdd> extToAdd
                 }
             }
 
+            if (!isCached) {
+                auto& entry = externalProjectionCache[key];
+                entry.geometry = std::move(geometry);
+                entry.placement = Plm;
+                entry.type = Types[i];
+                entry.arcFitTolerance = ArcFitTolerance.getValue();
+                entry.geos.clear();
+                for (const auto& geo : geos) {
+                    entry.geos.emplace_back(geo->clone());
+                }
+            }
+
         } catch (Base::Exception &e) {
             FC_ERR("Failed to project external geometry in "
                    << getFullName() << ": " << key << std::endl << e.what());
@@ -9037,6 +9274,11 @@ void SketchObject::rebuildExternalGeometry(std::optional<ExternalToAdd> extToAdd
     ExternalGeo.setValues(std::move(geoms));
     rebuildVertexIndex();
 
+    // forget the projections of removed references
+    std::erase_if(externalProjectionCache, [&refSet](const auto& entry) {
+        return refSet.count(entry.first) == 0;
+    });
+
     // clean up geometry reference
     if(refSet.size() != (size_t)ExternalGeometry.getSize()) {
         if(refSet.size() < keys.size()) {
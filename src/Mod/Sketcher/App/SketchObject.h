@@ -254,6 +254,11 @@ public:
     // It uses std::optional because this function is actually used to both recompute external
     // geometries but also to add new external geometries. Ideally this should be refactored.
     void rebuildExternalGeometry(std::optional<ExternalToAdd> extToAdd = std::nullopt);
+    /// returns how often rebuildExternalGeometry() reused a cached projection
+    int getExternalProjectionCacheHits() const
+    {
+        return externalProjectionCacheHits;
+    }
     /// returns the number of external Geometry entities
     int getExternalGeometryCount() const
     {
@@ -704,6 +709,11 @@ public: /* Solver exposed interface */
         solvedSketch.setRecalculateInitialSolutionWhileMovingPoint(
             recalculateInitialSolutionWhileMovingPoint);
     }
+    /// Forwards the time budget (in milliseconds) of each solve while dragging to the solver
+    inline void setDragSolveTimeBudget(double dragSolveTimeBudget)
+    {
+        solvedSketch.setDragSolveTimeBudget(dragSolveTimeBudget);
+    }
     /// Forwards a request for a temporary initMove to the solver using the current sketch state as
     /// a reference (enables dragging)
 
@@ -1096,6 +1106,31 @@ private:
     // mapping from ExternalGeo[*].Id to index of ExternalGeo
     std::map<long, int> externalGeoMap;
 
+    // Result of projecting/intersecting an external reference, reused by
+    // rebuildExternalGeometry() as long as neither the geometry of the referenced sub-shape nor
+    // the sketch placement (nor the projection settings) changed.
+    struct ExternalProjection
+    {
+        std::vector<double> geometry;
+        Base::Placement placement;
+        long type = 0;
+        double arcFitTolerance = 0;
+        std::vector<std::unique_ptr<Part::Geometry>> geos;
+
+        bool isUpToDate(const std::vector<double>& geom,
+                        const Base::Placement& plm,
+                        long extType,
+                        double tolerance) const
+        {
+            return geometry == geom && placement == plm && type == extType
+                && arcFitTolerance == tolerance;
+        }
+    };
+
+    // mapping from ExternalGeometry[*] (object name and subname) to its last projection
+    std::map<std::string, ExternalProjection> externalProjectionCache;
+    int externalProjectionCacheHits = 0;
+
     // mapping from Geometry[*].Id to index of Geometry
     std::map<long, int> geoMap;
 
@@ -1116,7 +1151,9 @@ inline int SketchObject::initTemporaryMove(std::vector<GeoElementId> moved, bool
         solve();
     }
 
-    return solvedSketch.initMove(moved, fine);
+    int ret = solvedSketch.initMove(moved, fine);
+    solvedSketch.setInteractiveMove(ret == 0);
+    return ret;
 }
 
 inline int SketchObject::initTemporaryMove(int geoId, PointPos pos, bool fine /*=true*/)
@@ -1137,7 +1174,9 @@ inline int SketchObject::initTemporaryBSplinePieceMove(int geoId,
         solve();
     }
 
-    return solvedSketch.initBSplinePieceMove(geoId, pos, firstPoint, fine);
+    int ret = solvedSketch.initBSplinePieceMove(geoId, pos, firstPoint, fine);
+    solvedSketch.setInteractiveMove(ret == 0);
+    return ret;
 }
 
 inline int SketchObject::moveGeometriesTemporary(std::vector<GeoElementId> geoEltIds,
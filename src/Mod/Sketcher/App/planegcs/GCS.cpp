@@ -471,6 +471,9 @@ System::System()
     , hasDiagnosis(false)
     , isInit(false)
     , emptyDiagnoseMatrix(true)
+    , isDragging(false)
+    , dragTimeBudget(0.)
+    , isBudgetExceeded(false)
     , maxIter(100)
     , maxIterRedundant(100)
     , sketchSizeMultiplier(false)
@@ -526,6 +529,7 @@ void System::clear()
     reference.clear();
     clearSubSystems();
     deleteAllContent(clist);
+    isDragging = false;
     c2p.clear();
     p2c.clear();
 }
@@ -1974,11 +1978,24 @@ int System::solve(bool isFine, Algorithm alg, bool isRedundantsolving)
         return Failed;
     }
 
-    bool isReset = false;
+    isBudgetExceeded = false;
+    if (isDragging && dragTimeBudget > 0.) {
+        dragDeadline = std::chrono::steady_clock::now()
+            + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                           std::chrono::duration<double, std::milli>(dragTimeBudget));
+    }
+
+    // while dragging the parameters hold the previous solution, which is a much better
+    // starting point than the reference. Components without temporary constraints are not
+    // affected by the drag and are left untouched.
+    bool isReset = isDragging;
     // return success by default in order to permit coincidence constraints to be applied
     // even if no other system has to be solved
     int res = Success;
     for (int cid = 0; cid < int(subSystems.size()); cid++) {
+        if (isDragging && !subSystemsAux[cid]) {
+            continue;
+        }
         if ((subSystems[cid] || subSystemsAux[cid]) && !isReset) {
             resetToReference();
             isReset = true;
@@ -2399,6 +2416,12 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
     double divergingLim = 1e6 * err + 1e12;
 
     double delta = 0.1;
+    if (isDragging) {
+        auto it = dragDelta.find(subsys);
+        if (it != dragDelta.end()) {
+            delta = it->second;
+        }
+    }
     double alpha = 0.;
     double nu = 2.;
     int iter = 0, stop = 0, reduce = 0;
@@ -2426,6 +2449,12 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
             stop = 6;
             break;
         }
+        else if (dragBudgetExhausted()) {
+            // keep the best iterate so far (a rejected step leaves x_new in the subsystem)
+            subsys->setParams(x);
+            stop = 7;
+            break;
+        }
 
         // get the steepest descent direction
         alpha = g.squaredNorm() / (Jx * g).squaredNorm();
@@ -2541,6 +2570,11 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
 
     subsys->revertParams();
 
+    if (isDragging) {
+        // a radius that collapsed on convergence would only slow down the next frame
+        dragDelta[subsys] = (delta > tolx * (tolx + x.norm())) ? delta : 0.1;
+    }
+
     if (debugMode == IterationLevel) {
         std::stringstream stream;
         stream << "DL: stopcode: " << stop << ((stop == 1) ? ", Success" : ", Failed") << "\n";
@@ -4632,6 +4666,12 @@ int System::solve(SubSystem* subsysA, SubSystem* subsysB, bool /*isFine*/, bool
     int xsize = plistAB.size();
 
     Eigen::MatrixXd B = Eigen::MatrixXd::Identity(xsize, xsize);
+    if (isDragging) {
+        auto it = dragHessian.find(subsysA);
+        if (it != dragHessian.end() && it->second.rows() == xsize) {
+            B = it->second;
+        }
+    }
     Eigen::MatrixXd JA(csizeA, xsize);
     Eigen::MatrixXd Y, Z;
 
@@ -4758,6 +4798,13 @@ int System::solve(SubSystem* subsysA, SubSystem* subsysB, bool /*isFine*/, bool
         if (err > divergingLim || err != err) {  // check for diverging and NaN
             break;
         }
+        if (dragBudgetExhausted()) {
+            break;
+        }
+    }
+
+    if (isDragging) {
+        dragHessian[subsysA] = B;
     }
 
     int ret;
@@ -4798,6 +4845,26 @@ void System::undoSolution()
     resetToReference();
 }
 
+void System::setDragging(bool dragging, double timeBudget)
+{
+    isDragging = dragging;
+    dragTimeBudget = dragging ? timeBudget : 0.;
+    isBudgetExceeded = false;
+    dragDelta.clear();
+    dragHessian.clear();
+}
+
+bool System::dragBudgetExhausted()
+{
+    if (!isDragging) {
+        return false;
+    }
+    if (dragTimeBudget > 0. && std::chrono::steady_clock::now() >= dragDeadline) {
+        isBudgetExceeded = true;
+    }
+    return isBudgetExceeded;
+}
+
 void System::makeReducedJacobian(Eigen::MatrixXd& J,
                                  std::map<int, int>& jacobianconstraintmap,
                                  GCS::VEC_pD& pdiagnoselist,
@@ -5735,6 +5802,8 @@ void System::identifyConflictingRedundantConstraints(
 void System::clearSubSystems()
 {
     isInit = false;
+    dragDelta.clear();
+    dragHessian.clear();
     deleteAllContent(subSystems);
     deleteAllContent(subSystemsAux);
     subSystems.clear();
@@ -23,6 +23,7 @@
 #ifndef PLANEGCS_GCS_H
 #define PLANEGCS_GCS_H
 
+#include <chrono>
 #include <Eigen/QR>
 
 #include "../../SketcherGlobal.h"
@@ -143,6 +144,15 @@ private:
 
     bool emptyDiagnoseMatrix;  // false only if there is at least one driving constraint.
 
+    // interactive dragging (see setDragging)
+    bool isDragging;        // warm start, solve only dragged components, bounded time
+    double dragTimeBudget;  // per solve in milliseconds, <= 0 means unbounded
+    bool isBudgetExceeded;  // the last solve stopped because the time budget ran out
+    std::chrono::steady_clock::time_point dragDeadline;
+    std::map<SubSystem*, double> dragDelta;             // last DogLeg trust region radius
+    std::map<SubSystem*, Eigen::MatrixXd> dragHessian;  // last SQP BFGS Hessian approximation
+    bool dragBudgetExhausted();
+
     int solve_BFGS(SubSystem* subsys, bool isFine = true, bool isRedundantsolving = false);
     int solve_LM(SubSystem* subsys, bool isRedundantsolving = false);
     int solve_DL(SubSystem* subsys, bool isRedundantsolving = false);
@@ -559,6 +569,21 @@ public:
 
     void applySolution();
     void undoSolution();
+
+    // Interactive dragging mode. While enabled, every solve starts from the previous
+    // solution (and the previous DogLeg trust region radius or SQP Hessian), only the
+    // components holding temporary constraints are solved and, if timeBudget (ms) is
+    // positive, the solvers stop after that time keeping the best iterate so far.
+    void setDragging(bool dragging, double timeBudget = 0.);
+    bool isDraggingMode() const
+    {
+        return isDragging;
+    }
+    // true if the last solve stopped because the drag time budget was exhausted
+    bool isSolveInterrupted() const
+    {
+        return isBudgetExceeded;
+    }
     // FIXME: looks like XconvergenceFine is not the solver precision, at least in DogLeg
     // solver.
     //  Note: Yes, every solver has a different way of interpreting precision
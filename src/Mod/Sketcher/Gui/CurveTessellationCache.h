@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef SKETCHERGUI_CurveTessellationCache_H
+#define SKETCHERGUI_CurveTessellationCache_H
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <Base/Vector3D.h>
+
+
+namespace SketcherGui
+{
+
+/** @brief      Helper struct caching the polylines of curved geometry between draws.
+ *
+ * Sampling a curve requires one kernel evaluation per segment (and, for B-Splines, the
+ * curvature analysis of the comb). While dragging, only the geometry of the component being
+ * solved changes, so curves whose defining data (key) did not change reuse their polyline.
+ */
+struct CurveTessellationCache
+{
+    struct Entry
+    {
+        std::vector<double> key;
+        std::vector<Base::Vector3d> polyline;
+        double combRepresentationScale = 0;
+    };
+
+    /** Returns the entry of \a geoId and whether its curve must be sampled again. If \a key
+     * differs from the stored one the entry takes the new key and its polyline is cleared.
+     */
+    std::pair<Entry&, bool> update(int geoId, std::vector<double>&& key)
+    {
+        Entry& entry = entries[geoId];
+        bool isChanged = entry.key != key;
+        if (isChanged) {
+            entry.key = std::move(key);
+            entry.polyline.clear();
+            entry.combRepresentationScale = 0;
+        }
+        return {entry, isChanged};
+    }
+
+    /// Drops the entries of geometry that no longer exists
+    void prune(int internalCount, int externalCount)
+    {
+        std::erase_if(entries, [internalCount, externalCount](const auto& entry) {
+            return entry.first >= internalCount || entry.first < -externalCount;
+        });
+    }
+
+    void clear()
+    {
+        entries.clear();
+    }
+
+    /// entries indexed by GeoId
+    std::map<int, Entry> entries;
+};
+
+}  // namespace SketcherGui
+
+#endif  // SKETCHERGUI_CurveTessellationCache_H
@@ -25,6 +25,7 @@
 #include <Base/Console.h>
 #include <Base/Exception.h>
 
+#include "CurveTessellationCache.h"
 #include "EditModeCoinManagerParameters.h"
 #include "EditModeGeometryCoinConverter.h"
 #include "Utils.h"
@@ -39,12 +40,14 @@ EditModeGeometryCoinConverter::EditModeGeometryCoinConverter(
     GeometryLayerNodes& geometrylayernodes,
     DrawingParameters& drawingparameters,
     GeometryLayerParameters& geometryLayerParams,
-    CoinMapping& coinMap)
+    CoinMapping& coinMap,
+    CurveTessellationCache& tessellationcache)
     : viewProvider(vp)
     , geometryLayerNodes(geometrylayernodes)
     , drawingParameters(drawingparameters)
     , geometryLayerParameters(geometryLayerParams)
     , coinMapping(coinMap)
+    , tessellationCache(tessellationcache)
 {}
 
 void EditModeGeometryCoinConverter::convert(const Sketcher::GeoListFacade& geolistfacade)
@@ -81,6 +84,8 @@ void EditModeGeometryCoinConverter::convert(const Sketcher::GeoListFacade& geoli
 
     pointCounter.resize(geometryLayerParameters.getCoinLayerCount(), 0);
 
+    tessellationCache.prune(geolistfacade.getInternalCount(), geolistfacade.getExternalCount());
+
     auto setTracking = [this](int geoId,
                               int coinLayer,
                               EditModeGeometryCoinConverter::PointsMode pointmode,
@@ -347,15 +352,24 @@ void EditModeGeometryCoinConverter::convert(const Sketcher::GeometryFacade* geom
             numSegments *= geo->countKnots();
         }
 
-        double segment = (geo->getLastParameter() - geo->getFirstParameter()) / numSegments;
+        auto [cached, isChanged] =
+            tessellationCache.update(geoid, getTessellationKey(geo, numSegments));
 
-        for (int i = 0; i < numSegments; i++) {
-            Base::Vector3d pnt = geo->value(i * segment);
-            addPoint(Coords[coinLayer][subLayer], pnt);
+        if (isChanged) {
+            cached.polyline.reserve(numSegments + 1);
+
+            double segment = (geo->getLastParameter() - geo->getFirstParameter()) / numSegments;
+
+            for (int i = 0; i < numSegments; i++) {
+                cached.polyline.push_back(geo->value(i * segment));
+            }
+
+            cached.polyline.push_back(geo->value(0));
         }
 
-        Base::Vector3d pnt = geo->value(0);
-        addPoint(Coords[coinLayer][subLayer], pnt);
+        for (const auto& pnt : cached.polyline) {
+            addPoint(Coords[coinLayer][subLayer], pnt);
+        }
 
         Index[coinLayer][subLayer].push_back(numSegments + 1);
     }
@@ -365,19 +379,33 @@ void EditModeGeometryCoinConverter::convert(const Sketcher::GeometryFacade* geom
             numSegments *= (geo->countKnots() - 1);  // one less segments than knots
         }
 
-        double segment = (geo->getLastParameter() - geo->getFirstParameter()) / numSegments;
+        auto [cached, isChanged] =
+            tessellationCache.update(geoid, getTessellationKey(geo, numSegments));
 
-        for (int i = 0; i < numSegments; i++) {
-            Base::Vector3d pnt = geo->value(geo->getFirstParameter() + i * segment);
-            addPoint(Coords[coinLayer][subLayer], pnt);
+        if (isChanged) {
+            cached.polyline.reserve(numSegments + 1);
+
+            double segment = (geo->getLastParameter() - geo->getFirstParameter()) / numSegments;
+
+            for (int i = 0; i < numSegments; i++) {
+                cached.polyline.push_back(geo->value(geo->getFirstParameter() + i * segment));
+            }
+
+            cached.polyline.push_back(geo->value(geo->getLastParameter()));
         }
 
-        Base::Vector3d pnt = geo->value(geo->getLastParameter());
-        addPoint(Coords[coinLayer][subLayer], pnt);
+        for (const auto& pnt : cached.polyline) {
+            addPoint(Coords[coinLayer][subLayer], pnt);
+        }
 
         Index[coinLayer][subLayer].push_back(numSegments + 1);
 
         if constexpr (analysemode == AnalyseMode::BoundingBoxMagnitudeAndBSplineCurvature) {
+            if (!isChanged) {
+                combrepscale = std::max(combrepscale, cached.combRepresentationScale);
+                return;
+            }
+
             //***************************************************************************************************************
             // global information gathering for geometry information layer
 
@@ -442,6 +470,8 @@ void EditModeGeometryCoinConverter::convert(const Sketcher::GeometryFacade* geom
                     / maxcurv;  // just a factor to make a comb reasonably visible
             }
 
+            cached.combRepresentationScale = temprepscale;
+
             if (temprepscale > combrepscale) {
                 combrepscale = temprepscale;
             }
@@ -449,6 +479,49 @@ void EditModeGeometryCoinConverter::convert(const Sketcher::GeometryFacade* geom
     }
 }
 
+template<typename GeoType>
+std::vector<double>
+EditModeGeometryCoinConverter::getTessellationKey(const GeoType* geo, int numSegments) const
+{
+    std::vector<double> key {static_cast<double>(geo->getTypeId().getKey()),
+                             static_cast<double>(numSegments),
+                             geo->getFirstParameter(),
+                             geo->getLastParameter()};
+
+    auto addVector = [&key](const Base::Vector3d& vector) {
+        key.push_back(vector.x);
+        key.push_back(vector.y);
+    };
+
+    if constexpr (std::is_same<GeoType, Part::GeomBSplineCurve>::value) {
+        key.push_back(geo->getDegree());
+        key.push_back(geo->isPeriodic() ? 1 : 0);
+
+        for (const auto& pole : geo->getPoles()) {
+            addVector(pole);
+        }
+
+        auto weights = geo->getWeights();
+        auto knots = geo->getKnots();
+        auto multiplicities = geo->getMultiplicities();
+        key.insert(key.end(), weights.begin(), weights.end());
+        key.insert(key.end(), knots.begin(), knots.end());
+        key.insert(key.end(), multiplicities.begin(), multiplicities.end());
+    }
+    else {
+        // Conics are parametrised as c + f(u) * e1 + g(u) * e2, which is linear in (c, e1, e2),
+        // so their values at three distinct parameters define the whole curve.
+        double first = geo->getFirstParameter();
+        double step = (geo->getLastParameter() - first) / 3;
+
+        for (int i = 0; i < 3; i++) {
+            addVector(geo->value(first + i * step));
+        }
+    }
+
+    return key;
+}
+
 float EditModeGeometryCoinConverter::getBoundingBoxMaxMagnitude()
 {
     return boundingBoxMaxMagnitude;
@@ -54,6 +54,7 @@ struct GeometryLayerNodes;
 struct DrawingParameters;
 class GeometryLayerParameters;
 struct CoinMapping;
+struct CurveTessellationCache;
 
 /** @brief      Class for creating the Geometry layer into coin nodes
  *  @details
@@ -108,12 +109,16 @@ public:
      * the geometry
      *
      * @param drawingparameters: Parameters for drawing the overlay information
+     *
+     * @param tessellationcache: Polylines of the previous conversion, reused for the
+     * curves that did not change and updated for the others
      */
     EditModeGeometryCoinConverter(ViewProviderSketch& vp,
                                   GeometryLayerNodes& geometrylayernodes,
                                   DrawingParameters& drawingparameters,
                                   GeometryLayerParameters& geometryLayerParams,
-                                  CoinMapping& coinMap);
+                                  CoinMapping& coinMap,
+                                  CurveTessellationCache& tessellationcache);
 
     /**
      * converts the geometry defined by GeometryLayer into the coin nodes.
@@ -156,6 +161,10 @@ private:
                  [[maybe_unused]] int geoId,
                  [[maybe_unused]] int subLayerId = 0);
 
+    /// returns the data fully defining the polyline of the curve with numSegments segments
+    template<typename GeoType>
+    std::vector<double> getTessellationKey(const GeoType* geo, int numSegments) const;
+
 private:
     /// Reference to ViewProviderSketch in order to access the public and the Attorney Interface
     ViewProviderSketch& viewProvider;
@@ -177,6 +186,8 @@ private:
     GeometryLayerParameters& geometryLayerParameters;
     // Mappings coin geoId
     CoinMapping& coinMapping;
+    // Polylines of the curves, kept between conversions
+    CurveTessellationCache& tessellationCache;
 
     // measurements
     float boundingBoxMaxMagnitude = 100;
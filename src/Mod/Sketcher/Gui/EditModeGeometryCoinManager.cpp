@@ -106,7 +106,8 @@ void EditModeGeometryCoinManager::processGeometry(const GeoListFacade& geolistfa
                                          geometrylayernodes,
                                          drawingParameters,
                                          geometryLayerParameters,
-                                         coinMapping);
+                                         coinMapping,
+                                         tessellationCache);
 
     gcconv.convert(geolistfacade);
 
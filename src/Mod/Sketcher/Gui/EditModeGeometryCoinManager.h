@@ -28,6 +28,7 @@
 
 #include <Mod/Sketcher/App/GeoList.h>
 
+#include "CurveTessellationCache.h"
 #include "EditModeCoinManagerParameters.h"
 
 
@@ -122,6 +123,9 @@ private:
     EditModeScenegraphNodes& editModeScenegraphNodes;
 
     CoinMapping& coinMapping;
+
+    // polylines of the curves of the last draw, only changed curves are sampled again
+    CurveTessellationCache tessellationCache;
 };
 
 
@@ -200,6 +200,20 @@ void ViewProviderSketch::ParameterObserver::updateRecalculateInitialSolutionWhil
         hGrp2->GetBool("RecalculateInitialSolutionWhileDragging", true);
 }
 
+void ViewProviderSketch::ParameterObserver::updateDragSolveTimeBudget(const std::string& string,
+                                                                      App::Property* property)
+{
+    (void)property;
+    (void)string;
+
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Sketcher");
+
+    // in milliseconds, 0 disables the bound
+    Client.viewProviderParameters.dragSolveTimeBudget =
+        static_cast<int>(hGrp->GetInt("DragSolveTimeBudget", 30));
+}
+
 void ViewProviderSketch::ParameterObserver::subscribeToParameters()
 {
     try {
@@ -307,6 +321,11 @@ void ViewProviderSketch::ParameterObserver::initParameters()
               updateRecalculateInitialSolutionWhileDragging(string, property);
           },
           nullptr}},
+        {"DragSolveTimeBudget",
+         {[this](const std::string& string, App::Property* property) {
+              updateDragSolveTimeBudget(string, property);
+          },
+          nullptr}},
         {"GridSizePixelThreshold",
          {[this](const std::string& string, [[maybe_unused]] App::Property* property) {
               auto v = getSketcherGeneralParameter(string, 15);
@@ -3163,6 +3182,9 @@ bool ViewProviderSketch::setEdit(int ModNum)
     getSketchObject()->setRecalculateInitialSolutionWhileMovingPoint(
         viewProviderParameters.recalculateInitialSolutionWhileDragging);
 
+    // Bound the solve time of every drag step, so that dragging stays fluid on large sketches.
+    getSketchObject()->setDragSolveTimeBudget(viewProviderParameters.dragSolveTimeBudget);
+
     // intercept del key press from main app
     listener = new ShortcutListener(this);
 
@@ -198,6 +198,8 @@ private:
         void updateRecalculateInitialSolutionWhileDragging(const std::string& string,
                                                            App::Property* property);
 
+        void updateDragSolveTimeBudget(const std::string& string, App::Property* property);
+
     private:
         ViewProviderSketch& Client;
         std::map<std::string,
@@ -446,6 +448,7 @@ private:
         bool handleEscapeButton = false;
         bool autoRecompute = false;
         bool recalculateInitialSolutionWhileDragging = false;
+        int dragSolveTimeBudget = 30;  // milliseconds per drag step, 0 means unbounded
 
         bool isShownVirtualSpace =
             false;  // indicates whether the present virtual space view is the
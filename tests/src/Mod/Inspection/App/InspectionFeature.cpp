@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <BRepAdaptor_Surface.hxx>
+#include <BRepBuilderAPI_MakeVertex.hxx>
+#include <BRepExtrema_DistShapeShape.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <BRepPrimAPI_MakeSphere.hxx>
+#include <BRep_Tool.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
+
+#include <src/App/InitApplication.h>
+#include <Mod/Inspection/App/InspectionFeature.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class InspectNominalShapeTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    static std::vector<Handle(Poly_Triangulation)> triangulations(const TopoDS_Shape& shape)
+    {
+        std::vector<Handle(Poly_Triangulation)> result;
+        for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+            TopLoc_Location loc;
+            result.push_back(BRep_Tool::Triangulation(TopoDS::Face(xp.Current()), loc));
+        }
+        return result;
+    }
+};
+
+TEST_F(InspectNominalShapeTest, testBoxDistances)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Solid();
+
+    // Act
+    Inspection::InspectNominalShape nominal(box, 0.0F);
+
+    // Assert
+    // points inside the solid get a negative distance
+    EXPECT_NEAR(nominal.getDistance(Base::Vector3f(15, 5, 5)), 5.0F, 1e-4F);
+    EXPECT_NEAR(nominal.getDistance(Base::Vector3f(5, 5, 11.5F)), 1.5F, 1e-4F);
+    EXPECT_NEAR(nominal.getDistance(Base::Vector3f(5, 5, 2)), -2.0F, 1e-4F);
+    EXPECT_NEAR(nominal.getDistance(Base::Vector3f(9, 9, 5)), -1.0F, 1e-4F);
+    // the closest points lie on an edge and a vertex
+    EXPECT_NEAR(nominal.getDistance(Base::Vector3f(13, 14, 5)), 5.0F, 1e-4F);
+    EXPECT_NEAR(nominal.getDistance(Base::Vector3f(12, 13, 14)), std::sqrt(29.0F), 1e-4F);
+}
+
+TEST_F(InspectNominalShapeTest, testSphereDistances)
+{
+    // Arrange
+    TopoDS_Shape sphere = BRepPrimAPI_MakeSphere(5.0).Solid();
+
+    // Act
+    Inspection::InspectNominalShape nominal(sphere, 0.0F);
+
+    // Assert
+    // the exact surface is used, not its tessellation
+    EXPECT_NEAR(nominal.getDistance(Base::Vector3f(0, 0, 8)), 3.0F, 1e-4F);
+    EXPECT_NEAR(nominal.getDistance(Base::Vector3f(6, 8, 0)), 5.0F, 1e-4F);
+    EXPECT_NEAR(nominal.getDistance(Base::Vector3f(1, 2, 2)), -2.0F, 1e-4F);
+    EXPECT_NEAR(nominal.getDistance(Base::Vector3f(-2.4F, 1.2F, -3.1F)),
+                std::sqrt(2.4F * 2.4F + 1.2F * 1.2F + 3.1F * 3.1F) - 5.0F,
+                1e-4F);
+}
+
+TEST_F(InspectNominalShapeTest, testOpenFaceMatchesExtrema)
+{
+    // Arrange
+    TopoDS_Face face;
+    TopoDS_Shape cylinder = BRepPrimAPI_MakeCylinder(2.0, 5.0).Solid();
+    for (TopExp_Explorer xp(cylinder, TopAbs_FACE); xp.More(); xp.Next()) {
+        if (BRepAdaptor_Surface(TopoDS::Face(xp.Current())).GetType() == GeomAbs_Cylinder) {
+            face = TopoDS::Face(xp.Current());
+        }
+    }
+    ASSERT_FALSE(face.IsNull());
+
+    // Act
+    Inspection::InspectNominalShape nominal(face, 0.0F);
+
+    // Assert
+    // the closest points lie inside the face as well as on its boundary edges
+    for (int i = 0; i < 8; i++) {
+        for (int j = 0; j < 8; j++) {
+            float angle = 0.7F * float(i) + 0.1F;
+            float radius = 0.5F + 0.5F * float(j);
+            Base::Vector3f pnt(radius * std::cos(angle), radius * std::sin(angle), float(i) - 1.5F);
+            BRepExtrema_DistShapeShape distss(
+                face,
+                BRepBuilderAPI_MakeVertex(gp_Pnt(pnt.x, pnt.y, pnt.z)).Vertex());
+            ASSERT_TRUE(distss.IsDone());
+            EXPECT_NEAR(std::fabs(nominal.getDistance(pnt)), distss.Value(), 1e-4);
+        }
+    }
+}
+
+TEST_F(InspectNominalShapeTest, testShapeTriangulationUnchanged)
+{
+    // Arrange
+    TopoDS_Shape plain = BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Solid();
+    TopoDS_Shape meshed = BRepPrimAPI_MakeSphere(5.0).Solid();
+    BRepMesh_IncrementalMesh mesher(meshed, 1.0);
+    std::vector<Handle(Poly_Triangulation)> before = triangulations(meshed);
+
+    // Act
+    Inspection::InspectNominalShape nominal1(plain, 0.0F);
+    Inspection::InspectNominalShape nominal2(meshed, 0.0F);
+
+    // Assert
+    // the index tessellates a copy so that the shapes keep their own triangulation
+    for (const auto& it : triangulations(plain)) {
+        EXPECT_TRUE(it.IsNull());
+    }
+    std::vector<Handle(Poly_Triangulation)> after = triangulations(meshed);
+    ASSERT_EQ(after.size(), before.size());
+    for (std::size_t i = 0; i < after.size(); i++) {
+        EXPECT_EQ(after[i], before[i]);
+    }
+    EXPECT_NEAR(nominal2.getDistance(Base::Vector3f(0, 0, 8)), 3.0F, 1e-4F);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <cmath>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class BVHTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // wavy surface whose facets get finer in x direction
+        const int size = 60;
+        MeshCore::MeshPointArray points;
+        for (int i = 0; i <= size; i++) {
+            float x = std::pow(float(i) / size, 3.0F) * 10.0F;
+            for (int j = 0; j <= size; j++) {
+                float y = float(j) * 10.0F / size;
+                points.push_back(MeshCore::MeshPoint(x, y, std::sin(x) * std::cos(y)));
+            }
+        }
+
+        MeshCore::MeshFacetArray facets;
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                unsigned long p0 = i * (size + 1) + j;
+                unsigned long p1 = p0 + size + 1;
+                facets.push_back(MeshCore::MeshFacet(p0, p1, p1 + 1));
+                facets.push_back(MeshCore::MeshFacet(p0, p1 + 1, p0 + 1));
+            }
+        }
+
+        kernel.Adopt(points, facets, true);
+    }
+
+    void TearDown() override
+    {}
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(BVHTest, TestEmpty)
+{
+    MeshCore::MeshFacetBVH bvh;
+    Base::Vector3f res;
+    MeshCore::FacetIndex facet {};
+    EXPECT_EQ(bvh.IsEmpty(), true);
+    EXPECT_EQ(bvh.NearestFacetOnRay(Base::Vector3f(), Base::Vector3f(0, 0, 1), res, facet), false);
+    EXPECT_EQ(bvh.NearestFacet(Base::Vector3f(), res), MeshCore::FACET_INDEX_MAX);
+}
+
+TEST_F(BVHTest, TestRayMatchesBruteForce)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+    MeshCore::MeshAlgorithm alg(kernel);
+    for (int i = 0; i < 50; i++) {
+        Base::Vector3f pnt(0.2F * float(i), 0.17F * float(i) + 0.3F, 5.0F);
+        Base::Vector3f dir(0.0F, 0.0F, -1.0F);
+        Base::Vector3f res1, res2;
+        MeshCore::FacetIndex facet1 {}, facet2 {};
+        bool hit1 = bvh.NearestFacetOnRay(pnt, dir, res1, facet1);
+        bool hit2 = alg.NearestFacetOnRay(pnt, dir, res2, facet2);
+        EXPECT_EQ(hit1, hit2);
+        if (hit1 && hit2) {
+            EXPECT_NEAR(Base::Distance(res1, res2), 0.0F, 1e-4F);
+        }
+    }
+}
+
+TEST_F(BVHTest, TestRayPackets)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+    std::vector<Base::Vector3f> pnts, dirs, res;
+    std::vector<MeshCore::FacetIndex> facets;
+    for (int i = 0; i < 37; i++) {
+        pnts.emplace_back(0.25F * float(i), 5.0F, 5.0F);
+        dirs.emplace_back(0.1F, 0.0F, -1.0F);
+    }
+    bvh.NearestFacetsOnRays(pnts, dirs, res, facets);
+
+    ASSERT_EQ(facets.size(), pnts.size());
+    for (std::size_t i = 0; i < pnts.size(); i++) {
+        Base::Vector3f hit;
+        MeshCore::FacetIndex facet = MeshCore::FACET_INDEX_MAX;
+        bvh.NearestFacetOnRay(pnts[i], dirs[i], hit, facet);
+        EXPECT_EQ(facets[i], facet);
+    }
+}
+
+TEST_F(BVHTest, TestNearestFacetMatchesBruteForce)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+    for (int i = 0; i < 50; i++) {
+        Base::Vector3f pnt(0.21F * float(i), 10.0F - 0.19F * float(i), float(i % 5) - 2.0F);
+        float minDist = std::numeric_limits<float>::max();
+        for (MeshCore::FacetIndex j = 0; j < kernel.CountFacets(); j++) {
+            minDist = std::min(minDist, kernel.GetFacet(j).DistanceToPoint(pnt));
+        }
+
+        Base::Vector3f res;
+        MeshCore::FacetIndex facet = bvh.NearestFacet(pnt, res);
+        ASSERT_NE(facet, MeshCore::FACET_INDEX_MAX);
+        EXPECT_NEAR(Base::Distance(pnt, res), minDist, 1e-5F);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
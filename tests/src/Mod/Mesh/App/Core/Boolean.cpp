@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Boolean.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class BooleanTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        box1 = makeBox(Base::Vector3f(0.0F, 0.0F, 0.0F), Base::Vector3f(1.0F, 1.0F, 1.0F), 8);
+        box2 = makeBox(Base::Vector3f(0.5F, 0.25F, 0.3F), Base::Vector3f(1.5F, 1.25F, 1.3F), 5);
+    }
+
+    void TearDown() override
+    {}
+
+    // creates an axis-aligned box with outward normals and n x n squares per side
+    static MeshCore::MeshKernel
+    makeBox(const Base::Vector3f& min, const Base::Vector3f& max, int n)
+    {
+        std::vector<MeshCore::MeshGeomFacet> facets;
+        Base::Vector3f size = max - min;
+        for (int axis = 0; axis < 3; axis++) {
+            int u = (axis + 1) % 3;
+            int v = (axis + 2) % 3;
+            for (int side = 0; side < 2; side++) {
+                for (int i = 0; i < n; i++) {
+                    for (int j = 0; j < n; j++) {
+                        auto corner = [&](int di, int dj) {
+                            Base::Vector3f p = min;
+                            p[axis] += side * size[axis];
+                            p[u] += size[u] * float(i + di) / float(n);
+                            p[v] += size[v] * float(j + dj) / float(n);
+                            return p;
+                        };
+                        Base::Vector3f p0 = corner(0, 0);
+                        Base::Vector3f p1 = corner(1, 0);
+                        Base::Vector3f p2 = corner(1, 1);
+                        Base::Vector3f p3 = corner(0, 1);
+                        if (side == 0) {
+                            std::swap(p1, p3);
+                        }
+                        facets.emplace_back(p0, p1, p2);
+                        facets.emplace_back(p0, p2, p3);
+                    }
+                }
+            }
+        }
+
+        MeshCore::MeshKernel kernel;
+        kernel = facets;
+        return kernel;
+    }
+
+    static bool isSolid(const MeshCore::MeshKernel& kernel)
+    {
+        MeshCore::MeshEvalSolid solid(kernel);
+        MeshCore::MeshEvalTopology topology(kernel);
+        return solid.Evaluate() && topology.Evaluate();
+    }
+
+    MeshCore::MeshKernel box1;
+    MeshCore::MeshKernel box2;
+    // volume of the overlapping part of both boxes
+    const float overlap = 0.5F * 0.75F * 0.7F;
+};
+
+TEST_F(BooleanTest, TestUnion)
+{
+    MeshCore::MeshKernel result;
+    MeshCore::MeshBoolean boolean(box1, box2);
+    EXPECT_TRUE(boolean.Compute(MeshCore::MeshBoolean::Union, result));
+
+    EXPECT_TRUE(isSolid(result));
+    EXPECT_NEAR(result.GetVolume(), 2.0F - overlap, 1e-4F);
+}
+
+TEST_F(BooleanTest, TestIntersect)
+{
+    MeshCore::MeshKernel result;
+    MeshCore::MeshBoolean boolean(box1, box2);
+    EXPECT_TRUE(boolean.Compute(MeshCore::MeshBoolean::Intersect, result));
+
+    EXPECT_TRUE(isSolid(result));
+    EXPECT_NEAR(result.GetVolume(), overlap, 1e-4F);
+}
+
+TEST_F(BooleanTest, TestDifference)
+{
+    MeshCore::MeshKernel result;
+    MeshCore::MeshBoolean boolean(box1, box2);
+    boolean.SetThreads(1);
+    EXPECT_TRUE(boolean.Compute(MeshCore::MeshBoolean::Difference, result));
+
+    EXPECT_TRUE(isSolid(result));
+    EXPECT_NEAR(result.GetVolume(), 1.0F - overlap, 1e-4F);
+}
+
+TEST_F(BooleanTest, TestDisjoint)
+{
+    MeshCore::MeshKernel box3 =
+        makeBox(Base::Vector3f(2.0F, 0.0F, 0.0F), Base::Vector3f(3.0F, 1.0F, 1.0F), 2);
+
+    MeshCore::MeshKernel result;
+    MeshCore::MeshBoolean boolean(box1, box3);
+    EXPECT_TRUE(boolean.Compute(MeshCore::MeshBoolean::Union, result));
+    EXPECT_EQ(result.CountFacets(), box1.CountFacets() + box3.CountFacets());
+
+    EXPECT_TRUE(boolean.Compute(MeshCore::MeshBoolean::Intersect, result));
+    EXPECT_EQ(result.CountFacets(), 0);
+}
+
+TEST_F(BooleanTest, TestContained)
+{
+    MeshCore::MeshKernel box3 =
+        makeBox(Base::Vector3f(0.2F, 0.3F, 0.4F), Base::Vector3f(0.6F, 0.7F, 0.8F), 2);
+
+    MeshCore::MeshKernel result;
+    MeshCore::MeshBoolean boolean(box1, box3);
+    EXPECT_TRUE(boolean.Compute(MeshCore::MeshBoolean::Union, result));
+    EXPECT_EQ(result.CountFacets(), box1.CountFacets());
+
+    EXPECT_TRUE(boolean.Compute(MeshCore::MeshBoolean::Difference, result));
+    EXPECT_TRUE(isSolid(result));
+    EXPECT_NEAR(result.GetVolume(), 1.0F - 0.4F * 0.4F * 0.4F, 1e-4F);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/IO/Compact.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <cmath>
+#include <sstream>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class CompactTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a wavy grid with more points and facets than fit into a single chunk
+        const int num = 300;
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (int j = 0; j < num; j++) {
+            for (int i = 0; i < num; i++) {
+                float x = 0.37F * float(i);
+                float y = 0.41F * float(j);
+                points.emplace_back(x, y, std::sin(x) * std::cos(y));
+            }
+        }
+        for (int j = 0; j + 1 < num; j++) {
+            for (int i = 0; i + 1 < num; i++) {
+                MeshCore::PointIndex p = j * num + i;
+                facets.emplace_back(p, p + 1, p + num + 1);
+                facets.emplace_back(p, p + num + 1, p + num);
+            }
+        }
+        kernel.Adopt(points, facets, true);
+    }
+
+    void TearDown() override
+    {}
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(CompactTest, TestLosslessRoundTrip)
+{
+    std::stringstream str;
+    MeshCore::WriterCompact writer(kernel);
+    ASSERT_TRUE(writer.Save(str));
+
+    MeshCore::MeshKernel copy;
+    copy.Read(str);
+
+    ASSERT_EQ(copy.CountPoints(), kernel.CountPoints());
+    ASSERT_EQ(copy.CountFacets(), kernel.CountFacets());
+    for (std::size_t i = 0; i < kernel.CountPoints(); i++) {
+        EXPECT_EQ(Base::Vector3f(copy.GetPoints()[i]), Base::Vector3f(kernel.GetPoints()[i]));
+    }
+    for (std::size_t i = 0; i < kernel.CountFacets(); i++) {
+        const MeshCore::MeshFacet& f1 = kernel.GetFacets()[i];
+        const MeshCore::MeshFacet& f2 = copy.GetFacets()[i];
+        for (int j = 0; j < 3; j++) {
+            EXPECT_EQ(f1._aulPoints[j], f2._aulPoints[j]);
+            EXPECT_EQ(f1._aulNeighbours[j], f2._aulNeighbours[j]);
+        }
+    }
+}
+
+TEST_F(CompactTest, TestQuantizedRoundTrip)
+{
+    const float tolerance = 0.001F;
+    std::stringstream str1, str2;
+    kernel.Write(str1);
+    MeshCore::WriterCompact writer(kernel, 2);
+    writer.SetTolerance(tolerance);
+    ASSERT_TRUE(writer.Save(str2));
+    EXPECT_LT(str2.str().size(), str1.str().size() / 3);
+
+    MeshCore::MeshKernel copy;
+    MeshCore::ReaderCompact reader(copy, 2);
+    ASSERT_TRUE(reader.Load(str2));
+
+    ASSERT_EQ(copy.CountPoints(), kernel.CountPoints());
+    ASSERT_EQ(copy.CountFacets(), kernel.CountFacets());
+    for (std::size_t i = 0; i < kernel.CountPoints(); i++) {
+        Base::Vector3f p1 = kernel.GetPoints()[i];
+        Base::Vector3f p2 = copy.GetPoints()[i];
+        EXPECT_LE(std::fabs(p1.x - p2.x), tolerance * 1.01F);
+        EXPECT_LE(std::fabs(p1.y - p2.y), tolerance * 1.01F);
+        EXPECT_LE(std::fabs(p1.z - p2.z), tolerance * 1.01F);
+    }
+    for (std::size_t i = 0; i < kernel.CountFacets(); i++) {
+        const MeshCore::MeshFacet& f1 = kernel.GetFacets()[i];
+        const MeshCore::MeshFacet& f2 = copy.GetFacets()[i];
+        for (int j = 0; j < 3; j++) {
+            EXPECT_EQ(f1._aulPoints[j], f2._aulPoints[j]);
+        }
+    }
+}
+
+TEST(CompactNonManifoldTest, TestNeighboursKept)
+{
+    // three facets share the edge (0,1), the first two are linked explicitly
+    MeshCore::MeshPointArray points;
+    points.emplace_back(0.F, 0.F, 0.F);
+    points.emplace_back(1.F, 0.F, 0.F);
+    points.emplace_back(0.F, 1.F, 0.F);
+    points.emplace_back(0.F, -1.F, 0.F);
+    points.emplace_back(0.F, 0.F, 1.F);
+    MeshCore::MeshFacetArray facets;
+    facets.emplace_back(0, 1, 2, 1);
+    facets.emplace_back(1, 0, 3, 0);
+    facets.emplace_back(0, 1, 4);
+
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets);
+
+    std::stringstream str;
+    ASSERT_TRUE(MeshCore::WriterCompact(kernel).Save(str));
+    MeshCore::MeshKernel copy;
+    copy.Read(str);
+
+    ASSERT_EQ(copy.CountFacets(), 3);
+    for (std::size_t i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            EXPECT_EQ(copy.GetFacets()[i]._aulNeighbours[j],
+                      kernel.GetFacets()[i]._aulNeighbours[j]);
+        }
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
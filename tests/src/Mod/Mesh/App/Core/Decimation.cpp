@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Decimation.h>
+#include <Mod/Mesh/App/Core/Degeneration.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <cmath>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class DecimationTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // closed torus, so that every stitching error leaves open edges
+        const int numU = 240;
+        const int numV = 120;
+        const float R = 10.0F;
+        const float r = 3.0F;
+        const float pi = 3.14159265F;
+        MeshCore::MeshPointArray points;
+        for (int i = 0; i < numU; i++) {
+            float u = 2.0F * pi * float(i) / float(numU);
+            for (int j = 0; j < numV; j++) {
+                float v = 2.0F * pi * float(j) / float(numV);
+                points.push_back(MeshCore::MeshPoint((R + r * std::cos(v)) * std::cos(u),
+                                                     (R + r * std::cos(v)) * std::sin(u),
+                                                     r * std::sin(v)));
+            }
+        }
+
+        MeshCore::MeshFacetArray facets;
+        for (int i = 0; i < numU; i++) {
+            for (int j = 0; j < numV; j++) {
+                unsigned long p0 = i * numV + j;
+                unsigned long p1 = ((i + 1) % numU) * numV + j;
+                unsigned long p2 = ((i + 1) % numU) * numV + (j + 1) % numV;
+                unsigned long p3 = i * numV + (j + 1) % numV;
+                facets.push_back(MeshCore::MeshFacet(p0, p1, p2));
+                facets.push_back(MeshCore::MeshFacet(p0, p2, p3));
+            }
+        }
+
+        kernel.Adopt(points, facets, true);
+    }
+
+    void TearDown() override
+    {}
+
+    bool isClosed() const
+    {
+        for (const auto& face : kernel.GetFacets()) {
+            for (auto n : face._aulNeighbours) {
+                if (n == MeshCore::FACET_INDEX_MAX) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(DecimationTest, TestSimplifyAtOnce)
+{
+    MeshCore::MeshSimplify simplify(kernel);
+    simplify.setBlockSize(0);
+    simplify.simplify(10000);
+    EXPECT_LE(kernel.CountFacets(), 10000);
+    EXPECT_EQ(isClosed(), true);
+}
+
+TEST_F(DecimationTest, TestSimplifyBlocks)
+{
+    std::size_t numFacets = kernel.CountFacets();
+    MeshCore::MeshSimplify simplify(kernel);
+    simplify.setBlockSize(4000);
+    simplify.setThreads(4);
+    simplify.simplify(10000);
+
+    // what the locked vertices at the block boundaries keep is removed by the global pass
+    EXPECT_LT(kernel.CountFacets(), numFacets / 4);
+    EXPECT_LE(kernel.CountFacets(), 10000);
+    EXPECT_EQ(isClosed(), true);
+    EXPECT_EQ(MeshCore::MeshEvalTopology(kernel).Evaluate(), true);
+    EXPECT_EQ(MeshCore::MeshEvalDuplicatePoints(kernel).Evaluate(), true);
+    EXPECT_EQ(MeshCore::MeshEvalRangePoint(kernel).Evaluate(), true);
+}
+
+TEST_F(DecimationTest, TestSimplifyBlocksReachTarget)
+{
+    // the locked vertices keep the block passes from getting below the block size
+    MeshCore::MeshSimplify simplify(kernel);
+    simplify.setBlockSize(500);
+    simplify.setThreads(4);
+    simplify.simplify(1000);
+    EXPECT_LE(kernel.CountFacets(), 1000);
+    EXPECT_EQ(isClosed(), true);
+}
+
+TEST_F(DecimationTest, TestSimplifyBlocksWithTolerance)
+{
+    std::size_t numFacets = kernel.CountFacets();
+    MeshCore::MeshSimplify simplify(kernel);
+    simplify.setBlockSize(4000);
+    simplify.simplify(0.1F, 0.5F);
+    EXPECT_LT(kernel.CountFacets(), numFacets);
+    EXPECT_EQ(isClosed(), true);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
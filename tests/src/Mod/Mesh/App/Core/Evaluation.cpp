@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Degeneration.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <atomic>
+#include <stdexcept>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class EvaluationTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // planar grid in the xy plane
+        const int size = 40;
+        MeshCore::MeshPointArray points;
+        for (int i = 0; i <= size; i++) {
+            for (int j = 0; j <= size; j++) {
+                points.push_back(MeshCore::MeshPoint(float(i), float(j), 0.0F));
+            }
+        }
+
+        MeshCore::MeshFacetArray facets;
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                unsigned long p0 = i * (size + 1) + j;
+                unsigned long p1 = p0 + size + 1;
+                facets.push_back(MeshCore::MeshFacet(p0, p1, p1 + 1));
+                facets.push_back(MeshCore::MeshFacet(p0, p1 + 1, p0 + 1));
+            }
+        }
+
+        kernel.Adopt(points, facets, true);
+    }
+
+    void TearDown() override
+    {}
+
+    // adds a vertical triangle that pierces the grid
+    void addPiercingFacet()
+    {
+        MeshCore::MeshGeomFacet facet;
+        facet._aclPoints[0].Set(10.3F, 10.3F, -1.0F);
+        facet._aclPoints[1].Set(12.7F, 10.3F, -1.0F);
+        facet._aclPoints[2].Set(11.5F, 10.3F, 1.0F);
+        facet.CalcNormal();
+        kernel += facet;
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(EvaluationTest, TestNoSelfIntersection)
+{
+    MeshCore::MeshEvalSelfIntersection eval(kernel);
+    EXPECT_EQ(eval.Evaluate(), true);
+
+    std::vector<std::pair<MeshCore::FacetIndex, MeshCore::FacetIndex>> pairs;
+    eval.GetIntersections(pairs);
+    EXPECT_EQ(pairs.empty(), true);
+}
+
+TEST_F(EvaluationTest, TestSelfIntersection)
+{
+    addPiercingFacet();
+    MeshCore::FacetIndex piercing = kernel.CountFacets() - 1;
+
+    MeshCore::MeshEvalSelfIntersection eval(kernel);
+    EXPECT_EQ(eval.Evaluate(), false);
+
+    std::vector<std::pair<MeshCore::FacetIndex, MeshCore::FacetIndex>> pairs;
+    eval.GetIntersections(pairs);
+    EXPECT_EQ(pairs.empty(), false);
+    EXPECT_EQ(std::is_sorted(pairs.begin(), pairs.end()), true);
+    EXPECT_EQ(std::adjacent_find(pairs.begin(), pairs.end()), pairs.end());
+    for (const auto& it : pairs) {
+        EXPECT_LT(it.first, it.second);
+        EXPECT_EQ(it.second, piercing);
+    }
+
+    std::vector<std::pair<Base::Vector3f, Base::Vector3f>> lines;
+    eval.GetIntersections(pairs, lines);
+    EXPECT_EQ(lines.size(), pairs.size());
+}
+
+TEST_F(EvaluationTest, TestDegeneratedFacets)
+{
+    MeshCore::MeshEvalDegeneratedFacets eval(kernel, 0.0F);
+    EXPECT_EQ(eval.Evaluate(), true);
+
+    MeshCore::MeshGeomFacet facet;
+    facet._aclPoints[0].Set(0.0F, 0.0F, 5.0F);
+    facet._aclPoints[1].Set(1.0F, 0.0F, 5.0F);
+    facet._aclPoints[2].Set(2.0F, 0.0F, 5.0F);
+    kernel += facet;
+    kernel += facet;
+
+    EXPECT_EQ(eval.Evaluate(), false);
+    std::vector<MeshCore::FacetIndex> indices = eval.GetIndices();
+    ASSERT_EQ(indices.size(), 2);
+    EXPECT_EQ(indices[0], kernel.CountFacets() - 2);
+    EXPECT_EQ(indices[1], kernel.CountFacets() - 1);
+}
+
+TEST_F(EvaluationTest, TestRunner)
+{
+    addPiercingFacet();
+
+    bool selfIntersection = true;
+    bool topology = false;
+    MeshCore::MeshEvalSelfIntersection s_eval(kernel);
+    MeshCore::MeshEvalTopology t_eval(kernel);
+    std::atomic<int> count {0};
+
+    MeshCore::MeshEvaluationRunner runner(2);
+    runner.Add(s_eval, selfIntersection);
+    runner.Add(t_eval, topology);
+    for (int i = 0; i < 10; i++) {
+        runner.Add([&count]() {
+            count++;
+        });
+    }
+
+    EXPECT_EQ(runner.Count(), 12);
+    runner.Run("Checking mesh...");
+    EXPECT_EQ(selfIntersection, false);
+    EXPECT_EQ(topology, true);
+    EXPECT_EQ(count, 10);
+}
+
+TEST_F(EvaluationTest, TestRunnerRethrows)
+{
+    MeshCore::MeshEvaluationRunner runner;
+    runner.Add([]() {
+        throw std::runtime_error("failed check");
+    });
+    runner.Add([]() {});
+    EXPECT_THROW(runner.Run("Checking mesh..."), std::runtime_error);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
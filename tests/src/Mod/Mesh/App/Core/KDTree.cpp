@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include <Mod/Mesh/App/Core/KDTree.h>
+#include <algorithm>
+#include <random>
 
 // NOLINTBEGIN(cppcoreguidelines-*,readability-*)
 
@@ -88,4 +90,106 @@ TEST_F(KDTreeTest, TestKDTreeFindRange)
     tree.FindInRange(Base::Vector3f(0.5F, 0, 0), 0.6F, index);
     EXPECT_EQ(index, result);
 }
+class KDTreeBatchTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> dist(-10.F, 10.F);
+        for (int i = 0; i < 1000; i++) {
+            points.emplace_back(dist(gen), dist(gen), dist(gen));
+        }
+        for (int i = 0; i < 1500; i++) {
+            queries.emplace_back(dist(gen), dist(gen), dist(gen));
+        }
+        tree.AddPoints(points);
+    }
+
+    void TearDown() override
+    {}
+
+    // the point indices sorted by the distance to p
+    std::vector<MeshCore::PointIndex> sortedByDistance(const Base::Vector3f& p) const
+    {
+        std::vector<MeshCore::PointIndex> order(points.size());
+        for (std::size_t i = 0; i < order.size(); i++) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](auto i1, auto i2) {
+            return Base::DistanceP2(p, points[i1]) < Base::DistanceP2(p, points[i2]);
+        });
+        return order;
+    }
+
+    std::vector<Base::Vector3f> points;
+    std::vector<Base::Vector3f> queries;
+    MeshCore::MeshKDTree tree;
+};
+
+TEST_F(KDTreeBatchTest, TestFindNearest)
+{
+    std::vector<MeshCore::PointIndex> indices;
+    tree.FindNearest(queries, -1.F, indices, 4);
+    ASSERT_EQ(indices.size(), queries.size());
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        EXPECT_EQ(indices[i], sortedByDistance(queries[i]).front());
+    }
+}
+
+TEST_F(KDTreeBatchTest, TestFindNearestMaxDist)
+{
+    std::vector<MeshCore::PointIndex> indices;
+    tree.FindNearest(queries, 0.5F, indices, 4);
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        MeshCore::PointIndex index = sortedByDistance(queries[i]).front();
+        if (Base::Distance(queries[i], points[index]) > 0.5F) {
+            index = MeshCore::POINT_INDEX_MAX;
+        }
+        EXPECT_EQ(indices[i], index);
+    }
+}
+
+TEST_F(KDTreeBatchTest, TestFindKNearest)
+{
+    const std::size_t k = 7;
+    std::vector<MeshCore::PointIndex> indices;
+    tree.FindKNearest(queries, k, indices, 4);
+    ASSERT_EQ(indices.size(), queries.size() * k);
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        std::vector<MeshCore::PointIndex> order = sortedByDistance(queries[i]);
+        for (std::size_t j = 0; j < k; j++) {
+            EXPECT_EQ(indices[i * k + j], order[j]);
+        }
+    }
+}
+
+TEST_F(KDTreeBatchTest, TestFindInRadius)
+{
+    const float radius = 1.5F;
+    std::vector<std::vector<MeshCore::PointIndex>> indices;
+    tree.FindInRadius(queries, radius, indices, 4);
+    ASSERT_EQ(indices.size(), queries.size());
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        std::vector<MeshCore::PointIndex> expected;
+        for (auto index : sortedByDistance(queries[i])) {
+            if (Base::Distance(queries[i], points[index]) > radius) {
+                break;
+            }
+            expected.push_back(index);
+        }
+        EXPECT_EQ(indices[i], expected);
+    }
+}
+
+TEST_F(KDTreeBatchTest, TestAddPointsAfterQuery)
+{
+    Base::Vector3f nor;
+    float dist {};
+    Base::Vector3f pnt(20.F, 20.F, 20.F);
+    EXPECT_NE(tree.FindNearest(pnt, nor, dist), points.size());
+    tree.AddPoint(pnt);
+    EXPECT_EQ(tree.FindNearest(pnt, nor, dist), points.size());
+    EXPECT_EQ(dist, 0.F);
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Builder.h>
+#include <Mod/Mesh/App/Core/IO/ReaderMapped.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+TEST(MeshPointWelderTest, TestWeldKeepsFirstOccurrence)
+{
+    std::vector<Base::Vector3f> corners;
+    corners.emplace_back(1.F, 0.F, 0.F);
+    corners.emplace_back(0.F, 1.F, 0.F);
+    corners.emplace_back(0.F, 0.F, 0.F);
+    corners.emplace_back(0.F, 1.F, 0.F);
+    corners.emplace_back(1.F, 0.F, 0.F);
+    corners.emplace_back(1.F, 1.F, -0.F);
+
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    MeshCore::MeshPointWelder welder(4);
+    welder.Weld(corners, points, facets);
+
+    EXPECT_EQ(points.size(), 4);
+    EXPECT_EQ(facets.size(), 2);
+    EXPECT_EQ(Base::Vector3f(points[0]), Base::Vector3f(1.F, 0.F, 0.F));
+    EXPECT_EQ(Base::Vector3f(points[3]), Base::Vector3f(1.F, 1.F, 0.F));
+    EXPECT_EQ(facets[1]._aulPoints[0], 1);
+    EXPECT_EQ(facets[1]._aulPoints[1], 0);
+    EXPECT_EQ(facets[1]._aulPoints[2], 3);
+}
+
+TEST(MeshPointWelderTest, TestWeldIndependentOfThreads)
+{
+    std::vector<Base::Vector3f> corners;
+    for (int i = 0; i < 300; i++) {
+        corners.emplace_back(float(i % 7), float(i % 11), float(i % 5));
+    }
+
+    MeshCore::MeshPointArray points1, points2;
+    MeshCore::MeshFacetArray facets1, facets2;
+    MeshCore::MeshPointWelder(1).Weld(corners, points1, facets1);
+    MeshCore::MeshPointWelder(8).Weld(corners, points2, facets2);
+
+    ASSERT_EQ(points1.size(), points2.size());
+    ASSERT_EQ(facets1.size(), facets2.size());
+    for (std::size_t i = 0; i < facets1.size(); i++) {
+        for (int j = 0; j < 3; j++) {
+            EXPECT_EQ(facets1[i]._aulPoints[j], facets2[i]._aulPoints[j]);
+        }
+    }
+}
+
+TEST(MeshPointWelderTest, TestWeldOnlyIdenticalPoints)
+{
+    // neighbouring floats differ by less than FLT_EPSILON, enough of them share a hash bucket
+    std::vector<Base::Vector3f> corners;
+    float x = 0.5F;
+    for (int i = 0; i < 30000; i++) {
+        corners.emplace_back(x, 0.F, 0.F);
+        x = std::nextafter(x, 1.F);
+    }
+
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    MeshCore::MeshPointWelder(4).Weld(corners, points, facets);
+
+    ASSERT_EQ(points.size(), corners.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        EXPECT_EQ(points[i].x, corners[i].x);
+    }
+}
+
+TEST(ReaderMappedTest, TestAsciiSTL)
+{
+    std::string data = "solid cube\n"
+                       "  facet normal 0 0 -1\n"
+                       "    outer loop\n"
+                       "      vertex 0 0 0\n"
+                       "      vertex 1 1 0\n"
+                       "      vertex 1 0 0\n"
+                       "    endloop\n"
+                       "  endfacet\n"
+                       "  facet normal 0 0 -1\n"
+                       "    outer loop\n"
+                       "      vertex 0 0 0\n"
+                       "      vertex 0 1 0\n"
+                       "      vertex 1 1 0\n"
+                       "    endloop\n"
+                       "  endfacet\n"
+                       "endsolid cube\n";
+
+    MeshCore::MeshKernel kernel;
+    MeshCore::ReaderMapped reader(kernel, 2);
+    EXPECT_EQ(reader.LoadSTL(data.c_str(), data.size()), true);
+    EXPECT_EQ(kernel.CountPoints(), 4);
+    EXPECT_EQ(kernel.CountFacets(), 2);
+}
+
+TEST(ReaderMappedTest, TestBinarySTL)
+{
+    std::string data(80, ' ');
+    std::uint32_t count = 2;
+    data.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    float facets[2][12] = {{0, 0, -1, 0, 0, 0, 1, 1, 0, 1, 0, 0},
+                           {0, 0, -1, 0, 0, 0, 0, 1, 0, 1, 1, 0}};
+    for (const auto& facet : facets) {
+        data.append(reinterpret_cast<const char*>(facet), sizeof(facet));
+        data.append(2, '\0');
+    }
+
+    MeshCore::MeshKernel kernel;
+    MeshCore::ReaderMapped reader(kernel, 2);
+    EXPECT_EQ(reader.LoadSTL(data.c_str(), data.size()), true);
+    EXPECT_EQ(kernel.CountPoints(), 4);
+    EXPECT_EQ(kernel.CountFacets(), 2);
+    EXPECT_EQ(kernel.CountEdges(), 5);
+}
+
+TEST(ReaderMappedTest, TestBinarySTLWithKeywordAfterNul)
+{
+    std::string data(80, ' ');
+    std::uint32_t count = 2;
+    data.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    float facets[2][12] = {{0, 0, -1, 0, 0, 0, 1, 1, 0, 1, 0, 0},
+                           {0, 0, -1, 0, 0, 0, 0, 1, 0, 1, 1, 0}};
+    for (const auto& facet : facets) {
+        data.append(reinterpret_cast<const char*>(facet), sizeof(facet));
+        data.append(2, '\0');
+    }
+    // the bytes of the second normal spell a keyword but come after the NUL bytes of the first
+    std::memcpy(&data[84 + 50], "facet normal", 12);
+
+    MeshCore::MeshKernel kernel;
+    MeshCore::ReaderMapped reader(kernel, 2);
+    EXPECT_EQ(reader.LoadSTL(data.c_str(), data.size()), true);
+    EXPECT_EQ(kernel.CountPoints(), 4);
+    EXPECT_EQ(kernel.CountFacets(), 2);
+}
+
+TEST(ReaderMappedTest, TestOBJ)
+{
+    std::string data = "# quad and triangle\n"
+                       "v 0 0 0\n"
+                       "v 1 0 0\n"
+                       "v 1 1 0\n"
+                       "v 0 1 0\n"
+                       "f 1/1 2/2 3/3 4/4\n"
+                       "v 0 0 1\n"
+                       "f -1 -4 -5\n";
+
+    MeshCore::MeshKernel kernel;
+    MeshCore::ReaderMapped reader(kernel, 2);
+    EXPECT_EQ(reader.LoadOBJ(data.c_str(), data.size()), true);
+    EXPECT_EQ(kernel.CountPoints(), 5);
+    EXPECT_EQ(kernel.CountFacets(), 3);
+    EXPECT_EQ(kernel.GetFacets()[2]._aulPoints[0], 4);
+    EXPECT_EQ(kernel.GetFacets()[2]._aulPoints[1], 1);
+    EXPECT_EQ(kernel.GetFacets()[2]._aulPoints[2], 0);
+}
+
+TEST(ReaderMappedTest, TestOBJWithGroups)
+{
+    std::string data = "v 0 0 0\n"
+                       "v 1 0 0\n"
+                       "v 1 1 0\n"
+                       "g part\n"
+                       "f 1 2 3\n";
+
+    MeshCore::MeshKernel kernel;
+    MeshCore::ReaderMapped reader(kernel, 2);
+    EXPECT_EQ(reader.LoadOBJ(data.c_str(), data.size()), false);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Smoothing.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class SmoothingTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // planar grid in the xy plane with a bump in the middle
+        MeshCore::MeshPointArray points;
+        for (int i = 0; i <= size; i++) {
+            for (int j = 0; j <= size; j++) {
+                points.push_back(MeshCore::MeshPoint(float(i), float(j), 0.0F));
+            }
+        }
+        points[center()].z = 5.0F;
+
+        MeshCore::MeshFacetArray facets;
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                unsigned long p0 = i * (size + 1) + j;
+                unsigned long p1 = p0 + size + 1;
+                facets.push_back(MeshCore::MeshFacet(p0, p1, p1 + 1));
+                facets.push_back(MeshCore::MeshFacet(p0, p1 + 1, p0 + 1));
+            }
+        }
+
+        kernel.Adopt(points, facets, true);
+    }
+
+    void TearDown() override
+    {}
+
+    MeshCore::PointIndex center() const
+    {
+        return (size / 2) * (size + 1) + size / 2;
+    }
+
+    const int size = 100;
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(SmoothingTest, TestPointAdjacency)
+{
+    MeshCore::MeshPointAdjacency adjacency(kernel);
+    MeshCore::MeshRefPointToPoints vv(kernel);
+    MeshCore::MeshRefPointToFacets vf(kernel);
+
+    ASSERT_EQ(adjacency.CountPoints(), kernel.CountPoints());
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        std::vector<MeshCore::PointIndex> expected(vv[i].begin(), vv[i].end());
+        std::vector<MeshCore::PointIndex> neighbours(adjacency.Begin(i), adjacency.End(i));
+        EXPECT_EQ(neighbours, expected);
+        EXPECT_EQ(adjacency.CountNeighbours(i), expected.size());
+        EXPECT_EQ(adjacency.CountFacets(i), vf[i].size());
+    }
+}
+
+TEST_F(SmoothingTest, TestLaplace)
+{
+    MeshCore::LaplaceSmoothing smooth(kernel);
+    smooth.Smooth(10);
+
+    EXPECT_LT(kernel.GetPoint(center()).z, 1.0F);
+    EXPECT_GT(kernel.GetPoint(center()).z, 0.0F);
+
+    // border points are not moved
+    EXPECT_EQ(kernel.GetPoint(0), Base::Vector3f(0.0F, 0.0F, 0.0F));
+    EXPECT_EQ(kernel.GetPoint(size), Base::Vector3f(0.0F, float(size), 0.0F));
+}
+
+TEST_F(SmoothingTest, TestLaplacePoints)
+{
+    MeshCore::MeshPointArray before = kernel.GetPoints();
+    std::vector<MeshCore::PointIndex> indices {center()};
+
+    MeshCore::LaplaceSmoothing smooth(kernel);
+    smooth.SmoothPoints(1, indices);
+
+    // the bump moves towards the centre of its neighbours, all other points keep their position
+    float z = 5.0F * (1.0F - float(smooth.GetLambda()));
+    EXPECT_FLOAT_EQ(kernel.GetPoint(center()).z, z);
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        if (i != center()) {
+            EXPECT_EQ(kernel.GetPoint(i), before[i]);
+        }
+    }
+}
+
+TEST_F(SmoothingTest, TestTaubin)
+{
+    MeshCore::TaubinSmoothing smooth(kernel);
+    smooth.Smooth(10);
+
+    EXPECT_LT(kernel.GetPoint(center()).z, 5.0F);
+    EXPECT_EQ(kernel.GetPoint(0), Base::Vector3f(0.0F, 0.0F, 0.0F));
+}
+
+TEST_F(SmoothingTest, TestPlaneFit)
+{
+    // with a flat bump the mean plane is parallel to the grid
+    kernel.SetPoint(center(), Base::Vector3f(50.0F, 50.0F, 0.5F));
+
+    MeshCore::PlaneFitSmoothing smooth(kernel);
+    smooth.SetMaximum(0.2F);
+    smooth.Smooth(1);
+
+    // the bump is moved towards the mean plane by at most the maximum distance
+    EXPECT_FLOAT_EQ(kernel.GetPoint(center()).z, 0.3F);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
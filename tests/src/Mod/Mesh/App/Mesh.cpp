@@ -106,4 +106,67 @@ TEST_F(MeshTest, TestGrid2OfAlmostPlanarMesh)
     EXPECT_EQ(countY, 1);
     EXPECT_EQ(countZ, 1);
 }
+
+TEST_F(MeshTest, TestRebuildNeighboursOfGrid)
+{
+    const unsigned long size = 200;
+    MeshCore::MeshPointArray points;
+    for (unsigned long i = 0; i <= size; i++) {
+        for (unsigned long j = 0; j <= size; j++) {
+            points.push_back(MeshCore::MeshPoint(float(i), float(j), 0.0F));
+        }
+    }
+
+    MeshCore::MeshFacetArray facets;
+    for (unsigned long i = 0; i < size; i++) {
+        for (unsigned long j = 0; j < size; j++) {
+            unsigned long p0 = i * (size + 1) + j;
+            unsigned long p1 = p0 + size + 1;
+            facets.push_back(MeshCore::MeshFacet(p0, p1, p1 + 1));
+            facets.push_back(MeshCore::MeshFacet(p0, p1 + 1, p0 + 1));
+        }
+    }
+
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+
+    unsigned long borders = 0;
+    const MeshCore::MeshFacetArray& rFacets = kernel.GetFacets();
+    for (MeshCore::FacetIndex i = 0; i < rFacets.size(); i++) {
+        for (MeshCore::FacetIndex nb : rFacets[i]._aulNeighbours) {
+            if (nb == MeshCore::FACET_INDEX_MAX) {
+                borders++;
+            }
+            else {
+                EXPECT_EQ(rFacets[nb].Side(i), rFacets[nb].Side(rFacets[i]));
+                EXPECT_LT(rFacets[nb].Side(i), 3);
+            }
+        }
+    }
+    EXPECT_EQ(borders, 4 * size);
+}
+
+TEST_F(MeshTest, TestRebuildNeighboursOfNonManifold)
+{
+    MeshCore::MeshPointArray points;
+    points.push_back(MeshCore::MeshPoint(0.0F, 0.0F, 0.0F));
+    points.push_back(MeshCore::MeshPoint(1.0F, 0.0F, 0.0F));
+    points.push_back(MeshCore::MeshPoint(0.0F, 1.0F, 0.0F));
+    points.push_back(MeshCore::MeshPoint(0.0F, -1.0F, 0.0F));
+    points.push_back(MeshCore::MeshPoint(0.0F, 0.0F, 1.0F));
+
+    MeshCore::MeshFacetArray facets;
+    facets.push_back(MeshCore::MeshFacet(0, 1, 2));
+    facets.push_back(MeshCore::MeshFacet(1, 0, 3));
+    facets.push_back(MeshCore::MeshFacet(0, 1, 4));
+
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+
+    // the edge shared by three facets is not linked
+    const MeshCore::MeshFacetArray& rFacets = kernel.GetFacets();
+    for (const auto& facet : rFacets) {
+        EXPECT_EQ(facet.CountOpenEdges(), 3);
+    }
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,269 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/Grid.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Projection.h>
+#include <Mod/MeshPart/App/CurveProjector.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+namespace
+{
+
+class TestProjection: public MeshPart::MeshProjection
+{
+public:
+    using MeshProjection::MeshProjection;
+    using MeshProjection::walkFacetPath;
+};
+
+float height(float x, float y)
+{
+    return 0.5F * std::sin(x) * std::cos(y);
+}
+
+}  // namespace
+
+class CurveProjectorTest: public ::testing::Test
+{
+protected:
+    // height field over [0,10]x[0,10], optionally with a square hole in the middle
+    static MeshCore::MeshKernel makeHeightField(bool hole)
+    {
+        const int size = 20;
+        const float step = 10.0F / size;
+        MeshCore::MeshPointArray points;
+        for (int i = 0; i <= size; i++) {
+            for (int j = 0; j <= size; j++) {
+                float x = float(i) * step;
+                float y = float(j) * step;
+                points.push_back(MeshCore::MeshPoint(x, y, height(x, y)));
+            }
+        }
+
+        MeshCore::MeshFacetArray facets;
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                float x = (float(i) + 0.5F) * step;
+                float y = (float(j) + 0.5F) * step;
+                if (hole && x > 4.0F && x < 6.0F && y > 4.0F && y < 6.0F) {
+                    continue;
+                }
+                unsigned long p0 = i * (size + 1) + j;
+                unsigned long p1 = p0 + size + 1;
+                facets.push_back(MeshCore::MeshFacet(p0, p1, p1 + 1));
+                facets.push_back(MeshCore::MeshFacet(p0, p1 + 1, p0 + 1));
+            }
+        }
+
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets, true);
+        return kernel;
+    }
+
+    // the polylines are placed above the mesh and avoid passing through its vertices
+    static std::vector<MeshPart::MeshProjection::PolyLine> makePolyLines()
+    {
+        std::vector<MeshPart::MeshProjection::PolyLine> polylines;
+        for (int k = 0; k < 3; k++) {
+            MeshPart::MeshProjection::PolyLine polyline;
+            for (int i = 0; i <= 20; i++) {
+                float t = float(i) / 20.0F;
+                float x = 0.33F + 9.3F * t;
+                float y = 1.13F + 3.71F * float(k) + 0.4F * std::sin(5.0F * t);
+                polyline.points.emplace_back(x, y, 2.0F);
+            }
+            polylines.push_back(polyline);
+        }
+        return polylines;
+    }
+
+    // the projection of the whole polyline with the grid search
+    static std::vector<Base::Vector3f> projectWithGrid(const MeshCore::MeshKernel& kernel,
+                                                       const std::vector<Base::Vector3f>& points,
+                                                       const Base::Vector3f& dir)
+    {
+        MeshCore::MeshAlgorithm alg(kernel);
+        MeshCore::MeshFacetGrid grid(kernel, 5.0F * alg.GetAverageEdgeLength());
+        MeshCore::MeshProjection projection(kernel);
+
+        std::vector<Base::Vector3f> result;
+        Base::Vector3f prevHit;
+        MeshCore::FacetIndex prevFacet = MeshCore::FACET_INDEX_MAX;
+        for (const auto& it : points) {
+            Base::Vector3f hit;
+            MeshCore::FacetIndex facet {};
+            if (!alg.NearestFacetOnRay(it, dir, hit, facet)) {
+                continue;
+            }
+            if (prevFacet != MeshCore::FACET_INDEX_MAX) {
+                std::vector<Base::Vector3f> path;
+                if (projection.projectLineOnMesh(grid, prevHit, prevFacet, hit, facet, dir, path)) {
+                    result.insert(result.end(), path.begin(), path.end());
+                }
+            }
+            prevHit = hit;
+            prevFacet = facet;
+        }
+        return result;
+    }
+
+    static void expectEqualPaths(const std::vector<Base::Vector3f>& path1,
+                                 const std::vector<Base::Vector3f>& path2)
+    {
+        ASSERT_EQ(path1.size(), path2.size());
+        for (std::size_t i = 0; i < path1.size(); i++) {
+            EXPECT_NEAR(Base::Distance(path1[i], path2[i]), 0.0F, 1e-4F) << "point " << i;
+        }
+    }
+
+    // The grid search joins cut points closer than 0.01 so that the walked path may have a few
+    // more points. All other points must be the same and in the same order.
+    static void expectSamePath(const std::vector<Base::Vector3f>& walked,
+                               const std::vector<Base::Vector3f>& searched)
+    {
+        ASSERT_GE(walked.size(), searched.size());
+        std::size_t index = 0;
+        for (std::size_t i = 0; i < walked.size(); i++) {
+            if (index < searched.size() && Base::Distance(walked[i], searched[index]) < 1e-4F) {
+                index++;
+            }
+            else {
+                ASSERT_GT(i, 0);
+                EXPECT_LT(Base::Distance(walked[i], walked[i - 1]), 0.01F) << "point " << i;
+            }
+        }
+        EXPECT_EQ(index, searched.size());
+    }
+};
+
+TEST_F(CurveProjectorTest, testProjectPolyLinesOnHeightField)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = makeHeightField(false);
+    std::vector<MeshPart::MeshProjection::PolyLine> polylines = makePolyLines();
+    Base::Vector3f dir(0.0F, 0.0F, -1.0F);
+
+    // Act
+    std::vector<MeshPart::MeshProjection::PolyLine> result;
+    MeshPart::MeshProjection(kernel).projectParallelToMesh(polylines, dir, result);
+
+    // Assert
+    ASSERT_EQ(result.size(), polylines.size());
+    for (std::size_t i = 0; i < polylines.size(); i++) {
+        expectSamePath(result[i].points, projectWithGrid(kernel, polylines[i].points, dir));
+        for (const auto& it : result[i].points) {
+            EXPECT_NEAR(it.z, height(it.x, it.y), 0.05F);
+        }
+    }
+}
+
+TEST_F(CurveProjectorTest, testProjectPolyLinesFromBelow)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = makeHeightField(false);
+    std::vector<MeshPart::MeshProjection::PolyLine> polylines = makePolyLines();
+    Base::Vector3f dir(0.0F, 0.0F, -1.0F);
+    std::vector<MeshPart::MeshProjection::PolyLine> expected;
+    MeshPart::MeshProjection(kernel).projectParallelToMesh(polylines, dir, expected);
+
+    // Act
+    // points behind the mesh are projected against the direction
+    for (auto& it : polylines) {
+        for (auto& pnt : it.points) {
+            pnt.z = -2.0F;
+        }
+    }
+    std::vector<MeshPart::MeshProjection::PolyLine> result;
+    MeshPart::MeshProjection(kernel).projectParallelToMesh(polylines, dir, result, 1);
+
+    // Assert
+    ASSERT_EQ(result.size(), expected.size());
+    for (std::size_t i = 0; i < expected.size(); i++) {
+        expectEqualPaths(result[i].points, expected[i].points);
+    }
+}
+
+TEST_F(CurveProjectorTest, testWalkFacetPath)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = makeHeightField(false);
+    MeshCore::MeshAlgorithm alg(kernel);
+    Base::Vector3f dir(0.0F, 0.0F, -1.0F);
+    Base::Vector3f p1, p2;
+    MeshCore::FacetIndex f1 {}, f2 {};
+    ASSERT_TRUE(alg.NearestFacetOnRay(Base::Vector3f(0.33F, 1.13F, 2.0F), dir, p1, f1));
+    ASSERT_TRUE(alg.NearestFacetOnRay(Base::Vector3f(9.63F, 8.42F, 2.0F), dir, p2, f2));
+
+    // Act
+    std::vector<Base::Vector3f> path;
+    bool walked = TestProjection(kernel).walkFacetPath(p1, f1, p2, f2, dir, path);
+
+    // Assert
+    EXPECT_TRUE(walked);
+    MeshCore::MeshFacetGrid grid(kernel, 5.0F * alg.GetAverageEdgeLength());
+    std::vector<Base::Vector3f> expected;
+    MeshCore::MeshProjection projection(kernel);
+    ASSERT_TRUE(projection.projectLineOnMesh(grid, p1, f1, p2, f2, dir, expected));
+    expectSamePath(path, expected);
+}
+
+TEST_F(CurveProjectorTest, testGridSearchAtBorder)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = makeHeightField(true);
+    MeshPart::MeshProjection::PolyLine polyline;
+    polyline.points.emplace_back(2.13F, 5.07F, 2.0F);
+    polyline.points.emplace_back(7.91F, 4.83F, 2.0F);
+    Base::Vector3f dir(0.0F, 0.0F, -1.0F);
+
+    // the walk over the facets stops at the hole in both directions
+    MeshCore::MeshAlgorithm alg(kernel);
+    Base::Vector3f p1, p2;
+    MeshCore::FacetIndex f1 {}, f2 {};
+    ASSERT_TRUE(alg.NearestFacetOnRay(polyline.points[0], dir, p1, f1));
+    ASSERT_TRUE(alg.NearestFacetOnRay(polyline.points[1], dir, p2, f2));
+    std::vector<Base::Vector3f> path;
+    EXPECT_FALSE(TestProjection(kernel).walkFacetPath(p1, f1, p2, f2, dir, path));
+    path.clear();
+    EXPECT_FALSE(TestProjection(kernel).walkFacetPath(p2, f2, p1, f1, dir, path));
+
+    // Act
+    std::vector<MeshPart::MeshProjection::PolyLine> result;
+    MeshPart::MeshProjection(kernel).projectParallelToMesh({polyline}, dir, result);
+
+    // Assert
+    ASSERT_EQ(result.size(), 1);
+    std::vector<Base::Vector3f> expected = projectWithGrid(kernel, polyline.points, dir);
+    EXPECT_FALSE(expected.empty());
+    expectEqualPaths(result[0].points, expected);
+    for (const auto& it : result[0].points) {
+        EXPECT_TRUE(it.x <= 4.0F || it.x >= 6.0F);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
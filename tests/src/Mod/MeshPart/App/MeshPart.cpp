@@ -1,11 +1,17 @@
 #include <gtest/gtest.h>
+#include <list>
+#include <memory>
 #include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
 #include <TopoDS_Solid.hxx>
 #include <TopExp_Explorer.hxx>
 #include <TopAbs_ShapeEnum.hxx>
 #include <QObject>
 
 #include <src/App/InitApplication.h>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Mesh.h>
+#include <Mod/MeshPart/App/Mesher.h>
 
 
 QT_WARNING_PUSH
@@ -111,4 +117,57 @@ TEST_F(SMesh, testStdMeshers)
     delete mesh;
     delete gen;
 }
+
+class StandardMesher: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    static std::unique_ptr<Mesh::MeshObject> createMesh(const TopoDS_Shape& shape, bool parallel)
+    {
+        MeshPart::Mesher mesher(shape);
+        mesher.setMethod(MeshPart::Mesher::Standard);
+        mesher.setDeflection(0.05);
+        mesher.setAngularDeflection(0.2);
+        mesher.setSegments(true);
+        mesher.setParallel(parallel);
+        return std::unique_ptr<Mesh::MeshObject>(mesher.createMesh());
+    }
+
+    static void compareWithSerial(const TopoDS_Shape& shape, unsigned long numFaces)
+    {
+        // the serial path merges the points of the face triangulations
+        auto serial = createMesh(shape, false);
+        auto parallel = createMesh(shape, true);
+
+        std::list<std::vector<MeshCore::PointIndex>> borders;
+        MeshCore::MeshAlgorithm(parallel->getKernel()).GetMeshBorders(borders);
+        EXPECT_TRUE(borders.empty());
+        EXPECT_EQ(parallel->countPoints(), serial->countPoints());
+        EXPECT_EQ(parallel->countFacets(), serial->countFacets());
+
+        ASSERT_EQ(parallel->countSegments(), numFaces);
+        ASSERT_EQ(serial->countSegments(), numFaces);
+        std::size_t numFacets = 0;
+        for (unsigned long i = 0; i < numFaces; i++) {
+            std::size_t size = parallel->getSegment(i).getIndices().size();
+            EXPECT_EQ(size, serial->getSegment(i).getIndices().size());
+            numFacets += size;
+        }
+        EXPECT_EQ(numFacets, parallel->countFacets());
+    }
+};
+
+TEST_F(StandardMesher, testParallelBox)
+{
+    compareWithSerial(BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Solid(), 6);
+}
+
+TEST_F(StandardMesher, testParallelCylinder)
+{
+    compareWithSerial(BRepPrimAPI_MakeCylinder(5.0, 10.0).Solid(), 3);
+}
 // NOLINTEND
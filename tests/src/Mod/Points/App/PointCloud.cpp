@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <Mod/Points/App/PointCloud.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class PointCloudTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // more than one block with a partially filled last block
+        for (std::size_t i = 0; i < 2 * Points::PointCloud::BlockSize + 100; i++) {
+            float t = static_cast<float>(i);
+            points.emplace_back(std::sin(t), std::cos(t), 0.001F * t);
+        }
+    }
+
+    void TearDown() override
+    {}
+
+    std::vector<Base::Vector3f> points;
+};
+
+TEST_F(PointCloudTest, testSetGetPoints)
+{
+    Points::PointCloud cloud;
+    cloud.setPoints(points, 3);
+    EXPECT_EQ(cloud.size(), points.size());
+    EXPECT_EQ(cloud.countBlocks(), 3);
+    EXPECT_EQ(cloud.getPoints(2), points);
+    EXPECT_EQ(cloud.block(2).x.size(), 100);
+    EXPECT_TRUE(cloud.block(2).nx.empty());
+}
+
+TEST_F(PointCloudTest, testAttributes)
+{
+    Points::PointCloud cloud;
+    cloud.setPoints(points);
+    cloud.setIntensities(std::vector<float>(points.size(), 0.5F));
+    EXPECT_TRUE(cloud.hasAttribute(Points::PointCloud::Intensities));
+    EXPECT_FALSE(cloud.hasAttribute(Points::PointCloud::Colors));
+
+    cloud.resize(10);
+    cloud.push_back(Base::Vector3f(1, 2, 3));
+    EXPECT_EQ(cloud.size(), 11);
+    EXPECT_EQ(cloud.getIntensity(9), 0.5F);
+    EXPECT_EQ(cloud.getIntensity(10), 0.0F);
+    EXPECT_EQ(cloud.getPoint(10), Base::Vector3f(1, 2, 3));
+
+    Points::PointCloud copy(cloud);
+    cloud.clear();
+    EXPECT_EQ(copy.size(), 11);
+    EXPECT_EQ(copy.getIntensities().size(), 11);
+}
+
+TEST_F(PointCloudTest, testTransform)
+{
+    Points::PointCloud cloud(Points::PointCloud::Normals);
+    cloud.setPoints(points);
+    cloud.setNormals(std::vector<Base::Vector3f>(points.size(), Base::Vector3f(1, 0, 0)));
+
+    Base::Matrix4D mat;
+    mat.rotZ(0.5);
+    mat.scale(2.0, 2.0, 2.0);
+    mat.move(Base::Vector3d(1, 2, 3));
+    cloud.transformGeometry(mat, 2);
+
+    for (std::size_t i = 0; i < points.size(); i += 97) {
+        Base::Vector3f pnt = mat * points[i];
+        EXPECT_LT(Base::Distance(cloud.getPoint(i), pnt), 1e-5F);
+        EXPECT_FLOAT_EQ(cloud.getNormal(i).Length(), 1.0F);
+    }
+}
+
+TEST_F(PointCloudTest, testBoundBox)
+{
+    float nan = std::numeric_limits<float>::quiet_NaN();
+    points[17].Set(nan, nan, nan);
+
+    Points::PointCloud cloud;
+    cloud.setPoints(points);
+
+    Base::BoundBox3f box;
+    for (const auto& it : points) {
+        if (!std::isnan(it.x)) {
+            box.Add(it);
+        }
+    }
+    Base::BoundBox3f bnd = cloud.getBoundBox(2);
+    EXPECT_EQ(bnd.MinX, box.MinX);
+    EXPECT_EQ(bnd.MaxY, box.MaxY);
+    EXPECT_EQ(bnd.MaxZ, box.MaxZ);
+    EXPECT_FALSE(Points::PointCloud().getBoundBox().IsValid());
+}
+
+TEST_F(PointCloudTest, testKeep)
+{
+    Points::PointCloud cloud(Points::PointCloud::Intensities | Points::PointCloud::Colors);
+    cloud.setPoints(points);
+    for (std::size_t i = 0; i < points.size(); i++) {
+        cloud.setIntensity(i, static_cast<float>(i));
+    }
+    cloud.setColor(5000, Base::Color(1.0F, 0.0F, 0.0F));
+
+    std::vector<std::size_t> indices {0, 3, 5000, points.size() - 1};
+    cloud.keep(indices);
+    EXPECT_EQ(cloud.size(), 4);
+    EXPECT_EQ(cloud.countBlocks(), 1);
+    for (std::size_t i = 0; i < indices.size(); i++) {
+        EXPECT_EQ(cloud.getPoint(i), points[indices[i]]);
+        EXPECT_EQ(cloud.getIntensity(i), static_cast<float>(indices[i]));
+    }
+    EXPECT_EQ(cloud.getColor(2), Base::Color(1.0F, 0.0F, 0.0F));
+    EXPECT_EQ(cloud.getColor(3).getPackedValue(), 0U);
+}
+
+TEST_F(PointCloudTest, testTakeData)
+{
+    Points::PointCloud cloud(Points::PointCloud::Normals);
+    cloud.setPoints(points);
+    cloud.setNormals(std::vector<Base::Vector3f>(points.size(), Base::Vector3f(0, 0, 1)));
+
+    std::vector<Base::Vector3f> pts;
+    std::vector<Base::Vector3f> normals;
+    std::vector<float> intensities(1);
+    std::vector<Base::Color> colors(1);
+    cloud.takeData(pts, normals, intensities, colors);
+    EXPECT_TRUE(cloud.empty());
+    EXPECT_EQ(cloud.countBlocks(), 0);
+    EXPECT_EQ(pts, points);
+    EXPECT_EQ(normals.size(), points.size());
+    EXPECT_EQ(normals.back(), Base::Vector3f(0, 0, 1));
+    EXPECT_TRUE(intensities.empty());
+    EXPECT_TRUE(colors.empty());
+
+    // the attributes are kept for the next points
+    cloud.push_back(Base::Vector3f(1, 2, 3));
+    EXPECT_EQ(cloud.block(0).nx.size(), 1);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
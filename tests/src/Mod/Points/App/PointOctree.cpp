@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <Mod/Points/App/PointOctree.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class PointOctreeTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> dist(0.0F, 10.0F);
+        for (std::size_t i = 0; i < 100000; i++) {
+            points.emplace_back(dist(rng), dist(rng), dist(rng));
+        }
+        points[5].x = std::numeric_limits<float>::quiet_NaN();
+    }
+
+    void TearDown() override
+    {}
+
+    std::vector<Base::Vector3f> points;
+};
+
+TEST_F(PointOctreeTest, testBuild)
+{
+    Points::PointOctree octree;
+    octree.build(points);
+    ASSERT_FALSE(octree.empty());
+
+    // every valid point belongs to exactly one node
+    std::vector<uint32_t> order = octree.getOrder();
+    EXPECT_EQ(order.size(), points.size() - 1);
+    std::ranges::sort(order);
+    EXPECT_EQ(std::ranges::adjacent_find(order), order.end());
+
+    const auto& nodes = octree.getNodes();
+    std::size_t count = 0;
+    for (const auto& node : nodes) {
+        count += node.count;
+        EXPECT_LE(node.firstChild + node.numChildren, nodes.size());
+        for (uint32_t i = node.begin; i < node.begin + node.count; i++) {
+            EXPECT_TRUE(node.box.IsInBox(points[octree.getOrder()[i]]));
+        }
+    }
+    EXPECT_EQ(count, order.size());
+    EXPECT_GT(nodes.size(), 1);
+}
+
+TEST_F(PointOctreeTest, testSelectNodes)
+{
+    Points::PointOctree octree;
+    octree.build(points);
+
+    // everything is visible and very large on the screen
+    auto pixelSpacing = [](const Points::PointOctree::Node&) {
+        return 100.0F;
+    };
+    std::size_t budget = octree.getNodes().front().count + 1000;
+    auto selection = octree.selectNodes(pixelSpacing, budget);
+    ASSERT_GT(selection.size(), 1);
+    EXPECT_EQ(selection.front(), 0);
+
+    std::size_t count = 0;
+    for (uint32_t index : selection) {
+        count += octree.getNodes()[index].count;
+    }
+    EXPECT_LE(count, budget);
+
+    // nothing visible
+    auto culled = [](const Points::PointOctree::Node&) {
+        return -1.0F;
+    };
+    EXPECT_TRUE(octree.selectNodes(culled, budget).empty());
+
+    // the root alone is dense enough
+    auto tiny = [](const Points::PointOctree::Node&) {
+        return 0.5F;
+    };
+    EXPECT_EQ(octree.selectNodes(tiny, budget).size(), 1);
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
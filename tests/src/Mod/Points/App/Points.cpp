@@ -238,4 +238,52 @@ TEST_F(PointsTest, TestPCDStructured)
     EXPECT_EQ(reader.getWidth(), 4);
     EXPECT_EQ(reader.getHeight(), 2);
 }
+
+TEST_F(PointsTest, TestPLYCropFilter)
+{
+    std::string name = getFileName();
+    Points::PlyWriter writer(getKernel());
+    writer.setIntensities(getIntensity());
+    writer.write(name);
+
+    Points::ReadFilter filter;
+    filter.cropBox = Base::BoundBox3d(-0.5, -0.5, -0.5, 0.5, 1.5, 1.5);
+    Points::PlyReader reader;
+    reader.setFilter(filter);
+    reader.read(name);
+
+    EXPECT_EQ(reader.getPoints().size(), 4);
+    EXPECT_EQ(reader.getIntensities().size(), 4);
+    EXPECT_EQ(reader.getWidth(), 4);
+    EXPECT_EQ(reader.getHeight(), 1);
+}
+
+TEST_F(PointsTest, TestPCDSubsampling)
+{
+    std::string name = getFileName();
+    Points::PcdWriter writer(getKernel());
+    writer.setColors(getColors());
+    writer.setWidth(4);
+    writer.setHeight(2);
+    writer.write(name);
+
+    Points::ReadFilter filter;
+    filter.voxelSize = 2.0;
+    Points::PcdReader reader;
+    reader.setFilter(filter);
+    reader.read(name);
+
+    EXPECT_EQ(reader.getPoints().size(), 1);
+    EXPECT_EQ(reader.getColors().size(), 1);
+    EXPECT_FALSE(reader.isStructured());
+
+    filter.voxelSize = 0.0;
+    filter.pointBudget = 3;
+    reader.setFilter(filter);
+    reader.read(name);
+
+    EXPECT_LE(reader.getPoints().size(), 3);
+    EXPECT_GT(reader.getPoints().size(), 0);
+    EXPECT_EQ(reader.getColors().size(), reader.getPoints().size());
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,216 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <Geom_BSplineSurface.hxx>
+#include <TColStd_Array1OfInteger.hxx>
+#include <TColStd_Array1OfReal.hxx>
+#include <TColgp_Array1OfPnt.hxx>
+#include <TColgp_Array2OfPnt.hxx>
+#include <math_Gauss.hxx>
+#include <math_Matrix.hxx>
+#include <math_Vector.hxx>
+#include <Mod/ReverseEngineering/App/ApproxSurface.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class ApproxSurfaceTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // clamped uniform knots as used by BSplineParameterCorrection
+        knots.SetValue(1, 0.0);
+        knots.SetValue(2, 1.0 / 3.0);
+        knots.SetValue(3, 2.0 / 3.0);
+        knots.SetValue(4, 1.0);
+        mults.SetValue(1, order);
+        mults.SetValue(2, 1);
+        mults.SetValue(3, 1);
+        mults.SetValue(4, order);
+
+        // The x and y coordinates of the poles are the Greville abscissae so that the surface
+        // is a graph over the unit square with x = u and y = v
+        const double greville[numPoles] = {0.0, 1.0 / 9.0, 1.0 / 3.0, 2.0 / 3.0, 8.0 / 9.0, 1.0};
+        for (int j = 0; j < numPoles; j++) {
+            for (int k = 0; k < numPoles; k++) {
+                double z = 0.3 * std::sin(double(j) + 0.5 * double(k));
+                poles.SetValue(j + 1, k + 1, gp_Pnt(greville[j], greville[k], z));
+            }
+        }
+        surface = new Geom_BSplineSurface(poles, knots, knots, mults, mults, order - 1, order - 1);
+    }
+
+    void TearDown() override
+    {}
+
+    // samples the known surface on a regular grid, optionally leaving out a corner
+    TColgp_Array1OfPnt samplePoints(bool gap) const
+    {
+        std::vector<gp_Pnt> points;
+        for (int i = 0; i <= numSamples; i++) {
+            for (int j = 0; j <= numSamples; j++) {
+                double u = double(i) / numSamples;
+                double v = double(j) / numSamples;
+                if (gap && u < 0.4 && v < 0.4) {
+                    continue;
+                }
+                points.push_back(surface->Value(u, v));
+            }
+        }
+
+        TColgp_Array1OfPnt array(1, static_cast<int>(points.size()));
+        for (std::size_t i = 0; i < points.size(); i++) {
+            array.SetValue(static_cast<int>(i) + 1, points[i]);
+        }
+        return array;
+    }
+
+    static Handle(Geom_BSplineSurface) fit(Reen::BSplineParameterCorrection& correction,
+                                          const TColgp_Array1OfPnt& points)
+    {
+        correction.SetUV(Base::Vector3d(1, 0, 0), Base::Vector3d(0, 1, 0));
+        // with a size factor of one the (u,v) parameters are the x and y coordinates
+        return correction.CreateSurface(points, 0, false, 1.0);
+    }
+
+    static constexpr int order = 4;
+    static constexpr int numPoles = 6;
+    static constexpr int numSamples = 30;
+    TColStd_Array1OfReal knots {1, 4};
+    TColStd_Array1OfInteger mults {1, 4};
+    TColgp_Array2OfPnt poles {1, numPoles, 1, numPoles};
+    Handle(Geom_BSplineSurface) surface;
+};
+
+TEST_F(ApproxSurfaceTest, testFitWithoutSmoothing)
+{
+    // Arrange
+    TColgp_Array1OfPnt points = samplePoints(false);
+    Reen::BSplineParameterCorrection correction(order, order, numPoles, numPoles);
+
+    // Act
+    Handle(Geom_BSplineSurface) result = fit(correction, points);
+
+    // Assert
+    ASSERT_FALSE(result.IsNull());
+    ASSERT_EQ(result->NbUPoles(), numPoles);
+    ASSERT_EQ(result->NbVPoles(), numPoles);
+    for (int j = 1; j <= numPoles; j++) {
+        for (int k = 1; k <= numPoles; k++) {
+            EXPECT_NEAR(result->Pole(j, k).Distance(poles(j, k)), 0.0, 1e-8);
+        }
+    }
+}
+
+TEST_F(ApproxSurfaceTest, testFitWithSmoothing)
+{
+    // Arrange
+    TColgp_Array1OfPnt points = samplePoints(false);
+    Reen::BSplineParameterCorrection correction(order, order, numPoles, numPoles);
+    const double weight = 10.0;
+    correction.EnableSmoothing(true, weight);
+
+    // the dense normal equations with the first smoothing term as reference
+    const int dim = numPoles * numPoles;
+    Reen::BSplineBasis basis(knots, mults, numPoles + order, order);
+    math_Matrix matrix(1, dim, 1, dim, 0.0);
+    math_Vector rhsX(1, dim, 0.0), rhsY(1, dim, 0.0), rhsZ(1, dim, 0.0);
+    std::vector<double> values(dim);
+    for (int i = points.Lower(); i <= points.Upper(); i++) {
+        const gp_Pnt& pnt = points(i);
+        for (int row = 0; row < dim; row++) {
+            values[row] = basis.BasisFunction(row / numPoles, pnt.X())
+                * basis.BasisFunction(row % numPoles, pnt.Y());
+        }
+        for (int row = 0; row < dim; row++) {
+            for (int col = 0; col < dim; col++) {
+                matrix(row + 1, col + 1) += values[row] * values[col];
+            }
+            rhsX(row + 1) += values[row] * pnt.X();
+            rhsY(row + 1) += values[row] * pnt.Y();
+            rhsZ(row + 1) += values[row] * pnt.Z();
+        }
+    }
+    const math_Matrix& smoothing = correction.GetFirstSmoothMatrix();
+    for (int row = 0; row < dim; row++) {
+        for (int col = 0; col < dim; col++) {
+            matrix(row + 1, col + 1) += weight * smoothing(row, col);
+        }
+    }
+    math_Gauss gauss(matrix);
+    ASSERT_TRUE(gauss.IsDone());
+    math_Vector solX(1, dim), solY(1, dim), solZ(1, dim);
+    gauss.Solve(rhsX, solX);
+    gauss.Solve(rhsY, solY);
+    gauss.Solve(rhsZ, solZ);
+
+    // Act
+    Handle(Geom_BSplineSurface) result = fit(correction, points);
+
+    // Assert
+    ASSERT_FALSE(result.IsNull());
+    double maxDeviation = 0.0;
+    for (int j = 1; j <= numPoles; j++) {
+        for (int k = 1; k <= numPoles; k++) {
+            int index = (j - 1) * numPoles + k;
+            gp_Pnt expected(solX(index), solY(index), solZ(index));
+            EXPECT_NEAR(result->Pole(j, k).Distance(expected), 0.0, 1e-8);
+            maxDeviation = std::max(maxDeviation, result->Pole(j, k).Distance(poles(j, k)));
+        }
+    }
+    // the smoothing term pulls the poles off the exact solution
+    EXPECT_GT(maxDeviation, 1e-3);
+}
+
+TEST_F(ApproxSurfaceTest, testPoleWithoutPoints)
+{
+    // Arrange
+    // no point lies in the support of the corner pole
+    TColgp_Array1OfPnt points = samplePoints(true);
+    Reen::BSplineParameterCorrection correction(order, order, numPoles, numPoles);
+
+    // Act
+    Handle(Geom_BSplineSurface) result = fit(correction, points);
+
+    // Assert
+    // the singular normal equations are reported instead of returning non-finite poles
+    EXPECT_TRUE(result.IsNull());
+
+    // the smoothing terms make the system regular again
+    correction.EnableSmoothing(true, 0.1);
+    result = fit(correction, points);
+    ASSERT_FALSE(result.IsNull());
+    for (int j = 1; j <= numPoles; j++) {
+        for (int k = 1; k <= numPoles; k++) {
+            const gp_Pnt& pole = result->Pole(j, k);
+            EXPECT_TRUE(std::isfinite(pole.X()) && std::isfinite(pole.Y())
+                        && std::isfinite(pole.Z()));
+        }
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
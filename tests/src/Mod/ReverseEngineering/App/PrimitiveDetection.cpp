@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <Mod/ReverseEngineering/App/PrimitiveDetection.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class PrimitiveDetectionTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        rng.seed(42);
+    }
+
+    void TearDown() override
+    {}
+
+    float random(float min, float max)
+    {
+        return std::uniform_real_distribution<float>(min, max)(rng);
+    }
+
+    Base::Vector3f randomDirection()
+    {
+        Base::Vector3f dir(random(-1, 1), random(-1, 1), random(-1, 1));
+        while (dir.Length() < 0.1F) {
+            dir.Set(random(-1, 1), random(-1, 1), random(-1, 1));
+        }
+        return dir.Normalize();
+    }
+
+    // points with random normals in a box far away from all tested primitives
+    void addOutliers(std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i++) {
+            points.emplace_back(random(20, 30), random(20, 30), random(20, 30));
+            normals.push_back(randomDirection());
+        }
+    }
+
+    std::vector<int> detect(Reen::PrimitiveDetector::Primitive type,
+                            std::vector<float>& parameters,
+                            double& probability)
+    {
+        Reen::PrimitiveDetector::Parameters params;
+        Reen::PrimitiveDetector detector(type, params);
+        std::vector<int> inliers;
+        EXPECT_TRUE(detector.perform(points, normals, parameters, inliers, &probability));
+        return inliers;
+    }
+
+    static constexpr std::size_t numSurface = 2000;
+    static constexpr std::size_t numOutliers = 500;
+    std::mt19937 rng;
+    std::vector<Base::Vector3f> points;
+    std::vector<Base::Vector3f> normals;
+};
+
+TEST_F(PrimitiveDetectionTest, testPlane)
+{
+    // Arrange
+    for (std::size_t i = 0; i < numSurface; i++) {
+        points.emplace_back(random(-5, 5), random(-5, 5), 1.0F);
+        normals.emplace_back(0.0F, 0.0F, 1.0F);
+    }
+    addOutliers(numOutliers);
+
+    // Act
+    std::vector<float> parameters;
+    double probability {};
+    auto inliers = detect(Reen::PrimitiveDetector::Primitive::Plane, parameters, probability);
+
+    // Assert
+    ASSERT_EQ(parameters.size(), 4);
+    EXPECT_EQ(inliers.size(), numSurface);
+    EXPECT_LT(inliers.back(), int(numSurface));
+    EXPECT_NEAR(std::fabs(parameters[2]), 1.0F, 1e-4F);
+    EXPECT_NEAR(parameters[3] / parameters[2], -1.0F, 1e-4F);
+    EXPECT_GE(probability, 0.99);
+    EXPECT_LE(probability, 1.0);
+}
+
+TEST_F(PrimitiveDetectionTest, testSphere)
+{
+    // Arrange
+    Base::Vector3f center(1.0F, 2.0F, 3.0F);
+    for (std::size_t i = 0; i < numSurface; i++) {
+        Base::Vector3f dir = randomDirection();
+        points.push_back(center + dir * 2.0F);
+        normals.push_back(dir);
+    }
+    addOutliers(numOutliers);
+
+    // Act
+    std::vector<float> parameters;
+    double probability {};
+    auto inliers = detect(Reen::PrimitiveDetector::Primitive::Sphere, parameters, probability);
+
+    // Assert
+    ASSERT_EQ(parameters.size(), 4);
+    EXPECT_EQ(inliers.size(), numSurface);
+    EXPECT_LT(Base::Distance(Base::Vector3f(parameters[0], parameters[1], parameters[2]), center),
+              1e-3F);
+    EXPECT_NEAR(parameters[3], 2.0F, 1e-3F);
+    EXPECT_GE(probability, 0.99);
+}
+
+TEST_F(PrimitiveDetectionTest, testCylinder)
+{
+    // Arrange
+    for (std::size_t i = 0; i < numSurface; i++) {
+        float angle = random(0, 2 * std::numbers::pi_v<float>);
+        Base::Vector3f radial(std::cos(angle), std::sin(angle), 0.0F);
+        points.push_back(Base::Vector3f(1.0F, 1.0F, random(-3, 3)) + radial * 1.5F);
+        normals.push_back(radial);
+    }
+    addOutliers(numOutliers);
+
+    // Act
+    std::vector<float> parameters;
+    double probability {};
+    auto inliers = detect(Reen::PrimitiveDetector::Primitive::Cylinder, parameters, probability);
+
+    // Assert
+    ASSERT_EQ(parameters.size(), 7);
+    EXPECT_EQ(inliers.size(), numSurface);
+    Base::Vector3f base(parameters[0], parameters[1], parameters[2]);
+    Base::Vector3f axis(parameters[3], parameters[4], parameters[5]);
+    EXPECT_NEAR(std::fabs(axis.z), 1.0F, 1e-4F);
+    EXPECT_LT(base.DistanceToLine(Base::Vector3f(1.0F, 1.0F, 0.0F), Base::Vector3f(0, 0, 1)),
+              1e-3F);
+    EXPECT_NEAR(parameters[6], 1.5F, 1e-3F);
+    EXPECT_GE(probability, 0.99);
+}
+
+TEST_F(PrimitiveDetectionTest, testCone)
+{
+    // Arrange
+    const float halfAngle = std::numbers::pi_v<float> / 6.0F;
+    Base::Vector3f axis(0.0F, 0.0F, 1.0F);
+    for (std::size_t i = 0; i < numSurface; i++) {
+        float angle = random(0, 2 * std::numbers::pi_v<float>);
+        float height = random(1, 5);
+        Base::Vector3f radial(std::cos(angle), std::sin(angle), 0.0F);
+        points.push_back(axis * height + radial * (height * std::tan(halfAngle)));
+        normals.push_back(radial * std::cos(halfAngle) - axis * std::sin(halfAngle));
+    }
+    addOutliers(numOutliers);
+
+    // Act
+    std::vector<float> parameters;
+    double probability {};
+    auto inliers = detect(Reen::PrimitiveDetector::Primitive::Cone, parameters, probability);
+
+    // Assert
+    ASSERT_EQ(parameters.size(), 7);
+    EXPECT_EQ(inliers.size(), numSurface);
+    EXPECT_LT(Base::Vector3f(parameters[0], parameters[1], parameters[2]).Length(), 1e-3F);
+    EXPECT_NEAR(parameters[5], 1.0F, 1e-4F);
+    EXPECT_NEAR(parameters[6], halfAngle, 1e-3F);
+    EXPECT_GE(probability, 0.99);
+}
+
+TEST_F(PrimitiveDetectionTest, testDistanceThreshold)
+{
+    // Arrange
+    // half of the points lie 0.05 above the plane
+    for (std::size_t i = 0; i < numSurface; i++) {
+        float offset = i % 2 == 0 ? 0.0F : 0.05F;
+        points.emplace_back(random(-5, 5), random(-5, 5), offset);
+    }
+    Reen::PrimitiveDetector::Parameters params;
+
+    // Act
+    std::vector<float> parameters;
+    std::vector<int> strict;
+    params.distance = 0.01F;
+    Reen::PrimitiveDetector(Reen::PrimitiveDetector::Primitive::Plane, params)
+        .perform(points, normals, parameters, strict);
+    std::vector<int> loose;
+    params.distance = 0.1F;
+    Reen::PrimitiveDetector(Reen::PrimitiveDetector::Primitive::Plane, params)
+        .perform(points, normals, parameters, loose);
+
+    // Assert
+    EXPECT_EQ(strict.size(), numSurface / 2);
+    EXPECT_EQ(loose.size(), numSurface);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
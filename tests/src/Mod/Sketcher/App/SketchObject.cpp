@@ -2,10 +2,16 @@
 
 #include <FCConfig.h>
 
+#include <BRepBuilderAPI_MakeEdge.hxx>
+#include <gp_Ax2.hxx>
+#include <gp_Elips.hxx>
+#include <gp_Pnt.hxx>
+
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/Expression.h>
 #include <App/ObjectIdentifier.h>
+#include <Mod/Part/App/PartFeature.h>
 #include <Mod/Sketcher/App/GeoEnum.h>
 #include <Mod/Sketcher/App/SketchObject.h>
 #include "SketcherTestHelpers.h"
@@ -860,3 +866,55 @@ TEST_F(SketchObjectTest, testGetElementName)
     EXPECT_STREQ(reverse_export_name.newName.c_str(), (";" + tagName + "v1;SKT.Vertex1").c_str());
     EXPECT_STREQ(reverse_export_name.oldName.c_str(), "Vertex1");
 }
+
+TEST_F(SketchObjectTest, testExternalProjectionCacheHitAfterRecompute)
+{
+    // Arrange
+    auto makeEdge = [](double y) {
+        return BRepBuilderAPI_MakeEdge(gp_Pnt(0.0, y, 1.0), gp_Pnt(10.0, y, 1.0)).Edge();
+    };
+    auto feature =
+        static_cast<Part::Feature*>(getObject()->getDocument()->addObject("Part::Feature"));
+    feature->Shape.setValue(makeEdge(0.0));
+    ASSERT_GE(getObject()->addExternal(feature, "Edge1"), 0);
+    int hits = getObject()->getExternalProjectionCacheHits();
+
+    // Act
+    // a recompute of the referenced object creates a new shape with the same geometry
+    feature->Shape.setValue(makeEdge(0.0));
+    getObject()->rebuildExternalGeometry();
+    int hitsAfterRecompute = getObject()->getExternalProjectionCacheHits();
+    feature->Shape.setValue(makeEdge(2.0));
+    getObject()->rebuildExternalGeometry();
+    int hitsAfterMove = getObject()->getExternalProjectionCacheHits();
+
+    // Assert
+    EXPECT_EQ(hitsAfterRecompute, hits + 1);
+    EXPECT_EQ(hitsAfterMove, hitsAfterRecompute);
+    EXPECT_EQ(getObject()->getExternalGeometryCount(), 3);  // the two axes and the edge
+}
+
+TEST_F(SketchObjectTest, testExternalProjectionRebuiltAfterEllipseChange)
+{
+    // Arrange
+    // an ellipse with the same vertex and the same points at its first, middle and last parameter
+    auto makeEllipse = [](double minorRadius) {
+        gp_Ax2 axes(gp_Pnt(0.0, 0.0, 1.0), gp_Dir(0.0, 0.0, 1.0), gp_Dir(1.0, 0.0, 0.0));
+        return BRepBuilderAPI_MakeEdge(gp_Elips(axes, 5.0, minorRadius)).Edge();
+    };
+    auto feature =
+        static_cast<Part::Feature*>(getObject()->getDocument()->addObject("Part::Feature"));
+    feature->Shape.setValue(makeEllipse(2.0));
+    ASSERT_GE(getObject()->addExternal(feature, "Edge1"), 0);
+    int hits = getObject()->getExternalProjectionCacheHits();
+
+    // Act
+    feature->Shape.setValue(makeEllipse(3.0));
+    getObject()->rebuildExternalGeometry();
+
+    // Assert
+    EXPECT_EQ(getObject()->getExternalProjectionCacheHits(), hits);
+    auto ellipse = dynamic_cast<const Part::GeomEllipse*>(getObject()->getGeometry(-3));
+    ASSERT_NE(ellipse, nullptr);
+    EXPECT_DOUBLE_EQ(ellipse->getMinorRadius(), 3.0);
+}
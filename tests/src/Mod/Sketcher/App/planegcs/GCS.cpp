@@ -50,3 +50,37 @@ TEST_F(GCSTest, clearConstraints)  // NOLINT
     // Assert
     EXPECT_EQ(0, System()->getNumberOfConstraints());
 }
+
+TEST_F(GCSTest, dragSolvesOnlyDraggedComponent)  // NOLINT
+{
+    // Arrange
+    double p1x = 0.0, p1y = 0.0, p2x = 10.0, p2y = 0.0;
+    double q = 0.0, qRef = 0.0, qOffset = 5.0;
+    double distance = 10.0;
+    double targetX = 0.0, targetY = 20.0;
+    GCS::Point p1 {&p1x, &p1y}, p2 {&p2x, &p2y}, target {&targetX, &targetY};
+    std::vector<double*> unknowns = {&p1x, &p1y, &p2x, &p2y, &q};
+
+    System()->addConstraintP2PDistance(p1, p2, &distance, 1);
+    // a second component that is not satisfied and not affected by the drag
+    System()->addConstraintDifference(&qRef, &q, &qOffset, 2);
+    System()->addConstraintP2PCoincident(p2, target, GCS::DefaultTemporaryConstraint);
+    System()->declareUnknowns(unknowns);
+    System()->initSolution();
+
+    // Act
+    System()->setDragging(true);
+    int firstResult = System()->solve(true, GCS::DogLeg);
+    System()->applySolution();
+    targetY = 30.0;
+    int secondResult = System()->solve(true, GCS::DogLeg);
+    System()->applySolution();
+
+    // Assert
+    EXPECT_TRUE(System()->isDraggingMode());
+    EXPECT_FALSE(System()->isSolveInterrupted());
+    EXPECT_EQ(firstResult, GCS::Success);
+    EXPECT_EQ(secondResult, GCS::Success);
+    EXPECT_NEAR(std::hypot(p2x - p1x, p2y - p1y), distance, 1e-6);
+    EXPECT_DOUBLE_EQ(q, 0.0);
+}
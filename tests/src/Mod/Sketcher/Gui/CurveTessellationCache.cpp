@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <Mod/Sketcher/Gui/CurveTessellationCache.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+TEST(CurveTessellationCache, testUpdateWithSameKeyReusesPolyline)
+{
+    // Arrange
+    SketcherGui::CurveTessellationCache cache;
+    auto [entry, isNew] = cache.update(0, {1.0, 2.0, 3.0});
+    entry.polyline = {Base::Vector3d(0, 0, 0), Base::Vector3d(1, 0, 0)};
+    entry.combRepresentationScale = 0.5;
+
+    // Act
+    auto [cached, isChanged] = cache.update(0, {1.0, 2.0, 3.0});
+
+    // Assert
+    EXPECT_TRUE(isNew);
+    EXPECT_FALSE(isChanged);
+    EXPECT_EQ(cached.polyline.size(), 2);
+    EXPECT_EQ(cached.combRepresentationScale, 0.5);
+}
+
+TEST(CurveTessellationCache, testUpdateWithChangedKeyInvalidates)
+{
+    // Arrange
+    SketcherGui::CurveTessellationCache cache;
+    auto [entry, isNew] = cache.update(0, {1.0, 2.0, 3.0});
+    entry.polyline = {Base::Vector3d(0, 0, 0), Base::Vector3d(1, 0, 0)};
+    entry.combRepresentationScale = 0.5;
+    cache.update(1, {1.0, 2.0, 3.0}).first.polyline = {Base::Vector3d(0, 1, 0)};
+
+    // Act
+    auto [changed, isChanged] = cache.update(0, {1.0, 2.0, 4.0});
+    auto [other, isOtherChanged] = cache.update(1, {1.0, 2.0, 3.0});
+
+    // Assert
+    EXPECT_TRUE(isChanged);
+    EXPECT_TRUE(changed.polyline.empty());
+    EXPECT_EQ(changed.combRepresentationScale, 0.0);
+    EXPECT_EQ(changed.key, std::vector<double>({1.0, 2.0, 4.0}));
+    EXPECT_FALSE(isOtherChanged);
+    EXPECT_EQ(other.polyline.size(), 1);
+}
+
+TEST(CurveTessellationCache, testPruneDropsRemovedGeometry)
+{
+    // Arrange
+    SketcherGui::CurveTessellationCache cache;
+    for (int geoId : {-4, -3, -1, 0, 1, 2}) {
+        cache.update(geoId, {double(geoId)});
+    }
+
+    // Act
+    // two internal and three external geometries (including the axes) remain
+    cache.prune(2, 3);
+
+    // Assert
+    EXPECT_EQ(cache.entries.size(), 4);
+    EXPECT_EQ(cache.entries.count(-4), 0);
+    EXPECT_EQ(cache.entries.count(-3), 1);
+    EXPECT_EQ(cache.entries.count(1), 1);
+    EXPECT_EQ(cache.entries.count(2), 0);
+    EXPECT_FALSE(cache.update(-3, {-3.0}).second);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)